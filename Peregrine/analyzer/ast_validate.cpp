@@ -24,8 +24,22 @@ Validator::Validator(AstNodePtr ast,std::string filename,bool is_js,bool should_
     m_is_js=is_js;
     m_filename = filename;
     m_should_contain_main=should_contain_main;
-    ast->accept(*this);
-    if(m_errors.size()>0||(m_should_contain_main && !m_has_main)){
+    accept(ast);
+    finish();
+}
+Validator::Validator(std::string filename,bool is_js,bool should_contain_main){
+    m_is_js=is_js;
+    m_filename = filename;
+    m_should_contain_main=should_contain_main;
+}
+bool Validator::has_errors() const{
+    return m_errors.size()>0;
+}
+bool Validator::passed() const{
+    return !has_errors() && (!m_should_contain_main || m_has_main);
+}
+void Validator::finish(){
+    if(!passed()){
         for(auto& e:m_errors){
             display(e);
         }
@@ -39,62 +53,65 @@ Validator::Validator(AstNodePtr ast,std::string filename,bool is_js,bool should_
 }
 bool Validator::visit(const Program& node){
     for (auto& stmt : node.statements()) {
-        switch(stmt->type()){
-            case KAstTryExcept:
-            case KAstRaiseStmt:
-            case KAstScopeStmt:
-            case KAstWith:
-            case KAstAssertStmt:
-            case KAstContinueStatement:
-            case KAstMatchStmt:
-            case KAstForStatement:
-            case KAstWhileStmt:
-            case KAstReturnStatement:
-            case KAstIfStmt:
-            case KAstBreakStatement:
-            case KAstPassStatement:{
-                add_error(stmt->token(),"SyntaxError: "+keyword[stmt->type()]+" statement outside function",
-                                        "In Peregrine the program stars executing from the main function and not from the global scope",
-                                        "Defining this inside a function");
-                break;
-            }
-            case KAstGenericCall:
-            case KAstFormatedStr:
-            case KAstLambda:
-            case KAstDotExpression:
-            case KAstArrowExpression:
-            case KAstListOrDictAccess:
-            case KAstPrefixExpr:
-            case KAstCast:
-            case KAstTernaryIf:
-            case KAstDict:
-            case KAstList:
-            case KAstIdentifier:
-            case KAstNone:
-            case KAstBool:
-            case KAstBinaryOp:
-            case KAstDecimal:
-            case KAstInteger:{
-                add_error(stmt->token(), "SyntaxError: Expression result unused","Assign the value to a variable ");
-                break;
-            }
-            case KAstFunctionCall:{
-                add_error(stmt->token(), "SyntaxError: Function call outside function", "Either assign the value to a variable or call it inside a function");
-                break;
-            }
-            case KAstAugAssign:{
-                add_error(stmt->token(), "SyntaxError: Reassignment outside function", "Use it inside a function because data can't be mutated outside a function");
-                break;
-            }
-            default:{
-                stmt->accept(*this);
-            }
+        validate(stmt);
+    }
+    return true;
+}
+void Validator::validate(AstNodePtr stmt){
+    switch(stmt->type()){
+        case KAstTryExcept:
+        case KAstRaiseStmt:
+        case KAstScopeStmt:
+        case KAstWith:
+        case KAstAssertStmt:
+        case KAstContinueStatement:
+        case KAstMatchStmt:
+        case KAstForStatement:
+        case KAstWhileStmt:
+        case KAstReturnStatement:
+        case KAstIfStmt:
+        case KAstBreakStatement:
+        case KAstPassStatement:{
+            add_error(stmt->token(),"SyntaxError: "+keyword[stmt->type()]+" statement outside function",
+                                    "In Peregrine the program stars executing from the main function and not from the global scope",
+                                    "Defining this inside a function");
+            break;
+        }
+        case KAstGenericCall:
+        case KAstFormatedStr:
+        case KAstLambda:
+        case KAstDotExpression:
+        case KAstArrowExpression:
+        case KAstListOrDictAccess:
+        case KAstPrefixExpr:
+        case KAstCast:
+        case KAstTernaryIf:
+        case KAstDict:
+        case KAstList:
+        case KAstIdentifier:
+        case KAstNone:
+        case KAstBool:
+        case KAstBinaryOp:
+        case KAstDecimal:
+        case KAstInteger:{
+            add_error(stmt->token(), "SyntaxError: Expression result unused","Assign the value to a variable ");
+            break;
+        }
+        case KAstFunctionCall:{
+            add_error(stmt->token(), "SyntaxError: Function call outside function", "Either assign the value to a variable or call it inside a function");
+            break;
+        }
+        case KAstAugAssign:{
+            add_error(stmt->token(), "SyntaxError: Reassignment outside function", "Use it inside a function because data can't be mutated outside a function");
+            break;
+        }
+        default:{
+            accept(stmt);
         }
     }
-    return true;
 }
 bool Validator::visit(const BlockStatement& node){
-    auto statements = node.statements();
+    auto& statements = node.statements();
     for (size_t i = 0; i < statements.size(); i++) {
         auto stmt=statements[i];
         switch(stmt->type()){
@@ -123,7 +140,7 @@ bool Validator::visit(const BlockStatement& node){
                 break;
             }
             case KAstStatic:{
-                std::shared_ptr<StaticStatement> x =std::dynamic_pointer_cast<StaticStatement>(stmt);
+                StaticStatement* x =static_cast<StaticStatement*>(stmt);
                 if(x->body()->type()==KAstInline){
                     add_error(stmt->token(),"SyntaxError: Nested inline function are not allowed",
                                             "Instead of making the code faster it just makes it less readable");
@@ -176,17 +193,17 @@ bool Validator::visit(const BlockStatement& node){
                 }
             }
             default:{
-                stmt->accept(*this);
+                accept(stmt);
             }
         }
     }
     return true;
 }
 bool Validator::visit(const ClassDefinition& node){
-    node.name()->accept(*this);
-    auto parents=node.parent();
+    accept(node.name());
+    auto& parents=node.parent();
     for (size_t i=0;i<parents.size();++i){
-        parents[i]->accept(*this);
+        accept(parents[i]);
     }
     for (auto& x : node.other()){
         switch(x->type()){
@@ -206,22 +223,22 @@ bool Validator::visit(const ClassDefinition& node){
                 break;
             }
             default:{
-                x->accept(*this);
+                accept(x);
             }
         }
     }
     for (auto& x : node.attributes()){
-        x->accept(*this);
+        accept(x);
     }
-    for (auto& x : node.methods()){
+    for (auto x : node.methods()){
         auto type=x->type();
         switch (x->type()) {
             case KAstStatic:{
-                x =std::dynamic_pointer_cast<StaticStatement>(x)->body();
+                x =static_cast<StaticStatement*>(x)->body();
                 break;
             }
             case KAstInline:{
-                x=std::dynamic_pointer_cast<InlineStatement>(x)->body();
+                x=static_cast<InlineStatement*>(x)->body();
                 break;
             }
             default:{}
@@ -231,7 +248,7 @@ bool Validator::visit(const ClassDefinition& node){
             When it is "static inline" function
             static inline def function():...
             */
-            x=std::dynamic_pointer_cast<InlineStatement>(x)->body();
+            x=static_cast<InlineStatement*>(x)->body();
         }
         switch (x->type()) {
             case KAstMethodDef:{
@@ -248,7 +265,7 @@ bool Validator::visit(const ClassDefinition& node){
                 if(type!=KAstStatic){
                     is_static_class_member=true;
                 }
-                x->accept(*this);
+                accept(x);
                 is_static_class_member=false;
             }
         }
@@ -258,10 +275,9 @@ bool Validator::visit(const ClassDefinition& node){
 bool Validator::visit(const ImportStatement& node){
     //TODO:complete it
     auto module=node.moduleName();
-    auto symbols=node.importedSymbols();
     switch (module->type()) {
         case KAstIdentifier:{
-            auto name=std::dynamic_pointer_cast<IdentifierExpression>(module)->value();
+            auto name=static_cast<IdentifierExpression*>(module)->value();
             std::cout<<"Importing module "<<name<<std::endl;
             break;
         }
@@ -273,13 +289,13 @@ bool Validator::visit(const ImportStatement& node){
     return true;
 }
 bool Validator::visit(const FunctionDefinition& node){
-    node.returnType()->accept(*this);
-    auto name=std::dynamic_pointer_cast<IdentifierExpression>(node.name())->value();
+    accept(node.returnType());
+    auto name=static_cast<IdentifierExpression*>(node.name())->value();
     if(name=="main"){
         m_has_main=true;
     }
-    node.name()->accept(*this);
-    node.body()->accept(*this);
+    accept(node.name());
+    accept(node.body());
     if(is_static_class_member){
         if(node.parameters().size()==0){
             add_error(node.name()->token(),"Error: Non static Methods defined in a class must have atleast one parameter to take in the instance of the object");
@@ -298,43 +314,43 @@ bool Validator::visit(const FunctionDefinition& node){
     return true;
 }
 bool Validator::visit(const VariableStatement& node){
-    node.name()->accept(*this);
-    node.value()->accept(*this);
-    node.varType()->accept(*this);
+    accept(node.name());
+    accept(node.value());
+    accept(node.varType());
     return true;
 }
 bool Validator::visit(const ConstDeclaration& node){
-    node.name()->accept(*this);
-    node.value()->accept(*this);
-    node.constType()->accept(*this);
+    accept(node.name());
+    accept(node.value());
+    accept(node.constType());
     return true;
 }
 bool Validator::visit(const TypeDefinition& node){
-    node.name()->accept(*this);
-    node.baseType()->accept(*this);
+    accept(node.name());
+    accept(node.baseType());
     return true;
 }
 bool Validator::visit(const PassStatement& node){return true;}
 bool Validator::visit(const IfStatement& node){
-    node.condition()->accept(*this);
-    node.ifBody()->accept(*this);
-    node.elseBody()->accept(*this);
-    auto elifs=node.elifs();
+    accept(node.condition());
+    accept(node.ifBody());
+    accept(node.elseBody());
+    auto& elifs=node.elifs();
     for (auto& x:elifs){
-        x.first->accept(*this);
-        x.second->accept(*this);
+        accept(x.first);
+        accept(x.second);
     }
     return true;
 }
 bool Validator::visit(const AssertStatement& node){
-    node.condition()->accept(*this);
+    accept(node.condition());
     return true;
 }
 bool Validator::visit(const StaticStatement& node){
     if(m_is_js){
         add_error(node.token(), "SyntaxError: Static statement is not allowed in javascript");
     }
-    node.body()->accept(*this);
+    accept(node.body());
     return true;
 }
 bool Validator::visit(const InlineStatement& node){
@@ -347,7 +363,7 @@ bool Validator::visit(const InlineStatement& node){
             break;
         }
         default:{
-            node.body()->accept(*this);
+            accept(node.body());
         }
     }
     return true;
@@ -365,88 +381,88 @@ bool Validator::visit(const ExportStatement& node){
             break;
         }
         default:{
-            node.body()->accept(*this);
+            accept(node.body());
         }
     }
     return true;
 }
 bool Validator::visit(const RaiseStatement& node){
-    node.value()->accept(*this);
+    accept(node.value());
     return true;
 }
 bool Validator::visit(const WhileStatement& node){
-    node.condition()->accept(*this);
-    node.body()->accept(*this);
+    accept(node.condition());
+    accept(node.body());
     return true;
 }
 bool Validator::visit(const ForStatement& node){
-    node.sequence()->accept(*this);
-    node.body()->accept(*this);
-    auto var=node.variable();
+    accept(node.sequence());
+    accept(node.body());
+    auto& var=node.variable();
     for(auto& x:var){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 bool Validator::visit(const MatchStatement& node){
     for (auto& x:node.matchItem()){
-        x->accept(*this);
+        accept(x);
     }
-    node.defaultBody()->accept(*this);
-    auto cases=node.caseBody();
+    accept(node.defaultBody());
+    auto& cases=node.caseBody();
     for (auto& x:cases){
         for (auto& y:x.first){
-            y->accept(*this);
+            accept(y);
         }
-        x.second->accept(*this);
+        accept(x.second);
     }
     return true;
 }
 bool Validator::visit(const ScopeStatement& node){
-    node.body()->accept(*this);
+    accept(node.body());
     return true;
 }
 bool Validator::visit(const ReturnStatement& node){
-    node.returnValue()->accept(*this);
+    accept(node.returnValue());
     return true;
 }
 bool Validator::visit(const ContinueStatement& node){return true;}
 bool Validator::visit(const BreakStatement& node){return true;}
 bool Validator::visit(const DecoratorStatement& node){
-    node.body()->accept(*this);
-    auto x=node.decoratorItem();
+    accept(node.body());
+    auto& x=node.decoratorItem();
     for (auto& y:x){
-        y->accept(*this);
+        accept(y);
     }
     return true;
 }
 bool Validator::visit(const ListLiteral& node){
     for (auto& x:node.elements()){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 bool Validator::visit(const DictLiteral& node){
     for (auto& x:node.elements()){
-        x.first->accept(*this);
-        x.second->accept(*this);
+        accept(x.first);
+        accept(x.second);
     }
     return true;
 }
 bool Validator::visit(const ListOrDictAccess& node){
-    node.container()->accept(*this);
+    accept(node.container());
     for (auto& y:node.keyOrIndex()){
-        y->accept(*this);
+        accept(y);
     }
     return true;
 }
 bool Validator::visit(const BinaryOperation& node){
-    node.left()->accept(*this);
-    node.right()->accept(*this);
+    accept(node.left());
+    accept(node.right());
     return true;
 }
 bool Validator::visit(const PrefixExpression& node){
-    node.right()->accept(*this);
+    accept(node.right());
     if(m_is_js){ 
         if(node.prefix().tkType==tk_ampersand||node.prefix().tkType==tk_multiply){
             add_error(node.prefix(),"SyntaxError: Pointers are not allowed in javascript");
@@ -455,48 +471,48 @@ bool Validator::visit(const PrefixExpression& node){
     return true;
 }
 bool Validator::visit(const PostfixExpression& node){
-    node.left()->accept(*this);
+    accept(node.left());
     return true;
 }
 bool Validator::visit(const FunctionCall& node){
-    node.name()->accept(*this);
+    accept(node.name());
     for (auto& x:node.arguments()){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 bool Validator::visit(const DotExpression& node){
-    node.owner()->accept(*this);
+    accept(node.owner());
     switch(node.referenced()->type()){
         case KAstIdentifier:
         case KAstCompileTimeExpression:
         case KAstFunctionCall:
         case KAstArrowExpression:
         case KAstDotExpression:{
-            node.referenced()->accept(*this);
+            accept(node.referenced());
             break;
         }
         default:{
             auto tok=node.referenced()->token();
-            add_error(tok,"Unexpected token "+ tok.keyword);
+            add_error(tok,"Unexpected token "+ tok.keyword());
         }
     }
     return true;
 }
 bool Validator::visit(const ArrowExpression& node){
-    node.owner()->accept(*this);
+    accept(node.owner());
     switch(node.referenced()->type()){
         case KAstIdentifier:
         case KAstCompileTimeExpression:
         case KAstFunctionCall:
         case KAstArrowExpression:
         case KAstDotExpression:{
-            node.referenced()->accept(*this);
+            accept(node.referenced());
             break;
         }
         default:{
             auto tok=node.referenced()->token();
-            add_error(tok,"Unexpected token "+ tok.keyword);
+            add_error(tok,"Unexpected token "+ tok.keyword());
         }
     }
     return true;
@@ -504,18 +520,18 @@ bool Validator::visit(const ArrowExpression& node){
 bool Validator::visit(const IdentifierExpression& node){return true;}
 bool Validator::visit(const TypeExpression& node){
     for (auto& x:node.generic_types()){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 bool Validator::visit(const ListTypeExpr& node){
-    node.elemType()->accept(*this);
-    node.size()->accept(*this);
+    accept(node.elemType());
+    accept(node.size());
     return true;
 }
 
 bool Validator::visit(const FunctionTypeExpr& node){
-    node.returnTypes()->accept(*this);
+    accept(node.returnTypes());
     validate_parameters(node.argTypes());
     return true;
 }
@@ -531,28 +547,28 @@ bool Validator::visit(const UnionLiteral& node){
     }
     else{
         for (auto& x:node.elements()){
-            x.first->accept(*this);
-            x.second->accept(*this);
+            accept(x.first);
+            accept(x.second);
         }
-        node.name()->accept(*this);
+        accept(node.name());
     }
     return true;
 }
 bool Validator::visit(const EnumLiteral& node){
     for (auto& x:node.fields()){
-        x.first->accept(*this);
-        x.second->accept(*this);
+        accept(x.first);
+        accept(x.second);
     }
-    node.name()->accept(*this);
+    accept(node.name());
     return true;
 }
 bool Validator::visit(const WithStatement& node){
-    node.body()->accept(*this);
+    accept(node.body());
     for(auto& x:node.values()){
-        x->accept(*this);
+        accept(x);
     }
     for(auto& x:node.variables()){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
@@ -571,14 +587,14 @@ bool Validator::visit(const VirtualStatement& node){
             break;
         }
         default:{
-            node.body()->accept(*this);
+            accept(node.body());
         }
     }
     return true;
 }
 bool Validator::visit(const CastStatement& node){
-    node.cast_type()->accept(*this);
-    node.value()->accept(*this);
+    accept(node.cast_type());
+    accept(node.value());
     return true;
 }
 bool Validator::visit(const PointerTypeExpr& node){
@@ -586,7 +602,7 @@ bool Validator::visit(const PointerTypeExpr& node){
         add_error(node.token(), "SyntaxError: Pointer type is not allowed in javascript");
     }
     else{
-        node.baseType()->accept(*this);
+        accept(node.baseType());
     }
     return true;
 }
@@ -595,57 +611,57 @@ bool Validator::visit(const RefTypeExpr& node){
         add_error(node.token(), "SyntaxError: Reference type is not allowed in javascript");
     }
     else{
-        node.baseType()->accept(*this);
+        accept(node.baseType());
     }
     return true;
 }
 bool Validator::visit(const DefaultArg& node){
-    node.value()->accept(*this);
-    node.name()->accept(*this);
+    accept(node.value());
+    accept(node.name());
     return true;
 }
 bool Validator::visit(const TernaryIf& node){
-    node.if_value()->accept(*this);
-    node.if_condition()->accept(*this);
-    node.else_value()->accept(*this);
+    accept(node.if_value());
+    accept(node.if_condition());
+    accept(node.else_value());
     return true;
 }
 bool Validator::visit(const TryExcept& node){
-    node.body()->accept(*this);
+    accept(node.body());
     for(auto& x:node.except_clauses()){
         for(auto& y:x.first.first){
-            y->accept(*this);
+            accept(y);
         }
-        x.first.second->accept(*this);
-        x.second->accept(*this);
+        accept(x.first.second);
+        accept(x.second);
     }
     return true;
 }
 bool Validator::visit(const ExpressionTuple& node){
     for(auto& x:node.items()){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 bool Validator::visit(const TypeTuple& node){
     for(auto& x:node.items()){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 bool Validator::visit(const ExternStatement& node){return true;}
 bool Validator::visit(const SumType& node){
     for(auto& x:node.sum_types()){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 bool Validator::visit(const MultipleAssign& node){
     for(auto& x:node.values()){
-        x->accept(*this);
+        accept(x);
     }
     for(auto& x:node.names()){
-        x->accept(*this);
+        accept(x);
     }
     if(node.values().size()!=1&&node.values().size()!=node.names().size()){
         if(node.values().size()>node.names().size()){
@@ -658,16 +674,16 @@ bool Validator::visit(const MultipleAssign& node){
     return true;
 }
 bool Validator::visit(const AugAssign& node){
-    node.name()->accept(*this);
-    node.value()->accept(*this);
+    accept(node.name());
+    accept(node.value());
     return true;
 }
 void Validator::validate_parameters(std::vector<parameter> param){
     bool has_vargs = false;
     for (size_t i=0;i<param.size();i++){
         auto x=param[i];
-        x.p_default->accept(*this);
-        x.p_name->accept(*this);
+        accept(x.p_default);
+        accept(x.p_name);
         if(x.p_type->type()==KAstVarArgTypeExpr){
             if(i<param.size()-1){
                 if(param[i+1].p_type->type()!=KAstVarKwargTypeExpr){
@@ -690,7 +706,7 @@ void Validator::validate_parameters(std::vector<parameter> param){
                 add_error(x.p_type->token(),"'...' has to be the last parameter of the function");
             }
         }
-        x.p_type->accept(*this);
+        accept(x.p_type);
     }
 }
 void Validator::validate_parameters(std::vector<AstNodePtr> param){
@@ -720,22 +736,22 @@ void Validator::validate_parameters(std::vector<AstNodePtr> param){
                 add_error(param[i+1]->token(),"'...' has to be the last parameter of the function");
             }
         }
-        x->accept(*this);
+        accept(x);
     }
 }
 bool Validator::visit(const MethodDefinition& node){
-    node.returnType()->accept(*this);
-    node.name()->accept(*this);
-    node.body()->accept(*this);
-    node.reciever().p_type->accept(*this);
-    node.reciever().p_default->accept(*this);
-    node.reciever().p_name->accept(*this);
+    accept(node.returnType());
+    accept(node.name());
+    accept(node.body());
+    accept(node.reciever().p_type);
+    accept(node.reciever().p_default);
+    accept(node.reciever().p_name);
     validate_parameters(node.parameters());
     return true;
 }
 bool Validator::visit(const ExternFuncDef& node){
-    node.returnType()->accept(*this);
-    node.name()->accept(*this);
+    accept(node.returnType());
+    accept(node.name());
     validate_parameters(node.parameters());
     return true;
 }
@@ -744,19 +760,19 @@ bool Validator::visit(const ExternUnionLiteral& node){
         add_error(node.token(), "SyntaxError: Union type is not allowed in javascript");
     }
     else{    
-        node.name()->accept(*this);
+        accept(node.name());
         for(auto& x:node.elements()){
-            x.first->accept(*this);
-            x.second->accept(*this);
+            accept(x.first);
+            accept(x.second);
         }
     }
     return true;
 }
 bool Validator::visit(const ExternStructLiteral& node){
-    node.name()->accept(*this);
+    accept(node.name());
     for(auto& x:node.elements()){
-        x.first->accept(*this);
-        x.second->accept(*this);
+        accept(x.first);
+        accept(x.second);
     }
     return true;
 }
@@ -773,7 +789,7 @@ bool Validator::visit(const CompileTimeExpression& node){
     auto exp=node.expression();
     auto token=exp->token();
     if(exp->type()==KAstPrivate){
-        exp=std::dynamic_pointer_cast<PrivateDef>(exp)->definition();
+        exp=static_cast<PrivateDef*>(exp)->definition();
     }
     switch(exp->type()){
         case KAstList:
@@ -872,7 +888,7 @@ bool Validator::visit(const CompileTimeExpression& node){
             break;
         }
         default:{
-            exp->accept(*this);
+            accept(exp);
         }
     }
     return true;
@@ -886,7 +902,7 @@ bool Validator::visit(const PrivateDef& node){
             break;
         }
         default:{
-            node.definition()->accept(*this);
+            accept(node.definition());
         }
     } 
     return true;
@@ -896,27 +912,27 @@ bool Validator::visit(const InlineAsm& node){
         add_error(node.token(), "SyntaxError: Inline assembly is not allowed in javascript");
     }
     else{
-        node.output()->accept(*this);
-        auto inputs=node.inputs();
+        accept(node.output());
+        auto& inputs=node.inputs();
         for(auto& x:inputs){
-            x.second->accept(*this);
+            accept(x.second);
         }
     }
     return true;
 } 
 bool Validator::visit(const TernaryFor& node){
-    node.for_value()->accept(*this);
-    node.for_iterate()->accept(*this);
-    auto variable=node.for_variable();
+    accept(node.for_value());
+    accept(node.for_iterate());
+    auto& variable=node.for_variable();
     for(auto& x:variable){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 
 bool Validator::visit(const LambdaDefinition& node){
-    node.body()->accept(*this);
-    auto param=node.parameters();
+    accept(node.body());
+    auto& param=node.parameters();
     for(auto& x:param){
         if(x.p_default->type()!=KAstNoLiteral){
             add_error(x.p_name->token(), "SyntaxError: Lambda parameters cannot have default values");
@@ -933,18 +949,18 @@ bool Validator::visit(const LambdaDefinition& node){
 }
 
 bool Validator::visit(const GenericCall& node){
-    node.identifier()->accept(*this);
-    auto types=node.generic_types();
+    accept(node.identifier());
+    auto& types=node.generic_types();
     for(auto& x:types){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
 
 bool Validator::visit(const FormatedStr& node){
-    auto items=node.items();
+    auto& items=node.items();
     for(auto& x:items){
-        x->accept(*this);
+        accept(x);
     }
     return true;
 }
@@ -952,7 +968,7 @@ bool Validator::visit(const FormatedStr& node){
 void Validator::add_error(Token tok, std::string msg,
                 std::string submsg,std::string hint,
                 std::string ecode){
-        PEError err = {{tok.line, tok.start,tok.location, m_filename, tok.statement},
+        PEError err = {{tok.line, tok.start,tok.location, m_filename, tok.statement()},
                    msg,
                    submsg,
                    hint,
@@ -8,7 +8,9 @@
 #include <vector>
 namespace astValidator{
 using namespace ast;
-class Validator: public AstVisitor {
+class Validator: public Visitor<Validator> {
+        friend class Visitor<Validator>;
+        using Visitor<Validator>::visit;
         std::vector<PEError> m_errors;
         std::string m_filename;
         bool m_is_js=false;
@@ -92,6 +94,15 @@ class Validator: public AstVisitor {
         bool visit(const FormatedStr& node);
     public:
         Validator(AstNodePtr ast,std::string filename,bool is_js=false,bool should_contain_main=false);
+        //for a file that is validated one top-level statement at a time,
+        //finish() reports the errors of all of them and exits if there were any
+        Validator(std::string filename,bool is_js=false,bool should_contain_main=false);
+        void validate(AstNodePtr stmt);
+        void finish();
+        //errors in the statements validated so far
+        bool has_errors() const;
+        //no errors and a main function if one is required
+        bool passed() const;
 };
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,641 @@
+#include "fold.hpp"
+#include "ast/flat.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+
+namespace analyzer {
+
+// the value of a literal
+struct Constant {
+    ast::AstKind kind;
+    int64_t integer = 0;
+    double decimal = 0;
+    bool boolean = false;
+    std::string string;
+};
+
+static std::optional<Constant> constant(ast::AstNodePtr node) {
+    Constant result{node->type()};
+    switch (node->type()) {
+        case ast::KAstInteger: {
+            auto& value = static_cast<ast::IntegerLiteral*>(node)->value();
+            auto end = value.data() + value.size();
+            auto [ptr, ec] = std::from_chars(value.data(), end, result.integer);
+            if (ec != std::errc() || ptr != end) {
+                return std::nullopt;
+            }
+            return result;
+        }
+        case ast::KAstDecimal: {
+            auto& value = static_cast<ast::DecimalLiteral*>(node)->value();
+            auto end = value.data() + value.size();
+            auto [ptr, ec] = std::from_chars(value.data(), end, result.decimal);
+            if (ec != std::errc() || ptr != end) {
+                return std::nullopt;
+            }
+            return result;
+        }
+        case ast::KAstBool:
+            result.boolean = static_cast<ast::BoolLiteral*>(node)->value() == "True";
+            return result;
+        case ast::KAstString: {
+            auto string = static_cast<ast::StringLiteral*>(node);
+            // the text of a raw string is not escaped like the others
+            if (string->raw()) {
+                return std::nullopt;
+            }
+            result.string = string->value();
+            return result;
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+static ast::AstNodePtr integer(Token tok, int64_t value) {
+    // the literal of the smallest value would be the negation of one that
+    // does not fit
+    if (value == std::numeric_limits<int64_t>::min()) {
+        return nullptr;
+    }
+    return ast::make<ast::IntegerLiteral>(tok, std::to_string(value));
+}
+
+static ast::AstNodePtr decimal(Token tok, double value) {
+    if (!std::isfinite(value)) {
+        return nullptr;
+    }
+    // the shortest text that reads back as the same value
+    char text[32];
+    auto end = std::to_chars(text, text + sizeof(text), value).ptr;
+    std::string result(text, end);
+    if (result.find_first_of(".e") == std::string::npos) {
+        result += ".0";
+    }
+    return ast::make<ast::DecimalLiteral>(tok, result);
+}
+
+static ast::AstNodePtr boolean(Token tok, bool value) {
+    return ast::make<ast::BoolLiteral>(tok, value ? "True" : "False");
+}
+
+static ast::AstNodePtr literal(Token tok, const Constant& value) {
+    switch (value.kind) {
+        case ast::KAstInteger:
+            return integer(tok, value.integer);
+        case ast::KAstDecimal:
+            return decimal(tok, value.decimal);
+        case ast::KAstBool:
+            return boolean(tok, value.boolean);
+        default:
+            return ast::make<ast::StringLiteral>(tok, value.string, false);
+    }
+}
+
+// strings keep the escapes they were written with, so joining two of them
+// could make an escape at the end of one take in the start of the next, like
+// "\x4" + "1" becoming "\x41". Strings with escapes are not joined
+static bool escaped(const Constant& value) {
+    return value.kind == ast::KAstString &&
+           value.string.find('\\') != std::string::npos;
+}
+
+// shifts and bitwise operators are only folded where JavaScript, which works
+// on 32 bit integers for them, gives the same result
+static bool fits_32(int64_t value) { return value >= 0 && value <= INT32_MAX; }
+
+static ast::AstNodePtr fold_integers(Token tok, TokenType op, int64_t a, int64_t b) {
+    int64_t result;
+    switch (op) {
+        case tk_plus:
+            return __builtin_add_overflow(a, b, &result) ? nullptr
+                                                         : integer(tok, result);
+        case tk_minus:
+            return __builtin_sub_overflow(a, b, &result) ? nullptr
+                                                         : integer(tok, result);
+        case tk_multiply:
+            return __builtin_mul_overflow(a, b, &result) ? nullptr
+                                                         : integer(tok, result);
+        case tk_floor: {
+            if (b == 0 || (a == std::numeric_limits<int64_t>::min() && b == -1)) {
+                return nullptr;
+            }
+            result = a / b;
+            if (a % b != 0 && (a < 0) != (b < 0)) {
+                result--;
+            }
+            return integer(tok, result);
+        }
+        case tk_modulo:
+            // the backends differ in the sign of the result for negative
+            // operands
+            if (a < 0 || b <= 0) {
+                return nullptr;
+            }
+            return integer(tok, a % b);
+        case tk_exponent: {
+            if (b < 0) {
+                return nullptr;
+            }
+            if (a == 0 || a == 1) {
+                return integer(tok, b == 0 ? 1 : a);
+            }
+            if (a == -1) {
+                return integer(tok, b % 2 == 0 ? 1 : -1);
+            }
+            // any other base overflows within 63 steps
+            result = 1;
+            for (int64_t i = 0; i < b; ++i) {
+                if (__builtin_mul_overflow(result, a, &result)) {
+                    return nullptr;
+                }
+            }
+            return integer(tok, result);
+        }
+        case tk_ampersand:
+        case tk_bit_or:
+        case tk_xor:
+            if (!fits_32(a) || !fits_32(b)) {
+                return nullptr;
+            }
+            result = op == tk_ampersand ? a & b : op == tk_bit_or ? a | b : a ^ b;
+            return integer(tok, result);
+        case tk_shift_left:
+        case tk_shift_right:
+            if (!fits_32(a) || b < 0 || b > 30) {
+                return nullptr;
+            }
+            result = op == tk_shift_left ? a << b : a >> b;
+            return fits_32(result) ? integer(tok, result) : nullptr;
+        case tk_equal:
+            return boolean(tok, a == b);
+        case tk_not_equal:
+            return boolean(tok, a != b);
+        case tk_less:
+            return boolean(tok, a < b);
+        case tk_greater:
+            return boolean(tok, a > b);
+        case tk_less_or_equ:
+            return boolean(tok, a <= b);
+        case tk_gr_or_equ:
+            return boolean(tok, a >= b);
+        default:
+            // `/` of integers is not folded, the backends do not agree on it
+            return nullptr;
+    }
+}
+
+static ast::AstNodePtr fold_decimals(Token tok, TokenType op, double a, double b) {
+    switch (op) {
+        case tk_plus:
+            return decimal(tok, a + b);
+        case tk_minus:
+            return decimal(tok, a - b);
+        case tk_multiply:
+            return decimal(tok, a * b);
+        case tk_divide:
+            return b == 0 ? nullptr : decimal(tok, a / b);
+        case tk_equal:
+            return boolean(tok, a == b);
+        case tk_not_equal:
+            return boolean(tok, a != b);
+        case tk_less:
+            return boolean(tok, a < b);
+        case tk_greater:
+            return boolean(tok, a > b);
+        case tk_less_or_equ:
+            return boolean(tok, a <= b);
+        case tk_gr_or_equ:
+            return boolean(tok, a >= b);
+        default:
+            return nullptr;
+    }
+}
+
+static ast::AstNodePtr fold_booleans(Token tok, TokenType op, bool a, bool b) {
+    switch (op) {
+        case tk_and:
+            return boolean(tok, a && b);
+        case tk_or:
+            return boolean(tok, a || b);
+        case tk_equal:
+            return boolean(tok, a == b);
+        case tk_not_equal:
+            return boolean(tok, a != b);
+        default:
+            return nullptr;
+    }
+}
+
+static std::optional<bool> condition(ast::AstNodePtr node) {
+    if (node->type() != ast::KAstBool) {
+        return std::nullopt;
+    }
+    return static_cast<ast::BoolLiteral*>(node)->value() == "True";
+}
+
+// the constants the folder may replace by their value. Every use of the
+// name must be read by an expression the folder goes into, a name also used
+// in any other way, like a parameter, a loop variable, a member or a
+// constant of another scope, is left alone
+static std::unordered_set<Utils::Symbol> propagated(ast::AstNodePtr program) {
+    ast::FlatAst flat(program);
+    std::vector<ast::FlatAst::Index> parent(flat.size());
+    for (ast::FlatAst::Index i = 0; i < flat.size(); ++i) {
+        for (auto child : flat.children(i)) {
+            parent[child] = i;
+        }
+    }
+    std::unordered_map<Utils::Symbol, size_t> declarations;
+    std::unordered_set<Utils::Symbol> excluded;
+    for (ast::FlatAst::Index i = 1; i < flat.size(); ++i) {
+        if (flat.kind(i) != ast::KAstIdentifier) {
+            continue;
+        }
+        auto node = flat.node(i);
+        auto name = static_cast<ast::IdentifierExpression*>(node)->symbol();
+        auto owner = flat.node(parent[i]);
+        switch (owner->type()) {
+            case ast::KAstConstDecl:
+                if (static_cast<ast::ConstDeclaration*>(owner)->name() == node) {
+                    declarations[name]++;
+                }
+                break;
+            case ast::KAstVariableStmt:
+                if (static_cast<ast::VariableStatement*>(owner)->name() == node) {
+                    excluded.insert(name);
+                }
+                break;
+            case ast::KAstAugAssign:
+                if (static_cast<ast::AugAssign*>(owner)->name() == node) {
+                    excluded.insert(name);
+                }
+                break;
+            case ast::KAstFunctionCall:
+                if (static_cast<ast::FunctionCall*>(owner)->name() == node) {
+                    excluded.insert(name);
+                }
+                break;
+            case ast::KAstBinaryOp:
+            case ast::KAstPrefixExpr:
+            case ast::KAstFormatedStr:
+            case ast::KAstIfStmt:
+            case ast::KAstWhileStmt:
+            case ast::KAstReturnStatement:
+            case ast::KAstTernaryIf:
+            case ast::KAstAssertStmt:
+            case ast::KAstList:
+            case ast::KAstExpressionTuple:
+                break;
+            default:
+                excluded.insert(name);
+                break;
+        }
+    }
+    std::unordered_set<Utils::Symbol> result;
+    for (auto& [name, count] : declarations) {
+        if (count == 1 && !excluded.contains(name)) {
+            result.insert(name);
+        }
+    }
+    return result;
+}
+
+ConstantFolder::ConstantFolder(ast::AstNodePtr program)
+    : m_propagated(propagated(program)) {}
+
+bool ConstantFolder::fold_all(std::vector<ast::AstNodePtr>& nodes) {
+    bool changed = false;
+    for (auto& node : nodes) {
+        auto folded = fold(node);
+        changed = changed || folded != node;
+        node = folded;
+    }
+    return changed;
+}
+
+std::vector<ast::AstNodePtr>
+ConstantFolder::fold_statements(const std::vector<ast::AstNodePtr>& statements) {
+    std::vector<ast::AstNodePtr> result;
+    result.reserve(statements.size());
+    for (auto& stmt : statements) {
+        if (auto folded = fold(stmt)) {
+            result.push_back(folded);
+        }
+    }
+    return result;
+}
+
+ast::AstNodePtr ConstantFolder::fold(ast::AstNodePtr node) {
+    switch (node->type()) {
+        case ast::KAstProgram: {
+            auto program = static_cast<ast::Program*>(node);
+            return ast::make<ast::Program>(fold_statements(program->statements()),
+                                           program->comment());
+        }
+        case ast::KAstBlockStmt: {
+            auto block = static_cast<ast::BlockStatement*>(node);
+            auto statements = fold_statements(block->statements());
+            if (statements == block->statements()) {
+                return node;
+            }
+            return ast::make<ast::BlockStatement>(statements);
+        }
+        case ast::KAstFunctionDef:
+            return fold_function(*static_cast<ast::FunctionDefinition*>(node));
+        case ast::KAstConstDecl:
+            return fold_constant(*static_cast<ast::ConstDeclaration*>(node));
+        case ast::KAstVariableStmt: {
+            auto variable = static_cast<ast::VariableStatement*>(node);
+            auto value = fold(variable->value());
+            if (value == variable->value()) {
+                return node;
+            }
+            return ast::make<ast::VariableStatement>(
+                variable->token(), variable->varType(), variable->name(), value);
+        }
+        case ast::KAstAugAssign: {
+            auto assign = static_cast<ast::AugAssign*>(node);
+            auto value = fold(assign->value());
+            if (value == assign->value()) {
+                return node;
+            }
+            return ast::make<ast::AugAssign>(assign->token(), assign->name(), value);
+        }
+        case ast::KAstIfStmt:
+            return fold_if(*static_cast<ast::IfStatement*>(node));
+        case ast::KAstWhileStmt: {
+            auto loop = static_cast<ast::WhileStatement*>(node);
+            auto cond = fold(loop->condition());
+            if (condition(cond) == false) {
+                return nullptr;
+            }
+            auto body = fold(loop->body());
+            if (cond == loop->condition() && body == loop->body()) {
+                return node;
+            }
+            return ast::make<ast::WhileStatement>(loop->token(), cond, body);
+        }
+        case ast::KAstForStatement: {
+            auto loop = static_cast<ast::ForStatement*>(node);
+            auto sequence = fold(loop->sequence());
+            auto body = fold(loop->body());
+            if (sequence == loop->sequence() && body == loop->body()) {
+                return node;
+            }
+            return ast::make<ast::ForStatement>(loop->token(), loop->variable(),
+                                                sequence, body);
+        }
+        case ast::KAstScopeStmt: {
+            auto scope = static_cast<ast::ScopeStatement*>(node);
+            auto body = fold(scope->body());
+            if (body == scope->body()) {
+                return node;
+            }
+            return ast::make<ast::ScopeStatement>(scope->token(), body);
+        }
+        case ast::KAstReturnStatement: {
+            auto ret = static_cast<ast::ReturnStatement*>(node);
+            auto value = fold(ret->returnValue());
+            if (value == ret->returnValue()) {
+                return node;
+            }
+            return ast::make<ast::ReturnStatement>(ret->token(), value);
+        }
+        case ast::KAstAssertStmt: {
+            auto check = static_cast<ast::AssertStatement*>(node);
+            auto cond = fold(check->condition());
+            if (cond == check->condition()) {
+                return node;
+            }
+            return ast::make<ast::AssertStatement>(check->token(), cond);
+        }
+        case ast::KAstIdentifier: {
+            auto identifier = static_cast<ast::IdentifierExpression*>(node);
+            auto it = m_constants.find(identifier->symbol());
+            if (it == m_constants.end()) {
+                return node;
+            }
+            return literal(identifier->token(), *constant(it->second));
+        }
+        case ast::KAstBinaryOp:
+            return fold_binary(*static_cast<ast::BinaryOperation*>(node));
+        case ast::KAstPrefixExpr:
+            return fold_prefix(*static_cast<ast::PrefixExpression*>(node));
+        case ast::KAstFormatedStr:
+            return fold_format(*static_cast<ast::FormatedStr*>(node));
+        case ast::KAstTernaryIf: {
+            auto ternary = static_cast<ast::TernaryIf*>(node);
+            auto cond = fold(ternary->if_condition());
+            auto if_value = fold(ternary->if_value());
+            auto else_value = fold(ternary->else_value());
+            if (auto known = condition(cond)) {
+                return *known ? if_value : else_value;
+            }
+            if (cond == ternary->if_condition() && if_value == ternary->if_value() &&
+                else_value == ternary->else_value()) {
+                return node;
+            }
+            return ast::make<ast::TernaryIf>(ternary->token(), if_value, cond,
+                                             else_value);
+        }
+        case ast::KAstFunctionCall: {
+            auto call = static_cast<ast::FunctionCall*>(node);
+            auto arguments = call->arguments();
+            if (!fold_all(arguments)) {
+                return node;
+            }
+            return ast::make<ast::FunctionCall>(call->token(), call->name(),
+                                                arguments);
+        }
+        case ast::KAstList: {
+            auto list = static_cast<ast::ListLiteral*>(node);
+            auto elements = list->elements();
+            if (!fold_all(elements)) {
+                return node;
+            }
+            return ast::make<ast::ListLiteral>(list->token(), elements);
+        }
+        case ast::KAstExpressionTuple: {
+            auto tuple = static_cast<ast::ExpressionTuple*>(node);
+            auto items = tuple->items();
+            if (!fold_all(items)) {
+                return node;
+            }
+            return ast::make<ast::ExpressionTuple>(items);
+        }
+        default:
+            return node;
+    }
+}
+
+ast::AstNodePtr ConstantFolder::fold_function(const ast::FunctionDefinition& node) {
+    auto body = fold(node.body());
+    if (body == node.body()) {
+        return const_cast<ast::FunctionDefinition*>(&node);
+    }
+    return ast::make<ast::FunctionDefinition>(node.token(), node.returnType(),
+                                              node.name(), node.parameters(), body,
+                                              node.comment(), node.generics());
+}
+
+ast::AstNodePtr ConstantFolder::fold_constant(const ast::ConstDeclaration& node) {
+    auto value = fold(node.value());
+    auto name = static_cast<ast::IdentifierExpression*>(node.name())->symbol();
+    if (m_propagated.contains(name) && constant(value)) {
+        m_constants[name] = value;
+    }
+    if (value == node.value()) {
+        return const_cast<ast::ConstDeclaration*>(&node);
+    }
+    return ast::make<ast::ConstDeclaration>(node.token(), node.constType(),
+                                            node.name(), value);
+}
+
+ast::AstNodePtr ConstantFolder::fold_binary(const ast::BinaryOperation& node) {
+    auto left = fold(node.left());
+    auto right = fold(node.right());
+    auto op = node.op().tkType;
+    auto a = constant(left);
+    // `False and x` and `True or x` do not look at x
+    if (a && a->kind == ast::KAstBool &&
+        ((op == tk_and && !a->boolean) || (op == tk_or && a->boolean))) {
+        return left;
+    }
+    auto b = constant(right);
+    ast::AstNodePtr folded = nullptr;
+    if (a && b && a->kind == b->kind) {
+        switch (a->kind) {
+            case ast::KAstInteger:
+                folded = fold_integers(node.token(), op, a->integer, b->integer);
+                break;
+            case ast::KAstDecimal:
+                folded = fold_decimals(node.token(), op, a->decimal, b->decimal);
+                break;
+            case ast::KAstBool:
+                folded = fold_booleans(node.token(), op, a->boolean, b->boolean);
+                break;
+            default:
+                if (op == tk_plus && !escaped(*a) && !escaped(*b)) {
+                    folded = ast::make<ast::StringLiteral>(
+                        node.token(), a->string + b->string, false);
+                }
+                break;
+        }
+    }
+    if (folded != nullptr) {
+        return folded;
+    }
+    if (left == node.left() && right == node.right()) {
+        return const_cast<ast::BinaryOperation*>(&node);
+    }
+    return ast::make<ast::BinaryOperation>(node.token(), left, node.op(), right);
+}
+
+ast::AstNodePtr ConstantFolder::fold_prefix(const ast::PrefixExpression& node) {
+    auto right = fold(node.right());
+    ast::AstNodePtr folded = nullptr;
+    if (auto value = constant(right)) {
+        auto op = node.prefix().tkType;
+        if (op == tk_not && value->kind == ast::KAstBool) {
+            folded = boolean(node.token(), !value->boolean);
+        } else if (op == tk_minus && value->kind == ast::KAstInteger) {
+            folded = integer(node.token(), -value->integer);
+        } else if (op == tk_minus && value->kind == ast::KAstDecimal) {
+            folded = decimal(node.token(), -value->decimal);
+        } else if (op == tk_bit_not && value->kind == ast::KAstInteger &&
+                   fits_32(value->integer)) {
+            folded = integer(node.token(), ~value->integer);
+        }
+    }
+    if (folded != nullptr) {
+        return folded;
+    }
+    if (right == node.right()) {
+        return const_cast<ast::PrefixExpression*>(&node);
+    }
+    return ast::make<ast::PrefixExpression>(node.token(), node.prefix(), right);
+}
+
+ast::AstNodePtr ConstantFolder::fold_format(const ast::FormatedStr& node) {
+    auto items = node.items();
+    bool changed = fold_all(items);
+    // decimals are left to the program, their text depends on how it
+    // prints them, and so are strings with escapes
+    std::string text;
+    for (auto& item : items) {
+        auto value = constant(item);
+        if (!value || value->kind == ast::KAstDecimal || escaped(*value)) {
+            if (!changed) {
+                return const_cast<ast::FormatedStr*>(&node);
+            }
+            return ast::make<ast::FormatedStr>(node.token(), items);
+        }
+        switch (value->kind) {
+            case ast::KAstInteger:
+                text += std::to_string(value->integer);
+                break;
+            case ast::KAstBool:
+                text += value->boolean ? "True" : "False";
+                break;
+            default:
+                text += value->string;
+                break;
+        }
+    }
+    return ast::make<ast::StringLiteral>(node.token(), text, false);
+}
+
+ast::AstNodePtr ConstantFolder::fold_if(const ast::IfStatement& node) {
+    // the condition and body of the if and each elif, the branches that can
+    // never be taken are left out and one that is always taken ends it
+    std::vector<std::pair<ast::AstNodePtr, ast::AstNodePtr>> branches;
+    branches.push_back({node.condition(), node.ifBody()});
+    branches.insert(branches.end(), node.elifs().begin(), node.elifs().end());
+    std::vector<std::pair<ast::AstNodePtr, ast::AstNodePtr>> taken;
+    auto elseBody = node.elseBody();
+    bool changed = false;
+    bool always = false;
+    for (auto& [cond, body] : branches) {
+        auto foldedCond = fold(cond);
+        auto known = condition(foldedCond);
+        if (known == false) {
+            changed = true;
+            continue;
+        }
+        auto foldedBody = fold(body);
+        if (known == true) {
+            elseBody = foldedBody;
+            changed = always = true;
+            break;
+        }
+        changed = changed || foldedCond != cond || foldedBody != body;
+        taken.push_back({foldedCond, foldedBody});
+    }
+    if (!always && elseBody->type() != ast::KAstNoLiteral) {
+        auto foldedElse = fold(elseBody);
+        changed = changed || foldedElse != elseBody;
+        elseBody = foldedElse;
+    }
+    if (!changed) {
+        return const_cast<ast::IfStatement*>(&node);
+    }
+    if (taken.empty()) {
+        // the body keeps its own scope
+        if (elseBody->type() == ast::KAstNoLiteral) {
+            return nullptr;
+        }
+        return ast::make<ast::ScopeStatement>(node.token(), elseBody);
+    }
+    auto first = taken.front();
+    taken.erase(taken.begin());
+    return ast::make<ast::IfStatement>(node.token(), first.first, first.second,
+                                       elseBody, taken);
+}
+
+} // namespace analyzer
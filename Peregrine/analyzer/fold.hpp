@@ -0,0 +1,49 @@
+#ifndef PEREGRINE_FOLD_HPP
+#define PEREGRINE_FOLD_HPP
+
+#include "ast/ast.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace analyzer {
+
+// folds what is known before the program runs, for both backends.
+// Arithmetic, comparisons and boolean logic on literals become literals,
+// f-strings of literals become strings, uses of a constant with a literal
+// value become that literal and the branches of an if that can not run are
+// removed. Nodes are not changed, one with a folded child is made again, so
+// fold returns the node to use instead
+class ConstantFolder {
+    // constants that can be replaced by their value: declared once, and only
+    // read by expressions the folder goes into
+    std::unordered_set<Utils::Symbol> m_propagated;
+    // the literal values of those of them declared so far
+    std::unordered_map<Utils::Symbol, ast::AstNodePtr> m_constants;
+
+    ast::AstNodePtr fold_binary(const ast::BinaryOperation& node);
+    ast::AstNodePtr fold_prefix(const ast::PrefixExpression& node);
+    ast::AstNodePtr fold_format(const ast::FormatedStr& node);
+    ast::AstNodePtr fold_if(const ast::IfStatement& node);
+    ast::AstNodePtr fold_function(const ast::FunctionDefinition& node);
+    ast::AstNodePtr fold_constant(const ast::ConstDeclaration& node);
+    // a statement that folds to nothing is left out
+    std::vector<ast::AstNodePtr>
+    fold_statements(const std::vector<ast::AstNodePtr>& statements);
+    // folds each node, true if any of them changed
+    bool fold_all(std::vector<ast::AstNodePtr>& nodes);
+
+  public:
+    // constants are only propagated when the whole program is known, a
+    // program folded one statement at a time only has its expressions
+    // folded
+    ConstantFolder() = default;
+    explicit ConstantFolder(ast::AstNodePtr program);
+
+    // nullptr for a statement that is removed
+    ast::AstNodePtr fold(ast::AstNodePtr node);
+};
+
+} // namespace analyzer
+
+#endif
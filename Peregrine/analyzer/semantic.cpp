@@ -0,0 +1,27 @@
+#include "semantic.hpp"
+
+namespace analyzer {
+
+Semantic::Semantic(std::string filename, bool is_js, bool should_contain_main,
+                   Types types)
+    : m_validator(filename, is_js, should_contain_main) {
+    if (types != Types::None) {
+        m_checker.emplace(filename, types == Types::Annotate);
+    }
+}
+
+void Semantic::analyze(ast::AstNodePtr stmt) {
+    m_validator.validate(stmt);
+    if (m_checker && !m_validator.has_errors()) {
+        m_checker->checkStatement(stmt);
+    }
+}
+
+void Semantic::finish() {
+    m_validator.finish();
+    if (m_checker) {
+        m_checker->finish();
+    }
+}
+
+} // namespace analyzer
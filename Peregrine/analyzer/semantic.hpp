@@ -0,0 +1,41 @@
+#ifndef PEREGRINE_SEMANTIC_HPP
+#define PEREGRINE_SEMANTIC_HPP
+
+#include "ast/ast.hpp"
+#include "analyzer/ast_validate.hpp"
+#include "analyzer/typeChecker.hpp"
+
+#include <optional>
+#include <string>
+
+namespace analyzer {
+
+// validation and type checking in one walk over the top-level statements.
+// Each statement is type checked right after it is validated, while its
+// nodes are still in the cache, instead of the tree being walked once per
+// pass. A statement is only type checked while no errors were found, the
+// type checker expects a valid tree
+class Semantic {
+  public:
+    // what is done with the types of a valid statement: report their
+    // errors, only record the ones that can be inferred in the tree for the
+    // C++ backend, or nothing for the backends that do not use them
+    enum class Types { Check, Annotate, None };
+
+    Semantic(std::string filename, bool is_js = false,
+             bool should_contain_main = false, Types types = Types::Check);
+
+    void analyze(ast::AstNodePtr stmt);
+
+    // reports the errors of every statement analyzed and exits if there
+    // were any
+    void finish();
+
+  private:
+    astValidator::Validator m_validator;
+    std::optional<TypeCheck::TypeChecker> m_checker;
+};
+
+} // namespace analyzer
+
+#endif
@@ -2,9 +2,14 @@
 
 #include "typeChecker.hpp"
 #include "ast/ast.hpp"
+#include "ast/flat.hpp"
 #include "ast/types.hpp"
 
+#include "utils/threadPool.hpp"
+
+#include <algorithm>
 #include <cassert>
+#include <future>
 #include <iostream>
 #include <memory>
 namespace TypeCheck{
@@ -12,7 +17,24 @@ namespace TypeCheck{
 TypeChecker::TypeChecker(ast::AstNodePtr ast) {
     m_env = createEnv(nullptr);
     m_currentFunction = nullptr;
-    ast->accept(*this);
+    accept(ast);
+    finish();
+}
+TypeChecker::TypeChecker(std::string filename, bool annotate, bool stream) {
+    m_filename = filename;
+    m_annotate = annotate;
+    m_stream = stream;
+    m_env = createEnv(nullptr);
+    m_currentFunction = nullptr;
+}
+void TypeChecker::finish() {
+    checkBodies();
+    if(m_annotate) {
+        if(!m_stream) {
+            inferParameters();
+        }
+        return;
+    }
     if(m_errors.size()!=0) {
         for(auto& err : m_errors) {
             display(err);
@@ -25,7 +47,8 @@ bool TypeChecker::defined(ast::AstNodePtr name){
     
     {
         if(name->type()==ast::KAstIdentifier){
-            auto identifierType = m_env->get(identifierName(name));
+            auto identifier = static_cast<ast::IdentifierExpression*>(name);
+            auto identifierType = m_env->get(identifier->symbol());
             if (identifierType==std::nullopt) {
                 defined_before=false;
             }
@@ -34,8 +57,11 @@ bool TypeChecker::defined(ast::AstNodePtr name){
     return defined_before;
 }
 void TypeChecker::add_error(Token tok, std::string_view msg) {
+    if (m_annotate) {
+        return;
+    }
     PEError err = {
-        {tok.line, tok.start, tok.location, m_filename, tok.statement},
+        {tok.line, tok.start, tok.location, m_filename, tok.statement()},
         std::string(msg),
         "TypeError",
         "",
@@ -57,23 +83,20 @@ void TypeChecker::checkBody(ast::AstNodePtr body,
             m_env->set(var.second,var.first);
         }
     }
-    body->accept(*this);
+    accept(body);
     m_env = previousEnv;
 }
 
 void TypeChecker::check(ast::AstNodePtr expr, const TypePtr expTypePtr) {
-    if(expTypePtr==NULL){
-        return;
-    }
-    expr->accept(*this);
-    if(m_result==NULL){
+    accept(expr);
+    if(m_result==NULL||expTypePtr==NULL){
         return;
     }
     const Type& exprType = *m_result;
 
     if (exprType != *expTypePtr) {
-        if (!exprType.isConvertibleTo(*expTypePtr) &&
-            !expTypePtr->isConvertibleTo(exprType)) {
+        if (!TypeProducer::isConvertible(exprType, *expTypePtr) &&
+            !TypeProducer::isConvertible(*expTypePtr, exprType)) {
             add_error(expr->token(), "expected type " + expTypePtr->stringify() +
                                      ", got " + exprType.stringify() +
                                      " instead");
@@ -86,10 +109,301 @@ void TypeChecker::check(ast::AstNodePtr expr, const TypePtr expTypePtr) {
 std::string TypeChecker::identifierName(ast::AstNodePtr identifier) {
     assert(identifier->type() == ast::KAstIdentifier);
 
-    return std::dynamic_pointer_cast<ast::IdentifierExpression>(identifier)
+    return static_cast<ast::IdentifierExpression*>(identifier)
         ->value();
 }
 
+bool TypeChecker::visit(const ast::Program& node) {
+    for (auto& stmt : node.statements()) {
+        checkStatement(stmt);
+    }
+    return true;
+}
+
+void TypeChecker::checkStatement(ast::AstNodePtr stmt) {
+    // the globals are defined first, in source order. A function without a
+    // declared return type gets the type of what it returns, so its body is
+    // checked right away for the code after it to see that type
+    m_errorsBefore.push_back(m_errors.size());
+    if (m_annotate && !m_stream) {
+        m_statements.push_back(stmt);
+    }
+    if (stmt->type() != ast::KAstFunctionDef) {
+        accept(stmt);
+        return;
+    }
+    auto& function = static_cast<const ast::FunctionDefinition&>(*stmt);
+    if (m_annotate && !m_stream) {
+        registerFunction(function);
+    }
+    EnvPtr oldEnv = m_env;
+    m_env = createEnv(oldEnv);
+    std::vector<TypePtr> parameterTypes;
+    checkParameters(function, parameterTypes);
+    accept(function.returnType());
+    auto returnType = m_result;
+    auto functionType = TypeProducer::function(parameterTypes, returnType);
+    bool deferred = !m_stream && returnType != NULL &&
+                    returnType->category() != TypeCategory::Void;
+    if (!deferred) {
+        functionType = checkFunctionBody(function, parameterTypes, functionType);
+    }
+    m_env = oldEnv;
+    m_env->set(function.name(), functionType);
+    if (deferred) {
+        m_bodies.push_back(
+            {m_errorsBefore.size() - 1, &function, parameterTypes, functionType});
+    }
+}
+
+void TypeChecker::checkBodies() {
+    auto& bodies = m_bodies;
+    if (bodies.empty()) {
+        m_errorsBefore.clear();
+        return;
+    }
+    size_t statements = m_errorsBefore.size();
+    auto errorsBefore = std::move(m_errorsBefore);
+    errorsBefore.push_back(m_errors.size());
+
+    // the other bodies only read the globals, each chunk of them is checked
+    // on a thread of its own
+    auto& pool = Utils::ThreadPool::shared();
+    size_t chunks = std::min(pool.size(), bodies.size());
+    std::vector<std::future<CheckedBodies>> later;
+    for (size_t i = 1; i < chunks; ++i) {
+        later.push_back(pool.submit([this, begin = bodies.size() * i / chunks,
+                                     end = bodies.size() * (i + 1) / chunks] {
+            return checkChunk(begin, end);
+        }));
+    }
+    std::vector<CheckedBodies> checked;
+    checked.push_back(checkChunk(0, bodies.size() / chunks));
+    for (auto& chunk : later) {
+        checked.push_back(chunk.get());
+    }
+
+    // the errors of a body go after those of its signature, so they are
+    // reported in source order
+    std::vector<std::vector<PEError>> bodyErrors(statements);
+    auto& arena = ast::Arena::current();
+    size_t next = 0;
+    for (auto& chunk : checked) {
+        arena.adopt(*chunk.arena);
+        mergeArguments(m_arguments, chunk.arguments);
+        for (auto& errors : chunk.errors) {
+            bodyErrors[bodies[next++].statement] = std::move(errors);
+        }
+    }
+    std::vector<PEError> errors;
+    for (size_t i = 0; i < statements; ++i) {
+        errors.insert(errors.end(), m_errors.begin() + errorsBefore[i],
+                      m_errors.begin() + errorsBefore[i + 1]);
+        errors.insert(errors.end(), bodyErrors[i].begin(), bodyErrors[i].end());
+    }
+    m_errors = std::move(errors);
+    m_bodies.clear();
+    m_errorsBefore.clear();
+}
+
+TypeChecker::CheckedBodies TypeChecker::checkChunk(size_t begin,
+                                                   size_t end) const {
+    CheckedBodies checked;
+    checked.arena = std::make_unique<ast::Arena>();
+    ast::Arena::Scope scope(*checked.arena);
+    TypeChecker checker;
+    checker.m_filename = m_filename;
+    checker.m_annotate = m_annotate;
+    // the calls made by these bodies, added to the others afterwards
+    for (auto& [name, arguments] : m_arguments) {
+        checker.m_arguments[name] = {arguments.node, 0,
+                                     std::vector<std::optional<TypePtr>>(
+                                         arguments.types.size())};
+    }
+    for (size_t i = begin; i < end; ++i) {
+        auto& body = m_bodies[i];
+        checker.m_env = SymbolTable<TypePtr>::fork(m_env);
+        auto& parameters = body.node->parameters();
+        for (size_t j = 0; j < parameters.size(); ++j) {
+            checker.m_env->set(parameters[j].p_name, body.parameterTypes[j]);
+        }
+        checker.checkFunctionBody(*body.node, body.parameterTypes, body.type);
+        checker.m_env = nullptr;
+        checked.errors.push_back(std::move(checker.m_errors));
+        checker.m_errors.clear();
+    }
+    checked.arguments = std::move(checker.m_arguments);
+    return checked;
+}
+
+bool TypeChecker::known(const TypePtr& type) {
+    if (type == NULL) {
+        return false;
+    }
+    switch (type->category()) {
+        case TypeCategory::Pointer:
+            return known(std::static_pointer_cast<PointerType>(type)->baseType());
+        case TypeCategory::List:
+            return known(std::static_pointer_cast<ListType>(type)->elemType());
+        case TypeCategory::UserDefined:
+            return known(
+                std::static_pointer_cast<UserDefinedType>(type)->baseType());
+        case TypeCategory::Function: {
+            auto function = std::static_pointer_cast<FunctionType>(type);
+            // a parameter declared without a type is void
+            for (auto& parameter : function->parameterTypes()) {
+                if (!known(parameter) ||
+                    parameter->category() == TypeCategory::Void) {
+                    return false;
+                }
+            }
+            return known(function->returnType());
+        }
+        case TypeCategory::MultipleReturn:
+            for (auto& returned :
+                 std::static_pointer_cast<MultipleReturnType>(type)->returnTypes()) {
+                if (!known(returned)) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+// a parameter the type of which can be taken from the calls
+static bool untyped(const ast::parameter& parameter) {
+    return parameter.p_paramType == ast::Normal &&
+           parameter.p_type->type() == ast::KAstNoLiteral &&
+           parameter.p_default->type() == ast::KAstNoLiteral;
+}
+
+void TypeChecker::registerFunction(const ast::FunctionDefinition& node) {
+    auto& parameters = node.parameters();
+    if (node.generics().size() > 0 ||
+        std::none_of(parameters.begin(), parameters.end(), untyped)) {
+        return;
+    }
+    auto name = static_cast<ast::IdentifierExpression*>(node.name())->symbol();
+    auto [it, inserted] = m_arguments.try_emplace(
+        name, Arguments{&node, 0,
+                        std::vector<std::optional<TypePtr>>(parameters.size())});
+    if (!inserted) {
+        // defined twice, the calls can not be told apart
+        it->second.node = nullptr;
+    }
+}
+
+void TypeChecker::recordCall(const ast::FunctionCall& node,
+                             const std::vector<TypePtr>& argumentTypes) {
+    if (node.name()->type() != ast::KAstIdentifier) {
+        return;
+    }
+    auto it = m_arguments.find(
+        static_cast<ast::IdentifierExpression*>(node.name())->symbol());
+    if (it == m_arguments.end()) {
+        return;
+    }
+    auto& arguments = it->second;
+    arguments.calls++;
+    bool positional = argumentTypes.size() == arguments.types.size();
+    for (auto& argument : node.arguments()) {
+        positional = positional && argument->type() != ast::KAstDefaultArg;
+    }
+    for (size_t i = 0; i < arguments.types.size(); ++i) {
+        auto type = positional ? argumentTypes[i] : NULL;
+        auto& merged = arguments.types[i];
+        if (!merged) {
+            merged = type;
+        } else if (*merged != type) {
+            merged = TypePtr();
+        }
+    }
+}
+
+void TypeChecker::mergeArguments(std::unordered_map<Symbol, Arguments>& into,
+                                 const std::unordered_map<Symbol, Arguments>& from) {
+    for (auto& [name, arguments] : from) {
+        auto& merged = into.at(name);
+        merged.calls += arguments.calls;
+        for (size_t i = 0; i < arguments.types.size(); ++i) {
+            auto& type = arguments.types[i];
+            if (!type) {
+                continue;
+            }
+            if (!merged.types[i]) {
+                merged.types[i] = type;
+            } else if (*merged.types[i] != *type) {
+                merged.types[i] = TypePtr();
+            }
+        }
+    }
+}
+
+// gives a parameter declared without a type the one of the arguments of
+// every call, when all the calls pass the same type. That is only safe if
+// every use of the function is one of those calls, a function that is
+// passed around or called from code that is not checked keeps its generic
+// parameters. Types are interned, so equal types are the same pointer
+void TypeChecker::inferParameters() {
+    if (m_arguments.empty()) {
+        return;
+    }
+    std::unordered_map<Symbol, size_t> uses;
+    for (auto stmt : m_statements) {
+        ast::FlatAst flat(stmt);
+        for (ast::FlatAst::Index i = 0; i < flat.size(); ++i) {
+            if (flat.kind(i) != ast::KAstIdentifier) {
+                continue;
+            }
+            auto name =
+                static_cast<ast::IdentifierExpression*>(flat.node(i))->symbol();
+            if (m_arguments.contains(name)) {
+                uses[name]++;
+            }
+        }
+    }
+    bool inferred = false;
+    for (auto& [name, arguments] : m_arguments) {
+        // the calls and the name of the definition
+        if (arguments.node == nullptr || uses[name] != arguments.calls + 1) {
+            continue;
+        }
+        auto& node = const_cast<ast::FunctionDefinition&>(*arguments.node);
+        for (size_t i = 0; i < arguments.types.size(); ++i) {
+            auto& type = arguments.types[i];
+            if (!untyped(node.parameters()[i]) || !type || !known(*type)) {
+                continue;
+            }
+            switch ((*type)->category()) {
+                case TypeCategory::Integer:
+                case TypeCategory::Decimal:
+                case TypeCategory::String:
+                case TypeCategory::Bool:
+                case TypeCategory::Pointer:
+                case TypeCategory::Enum:
+                case TypeCategory::Union:
+                    node.setParameterType(i, (*type)->getTypeAst());
+                    inferred = true;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    m_arguments.clear();
+    auto statements = std::move(m_statements);
+    if (inferred) {
+        // the types of the code using those parameters are found with them
+        TypeChecker checker(m_filename, true, true);
+        for (auto stmt : statements) {
+            checker.checkStatement(stmt);
+        }
+        checker.finish();
+    }
+}
+
 bool TypeChecker::visit(const ast::ClassDefinition& node) { return true; }
 
 bool TypeChecker::visit(const ast::ImportStatement& node) { return true; }
@@ -100,60 +414,90 @@ bool TypeChecker::visit(const ast::FunctionDefinition& node) {
     m_env = createEnv(oldEnv);
 
     std::vector<TypePtr> parameterTypes;
+    checkParameters(node, parameterTypes);
+    accept(node.returnType());
+    auto functionType =
+        checkFunctionBody(node, parameterTypes,
+                          TypeProducer::function(parameterTypes, m_result));
+
+    m_env = oldEnv;
+
+    m_env->set(node.name(), functionType);
+    return true;
+}
+
+// defines the parameters in the current scope
+void TypeChecker::checkParameters(const ast::FunctionDefinition& node,
+                                  std::vector<TypePtr>& parameterTypes) {
     parameterTypes.reserve(node.parameters().size());
 
     for (auto& param : node.parameters()) {
         if (param.p_default->type() != ast::KAstNoLiteral) {
             if (param.p_type->type() != ast::KAstNoLiteral) {
-                param.p_type->accept(*this);
+                accept(param.p_type);
                 check(param.p_default, m_result);
+            } else {
+                accept(param.p_default);
             }
 
-            param.p_default->accept(*this);
             parameterTypes.push_back(m_result);
-            m_env->set(identifierName(param.p_name), m_result);
+            m_env->set(param.p_name, m_result);
             continue;
         }
 
-        param.p_type->accept(*this);
+        accept(param.p_type);
         parameterTypes.push_back(m_result);
-        m_env->set(identifierName(param.p_name), m_result);
+        m_env->set(param.p_name, m_result);
     }
-    node.returnType()->accept(*this);
-    auto returnType=m_result;
-    auto functionType =
-        std::make_shared<FunctionType>(parameterTypes, returnType);
+}
 
+// returns the type of the function, with the return type taken from the
+// body if none was declared
+TypePtr TypeChecker::checkFunctionBody(const ast::FunctionDefinition& node,
+                                       const std::vector<TypePtr>& parameterTypes,
+                                       TypePtr functionType) {
     auto oldFunction = m_currentFunction;
     auto oldReturnType = m_returnType;
     m_returnType = NULL;
-    m_currentFunction = functionType;
-    node.body()->accept(*this);
-    if(m_returnType!=NULL){
+    m_currentFunction = std::static_pointer_cast<FunctionType>(functionType);
+    accept(node.body());
+    // a parameter declared without a type is void, returning it says
+    // nothing about the type of the function
+    if(known(m_returnType)&&m_returnType->category()!=TypeCategory::Void){
         auto& nonconstnode = const_cast<ast::FunctionDefinition&>(node);
         nonconstnode.setType(m_returnType);
-        functionType =std::make_shared<FunctionType>(parameterTypes, m_returnType);
+        functionType = TypeProducer::function(parameterTypes, m_returnType);
     }
     m_returnType = oldReturnType;
     m_currentFunction = oldFunction;
-
-    m_env = oldEnv;
-
-    m_env->set(identifierName(node.name()), functionType);
-    return true;
+    return functionType;
 }
 
 bool TypeChecker::visit(const ast::VariableStatement& node) {
     //TODO:check if redefination
     auto& nonConstNode = const_cast<ast::VariableStatement&>(node);
     if(node.name()->type()==ast::KAstIdentifier){
-        node.varType()->accept(*this);
+        accept(node.varType());
         TypePtr varType = m_result;
         bool defined_before=defined(node.name());
-        if (varType->category() == TypeCategory::Void) {
+        if (varType == NULL) {
+            // the declared type is unknown, the value is checked anyway
+            accept(node.value());
+        } else if (varType->category() == TypeCategory::Void) {
             // inferring the type of the variable
-            node.value()->accept(*this);
-            if(m_result->category()==MultipleReturn){
+            accept(node.value());
+            // the variable is defined but its type is not known. A void
+            // value is a parameter declared without a type when the program
+            // is valid
+            if(m_result==NULL||
+               (m_annotate&&m_result->category()==TypeCategory::Void)){
+                varType = NULL;
+                if(m_annotate&&!defined_before&&
+                   node.value()->type()!=ast::KAstNoLiteral){
+                    nonConstNode.setAutoType();
+                }
+            }
+            else if(m_result->category()==MultipleReturn){
                 add_error(node.token(), "Too few variables on the left hand side");
                 return true;
             }
@@ -161,26 +505,32 @@ bool TypeChecker::visit(const ast::VariableStatement& node) {
                 add_error(node.token(), "You cant declare a variable of type void");
                 return true;
             }
-            nonConstNode.setProcessedType(m_result,defined_before);
-            varType = m_result;
+            else{
+                if(known(m_result)){
+                    nonConstNode.setProcessedType(m_result,defined_before);
+                }
+                varType = m_result;
+            }
         } else{
             if(node.value()->type()!=ast::KAstNoLiteral){
                 check(node.value(), varType);
             }
-            if(m_result->category()==MultipleReturn){
+            if(m_result!=NULL&&m_result->category()==MultipleReturn){
                 add_error(node.token(), "Too few variables on the left hand side");
                 return true;
             }
-            else if(m_result->category()==Void){
+            else if(m_result!=NULL&&m_result->category()==Void){
                 add_error(node.token(), "You cant declare a variable of type void");
                 return true;
             }
-            nonConstNode.setProcessedType(varType,true);
+            if(known(varType)){
+                nonConstNode.setProcessedType(varType,true);
+            }
         }
-        m_env->set(identifierName(node.name()), varType);
+        m_env->set(node.name(), varType);
     }
     else{
-        node.name()->accept(*this);
+        accept(node.name());
         check(node.value(), m_result);
     }
     return true;
@@ -190,13 +540,18 @@ bool TypeChecker::visit(const ast::ConstDeclaration& node) {
     //TODO:check if redefination
     auto& nonConstNode = const_cast<ast::ConstDeclaration&>(node);
 
-    node.constType()->accept(*this);
+    accept(node.constType());
     TypePtr constType = m_result;
 
-    if (constType->category() == TypeCategory::Void) {
+    if (constType == NULL) {
+        accept(node.value());
+    } else if (constType->category() == TypeCategory::Void) {
         // inferring the type of the constant
-        node.value()->accept(*this);
-        if(m_result->category()==MultipleReturn){
+        accept(node.value());
+        if(m_result==NULL){
+            constType = NULL;
+        }
+        else if(m_result->category()==MultipleReturn){
             add_error(node.token(), "Too few variables on the left hand side");
             return true;
         }
@@ -204,30 +559,35 @@ bool TypeChecker::visit(const ast::ConstDeclaration& node) {
             add_error(node.token(), "You cant declare a constant of type void");
             return true;
         }
-        nonConstNode.setProcessedType(m_result);
-        constType = m_result;
+        else{
+            if(known(m_result)){
+                nonConstNode.setProcessedType(m_result);
+            }
+            constType = m_result;
+        }
     } else{
         check(node.value(), constType);
-        if(m_result->category()==MultipleReturn){
+        if(m_result!=NULL&&m_result->category()==MultipleReturn){
             add_error(node.token(), "Too few variables on the left hand side");
             return true;
         }
-        else if(m_result->category()==Void){
+        else if(m_result!=NULL&&m_result->category()==Void){
             add_error(node.token(), "You cant declare a variable of type void");
             return true;
         }
         nonConstNode.setProcessedType(NULL);
     }
 
-    m_env->set(identifierName(node.name()), constType);
+    m_env->set(node.name(), constType);
     return true;
 }
 
 bool TypeChecker::visit(const ast::TypeDefinition& node) {
-    node.baseType()->accept(*this);
-    TypePtr userDefinedType = std::make_shared<UserDefinedType>(m_result);
+    accept(node.baseType());
+    TypePtr userDefinedType =
+        m_result ? TypeProducer::userDefined(m_result) : NULL;
 
-    m_env->set(identifierName(node.name()), userDefinedType);
+    m_env->set(node.name(), userDefinedType);
     return true;
 }
 
@@ -254,18 +614,18 @@ bool TypeChecker::visit(const ast::AssertStatement& node) {
 bool TypeChecker::visit(const ast::StaticStatement& node) { return true; }
 
 bool TypeChecker::visit(const ast::ExportStatement& node) { 
-    node.body()->accept(*this); 
+    accept(node.body()); 
     return true; 
 }
 
 bool TypeChecker::visit(const ast::InlineStatement& node) {
-    node.body()->accept(*this); 
+    accept(node.body()); 
     return true; 
 }
 
 bool TypeChecker::visit(const ast::RaiseStatement& node) { 
     //TODO: Check if the exception is a subclass of the exception in the except block
-    node.value()->accept(*this);
+    accept(node.value());
     return true; 
 }
 
@@ -281,24 +641,31 @@ bool TypeChecker::visit(const ast::ForStatement& node) {
     m_env = createEnv(oldEnv);
     // m_env->set(identifierName(node.variable()), m_result); // result may not
     // be correct here
+    accept(node.sequence());
+    for (auto& variable : node.variable()) {
+        // defined with a type that is not known yet
+        if (variable->type() == ast::KAstIdentifier)
+            m_env->set(variable, NULL);
+    }
 
-    node.body()->accept(*this);
+    accept(node.body());
+    m_env = oldEnv;
     return true;
 }
 
 bool TypeChecker::visit(const ast::MatchStatement& node) { 
     std::vector<TypePtr> types;
-    auto match_item=node.matchItem();
+    auto& match_item=node.matchItem();
     for(auto& item:match_item){
-        item->accept(*this);
+        accept(item);
         types.push_back(m_result);
     }
-    auto cases=node.caseBody();
+    auto& cases=node.caseBody();
     for(auto& case_item:cases){
         checkBody(case_item.second);
         auto case_exp=case_item.first;
         for(size_t i=0;i<types.size();i++){
-            if(i>(case_exp.size()-1)){
+            if(i>=case_exp.size()){
                 //The last item is _. This has being checked in the parser
                 break;
             }
@@ -318,14 +685,16 @@ bool TypeChecker::visit(const ast::ScopeStatement& node) {
 bool TypeChecker::visit(const ast::ReturnStatement& node) {
     if (!m_currentFunction) {
         add_error(node.token(), "can not use return outside of a function");
+        return true;
     }
 
-    node.returnValue()->accept(*this);
-    if(m_currentFunction->returnType()->category()==TypeCategory::Void){
+    auto returnType=m_currentFunction->returnType();
+    if(returnType!=NULL&&returnType->category()==TypeCategory::Void){
+        accept(node.returnValue());
         m_returnType=m_result;
     }
     else{
-        check(node.returnValue(), m_currentFunction->returnType());
+        check(node.returnValue(), returnType);
     }
     return true;
 }
@@ -340,11 +709,14 @@ bool TypeChecker::visit(const ast::ListLiteral& node) {
         // m_result = TypeProducer::list();
         return true;
     }
-    node.elements()[0]->accept(*this); // TODO: check to see if its not empty
+    accept(node.elements()[0]); // TODO: check to see if its not empty
     TypePtr listType = m_result;
+    if (listType == NULL) {
+        return true;
+    }
 
-    for (auto& elem : node.elements()) {
-        check(elem, listType);
+    for (size_t i = 1; i < node.elements().size(); ++i) {
+        check(node.elements()[i], listType);
     }
     m_result = TypeProducer::list(listType, std::to_string(node.elements().size()));
     return true;
@@ -355,9 +727,9 @@ bool TypeChecker::visit(const ast::DictLiteral& node) { return true; }
 bool TypeChecker::visit(const ast::ListOrDictAccess& node) { return true; }
 
 bool TypeChecker::visit(const ast::BinaryOperation& node) {
-    node.left()->accept(*this);
+    accept(node.left());
     TypePtr leftType = m_result;
-    node.right()->accept(*this);
+    accept(node.right());
     if(m_result==NULL||leftType==NULL){
         m_result=NULL;//If left or right is null, the result is null
         return true;
@@ -366,7 +738,7 @@ bool TypeChecker::visit(const ast::BinaryOperation& node) {
 
     if (!result) {
         add_error(node.token(),
-              "operator " + node.op().keyword + " can not be used with types " +
+              "operator " + node.op().keyword() + " can not be used with types " +
                   leftType->stringify() + " and " + m_result->stringify());
     }
 
@@ -375,11 +747,14 @@ bool TypeChecker::visit(const ast::BinaryOperation& node) {
 }
 
 bool TypeChecker::visit(const ast::PrefixExpression& node) {
-    node.right()->accept(*this);
+    accept(node.right());
+    if (m_result == NULL) {
+        return true;
+    }
     TypePtr result = m_result->prefixOperatorResult(node.prefix());
 
     if (!result) {
-        add_error(node.token(), "operator " + node.prefix().keyword +
+        add_error(node.token(), "operator " + node.prefix().keyword() +
                                 " can not be used with type " +
                                 m_result->stringify());
     }
@@ -389,11 +764,14 @@ bool TypeChecker::visit(const ast::PrefixExpression& node) {
 }
 
 bool TypeChecker::visit(const ast::PostfixExpression& node) { 
-    node.left()->accept(*this);
+    accept(node.left());
+    if (m_result == NULL) {
+        return true;
+    }
     TypePtr result = m_result->postfixOperatorResult(node.postfix());
 
     if (!result) {
-        add_error(node.token(), "operator " + node.postfix().keyword +
+        add_error(node.token(), "operator " + node.postfix().keyword() +
                                 " can not be used with type " +
                                 m_result->stringify());
     }
@@ -403,20 +781,36 @@ bool TypeChecker::visit(const ast::PostfixExpression& node) {
 }
 
 bool TypeChecker::visit(const ast::FunctionCall& node) {
-    node.name()->accept(*this);
-
-    if (m_result->category() != TypeCategory::Function)
-        add_error(node.token(), identifierName(node.name()) + " is not a function");
+    accept(node.name());
 
     auto functionType = std::dynamic_pointer_cast<FunctionType>(m_result);
+    if (!functionType) {
+        if (m_result != NULL && node.name()->type() == ast::KAstIdentifier)
+            add_error(node.token(), identifierName(node.name()) + " is not a function");
+        std::vector<TypePtr> argumentTypes;
+        for (auto& argument : node.arguments()) {
+            accept(argument);
+            argumentTypes.push_back(m_result);
+        }
+        recordCall(node, argumentTypes);
+        m_result = NULL;
+        return true;
+    }
 
-    if (functionType->parameterTypes().size() != node.arguments().size())
+    auto& parameterTypes = functionType->parameterTypes();
+    if (parameterTypes.size() != node.arguments().size())
         add_error(node.token(), "invalid number of arguments passed to " +
                                 identifierName(node.name()));
 
+    std::vector<TypePtr> argumentTypes;
     for (size_t i = 0; i < node.arguments().size(); i++) {
-        check(node.arguments()[i], functionType->parameterTypes()[i]);
+        if (i < parameterTypes.size())
+            check(node.arguments()[i], parameterTypes[i]);
+        else
+            accept(node.arguments()[i]);
+        argumentTypes.push_back(m_result);
     }
+    recordCall(node, argumentTypes);
 
     m_result = functionType->returnType();
     return true;
@@ -426,9 +820,9 @@ bool TypeChecker::visit(const ast::DotExpression& node) {
     if(node.owner()->type()==ast::KAstIdentifier&&node.referenced()->type()==ast::KAstIdentifier){
         auto name=identifierName(node.owner());
         auto ref=identifierName(node.referenced());
-        auto enum_map=m_env->getEnumMap();
-        if(enum_map.contains(name)){
-            auto type=enum_map[name];
+        auto enum_type=m_env->get_enum(name);
+        if(enum_type){
+            auto type=enum_type.value();
             auto _enum=std::dynamic_pointer_cast<types::EnumType>(type);
             auto items=_enum->getItem();
             if(std::count(items.begin(),items.end(),ref)){
@@ -441,7 +835,7 @@ bool TypeChecker::visit(const ast::DotExpression& node) {
             return true; 
         }
     }
-    node.owner()->accept(*this);
+    accept(node.owner());
     auto type=m_result;
     if(type==NULL){
         return true;
@@ -474,10 +868,10 @@ bool TypeChecker::visit(const ast::DotExpression& node) {
 bool TypeChecker::visit(const ast::ArrowExpression& node) { return true; }
 
 bool TypeChecker::visit(const ast::IdentifierExpression& node) {
-    auto identifierType = m_env->get(node.value());
+    auto identifierType = m_env->get(node.symbol());
 
-    if (!identifierType ||
-        identifierType.value()->category() == TypeCategory::UserDefined) {
+    if (!identifierType || (identifierType.value() &&
+        identifierType.value()->category() == TypeCategory::UserDefined)) {
         add_error(node.token(), "undeclared identifier: " + node.value());
         m_result=NULL;
         return true;
@@ -488,20 +882,26 @@ bool TypeChecker::visit(const ast::IdentifierExpression& node) {
 }
 
 bool TypeChecker::visit(const ast::TypeExpression& node) {
-    auto enum_map = m_env->getEnumMap();
-    auto union_map = m_env->getUnionMap();
-    if(enum_map.contains(node.value())){
-        m_result=enum_map[node.value()];
+    if(m_annotate&&node.value()=="auto"){
+        // declared by the pass before, the type is that of the value
+        m_result=TypeProducer::voidT();
+        return true;
     }
-    else if(union_map.contains(node.value())){
-        m_result=union_map[node.value()];
+    if(auto enum_type = m_env->get_enum(node.symbol())){
+        m_result=enum_type.value();
+    }
+    else if(auto union_type = m_env->get_union(node.symbol())){
+        m_result=union_type.value();
     }
     else if (!identifierToTypeMap.count(node.value())) {
-        auto type = m_env->get(node.value());
+        auto type = m_env->get(node.symbol());
 
-        if (!type || type.value()->category() != TypeCategory::UserDefined) {
+        if (!type || !type.value() ||
+            type.value()->category() != TypeCategory::UserDefined) {
             add_error(node.token(),
                   node.value() + " is not a type"); // return or not return?
+            m_result = NULL;
+            return true;
         }
 
         m_result = type.value();
@@ -514,10 +914,13 @@ bool TypeChecker::visit(const ast::TypeExpression& node) {
 }
 
 bool TypeChecker::visit(const ast::ExpressionTuple& node){
-    auto items=node.items();
+    auto& items=node.items();
     std::vector<TypePtr> types;
     for(auto& elem:items){
-        elem->accept(*this);
+        accept(elem);
+        if(m_result==NULL){
+            return true;
+        }
         types.push_back(m_result);
     }
     m_result=TypeProducer::multipleReturn(types);
@@ -525,10 +928,13 @@ bool TypeChecker::visit(const ast::ExpressionTuple& node){
 }
 
 bool TypeChecker::visit(const ast::TypeTuple& node){
-    auto items=node.items();
+    auto& items=node.items();
     std::vector<TypePtr> types;
     for(auto& elem:items){
-        elem->accept(*this);
+        accept(elem);
+        if(m_result==NULL){
+            return true;
+        }
         types.push_back(m_result);
     }
     m_result=TypeProducer::multipleReturn(types);
@@ -536,8 +942,11 @@ bool TypeChecker::visit(const ast::TypeTuple& node){
 }
 
 bool TypeChecker::visit(const ast::ListTypeExpr& node) {
-    node.elemType()->accept(*this);
+    accept(node.elemType());
     auto listType = m_result;
+    if(listType==NULL){
+        return true;
+    }
     if(node.size()->type()!=ast::KAstNoLiteral){
         check(node.size(), TypeProducer::integer());
     }
@@ -546,7 +955,7 @@ bool TypeChecker::visit(const ast::ListTypeExpr& node) {
         size = "-1";
     }
     else{
-        size = std::dynamic_pointer_cast<ast::IntegerLiteral>(node.size())->value();
+        size = static_cast<ast::IntegerLiteral*>(node.size())->value();
     }
     m_result = TypeProducer::list(
         listType,size);
@@ -555,20 +964,25 @@ bool TypeChecker::visit(const ast::ListTypeExpr& node) {
 
 bool TypeChecker::visit(const ast::FunctionTypeExpr& node) {
     std::vector<TypePtr> parameterTypes;
-    auto args=node.argTypes();
+    auto& args=node.argTypes();
     for (auto& param : args) {
-        param->accept(*this);
+        accept(param);
+        if (m_result == NULL)
+            return true;
         parameterTypes.push_back(m_result);
     } 
-    node.returnTypes()->accept(*this);
+    accept(node.returnTypes());
     auto returnType = m_result;
+    if (returnType == NULL)
+        return true;
     m_result = TypeProducer::function(parameterTypes, returnType);
     return true; 
 }
 
 bool TypeChecker::visit(const ast::PointerTypeExpr& node) {
-    node.baseType()->accept(*this);
-    m_result = TypeProducer::pointer(m_result);
+    accept(node.baseType());
+    if (m_result != NULL)
+        m_result = TypeProducer::pointer(m_result);
     return true;
 }
 
@@ -606,7 +1020,7 @@ bool TypeChecker::visit(const ast::UnionLiteral& node) {
     auto name =identifierName(node.name());
     std::map<std::string, TypePtr> item_map;
     for (auto item : node.elements()) {
-        item.first->accept(*this);
+        accept(item.first);
         auto item_name=identifierName(item.second);
         if(item_map.contains(item_name)){
             add_error(item.second->token(),item_name+" is already defined as an union member");
@@ -615,8 +1029,7 @@ bool TypeChecker::visit(const ast::UnionLiteral& node) {
             item_map[item_name]=m_result;
         }
     }
-    auto union_map= m_env->getUnionMap();
-    if(union_map.contains(name)){
+    if(m_env->get_union(name)){
         add_error(node.token(), "Redefination of union: " + name);
     }
     else{
@@ -637,8 +1050,7 @@ bool TypeChecker::visit(const ast::EnumLiteral& node) {
             values.push_back(itemName);
         }
     }
-    auto enum_map= m_env->getEnumMap();
-    if(enum_map.contains(name)){
+    if(m_env->get_enum(name)){
         add_error(node.token(), "Redefination of enum: " + name);
     }
     else{
@@ -656,22 +1068,24 @@ bool TypeChecker::visit(const ast::WithStatement& node) {
 bool TypeChecker::visit(const ast::VirtualStatement& node) { return true; }
 
 bool TypeChecker::visit(const ast::CastStatement& node) {
-    node.cast_type()->accept(*this);
+    accept(node.cast_type());
     TypePtr castType = m_result;
-    node.value()->accept(*this);
+    accept(node.value());
 
-    if (!m_result->isCastableTo(*castType)) {
+    if (m_result != NULL && castType != NULL &&
+        !m_result->isCastableTo(*castType)) {
         add_error(node.token(), m_result->stringify() + " can not be casted to " +
                                 castType->stringify());
     }
 
+    m_result = castType;
     return true;
 }
 
 bool TypeChecker::visit(const ast::DefaultArg& node) { return true; }
 
 bool TypeChecker::visit(const ast::TernaryIf& node) { 
-    node.if_value()->accept(*this);
+    accept(node.if_value());
     TypePtr ifType = m_result;
     check(node.if_condition(), TypeProducer::boolean());
     check(node.else_value(), ifType);
@@ -684,13 +1098,13 @@ bool TypeChecker::visit(const ast::TryExcept& node) {
     if(node.else_body()->type()!=ast::KAstNoLiteral){
         checkBody(node.else_body());
     }
-    auto except_clauses = node.except_clauses();
+    auto& except_clauses = node.except_clauses();
     for(auto except_clause : except_clauses){
         //TODO: Check if the exception is a subclass of the exception in the except block
         auto exception=except_clause.first.first;
         std::vector<std::pair<TypePtr,ast::AstNodePtr>> add_var={};
         if(exception.size()>0){
-            exception[0]->accept(*this);
+            accept(exception[0]);
             auto type=m_result;
             for(size_t i=1;i<exception.size();i++){
                 check(exception[i],type);
@@ -705,33 +1119,41 @@ bool TypeChecker::visit(const ast::TryExcept& node) {
     return true; 
 }
 bool TypeChecker::visit(const ast::MultipleAssign& node){
-    auto name=node.names();
-    auto value=node.values();
+    auto& name=node.names();
+    auto& value=node.values();
     auto assign_type=ast::MultipleAssign::MultiAssignType::Normal;
     //type and if it is defined before
     std::vector<std::pair<TypePtr,bool>> value_type;
     for(auto& val : value){
-        val->accept(*this);
+        accept(val);
         value_type.push_back(std::make_pair(m_result,true));
     }
     if(value_type.size()>1){
         //this is not a list or function returning multiple stuff
-        for(size_t i=0;i<name.size();i++){
+        for(size_t i=0;i<name.size()&&i<value_type.size();i++){
             if(name[i]->type()==ast::KAstIdentifier){
                 if(defined(name[i])){
                     check(name[i],value_type[i].first);
                 }
                 else{
                     value_type[i].second=false;
-                    m_env->set(identifierName(name[i]), value_type[i].first);
+                    m_env->set(name[i], value_type[i].first);
                 }
             }
         }
     }
     else{
-        auto type=value_type[0].first;
+        auto type=value_type.empty() ? NULL : value_type[0].first;
         value_type.clear();
-        if(type->category()==List){
+        if(type==NULL){
+            //the type of the value is not known, nor that of the variables
+            for(auto& variable : name){
+                if(variable->type()==ast::KAstIdentifier&&!defined(variable)){
+                    m_env->set(variable, NULL);
+                }
+            }
+        }
+        else if(type->category()==List){
             //TODO:add dictionary here
             auto elem_type=std::dynamic_pointer_cast<ListType>(type)->elemType();
             for(size_t i=0;i<name.size();i++){
@@ -742,7 +1164,7 @@ bool TypeChecker::visit(const ast::MultipleAssign& node){
                     }
                     else{
                         value_type[i].second=false;
-                        m_env->set(identifierName(name[i]), elem_type);
+                        m_env->set(name[i], elem_type);
                     }
                 }
             }
@@ -766,7 +1188,7 @@ bool TypeChecker::visit(const ast::MultipleAssign& node){
                         }
                         else{
                             value_type[i].second=false;
-                            m_env->set(identifierName(name[i]), value_type[i].first);
+                            m_env->set(name[i], value_type[i].first);
                         }
                     }
                 }
@@ -783,24 +1205,24 @@ bool TypeChecker::visit(const ast::MultipleAssign& node){
     return true; 
 }
 bool TypeChecker::visit(const ast::LambdaDefinition& node){
-    auto params=node.parameters();
+    auto& params=node.parameters();
     auto body=node.body();
     std::vector<TypePtr> param_type;
     EnvPtr oldEnv = m_env;
     m_env = createEnv(oldEnv);
     for(auto& param : params){
-        param.p_type->accept(*this);
+        accept(param.p_type);
         param_type.push_back(m_result);
-        m_env->set(identifierName(param.p_name), m_result);
+        m_env->set(param.p_name, m_result);
     }
-    body->accept(*this);
+    accept(body);
     auto return_type=m_result;
-    if (return_type!=NULL){
+    if (known(return_type)){
         auto& nonconstnode = const_cast<ast::LambdaDefinition&>(node);
         nonconstnode.set_return_type(return_type->getTypeAst());
     }
     m_env=oldEnv;
-    auto functionType =std::make_shared<FunctionType>(param_type, return_type);
+    auto functionType = TypeProducer::function(param_type, return_type);
     m_result=functionType;
     return true;
 }
@@ -1,6 +1,7 @@
 #ifndef PEREGRINE_TYPE_CHECKER_HPP
 #define PEREGRINE_TYPE_CHECKER_HPP
 
+#include "ast/arena.hpp"
 #include "ast/ast.hpp"
 #include "ast/types.hpp"
 #include "ast/visitor.hpp"
@@ -8,19 +9,92 @@
 #include "errors/error.hpp"
 
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 namespace TypeCheck{
 using namespace types;
 using namespace Utils;
 using EnvPtr = std::shared_ptr<SymbolTable<TypePtr>>;
 
-class TypeChecker : public ast::AstVisitor {
+class TypeChecker : public ast::Visitor<TypeChecker> {
+    friend class ast::Visitor<TypeChecker>;
+    using ast::Visitor<TypeChecker>::visit;
+
     public:
     TypeChecker(ast::AstNodePtr ast);
+    // for a program checked one top-level statement at a time, finish()
+    // checks the bodies left for later and reports the errors of all of
+    // them, it exits if there were any.
+    // With `annotate` only the types that can be inferred are recorded in
+    // the tree for the code generator, no errors are reported since the
+    // validator decides if a program is valid, and parameters declared
+    // without a type get the one every call passes to them. With `stream`
+    // every statement is done when checkStatement returns, so it can be
+    // emitted right away, and parameters are left alone
+    TypeChecker(std::string filename, bool annotate=false, bool stream=false);
+    void checkStatement(ast::AstNodePtr stmt);
+    void finish();
 
     private:
+    TypeChecker() = default;
+
+    bool m_annotate=false;
+    bool m_stream=false;
+
+    // the calls of a top-level function with parameters declared without a
+    // type
+    struct Arguments {
+        const ast::FunctionDefinition* node;
+        size_t calls=0; // of the function by its name
+        // per parameter: nothing when there was no call, the type of what
+        // every call passed or NULL if they differ or it is not known
+        std::vector<std::optional<TypePtr>> types;
+    };
+    std::unordered_map<Symbol, Arguments> m_arguments;
+    // the top-level statements, to find every use of those functions
+    std::vector<ast::AstNodePtr> m_statements;
+    void registerFunction(const ast::FunctionDefinition& node);
+    void recordCall(const ast::FunctionCall& node,
+                    const std::vector<TypePtr>& argumentTypes);
+    static void
+    mergeArguments(std::unordered_map<Symbol, Arguments>& into,
+                   const std::unordered_map<Symbol, Arguments>& from);
+    void inferParameters();
+
+    // a top-level function with a declared return type. Its signature is
+    // known before its body is checked, so the bodies of these functions
+    // are checked after every global is defined and in parallel
+    struct Body {
+        size_t statement; // index among the top-level statements
+        const ast::FunctionDefinition* node;
+        std::vector<TypePtr> parameterTypes;
+        TypePtr type;
+    };
+
+    // the errors of bodies[begin..end), checked on another thread
+    struct CheckedBodies {
+        std::unique_ptr<ast::Arena> arena; // holds the nodes made meanwhile
+        std::vector<std::vector<PEError>> errors;
+        std::unordered_map<Symbol, Arguments> arguments;
+    };
+
+    CheckedBodies checkChunk(size_t begin, size_t end) const;
+
+    std::vector<Body> m_bodies;
+    // errors of the top-level statements before the i-th one
+    std::vector<size_t> m_errorsBefore;
+    void checkBodies();
+
     std::vector<PEError> m_errors;
     void add_error(Token tok, std::string_view msg);
+    // every expression leaves its type in m_result, NULL if it is not known
+    void accept(ast::AstNodePtr node) {
+        m_result=NULL;
+        ast::Visitor<TypeChecker>::accept(node);
+    }
+    // the type and all of its parts are known
+    static bool known(const TypePtr& type);
     bool defined(ast::AstNodePtr name);
     EnvPtr createEnv(EnvPtr parent);
     std::string identifierName(ast::AstNodePtr identifier);
@@ -29,6 +103,13 @@ class TypeChecker : public ast::AstVisitor {
 
     void check(ast::AstNodePtr expr, const TypePtr expectedType);
 
+    void checkParameters(const ast::FunctionDefinition& node,
+                         std::vector<TypePtr>& parameterTypes);
+    TypePtr checkFunctionBody(const ast::FunctionDefinition& node,
+                              const std::vector<TypePtr>& parameterTypes,
+                              TypePtr functionType);
+
+    bool visit(const ast::Program& node);
     bool visit(const ast::ClassDefinition& node);
     bool visit(const ast::ImportStatement& node);
     bool visit(const ast::FunctionDefinition& node);
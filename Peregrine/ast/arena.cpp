@@ -0,0 +1,77 @@
+#include "arena.hpp"
+#include "ast.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+
+namespace ast {
+
+static thread_local Arena* current_arena = nullptr;
+
+Arena::~Arena() { reset(); }
+
+void* Arena::allocate(size_t size, size_t align) {
+    assert(size + align <= block_size);
+    size_t pad = -reinterpret_cast<uintptr_t>(m_next) & (align - 1);
+    if (m_next == nullptr || pad + size > m_left) {
+        if (m_used == m_blocks.size()) {
+            m_blocks.emplace_back(new std::byte[block_size]);
+        }
+        m_next = m_blocks[m_used++].get();
+        m_left = block_size;
+        pad = -reinterpret_cast<uintptr_t>(m_next) & (align - 1);
+    }
+    void* result = m_next + pad;
+    m_next += pad + size;
+    m_left -= pad + size;
+    m_bytes += size;
+    return result;
+}
+
+void Arena::reset() {
+    for (auto it = m_nodes.rbegin(); it != m_nodes.rend(); ++it) {
+        (*it)->~AstNode();
+    }
+    m_nodes.clear();
+    m_used = 0;
+    m_next = nullptr;
+    m_left = 0;
+    m_bytes = 0;
+}
+
+void Arena::adopt(Arena& other) {
+    // the used blocks go right after the current one, so that the spare
+    // blocks stay at the end for allocate() to take
+    auto used = other.m_blocks.begin() + other.m_used;
+    m_blocks.insert(m_blocks.begin() + m_used,
+                    std::make_move_iterator(other.m_blocks.begin()),
+                    std::make_move_iterator(used));
+    other.m_blocks.erase(other.m_blocks.begin(), used);
+    m_used += other.m_used;
+    m_nodes.insert(m_nodes.end(), other.m_nodes.begin(), other.m_nodes.end());
+    m_bytes += other.m_bytes;
+
+    other.m_nodes.clear();
+    other.m_used = 0;
+    other.m_next = nullptr;
+    other.m_left = 0;
+    other.m_bytes = 0;
+}
+
+size_t Arena::bytes() const { return m_bytes; }
+
+size_t Arena::reserved() const { return m_blocks.size() * block_size; }
+
+Arena& Arena::current() {
+    static Arena global;
+    return current_arena ? *current_arena : global;
+}
+
+Arena::Scope::Scope(Arena& arena) : m_previous(current_arena) {
+    current_arena = &arena;
+}
+
+Arena::Scope::~Scope() { current_arena = m_previous; }
+
+} // namespace ast
@@ -0,0 +1,77 @@
+#ifndef PEREGRINE_ARENA_HPP
+#define PEREGRINE_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ast {
+
+class AstNode;
+
+// bump-pointer allocator that owns the ast of one compilation unit, nodes
+// point at each other with plain pointers and all of them go away together
+// when the arena is reset or destroyed
+class Arena {
+    static constexpr size_t block_size = 64 * 1024;
+
+    std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+    size_t m_used = 0; // blocks handed out since the last reset
+    std::byte* m_next = nullptr;
+    size_t m_left = 0;
+    size_t m_bytes = 0;
+    // nodes own strings and vectors, their destructors still have to run
+    std::vector<AstNode*> m_nodes;
+
+    void* allocate(size_t size, size_t align);
+
+  public:
+    Arena() = default;
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    template <typename T, typename... Args> T* make(Args&&... args) {
+        T* node =
+            new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        m_nodes.push_back(node);
+        return node;
+    }
+
+    // destroys every node, the blocks are kept for the next tree
+    void reset();
+
+    // takes over the nodes of `other`, which was usually filled on another
+    // thread. They are destroyed together with the nodes of this arena
+    void adopt(Arena& other);
+
+    // bytes taken by nodes and bytes reserved for them
+    size_t bytes() const;
+    size_t reserved() const;
+
+    // the arena new nodes go to on this thread, nodes made outside of any
+    // Scope live until the compiler exits
+    static Arena& current();
+
+    // makes an arena the current one of this thread while it is alive
+    class Scope {
+        Arena* m_previous;
+
+      public:
+        explicit Scope(Arena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+template <typename T, typename... Args> T* make(Args&&... args) {
+    return Arena::current().make<T>(std::forward<Args>(args)...);
+}
+
+} // namespace ast
+
+#endif
@@ -1,18 +1,26 @@
 #include "ast.hpp"
 #include "lexer/tokens.hpp"
 
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <vector>
 
 namespace ast {
 
+// the parser may build subtrees on several threads at once
+static std::atomic<size_t> nodes_created = 0;
+
+AstNode::AstNode() { nodes_created.fetch_add(1, std::memory_order_relaxed); }
+
+size_t AstNode::created() { return nodes_created; }
+
 Program::Program(std::vector<AstNodePtr> statements, std::string comment)
     : m_statements(statements), m_comment(comment) {}
 
-std::vector<AstNodePtr> Program::statements() const { return m_statements; }
+const std::vector<AstNodePtr>& Program::statements() const { return m_statements; }
 
-std::string Program::comment() const{ return m_comment; }
+const std::string& Program::comment() const{ return m_comment; }
 
 
 Token Program::token() const { return Token{}; }
@@ -35,7 +43,7 @@ IntegerLiteral::IntegerLiteral(Token tok, std::string_view value) {
     m_value = value;
 }
 
-std::string IntegerLiteral::value() const { return m_value; }
+const std::string& IntegerLiteral::value() const { return m_value; }
 
 Token IntegerLiteral::token() const { return m_token; }
 
@@ -48,7 +56,7 @@ DecimalLiteral::DecimalLiteral(Token tok, std::string_view value) {
     m_value = value;
 }
 
-std::string DecimalLiteral::value() const { return m_value; }
+const std::string& DecimalLiteral::value() const { return m_value; }
 
 Token DecimalLiteral::token() const { return m_token; }
 
@@ -62,7 +70,7 @@ StringLiteral::StringLiteral(Token tok, std::string_view value, bool raw) {
     m_raw = raw;
 }
 
-std::string StringLiteral::value() const { return m_value; }
+const std::string& StringLiteral::value() const { return m_value; }
 
 bool StringLiteral::raw() const { return m_raw; }
 
@@ -83,7 +91,7 @@ BoolLiteral::BoolLiteral(Token tok, std::string_view value) {
     m_value = value;
 }
 
-std::string BoolLiteral::value() const { return m_value; }
+const std::string& BoolLiteral::value() const { return m_value; }
 
 Token BoolLiteral::token() const { return m_token; }
 
@@ -110,13 +118,15 @@ IdentifierExpression::IdentifierExpression(Token tok, std::string_view value) {
     m_value = value;
 }
 
-std::string IdentifierExpression::value() const { return m_value; }
+const std::string& IdentifierExpression::value() const { return m_value.str(); }
+
+Utils::Symbol IdentifierExpression::symbol() const { return m_value; }
 
 Token IdentifierExpression::token() const { return m_token; }
 
 AstKind IdentifierExpression::type() const { return KAstIdentifier; }
 
-std::string IdentifierExpression::stringify() const { return m_value; }
+std::string IdentifierExpression::stringify() const { return m_value.str(); }
 
 TypeExpression::TypeExpression(Token tok, std::string_view value,
                                std::vector<AstNodePtr> generic_type) {
@@ -125,16 +135,18 @@ TypeExpression::TypeExpression(Token tok, std::string_view value,
     m_generic_type = generic_type;
 }
 
-std::string TypeExpression::value() const { return m_value; }
+const std::string& TypeExpression::value() const { return m_value.str(); }
+
+Utils::Symbol TypeExpression::symbol() const { return m_value; }
 
-std::vector<AstNodePtr> TypeExpression::generic_types() const { return m_generic_type; }
+const std::vector<AstNodePtr>& TypeExpression::generic_types() const { return m_generic_type; }
 
 Token TypeExpression::token() const { return m_token; }
 
 AstKind TypeExpression::type() const { return KAstTypeExpr; }
 
 std::string TypeExpression::stringify() const { 
-    auto res= m_value;
+    auto res= m_value.str();
     if(m_generic_type.size()>0){
         res+="{";
         for(size_t i=0;i<m_generic_type.size();i++){
@@ -155,7 +167,7 @@ ListLiteral::ListLiteral(Token tok,
 }
 
 
-std::vector<AstNodePtr> ListLiteral::elements() const { return m_elements; }
+const std::vector<AstNodePtr>& ListLiteral::elements() const { return m_elements; }
 
 Token ListLiteral::token() const { return m_token; }
 
@@ -182,7 +194,7 @@ DictLiteral::DictLiteral(
     m_elements = elements;
 }
 
-std::vector<std::pair<AstNodePtr, AstNodePtr>> DictLiteral::elements() const {
+const std::vector<std::pair<AstNodePtr, AstNodePtr>>& DictLiteral::elements() const {
     return m_elements;
 }
 
@@ -215,16 +227,16 @@ UnionLiteral::UnionLiteral(
     m_comment=comment;
     m_generics=generic;
 }
-std::vector<AstNodePtr> UnionLiteral::generics() const{
+const std::vector<AstNodePtr>& UnionLiteral::generics() const{
     return m_generics;
 }
-std::vector<std::pair<AstNodePtr, AstNodePtr>> UnionLiteral::elements() const {
+const std::vector<std::pair<AstNodePtr, AstNodePtr>>& UnionLiteral::elements() const {
     return m_elements;
 }
 
 Token UnionLiteral::token() const { return m_token; }
 
-std::string UnionLiteral::comment() const { return m_comment; }
+const std::string& UnionLiteral::comment() const { return m_comment; }
 
 AstNodePtr UnionLiteral::name() const { return m_name; }
 
@@ -265,11 +277,11 @@ EnumLiteral::EnumLiteral(Token tok,
 
 }
 
-std::vector<std::pair<AstNodePtr, AstNodePtr>> EnumLiteral::fields() const {
+const std::vector<std::pair<AstNodePtr, AstNodePtr>>& EnumLiteral::fields() const {
     return m_fields;
 }
 
-std::string EnumLiteral::comment() const {return m_comment;}
+const std::string& EnumLiteral::comment() const {return m_comment;}
 
 Token EnumLiteral::token() const { return m_token; }
 
@@ -318,7 +330,7 @@ std::string BinaryOperation::stringify() const {
 
     res += m_left->stringify();
     res += " ";
-    res += m_operator.keyword;
+    res += m_operator.keyword();
     res += " ";
     res += m_right->stringify();
     res += ")";
@@ -341,7 +353,7 @@ Token PrefixExpression::token() const { return m_token; }
 AstKind PrefixExpression::type() const { return KAstPrefixExpr; }
 
 std::string PrefixExpression::stringify() const {
-    std::string res = "(" + m_prefix.keyword;
+    std::string res = "(" + m_prefix.keyword();
 
     res += m_right->stringify();
 
@@ -365,7 +377,7 @@ AstKind PostfixExpression::type() const { return KAstPostfixExpr; }
 std::string PostfixExpression::stringify() const {
     std::string res = "(" + m_left->stringify();
 
-    res += m_postfix.keyword;
+    res += m_postfix.keyword();
 
     res += ")";
 
@@ -381,7 +393,7 @@ ListOrDictAccess::ListOrDictAccess(Token tok, AstNodePtr container,
 
 AstNodePtr ListOrDictAccess::container() const { return m_container; }
 
-std::vector<AstNodePtr> ListOrDictAccess::keyOrIndex() const { return m_keyOrIndex; }
+const std::vector<AstNodePtr>& ListOrDictAccess::keyOrIndex() const { return m_keyOrIndex; }
 
 Token ListOrDictAccess::token() const { return m_token; }
 
@@ -415,7 +427,7 @@ AstNodePtr ImportStatement::moduleName() const {
 bool ImportStatement::importAll() const {
     return m_importAll;
 }
-std::vector<std::pair<AstNodePtr, AstNodePtr>>
+const std::vector<std::pair<AstNodePtr, AstNodePtr>>&
 ImportStatement::importedSymbols() const {
     return m_importedSymbols;
 }
@@ -481,6 +493,10 @@ void VariableStatement::setProcessedType(types::TypePtr processedType,bool defin
     }
 }
 
+void VariableStatement::setAutoType() {
+    m_type=ast::make<TypeExpression>(Token{}, "auto");
+}
+
 Token VariableStatement::token() const { return m_token; }
 
 AstKind VariableStatement::type() const { return KAstVariableStmt; }
@@ -520,8 +536,8 @@ types::TypePtr ConstDeclaration::processedType() const {
 }
 
 void ConstDeclaration::setProcessedType(types::TypePtr processedType) {
+    m_processedType = processedType;
     if(m_processedType!=NULL){
-        m_processedType = processedType;
         m_type=m_processedType->getTypeAst();
     }
 }
@@ -550,7 +566,7 @@ BlockStatement::BlockStatement(std::vector<AstNodePtr> statements) {
     m_statements = statements;
 }
 
-std::vector<AstNodePtr> BlockStatement::statements() const {
+const std::vector<AstNodePtr>& BlockStatement::statements() const {
     return m_statements;
 }
 
@@ -586,20 +602,20 @@ ClassDefinition::ClassDefinition(Token tok, AstNodePtr name,
 }
 
 AstNodePtr ClassDefinition::name() const { return m_name; }
-std::vector<AstNodePtr> ClassDefinition::generics() const{
+const std::vector<AstNodePtr>& ClassDefinition::generics() const{
     return m_generics;
 }
-std::vector<AstNodePtr> ClassDefinition::parent() const { return m_parent; }
+const std::vector<AstNodePtr>& ClassDefinition::parent() const { return m_parent; }
 
-std::string ClassDefinition::comment() const { return m_comment; }
+const std::string& ClassDefinition::comment() const { return m_comment; }
 
-std::vector<AstNodePtr> ClassDefinition::other() const { return m_other; }
+const std::vector<AstNodePtr>& ClassDefinition::other() const { return m_other; }
 
-std::vector<AstNodePtr> ClassDefinition::attributes() const {
+const std::vector<AstNodePtr>& ClassDefinition::attributes() const {
     return m_attributes;
 }
 
-std::vector<AstNodePtr> ClassDefinition::methods() const { return m_methods; }
+const std::vector<AstNodePtr>& ClassDefinition::methods() const { return m_methods; }
 
 AstKind ClassDefinition::type() const { return KAstClassDef; }
 
@@ -659,22 +675,26 @@ FunctionDefinition::FunctionDefinition(Token tok, AstNodePtr returnType,
     m_comment=comment;
     m_generics=generic;
 }
-std::vector<AstNodePtr> FunctionDefinition::generics() const{
+const std::vector<AstNodePtr>& FunctionDefinition::generics() const{
     return m_generics;
 }
 AstNodePtr FunctionDefinition::returnType() const { return m_returnType; }
 
 AstNodePtr FunctionDefinition::name() const { return m_name; }
 
-std::vector<parameter> FunctionDefinition::parameters() const {
+const std::vector<parameter>& FunctionDefinition::parameters() const {
     return m_parameters;
 }
-std::string FunctionDefinition::comment() const { return m_comment; }
+const std::string& FunctionDefinition::comment() const { return m_comment; }
 
 void FunctionDefinition::setType(types::TypePtr type){
     m_returnType=type->getTypeAst();
 }
 
+void FunctionDefinition::setParameterType(size_t index, AstNodePtr type){
+    m_parameters[index].p_type=type;
+}
+
 AstNodePtr FunctionDefinition::body() const { return m_body; }
 
 Token FunctionDefinition::token() const { return m_token; }
@@ -771,7 +791,7 @@ FunctionCall::FunctionCall(Token tok, AstNodePtr name,
 
 AstNodePtr FunctionCall::name() const { return m_name; }
 
-std::vector<AstNodePtr> FunctionCall::arguments() const { return m_arguments; }
+const std::vector<AstNodePtr>& FunctionCall::arguments() const { return m_arguments; }
 
 Token FunctionCall::token() const { return m_token; }
 
@@ -833,7 +853,7 @@ AstNodePtr IfStatement::condition() const { return m_condition; }
 
 AstNodePtr IfStatement::ifBody() const { return m_ifBody; }
 
-std::vector<std::pair<AstNodePtr, AstNodePtr>> IfStatement::elifs() const {
+const std::vector<std::pair<AstNodePtr, AstNodePtr>>& IfStatement::elifs() const {
     return m_elifs;
 }
 
@@ -1007,7 +1027,7 @@ ForStatement::ForStatement(Token tok, std::vector<AstNodePtr> variable,
     m_body = body;
 }
 
-std::vector<AstNodePtr> ForStatement::variable() const { return m_variable; }
+const std::vector<AstNodePtr>& ForStatement::variable() const { return m_variable; }
 
 AstNodePtr ForStatement::sequence() const { return m_sequence; }
 
@@ -1049,7 +1069,7 @@ Token PassStatement::token() const { return m_token; }
 
 AstKind PassStatement::type() const { return KAstPassStatement; }
 
-std::string PassStatement::stringify() const { return m_token.keyword; }
+std::string PassStatement::stringify() const { return m_token.keyword(); }
 
 ContinueStatement::ContinueStatement(Token tok) { m_token = tok; }
 
@@ -1085,7 +1105,7 @@ TypeDefinition::TypeDefinition(Token tok, AstNodePtr name, AstNodePtr type,std::
     m_type = type;
     m_generics = generic;
 }
-std::vector<AstNodePtr> TypeDefinition::generics() const{
+const std::vector<AstNodePtr>& TypeDefinition::generics() const{
     return m_generics;
 }
 AstNodePtr TypeDefinition::name() const { return m_name; }
@@ -1125,9 +1145,9 @@ MatchStatement::MatchStatement(
     m_default = defaultbody;
 }
 
-std::vector<AstNodePtr> MatchStatement::matchItem() const { return m_toMatch; }
+const std::vector<AstNodePtr>& MatchStatement::matchItem() const { return m_toMatch; }
 
-std::vector<std::pair<std::vector<AstNodePtr>, AstNodePtr>>
+const std::vector<std::pair<std::vector<AstNodePtr>, AstNodePtr>>&
 MatchStatement::caseBody() const {
     return m_cases;
 }
@@ -1233,7 +1253,7 @@ FunctionTypeExpr::FunctionTypeExpr(Token tok, std::vector<AstNodePtr> argTypes,
 }
 AstKind FunctionTypeExpr::type() const { return KAstFuncTypeExpr; }
 Token FunctionTypeExpr::token() const { return m_token; }
-std::vector<AstNodePtr> FunctionTypeExpr::argTypes() const {
+const std::vector<AstNodePtr>& FunctionTypeExpr::argTypes() const {
     return m_argTypes;
 }
 AstNodePtr FunctionTypeExpr::returnTypes() const {
@@ -1263,7 +1283,7 @@ DecoratorStatement::DecoratorStatement(Token tok,
     m_decorators = decorators;
     m_body = body;
 }
-std::vector<AstNodePtr> DecoratorStatement::decoratorItem() const {
+const std::vector<AstNodePtr>& DecoratorStatement::decoratorItem() const {
     return m_decorators;
 }
 AstNodePtr DecoratorStatement::body() const { return m_body; }
@@ -1285,8 +1305,8 @@ WithStatement::WithStatement(Token tok, std::vector<AstNodePtr> variables,
     m_values = values;
     m_body = body;
 }
-std::vector<AstNodePtr> WithStatement::variables() const { return m_variables; }
-std::vector<AstNodePtr> WithStatement::values() const { return m_values; }
+const std::vector<AstNodePtr>& WithStatement::variables() const { return m_variables; }
+const std::vector<AstNodePtr>& WithStatement::values() const { return m_values; }
 AstNodePtr WithStatement::body() const { return m_body; }
 Token WithStatement::token() const { return m_token; }
 AstKind WithStatement::type() const { return KAstWith; }
@@ -1387,7 +1407,7 @@ TryExcept::TryExcept(Token token,AstNodePtr body,std::vector<except_type>  excep
     m_else_body=else_body;
 }
 AstNodePtr TryExcept::body() const{return m_body;}
-std::vector<except_type> TryExcept::except_clauses() const{return m_except_clauses;}
+const std::vector<except_type>& TryExcept::except_clauses() const{return m_except_clauses;}
 AstNodePtr TryExcept::else_body() const{return m_else_body;}
 Token TryExcept::token() const{return m_token;}
 AstKind TryExcept::type() const{return KAstTryExcept;}
@@ -1416,7 +1436,7 @@ std::string TryExcept::stringify() const{
 ExpressionTuple::ExpressionTuple(std::vector<AstNodePtr> items){
     m_items=items;
 }
-std::vector<AstNodePtr> ExpressionTuple::items() const{return m_items;}
+const std::vector<AstNodePtr>& ExpressionTuple::items() const{return m_items;}
 AstKind ExpressionTuple::type() const{return KAstExpressionTuple;}
 std::string ExpressionTuple::stringify() const{
     std::string res;
@@ -1432,7 +1452,7 @@ Token ExpressionTuple::token() const { return m_items[0]->token(); }
 TypeTuple::TypeTuple(std::vector<AstNodePtr> items){
     m_items=items;
 }
-std::vector<AstNodePtr> TypeTuple::items() const{return m_items;}
+const std::vector<AstNodePtr>& TypeTuple::items() const{return m_items;}
 AstKind TypeTuple::type() const{return KAstTypeTuple;}
 std::string TypeTuple::stringify() const{
     std::string res;
@@ -1451,8 +1471,8 @@ ExternStatement::ExternStatement(Token token,std::vector<std::string> libs,std::
     m_libs=libs;
     m_name=name;
 }
-std::vector<std::string> ExternStatement::libs() const{return m_libs;}
-std::string ExternStatement::name() const{return m_name;}
+const std::vector<std::string>& ExternStatement::libs() const{return m_libs;}
+const std::string& ExternStatement::name() const{return m_name;}
 AstKind ExternStatement::type() const{return KAstExternStatement;}
 Token ExternStatement::token() const{return m_token;}
 std::string ExternStatement::stringify() const{
@@ -1470,7 +1490,7 @@ std::string ExternStatement::stringify() const{
 SumType::SumType(std::vector<AstNodePtr> types){
     m_types=types;
 }
-std::vector<AstNodePtr> SumType::sum_types() const{return m_types;}
+const std::vector<AstNodePtr>& SumType::sum_types() const{return m_types;}
 AstKind SumType::type() const{return KAstSumType;}
 std::string SumType::stringify() const{
     std::string res="(";
@@ -1488,10 +1508,10 @@ MultipleAssign::MultipleAssign(std::vector<AstNodePtr> names,std::vector<AstNode
     m_names=names;
     m_values=values;
 }
-std::vector<AstNodePtr> MultipleAssign::names() const{return m_names;}
-std::vector<AstNodePtr> MultipleAssign::values() const{return m_values;}
+const std::vector<AstNodePtr>& MultipleAssign::names() const{return m_names;}
+const std::vector<AstNodePtr>& MultipleAssign::values() const{return m_values;}
 AstKind MultipleAssign::type() const{return KAstMultipleAssign;}
-std::vector<std::pair<types::TypePtr,bool>> MultipleAssign::processed_types() const{return m_processed_types;}
+const std::vector<std::pair<types::TypePtr,bool>>& MultipleAssign::processed_types() const{return m_processed_types;}
 void MultipleAssign::setProcessedType(std::vector<std::pair<types::TypePtr,bool>> processed_types){
     m_processed_types=processed_types;
 }
@@ -1500,7 +1520,8 @@ std::string MultipleAssign::stringify() const{
     if(m_processed_types.size()>0){
         for (size_t i=0;i<m_names.size();++i){
             res+=m_names[i]->stringify();
-            if(!m_processed_types[i].second){
+            if(i<m_processed_types.size()&&!m_processed_types[i].second&&
+               m_processed_types[i].first!=NULL){
                 res+=":"+m_processed_types[i].first->getTypeAst()->stringify();
             }
             if(i<m_names.size()-1){
@@ -1542,10 +1563,10 @@ AstKind AugAssign::type() const{return KAstAugAssign;}
 Token AugAssign::token() const{return m_token;}
 AstNodePtr AugAssign::name() const{return m_name;}
 AstNodePtr AugAssign::value() const{return m_value;}
-std::string AugAssign::op() const{return m_token.keyword;}
+std::string AugAssign::op() const{return m_token.keyword();}
 std::string AugAssign::stringify() const{
     std::string res=m_name->stringify();
-    res+=m_token.keyword;
+    res+=m_token.keyword();
     res+=m_value->stringify();
     return res;
 }
@@ -1560,7 +1581,7 @@ MethodDefinition::MethodDefinition(Token tok, AstNodePtr returnType, AstNodePtr
     m_reciever=reciever;
     m_generics=generic;
 }
-std::vector<AstNodePtr> MethodDefinition::generics() const{
+const std::vector<AstNodePtr>& MethodDefinition::generics() const{
     return m_generics;
 }
 AstNodePtr MethodDefinition::returnType() const { return m_returnType; }
@@ -1569,7 +1590,7 @@ parameter MethodDefinition::reciever() const { return m_reciever; }
 
 AstNodePtr MethodDefinition::name() const { return m_name; }
 
-std::vector<parameter> MethodDefinition::parameters() const {
+const std::vector<parameter>& MethodDefinition::parameters() const {
     return m_parameters;
 }
 std::vector<parameter> MethodDefinition::codegen_parameters() const {
@@ -1577,7 +1598,7 @@ std::vector<parameter> MethodDefinition::codegen_parameters() const {
     v.insert(v.begin(), m_reciever);
     return v;
 }
-std::string MethodDefinition::comment() const { return m_comment; }
+const std::string& MethodDefinition::comment() const { return m_comment; }
 
 AstNodePtr MethodDefinition::body() const { return m_body; }
 
@@ -1652,8 +1673,8 @@ ExternFuncDef::ExternFuncDef(Token tok, AstNodePtr returnType, AstNodePtr name,
 }
 AstNodePtr ExternFuncDef::returnType() const{return m_returnType;}
 AstNodePtr ExternFuncDef::name() const{return m_name;}
-std::string ExternFuncDef::owner() const{return m_owner;}
-std::vector<AstNodePtr> ExternFuncDef::parameters() const{return m_parameters;}
+const std::string& ExternFuncDef::owner() const{return m_owner;}
+const std::vector<AstNodePtr>& ExternFuncDef::parameters() const{return m_parameters;}
 Token ExternFuncDef::token() const{return m_token;}
 AstKind ExternFuncDef::type() const{return KAstExternFuncDef;}
 std::string ExternFuncDef::stringify() const{
@@ -1680,13 +1701,13 @@ ExternUnionLiteral::ExternUnionLiteral(
     m_owner=owner;
 }
 
-std::vector<std::pair<AstNodePtr, AstNodePtr>> ExternUnionLiteral::elements() const {
+const std::vector<std::pair<AstNodePtr, AstNodePtr>>& ExternUnionLiteral::elements() const {
     return m_elements;
 }
 
 Token ExternUnionLiteral::token() const { return m_token; }
 
-std::string ExternUnionLiteral::owner() const { return m_owner; }
+const std::string& ExternUnionLiteral::owner() const { return m_owner; }
 
 AstNodePtr ExternUnionLiteral::name() const { return m_name; }
 
@@ -1715,13 +1736,13 @@ ExternStructLiteral::ExternStructLiteral(
     m_owner=owner;
 }
 
-std::vector<std::pair<AstNodePtr, AstNodePtr>> ExternStructLiteral::elements() const {
+const std::vector<std::pair<AstNodePtr, AstNodePtr>>& ExternStructLiteral::elements() const {
     return m_elements;
 }
 
 Token ExternStructLiteral::token() const { return m_token; }
 
-std::string ExternStructLiteral::owner() const { return m_owner; }
+const std::string& ExternStructLiteral::owner() const { return m_owner; }
 
 AstNodePtr ExternStructLiteral::name() const { return m_name; }
 
@@ -1745,7 +1766,7 @@ EllipsesTypeExpr::EllipsesTypeExpr(Token tok) {
 }
 Token EllipsesTypeExpr::token() const { return m_token; }
 AstKind EllipsesTypeExpr::type() const { return KAstEllipsesTypeExpr; }
-std::string EllipsesTypeExpr::stringify() const { return m_token.keyword ; }
+std::string EllipsesTypeExpr::stringify() const { return m_token.keyword() ; }
 
 VarKwargTypeExpr::VarKwargTypeExpr(Token tok) {
     m_token = tok;
@@ -1759,7 +1780,7 @@ VarArgTypeExpr::VarArgTypeExpr(Token tok) {
 }
 Token VarArgTypeExpr::token() const { return m_token; }
 AstKind VarArgTypeExpr::type() const { return KAstVarArgTypeExpr; }
-std::string VarArgTypeExpr::stringify() const { return m_token.keyword ; }
+std::string VarArgTypeExpr::stringify() const { return m_token.keyword() ; }
 CompileTimeExpression::CompileTimeExpression(Token tok, AstNodePtr expr_node) {
     m_token = tok;
     m_expr_node = expr_node;
@@ -1778,7 +1799,7 @@ TernaryFor::TernaryFor(Token token,AstNodePtr for_value,AstNodePtr for_iterate,s
 }
 AstNodePtr TernaryFor::for_value()const{return m_for_value;}
 AstNodePtr TernaryFor::for_iterate()const{return m_for_iterate;}
-std::vector<AstNodePtr> TernaryFor::for_variable()const{return m_for_variable;}
+const std::vector<AstNodePtr>& TernaryFor::for_variable()const{return m_for_variable;}
 Token TernaryFor::token()const{return m_token;}
 AstKind TernaryFor::type()const{return KAstTernaryFor;}
 std::string TernaryFor::stringify()const{
@@ -1812,9 +1833,9 @@ InlineAsm::InlineAsm(Token token,std::string assembly,AstNodePtr output,std::vec
     m_output=output;
     m_inputs=inputs;
 }
-std::string InlineAsm::assembly() const{return m_assembly;}
+const std::string& InlineAsm::assembly() const{return m_assembly;}
 AstNodePtr InlineAsm::output() const{return m_output;}
-std::vector<std::pair<std::string,AstNodePtr>> InlineAsm::inputs() const{return m_inputs;}
+const std::vector<std::pair<std::string,AstNodePtr>>& InlineAsm::inputs() const{return m_inputs;}
 Token InlineAsm::token() const { return m_token; }
 AstKind InlineAsm::type() const { return KAstInlineAsm; }
 std::string InlineAsm::stringify() const{
@@ -1835,7 +1856,7 @@ LambdaDefinition::LambdaDefinition(Token tok,std::vector<parameter> parameters,
     m_parameters=parameters;
     m_body=body;
 }
-std::vector<parameter> LambdaDefinition::parameters() const{
+const std::vector<parameter>& LambdaDefinition::parameters() const{
     return m_parameters;
 }
 AstNodePtr LambdaDefinition::body() const{
@@ -1883,7 +1904,7 @@ GenericCall::GenericCall(Token tok,std::vector<AstNodePtr> generic_types,AstNode
     m_generic_types=generic_types;
     m_identifier=identifier;
 }
-std::vector<AstNodePtr> GenericCall::generic_types() const{
+const std::vector<AstNodePtr>& GenericCall::generic_types() const{
     return m_generic_types;
 }
 AstNodePtr GenericCall::identifier() const{
@@ -1911,7 +1932,7 @@ FormatedStr::FormatedStr(Token tok,std::vector<AstNodePtr> items){
     m_tok=tok;
     m_items=items;
 }
-std::vector<AstNodePtr> FormatedStr::items() const{
+const std::vector<AstNodePtr>& FormatedStr::items() const{
     return m_items;
 }
 Token FormatedStr::token() const{
@@ -2,7 +2,9 @@
 #define PEREGRINE_AST_HPP
 
 #include "lexer/tokens.hpp"
+#include "arena.hpp"
 #include "types.hpp"
+#include "utils/symbol.hpp"
 #include <memory>
 #include <string>
 #include <string_view>
@@ -85,32 +87,32 @@ enum AstKind {
     KAstFormatedStr
 };
 
-class AstVisitor;
-
 class AstNode {
   public:
+    AstNode();
     virtual ~AstNode() = default;
 
     virtual Token token() const = 0;
     virtual AstKind type() const = 0;
     virtual std::string stringify() const = 0;
-    virtual void accept(AstVisitor& visitor) const = 0;
+
+    // number of nodes created so far, the benchmarks report nodes/s with it
+    static size_t created();
 };
 
-using AstNodePtr = std::shared_ptr<AstNode>;
+using AstNodePtr = AstNode*;
 
 class Program : public AstNode {
     std::vector<AstNodePtr> m_statements;
     std::string  m_comment;//For generating docs
   public:
     Program(std::vector<AstNodePtr> statements,std::string  comment);
-    std::string comment() const;
-    std::vector<AstNodePtr> statements() const;
+    const std::string& comment() const;
+    const std::vector<AstNodePtr>& statements() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class IntegerLiteral : public AstNode {
@@ -120,12 +122,11 @@ class IntegerLiteral : public AstNode {
   public:
     IntegerLiteral(Token tok, std::string_view value);
 
-    std::string value() const;
+    const std::string& value() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class DecimalLiteral : public AstNode {
@@ -135,12 +136,11 @@ class DecimalLiteral : public AstNode {
   public:
     DecimalLiteral(Token tok, std::string_view value);
 
-    std::string value() const;
+    const std::string& value() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class StringLiteral : public AstNode {
@@ -151,13 +151,12 @@ class StringLiteral : public AstNode {
   public:
     StringLiteral(Token tok, std::string_view value, bool raw);
 
-    std::string value() const;
+    const std::string& value() const;
     bool raw() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class BoolLiteral : public AstNode {
@@ -167,12 +166,11 @@ class BoolLiteral : public AstNode {
   public:
     BoolLiteral(Token tok, std::string_view value);
 
-    std::string value() const;
+    const std::string& value() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class NoneLiteral : public AstNode {
@@ -184,7 +182,6 @@ class NoneLiteral : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class NoLiteral : public AstNode {
@@ -194,41 +191,40 @@ class NoLiteral : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class IdentifierExpression : public AstNode {
     Token m_token;
-    std::string m_value;
+    Utils::Symbol m_value;
 
   public:
     IdentifierExpression(Token tok, std::string_view value);
 
-    std::string value() const;
+    const std::string& value() const;
+    Utils::Symbol symbol() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 // ------------ TYPES ------------
 
 class TypeExpression : public AstNode {
     Token m_token;
-    std::string m_value;
+    Utils::Symbol m_value;
     std::vector<AstNodePtr> m_generic_type;
 
   public:
     TypeExpression(Token tok, std::string_view value, std::vector<AstNodePtr> generic_type={});
 
-    std::string value() const;
-    std::vector<AstNodePtr> generic_types() const;
+    const std::string& value() const;
+    Utils::Symbol symbol() const;
+    const std::vector<AstNodePtr>& generic_types() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ListTypeExpr : public AstNode {
@@ -245,7 +241,6 @@ class ListTypeExpr : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class PointerTypeExpr : public AstNode {
@@ -259,7 +254,6 @@ class PointerTypeExpr : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class RefTypeExpr : public AstNode {
@@ -273,7 +267,6 @@ class RefTypeExpr : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 
@@ -286,7 +279,6 @@ class VarArgTypeExpr : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class VarKwargTypeExpr : public AstNode {
@@ -298,7 +290,6 @@ class VarKwargTypeExpr : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class EllipsesTypeExpr : public AstNode {
     Token m_token;
@@ -309,7 +300,6 @@ class EllipsesTypeExpr : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class FunctionTypeExpr : public AstNode {
@@ -321,13 +311,12 @@ class FunctionTypeExpr : public AstNode {
     FunctionTypeExpr(Token tok, std::vector<AstNodePtr> argTypes,
                      AstNodePtr returnTypes);
 
-    std::vector<AstNodePtr> argTypes() const;
+    const std::vector<AstNodePtr>& argTypes() const;
     AstNodePtr returnTypes() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 // ------------------------------
@@ -339,12 +328,11 @@ class ListLiteral : public AstNode {
   public:
     ListLiteral(Token tok, std::vector<AstNodePtr> elements={});
 
-    std::vector<AstNodePtr> elements() const;
+    const std::vector<AstNodePtr>& elements() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class DictLiteral : public AstNode {
@@ -356,12 +344,11 @@ class DictLiteral : public AstNode {
     DictLiteral(Token tok,
                 std::vector<std::pair<AstNodePtr, AstNodePtr>> elements);
 
-    std::vector<std::pair<AstNodePtr, AstNodePtr>> elements() const;
+    const std::vector<std::pair<AstNodePtr, AstNodePtr>>& elements() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class UnionLiteral : public AstNode {
@@ -377,16 +364,15 @@ class UnionLiteral : public AstNode {
                  std::vector<std::pair<AstNodePtr, AstNodePtr>> elements,
                  AstNodePtr name,std::string  comment,std::vector<AstNodePtr> generic);
 
-    std::vector<std::pair<AstNodePtr, AstNodePtr>> elements() const;
+    const std::vector<std::pair<AstNodePtr, AstNodePtr>>& elements() const;
 
     AstNodePtr name() const;
 
     Token token() const;
-    std::vector<AstNodePtr> generics() const;
+    const std::vector<AstNodePtr>& generics() const;
     AstKind type() const;
-    std::string comment() const;
+    const std::string& comment() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class EnumLiteral : public AstNode {
@@ -400,14 +386,13 @@ class EnumLiteral : public AstNode {
                 std::vector<std::pair<AstNodePtr, AstNodePtr>> fields,
                 AstNodePtr name,std::string comment);
 
-    std::vector<std::pair<AstNodePtr, AstNodePtr>> fields() const;
+    const std::vector<std::pair<AstNodePtr, AstNodePtr>>& fields() const;
 
     AstNodePtr name() const;
-    std::string comment() const;
+    const std::string& comment() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class BinaryOperation : public AstNode {
@@ -426,7 +411,6 @@ class BinaryOperation : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class PrefixExpression : public AstNode {
@@ -443,7 +427,6 @@ class PrefixExpression : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class PostfixExpression : public AstNode {
     Token m_token;
@@ -459,7 +442,6 @@ class PostfixExpression : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 
@@ -472,12 +454,11 @@ class ListOrDictAccess : public AstNode {
     ListOrDictAccess(Token tok, AstNodePtr container, std::vector<AstNodePtr> keyOrIndex);
 
     AstNodePtr container() const;
-    std::vector<AstNodePtr> keyOrIndex() const;
+    const std::vector<AstNodePtr>& keyOrIndex() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ImportStatement : public AstNode {
@@ -494,12 +475,11 @@ class ImportStatement : public AstNode {
 
     AstNodePtr moduleName() const;
     bool importAll() const;
-    std::vector<std::pair<AstNodePtr, AstNodePtr>> importedSymbols() const;
+    const std::vector<std::pair<AstNodePtr, AstNodePtr>>& importedSymbols() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 // variable declaration, assignment and reassignment
@@ -524,11 +504,13 @@ class VariableStatement : public AstNode {
 
     types::TypePtr processedType() const;
     void setProcessedType(types::TypePtr processedType,bool defined_before=false);
+    // declares the variable with auto, for a value the type of which only
+    // the C++ compiler knows
+    void setAutoType();
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ConstDeclaration : public AstNode {
@@ -554,7 +536,6 @@ class ConstDeclaration : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class BlockStatement : public AstNode {
@@ -563,12 +544,11 @@ class BlockStatement : public AstNode {
   public:
     BlockStatement(std::vector<AstNodePtr> statements);
 
-    std::vector<AstNodePtr> statements() const;
+    const std::vector<AstNodePtr>& statements() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 enum ParamType{
   Normal,//normal parameter
@@ -601,16 +581,15 @@ class ClassDefinition : public AstNode {
                     std::string comment,std::vector<AstNodePtr> generic);
 
     AstNodePtr name() const;
-    std::string comment() const;
-    std::vector<AstNodePtr> parent() const;
-    std::vector<AstNodePtr> attributes() const;
-    std::vector<AstNodePtr> methods() const;
-    std::vector<AstNodePtr> other() const;
-    std::vector<AstNodePtr> generics() const;
+    const std::string& comment() const;
+    const std::vector<AstNodePtr>& parent() const;
+    const std::vector<AstNodePtr>& attributes() const;
+    const std::vector<AstNodePtr>& methods() const;
+    const std::vector<AstNodePtr>& other() const;
+    const std::vector<AstNodePtr>& generics() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class FunctionDefinition : public AstNode {
@@ -629,15 +608,15 @@ class FunctionDefinition : public AstNode {
 
     AstNodePtr returnType() const;
     AstNodePtr name() const;
-    std::vector<parameter> parameters() const;
+    const std::vector<parameter>& parameters() const;
     AstNodePtr body() const;
-    std::string comment() const;
+    const std::string& comment() const;
     Token token() const;
-    std::vector<AstNodePtr> generics() const;
+    const std::vector<AstNodePtr>& generics() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
     void setType(types::TypePtr type);
+    void setParameterType(size_t index, AstNodePtr type);
 };
 
 class ReturnStatement : public AstNode {
@@ -652,7 +631,6 @@ class ReturnStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class FunctionCall : public AstNode {
@@ -664,12 +642,11 @@ class FunctionCall : public AstNode {
     FunctionCall(Token tok, AstNodePtr name, std::vector<AstNodePtr> arguments);
 
     AstNodePtr name() const;
-    std::vector<AstNodePtr> arguments() const;
+    const std::vector<AstNodePtr>& arguments() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 // test.hello(), obj.prop, etc
@@ -687,7 +664,6 @@ class DotExpression : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class DefaultArg : public AstNode {
@@ -704,7 +680,6 @@ class DefaultArg : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class IfStatement : public AstNode {
@@ -725,13 +700,12 @@ class IfStatement : public AstNode {
 
     AstNodePtr condition() const;
     AstNodePtr ifBody() const;
-    std::vector<std::pair<AstNodePtr, AstNodePtr>> elifs() const;
+    const std::vector<std::pair<AstNodePtr, AstNodePtr>>& elifs() const;
     AstNodePtr elseBody() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class AssertStatement : public AstNode {
@@ -744,7 +718,6 @@ class AssertStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class StaticStatement : public AstNode {
@@ -757,7 +730,6 @@ class StaticStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ExportStatement : public AstNode {
@@ -770,7 +742,6 @@ class ExportStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class InlineStatement : public AstNode {
@@ -783,7 +754,6 @@ class InlineStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class VirtualStatement : public AstNode {
@@ -796,7 +766,6 @@ class VirtualStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class RaiseStatement : public AstNode {
@@ -809,7 +778,6 @@ class RaiseStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class WhileStatement : public AstNode {
@@ -826,7 +794,6 @@ class WhileStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ForStatement : public AstNode {
@@ -842,14 +809,13 @@ class ForStatement : public AstNode {
     ForStatement(Token tok, std::vector<AstNodePtr> variable,
                  AstNodePtr sequence, AstNodePtr body);
 
-    std::vector<AstNodePtr> variable() const;
+    const std::vector<AstNodePtr>& variable() const;
     AstNodePtr sequence() const;
     AstNodePtr body() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class BreakStatement : public AstNode {
@@ -861,7 +827,6 @@ class BreakStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class PassStatement : public AstNode {
@@ -873,7 +838,6 @@ class PassStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ContinueStatement : public AstNode {
@@ -885,7 +849,6 @@ class ContinueStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 
@@ -902,7 +865,6 @@ class ScopeStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class TypeDefinition : public AstNode {
@@ -919,9 +881,8 @@ class TypeDefinition : public AstNode {
 
     Token token() const;
     AstKind type() const;
-    std::vector<AstNodePtr> generics() const;
+    const std::vector<AstNodePtr>& generics() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class MatchStatement : public AstNode {
@@ -936,14 +897,13 @@ class MatchStatement : public AstNode {
         std::vector<std::pair<std::vector<AstNodePtr>, AstNodePtr>> cases,
         AstNodePtr defaultbody);
 
-    std::vector<AstNodePtr> matchItem() const;
-    std::vector<std::pair<std::vector<AstNodePtr>, AstNodePtr>> caseBody() const;
+    const std::vector<AstNodePtr>& matchItem() const;
+    const std::vector<std::pair<std::vector<AstNodePtr>, AstNodePtr>>& caseBody() const;
     AstNodePtr defaultBody() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class DecoratorStatement : public AstNode {
@@ -955,13 +915,12 @@ class DecoratorStatement : public AstNode {
     DecoratorStatement(Token tok, std::vector<AstNodePtr> decorators,
                        AstNodePtr body);
 
-    std::vector<AstNodePtr> decoratorItem() const;
+    const std::vector<AstNodePtr>& decoratorItem() const;
     AstNodePtr body() const;
 
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class WithStatement : public AstNode {
     Token m_token;
@@ -973,13 +932,12 @@ class WithStatement : public AstNode {
     WithStatement(Token tok, std::vector<AstNodePtr> variables,
                   std::vector<AstNodePtr> values, AstNodePtr body);
 
-    std::vector<AstNodePtr> variables() const;
-    std::vector<AstNodePtr> values() const;
+    const std::vector<AstNodePtr>& variables() const;
+    const std::vector<AstNodePtr>& values() const;
     AstNodePtr body() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class CastStatement : public AstNode {
     Token m_token;
@@ -993,7 +951,6 @@ class CastStatement : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class ArrowExpression : public AstNode {
     Token m_token;
@@ -1009,7 +966,6 @@ class ArrowExpression : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class TernaryIf : public AstNode {
     Token m_token;
@@ -1024,7 +980,6 @@ class TernaryIf : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 
 };
 //This is long 🤣🤣
@@ -1043,34 +998,31 @@ class TryExcept : public AstNode {
   public:
     TryExcept(Token token,AstNodePtr body,std::vector<except_type> except_clauses,AstNodePtr else_body);
     AstNodePtr body() const;
-    std::vector<except_type> except_clauses() const;
+    const std::vector<except_type>& except_clauses() const;
     AstNodePtr else_body() const;//If none of the exeptions are thrown, this is executed
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class TypeTuple : public AstNode {
     std::vector<AstNodePtr> m_items;
   public:
     TypeTuple(std::vector<AstNodePtr> items);
-    std::vector<AstNodePtr> items() const;
+    const std::vector<AstNodePtr>& items() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ExpressionTuple : public AstNode {
     std::vector<AstNodePtr> m_items;
   public:
     ExpressionTuple(std::vector<AstNodePtr> items);
-    std::vector<AstNodePtr> items() const;
+    const std::vector<AstNodePtr>& items() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ExternStatement : public AstNode {
@@ -1079,22 +1031,20 @@ class ExternStatement : public AstNode {
     std::string m_name;
   public:
     ExternStatement(Token token,std::vector<std::string> libs,std::string name);
-    std::vector<std::string> libs() const;
-    std::string name() const;
+    const std::vector<std::string>& libs() const;
+    const std::string& name() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class SumType : public AstNode {
     std::vector<AstNodePtr> m_types;
   public:
     SumType(std::vector<AstNodePtr> types);
-    std::vector<AstNodePtr> sum_types() const;
+    const std::vector<AstNodePtr>& sum_types() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 //multiple assign 
 class MultipleAssign : public AstNode {
@@ -1107,13 +1057,12 @@ class MultipleAssign : public AstNode {
     };
     MultipleAssign(std::vector<AstNodePtr> names,std::vector<AstNodePtr> values);
     void setProcessedType(std::vector<std::pair<types::TypePtr,bool>> types);
-    std::vector<std::pair<types::TypePtr,bool>> processed_types() const;
-    std::vector<AstNodePtr> names() const;
-    std::vector<AstNodePtr> values() const;
+    const std::vector<std::pair<types::TypePtr,bool>>& processed_types() const;
+    const std::vector<AstNodePtr>& names() const;
+    const std::vector<AstNodePtr>& values() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
     MultiAssignType get_assign_type() const;
     void set_assign_type(MultiAssignType type);
     private:
@@ -1137,7 +1086,6 @@ class AugAssign : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class MethodDefinition : public AstNode {
     Token m_token;
@@ -1157,15 +1105,14 @@ class MethodDefinition : public AstNode {
     AstNodePtr returnType() const;
     AstNodePtr name() const;
     parameter reciever() const;
-    std::vector<parameter> parameters() const;
+    const std::vector<parameter>& parameters() const;
     std::vector<parameter> codegen_parameters() const;
     AstNodePtr body() const;
-    std::vector<AstNodePtr> generics() const;
-    std::string comment() const;
+    const std::vector<AstNodePtr>& generics() const;
+    const std::string& comment() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class ExternFuncDef : public AstNode {
     Token m_token;
@@ -1180,12 +1127,11 @@ class ExternFuncDef : public AstNode {
 
     AstNodePtr returnType() const;
     AstNodePtr name() const;
-    std::string owner() const;
-    std::vector<AstNodePtr> parameters() const;
+    const std::string& owner() const;
+    const std::vector<AstNodePtr>& parameters() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class ExternUnionLiteral : public AstNode {
     Token m_token;
@@ -1198,14 +1144,13 @@ class ExternUnionLiteral : public AstNode {
                  std::vector<std::pair<AstNodePtr, AstNodePtr>> elements,
                  AstNodePtr name,std::string owner);
 
-    std::vector<std::pair<AstNodePtr, AstNodePtr>> elements() const;
+    const std::vector<std::pair<AstNodePtr, AstNodePtr>>& elements() const;
 
     AstNodePtr name() const;
-    std::string owner() const;
+    const std::string& owner() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 
 class ExternStructLiteral : public AstNode {
@@ -1219,14 +1164,13 @@ class ExternStructLiteral : public AstNode {
                  std::vector<std::pair<AstNodePtr, AstNodePtr>> elements,
                  AstNodePtr name,std::string owner);
 
-    std::vector<std::pair<AstNodePtr, AstNodePtr>> elements() const;
+    const std::vector<std::pair<AstNodePtr, AstNodePtr>>& elements() const;
 
     AstNodePtr name() const;
-    std::string owner() const;
+    const std::string& owner() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class CompileTimeExpression : public AstNode {
     Token m_token;
@@ -1240,7 +1184,6 @@ class CompileTimeExpression : public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class TernaryFor : public AstNode {
     Token m_token;
@@ -1251,11 +1194,10 @@ class TernaryFor : public AstNode {
     TernaryFor(Token token,AstNodePtr for_value,AstNodePtr for_iterate,std::vector<AstNodePtr> for_variable);
     AstNodePtr for_value() const;
     AstNodePtr for_iterate() const;
-    std::vector<AstNodePtr> for_variable() const;
+    const std::vector<AstNodePtr>& for_variable() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 
 };
 class PrivateDef: public AstNode {
@@ -1270,7 +1212,6 @@ class PrivateDef: public AstNode {
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class InlineAsm: public AstNode {
     Token m_token;
@@ -1279,13 +1220,12 @@ class InlineAsm: public AstNode {
     std::vector<std::pair<std::string,AstNodePtr>> m_inputs;
   public:
     InlineAsm(Token token,std::string assembly,AstNodePtr output,std::vector<std::pair<std::string,AstNodePtr>>inputs);
-    std::string assembly() const;
+    const std::string& assembly() const;
     AstNodePtr output() const;
-    std::vector<std::pair<std::string,AstNodePtr>> inputs() const;
+    const std::vector<std::pair<std::string,AstNodePtr>>& inputs() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class LambdaDefinition : public AstNode {
     Token m_tok;
@@ -1296,14 +1236,13 @@ class LambdaDefinition : public AstNode {
   public:
     LambdaDefinition(Token tok,std::vector<parameter> parameters, AstNodePtr body);
 
-    std::vector<parameter> parameters() const;
+    const std::vector<parameter>& parameters() const;
     void set_return_type(AstNodePtr return_type);
     AstNodePtr body() const;
     AstNodePtr return_type() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 class GenericCall : public AstNode{
     Token m_tok;
@@ -1312,11 +1251,10 @@ class GenericCall : public AstNode{
     public:
     GenericCall(Token tok,std::vector<AstNodePtr> generic_types,AstNodePtr identifier);
     AstNodePtr identifier() const;
-    std::vector<AstNodePtr> generic_types() const;
+    const std::vector<AstNodePtr>& generic_types() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 
 };
 
@@ -1325,11 +1263,10 @@ class FormatedStr: public AstNode{
     Token m_tok;
     public:
     FormatedStr(Token tok,std::vector<AstNodePtr> items);
-    std::vector<AstNodePtr> items() const;
+    const std::vector<AstNodePtr>& items() const;
     Token token() const;
     AstKind type() const;
     std::string stringify() const;
-    void accept(AstVisitor& visitor) const;
 };
 } // namespace ast
 
@@ -0,0 +1,113 @@
+#include "cache.hpp"
+#include "serialize.hpp"
+#include "lexer/source.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef PEREGRINE_VERSION
+#define PEREGRINE_VERSION "dev"
+#endif
+
+namespace ast {
+
+// FNV-1a, 64 bit
+static uint64_t hash(uint64_t seed, std::string_view data) {
+    for (unsigned char c : data) {
+        seed ^= c;
+        seed *= 0x100000001b3;
+    }
+    return seed;
+}
+
+AstCache::AstCache(uint16_t source, std::string_view options)
+    : m_source(source) {
+    auto dir = directory();
+    if (dir.empty()) {
+        return;
+    }
+    uint64_t key = 0xcbf29ce484222325;
+    key = hash(key, sources::get(source).text());
+    // a separator keeps the text and the options from running into each other
+    key = hash(key, std::string_view("\0", 1));
+    key = hash(key, options);
+    key = hash(key, PEREGRINE_VERSION);
+    key = hash(key, std::to_string(serialize_version));
+
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+    m_path = dir + "/" + name + ".ast";
+}
+
+AstNodePtr AstCache::load() const {
+    if (m_path.empty()) {
+        return nullptr;
+    }
+    int fd = open(m_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    AstNodePtr program = nullptr;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            // the tree copies what it keeps, the mapping is not needed after
+            program = deserialize(
+                std::string_view(static_cast<const char*>(data), st.st_size),
+                m_source);
+            munmap(data, st.st_size);
+        }
+    }
+    close(fd);
+    return program;
+}
+
+void AstCache::store(AstNodePtr program) const {
+    if (m_path.empty()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::path path(m_path);
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (ec) {
+        return;
+    }
+    auto data = serialize(program, m_source);
+    // written next to the entry and renamed over it, so a concurrent run never
+    // sees half of a file
+    auto temp = m_path + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary);
+        if (!file.write(data.data(), data.size())) {
+            file.close();
+            std::filesystem::remove(temp, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+    }
+}
+
+std::string AstCache::directory() {
+    if (auto dir = getenv("PEREGRINE_CACHE_DIR")) {
+        return dir;
+    }
+    if (auto dir = getenv("XDG_CACHE_HOME"); dir != nullptr && *dir != '\0') {
+        return std::string(dir) + "/peregrine";
+    }
+    if (auto dir = getenv("HOME"); dir != nullptr && *dir != '\0') {
+        return std::string(dir) + "/.cache/peregrine";
+    }
+    return "";
+}
+
+} // namespace ast
@@ -0,0 +1,39 @@
+#ifndef PEREGRINE_AST_CACHE_HPP
+#define PEREGRINE_AST_CACHE_HPP
+
+#include "ast.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ast {
+
+// validated trees kept on disk between runs, so compiling a file that did
+// not change skips the lexer, the parser and the validator. Entries are
+// named after a hash of the source text, the options the tree was validated
+// with and the compiler version, stale entries are never read again
+class AstCache {
+    uint16_t m_source;
+    std::string m_path;
+
+  public:
+    // `options` are the settings that change how the tree is validated
+    AstCache(uint16_t source, std::string_view options);
+
+    // the cached tree of the source built in the current arena, nullptr if
+    // there is none or it can not be read
+    AstNodePtr load() const;
+
+    // writes `program` for the next run, failures are ignored since the
+    // cache is only an optimization
+    void store(AstNodePtr program) const;
+
+    // $PEREGRINE_CACHE_DIR, else peregrine/ under $XDG_CACHE_HOME or
+    // ~/.cache. Empty when none of them is set, which disables the cache
+    static std::string directory();
+};
+
+} // namespace ast
+
+#endif
@@ -0,0 +1,389 @@
+#include "flat.hpp"
+
+namespace ast {
+
+static void add_child(std::vector<AstNodePtr>& out, AstNodePtr node) {
+    if (node != nullptr) {
+        out.push_back(node);
+    }
+}
+
+static void add_children(std::vector<AstNodePtr>& out,
+                         const std::vector<AstNodePtr>& nodes) {
+    for (auto& node : nodes) {
+        add_child(out, node);
+    }
+}
+
+static void add_children(std::vector<AstNodePtr>& out,
+                         const std::vector<std::pair<AstNodePtr, AstNodePtr>>& nodes) {
+    for (auto& node : nodes) {
+        add_child(out, node.first);
+        add_child(out, node.second);
+    }
+}
+
+static void add_children(std::vector<AstNodePtr>& out, const parameter& param) {
+    add_child(out, param.p_type);
+    add_child(out, param.p_name);
+    add_child(out, param.p_default);
+}
+
+static void add_children(std::vector<AstNodePtr>& out,
+                         const std::vector<parameter>& params) {
+    for (auto& param : params) {
+        add_children(out, param);
+    }
+}
+
+void children(AstNodePtr node, std::vector<AstNodePtr>& out) {
+    switch (node->type()) {
+        case KAstProgram:
+            add_children(out, static_cast<Program*>(node)->statements());
+            break;
+        case KAstTypeExpr:
+            add_children(out, static_cast<TypeExpression*>(node)->generic_types());
+            break;
+        case KAstListTypeExpr: {
+            auto list = static_cast<ListTypeExpr*>(node);
+            add_child(out, list->elemType());
+            add_child(out, list->size());
+            break;
+        }
+        case KAstPointerTypeExpr:
+            add_child(out, static_cast<PointerTypeExpr*>(node)->baseType());
+            break;
+        case KAstRefTypeExpr:
+            add_child(out, static_cast<RefTypeExpr*>(node)->baseType());
+            break;
+        case KAstFuncTypeExpr: {
+            auto function = static_cast<FunctionTypeExpr*>(node);
+            add_children(out, function->argTypes());
+            add_child(out, function->returnTypes());
+            break;
+        }
+        case KAstList:
+            add_children(out, static_cast<ListLiteral*>(node)->elements());
+            break;
+        case KAstDict:
+            add_children(out, static_cast<DictLiteral*>(node)->elements());
+            break;
+        case KAstUnion: {
+            auto union_ = static_cast<UnionLiteral*>(node);
+            add_child(out, union_->name());
+            add_children(out, union_->generics());
+            add_children(out, union_->elements());
+            break;
+        }
+        case KAstEnum: {
+            auto enum_ = static_cast<EnumLiteral*>(node);
+            add_child(out, enum_->name());
+            add_children(out, enum_->fields());
+            break;
+        }
+        case KAstBinaryOp: {
+            auto operation = static_cast<BinaryOperation*>(node);
+            add_child(out, operation->left());
+            add_child(out, operation->right());
+            break;
+        }
+        case KAstPrefixExpr:
+            add_child(out, static_cast<PrefixExpression*>(node)->right());
+            break;
+        case KAstPostfixExpr:
+            add_child(out, static_cast<PostfixExpression*>(node)->left());
+            break;
+        case KAstListOrDictAccess: {
+            auto access = static_cast<ListOrDictAccess*>(node);
+            add_child(out, access->container());
+            add_children(out, access->keyOrIndex());
+            break;
+        }
+        case KAstImportStmt: {
+            auto import = static_cast<ImportStatement*>(node);
+            add_child(out, import->moduleName());
+            add_children(out, import->importedSymbols());
+            break;
+        }
+        case KAstVariableStmt: {
+            auto variable = static_cast<VariableStatement*>(node);
+            add_child(out, variable->varType());
+            add_child(out, variable->name());
+            add_child(out, variable->value());
+            break;
+        }
+        case KAstConstDecl: {
+            auto constant = static_cast<ConstDeclaration*>(node);
+            add_child(out, constant->constType());
+            add_child(out, constant->name());
+            add_child(out, constant->value());
+            break;
+        }
+        case KAstBlockStmt:
+            add_children(out, static_cast<BlockStatement*>(node)->statements());
+            break;
+        case KAstClassDef: {
+            auto class_ = static_cast<ClassDefinition*>(node);
+            add_child(out, class_->name());
+            add_children(out, class_->generics());
+            add_children(out, class_->parent());
+            add_children(out, class_->attributes());
+            add_children(out, class_->methods());
+            add_children(out, class_->other());
+            break;
+        }
+        case KAstFunctionDef: {
+            auto function = static_cast<FunctionDefinition*>(node);
+            add_child(out, function->name());
+            add_children(out, function->generics());
+            add_children(out, function->parameters());
+            add_child(out, function->returnType());
+            add_child(out, function->body());
+            break;
+        }
+        case KAstReturnStatement:
+            add_child(out, static_cast<ReturnStatement*>(node)->returnValue());
+            break;
+        case KAstFunctionCall: {
+            auto call = static_cast<FunctionCall*>(node);
+            add_child(out, call->name());
+            add_children(out, call->arguments());
+            break;
+        }
+        case KAstDotExpression: {
+            auto dot = static_cast<DotExpression*>(node);
+            add_child(out, dot->owner());
+            add_child(out, dot->referenced());
+            break;
+        }
+        case KAstArrowExpression: {
+            auto arrow = static_cast<ArrowExpression*>(node);
+            add_child(out, arrow->owner());
+            add_child(out, arrow->referenced());
+            break;
+        }
+        case KAstIfStmt: {
+            auto if_ = static_cast<IfStatement*>(node);
+            add_child(out, if_->condition());
+            add_child(out, if_->ifBody());
+            add_children(out, if_->elifs());
+            add_child(out, if_->elseBody());
+            break;
+        }
+        case KAstAssertStmt:
+            add_child(out, static_cast<AssertStatement*>(node)->condition());
+            break;
+        case KAstMatchStmt: {
+            auto match = static_cast<MatchStatement*>(node);
+            add_children(out, match->matchItem());
+            for (auto& case_ : match->caseBody()) {
+                add_children(out, case_.first);
+                add_child(out, case_.second);
+            }
+            add_child(out, match->defaultBody());
+            break;
+        }
+        case KAstScopeStmt:
+            add_child(out, static_cast<ScopeStatement*>(node)->body());
+            break;
+        case KAstWhileStmt: {
+            auto while_ = static_cast<WhileStatement*>(node);
+            add_child(out, while_->condition());
+            add_child(out, while_->body());
+            break;
+        }
+        case KAstForStatement: {
+            auto for_ = static_cast<ForStatement*>(node);
+            add_children(out, for_->variable());
+            add_child(out, for_->sequence());
+            add_child(out, for_->body());
+            break;
+        }
+        case KAstTypeDefinition: {
+            auto definition = static_cast<TypeDefinition*>(node);
+            add_child(out, definition->name());
+            add_children(out, definition->generics());
+            add_child(out, definition->baseType());
+            break;
+        }
+        case KAstRaiseStmt:
+            add_child(out, static_cast<RaiseStatement*>(node)->value());
+            break;
+        case KAstDecorator: {
+            auto decorator = static_cast<DecoratorStatement*>(node);
+            add_children(out, decorator->decoratorItem());
+            add_child(out, decorator->body());
+            break;
+        }
+        case KAstExternUnion: {
+            auto union_ = static_cast<ExternUnionLiteral*>(node);
+            add_child(out, union_->name());
+            add_children(out, union_->elements());
+            break;
+        }
+        case KAstExternStruct: {
+            auto struct_ = static_cast<ExternStructLiteral*>(node);
+            add_child(out, struct_->name());
+            add_children(out, struct_->elements());
+            break;
+        }
+        case KAstStatic:
+            add_child(out, static_cast<StaticStatement*>(node)->body());
+            break;
+        case KAstInline:
+            add_child(out, static_cast<InlineStatement*>(node)->body());
+            break;
+        case KAstVirtual:
+            add_child(out, static_cast<VirtualStatement*>(node)->body());
+            break;
+        case KAstExport:
+            add_child(out, static_cast<ExportStatement*>(node)->body());
+            break;
+        case KAstPrivate:
+            add_child(out, static_cast<PrivateDef*>(node)->definition());
+            break;
+        case KAstWith: {
+            auto with = static_cast<WithStatement*>(node);
+            add_children(out, with->variables());
+            add_children(out, with->values());
+            add_child(out, with->body());
+            break;
+        }
+        case KAstCast: {
+            auto cast = static_cast<CastStatement*>(node);
+            add_child(out, cast->cast_type());
+            add_child(out, cast->value());
+            break;
+        }
+        case KAstDefaultArg: {
+            auto arg = static_cast<DefaultArg*>(node);
+            add_child(out, arg->name());
+            add_child(out, arg->value());
+            break;
+        }
+        case KAstTernaryIf: {
+            auto ternary = static_cast<TernaryIf*>(node);
+            add_child(out, ternary->if_value());
+            add_child(out, ternary->if_condition());
+            add_child(out, ternary->else_value());
+            break;
+        }
+        case KAstTernaryFor: {
+            auto ternary = static_cast<TernaryFor*>(node);
+            add_child(out, ternary->for_value());
+            add_children(out, ternary->for_variable());
+            add_child(out, ternary->for_iterate());
+            break;
+        }
+        case KAstTryExcept: {
+            auto try_ = static_cast<TryExcept*>(node);
+            add_child(out, try_->body());
+            for (auto& clause : try_->except_clauses()) {
+                add_children(out, clause.first.first);
+                add_child(out, clause.first.second);
+                add_child(out, clause.second);
+            }
+            add_child(out, try_->else_body());
+            break;
+        }
+        case KAstExpressionTuple:
+            add_children(out, static_cast<ExpressionTuple*>(node)->items());
+            break;
+        case KAstTypeTuple:
+            add_children(out, static_cast<TypeTuple*>(node)->items());
+            break;
+        case KAstSumType:
+            add_children(out, static_cast<SumType*>(node)->sum_types());
+            break;
+        case KAstMultipleAssign: {
+            auto assign = static_cast<MultipleAssign*>(node);
+            add_children(out, assign->names());
+            add_children(out, assign->values());
+            break;
+        }
+        case KAstMethodDef: {
+            auto method = static_cast<MethodDefinition*>(node);
+            add_children(out, method->reciever());
+            add_child(out, method->name());
+            add_children(out, method->generics());
+            add_children(out, method->parameters());
+            add_child(out, method->returnType());
+            add_child(out, method->body());
+            break;
+        }
+        case KAstExternFuncDef: {
+            auto function = static_cast<ExternFuncDef*>(node);
+            add_child(out, function->name());
+            add_children(out, function->parameters());
+            add_child(out, function->returnType());
+            break;
+        }
+        case KAstCompileTimeExpression:
+            add_child(out, static_cast<CompileTimeExpression*>(node)->expression());
+            break;
+        case KAstInlineAsm: {
+            auto assembly = static_cast<InlineAsm*>(node);
+            add_child(out, assembly->output());
+            for (auto& input : assembly->inputs()) {
+                add_child(out, input.second);
+            }
+            break;
+        }
+        case KAstLambda: {
+            auto lambda = static_cast<LambdaDefinition*>(node);
+            add_children(out, lambda->parameters());
+            add_child(out, lambda->body());
+            break;
+        }
+        case KAstGenericCall: {
+            auto call = static_cast<GenericCall*>(node);
+            add_child(out, call->identifier());
+            add_children(out, call->generic_types());
+            break;
+        }
+        case KAstFormatedStr:
+            add_children(out, static_cast<FormatedStr*>(node)->items());
+            break;
+        default:
+            // literals, identifiers and the keyword statements are leaves
+            break;
+    }
+}
+
+FlatAst::FlatAst(AstNodePtr root) {
+    std::vector<AstNodePtr> scratch;
+    add(root, scratch);
+    m_first_edge.push_back(m_edges.size());
+    m_kinds.shrink_to_fit();
+    m_first_edge.shrink_to_fit();
+    m_edges.shrink_to_fit();
+    m_nodes.shrink_to_fit();
+}
+
+FlatAst::Index FlatAst::add(AstNodePtr node, std::vector<AstNodePtr>& scratch) {
+    Index index = m_kinds.size();
+    m_kinds.push_back(node->type());
+    m_nodes.push_back(node);
+
+    // the children wait on the scratch stack while their subtrees are added
+    size_t start = scratch.size();
+    ast::children(node, scratch);
+    size_t count = scratch.size() - start;
+    Index first = m_edges.size();
+    m_first_edge.push_back(first);
+    m_edges.resize(first + count);
+    for (size_t i = 0; i < count; ++i) {
+        m_edges[first + i] = add(scratch[start + i], scratch);
+    }
+    scratch.resize(start);
+    return index;
+}
+
+size_t FlatAst::bytes() const {
+    return m_kinds.capacity() * sizeof(uint8_t) +
+           m_first_edge.capacity() * sizeof(Index) +
+           m_edges.capacity() * sizeof(Index) +
+           m_nodes.capacity() * sizeof(AstNodePtr);
+}
+
+} // namespace ast
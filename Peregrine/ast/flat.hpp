@@ -0,0 +1,56 @@
+#ifndef PEREGRINE_FLAT_AST_HPP
+#define PEREGRINE_FLAT_AST_HPP
+
+#include "ast.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ast {
+
+// appends the direct children of `node` to `out` in source order
+void children(AstNodePtr node, std::vector<AstNodePtr>& out);
+
+// the ast as parallel arrays instead of linked nodes, for passes that walk
+// the whole tree. Nodes are numbered in pre-order with the root at 0, so a
+// linear scan visits parents before their children, and the children of a
+// node are a range of the shared edge array.
+class FlatAst {
+  public:
+    using Index = uint32_t;
+
+  private:
+    std::vector<uint8_t> m_kinds;
+    // children of node i are m_edges[m_first_edge[i] .. m_first_edge[i+1])
+    std::vector<Index> m_first_edge;
+    std::vector<Index> m_edges;
+    // the linked node each entry was made from, for its token and the details
+    // a pass needs
+    std::vector<AstNodePtr> m_nodes;
+
+    Index add(AstNodePtr node, std::vector<AstNodePtr>& scratch);
+
+  public:
+    FlatAst() = default;
+    explicit FlatAst(AstNodePtr root);
+
+    Index size() const { return m_kinds.size(); }
+    AstKind kind(Index node) const { return AstKind(m_kinds[node]); }
+    Token token(Index node) const { return m_nodes[node]->token(); }
+    AstNodePtr node(Index node) const { return m_nodes[node]; }
+
+    std::span<const Index> children(Index node) const {
+        return {m_edges.data() + m_first_edge[node],
+                m_edges.data() + m_first_edge[node + 1]};
+    }
+
+    std::span<const uint8_t> kinds() const { return m_kinds; }
+
+    // bytes held by the arrays
+    size_t bytes() const;
+};
+
+} // namespace ast
+
+#endif
@@ -0,0 +1,1209 @@
+#include "serialize.hpp"
+#include "lexer/source.hpp"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace ast {
+
+static constexpr char magic[4] = {'P', 'E', 'A', 'T'};
+static constexpr uint8_t null_node = 0xff;
+
+// token flags
+static constexpr uint8_t token_pooled = 1;
+static constexpr uint8_t token_in_source = 2;
+
+// integers are written 7 bits at a time with the high bit set on all but the
+// last byte, most lines, offsets and ids fit in one or two bytes
+static void put_varint(std::string& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(char(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+namespace {
+
+class Writer {
+    uint16_t m_source;
+    std::string m_nodes;
+    std::vector<std::string_view> m_strings;
+    std::unordered_map<std::string_view, uint32_t> m_string_ids;
+
+    void u8(uint8_t value) { m_nodes.push_back(value); }
+
+    void u32(uint32_t value) { put_varint(m_nodes, value); }
+
+    void boolean(bool value) { u8(value); }
+
+    // the views have to outlive the writer, they point into the tree or into
+    // the pool of a source
+    void string(std::string_view value) {
+        auto [it, added] = m_string_ids.try_emplace(value, m_strings.size());
+        if (added) {
+            m_strings.push_back(value);
+        }
+        u32(it->second);
+    }
+
+    void token(const Token& tok) {
+        uint8_t flags = 0;
+        uint32_t text = tok.text;
+        if (tok.pooled) {
+            flags |= token_pooled;
+            auto lexeme = sources::get(tok.source).lexeme(tok.text);
+            auto [it, added] = m_string_ids.try_emplace(lexeme, m_strings.size());
+            if (added) {
+                m_strings.push_back(lexeme);
+            }
+            text = it->second;
+        }
+        if (tok.source == m_source && tok.source != 0) {
+            flags |= token_in_source;
+        }
+        u8(tok.tkType);
+        u8(flags);
+        u32(tok.location);
+        u32(tok.start);
+        u32(tok.line);
+        u32(text);
+        u32(tok.length);
+    }
+
+    void nodes(const std::vector<AstNodePtr>& items) {
+        u32(items.size());
+        for (auto& item : items) {
+            node(item);
+        }
+    }
+
+    void pairs(const std::vector<std::pair<AstNodePtr, AstNodePtr>>& items) {
+        u32(items.size());
+        for (auto& item : items) {
+            node(item.first);
+            node(item.second);
+        }
+    }
+
+    void param(const parameter& item) {
+        node(item.p_type);
+        node(item.p_name);
+        node(item.p_default);
+        boolean(item.is_const);
+        u8(item.p_paramType);
+    }
+
+    void params(const std::vector<parameter>& items) {
+        u32(items.size());
+        for (auto& item : items) {
+            param(item);
+        }
+    }
+
+  public:
+    explicit Writer(uint16_t source) : m_source(source) {}
+
+    void node(AstNodePtr node);
+
+    std::string finish() {
+        std::string out(magic, sizeof(magic));
+        put_varint(out, serialize_version);
+        put_varint(out, m_strings.size());
+        for (auto& value : m_strings) {
+            put_varint(out, value.size());
+            out.append(value);
+        }
+        out.append(m_nodes);
+        return out;
+    }
+};
+
+void Writer::node(AstNodePtr node) {
+    if (node == nullptr) {
+        u8(null_node);
+        return;
+    }
+    u8(node->type());
+    switch (node->type()) {
+        case KAstProgram: {
+            auto program = static_cast<Program*>(node);
+            nodes(program->statements());
+            string(program->comment());
+            break;
+        }
+        case KAstInteger: {
+            auto literal = static_cast<IntegerLiteral*>(node);
+            token(literal->token());
+            string(literal->value());
+            break;
+        }
+        case KAstDecimal: {
+            auto literal = static_cast<DecimalLiteral*>(node);
+            token(literal->token());
+            string(literal->value());
+            break;
+        }
+        case KAstString: {
+            auto literal = static_cast<StringLiteral*>(node);
+            token(literal->token());
+            string(literal->value());
+            boolean(literal->raw());
+            break;
+        }
+        case KAstBool: {
+            auto literal = static_cast<BoolLiteral*>(node);
+            token(literal->token());
+            string(literal->value());
+            break;
+        }
+        case KAstNone:
+        case KAstVarArgTypeExpr:
+        case KAstVarKwargTypeExpr:
+        case KAstEllipsesTypeExpr:
+        case KAstBreakStatement:
+        case KAstPassStatement:
+        case KAstContinueStatement:
+            token(node->token());
+            break;
+        case KAstNoLiteral:
+            break;
+        case KAstIdentifier: {
+            auto identifier = static_cast<IdentifierExpression*>(node);
+            token(identifier->token());
+            string(identifier->value());
+            break;
+        }
+        case KAstTypeExpr: {
+            auto type = static_cast<TypeExpression*>(node);
+            token(type->token());
+            string(type->value());
+            nodes(type->generic_types());
+            break;
+        }
+        case KAstListTypeExpr: {
+            auto type = static_cast<ListTypeExpr*>(node);
+            token(type->token());
+            this->node(type->elemType());
+            this->node(type->size());
+            break;
+        }
+        case KAstPointerTypeExpr: {
+            auto type = static_cast<PointerTypeExpr*>(node);
+            token(type->token());
+            this->node(type->baseType());
+            break;
+        }
+        case KAstRefTypeExpr: {
+            auto type = static_cast<RefTypeExpr*>(node);
+            token(type->token());
+            this->node(type->baseType());
+            break;
+        }
+        case KAstFuncTypeExpr: {
+            auto type = static_cast<FunctionTypeExpr*>(node);
+            token(type->token());
+            nodes(type->argTypes());
+            this->node(type->returnTypes());
+            break;
+        }
+        case KAstList: {
+            auto list = static_cast<ListLiteral*>(node);
+            token(list->token());
+            nodes(list->elements());
+            break;
+        }
+        case KAstDict: {
+            auto dict = static_cast<DictLiteral*>(node);
+            token(dict->token());
+            pairs(dict->elements());
+            break;
+        }
+        case KAstUnion: {
+            auto union_ = static_cast<UnionLiteral*>(node);
+            token(union_->token());
+            pairs(union_->elements());
+            this->node(union_->name());
+            string(union_->comment());
+            nodes(union_->generics());
+            break;
+        }
+        case KAstEnum: {
+            auto enum_ = static_cast<EnumLiteral*>(node);
+            token(enum_->token());
+            pairs(enum_->fields());
+            this->node(enum_->name());
+            string(enum_->comment());
+            break;
+        }
+        case KAstBinaryOp: {
+            auto operation = static_cast<BinaryOperation*>(node);
+            token(operation->token());
+            this->node(operation->left());
+            token(operation->op());
+            this->node(operation->right());
+            break;
+        }
+        case KAstPrefixExpr: {
+            auto prefix = static_cast<PrefixExpression*>(node);
+            token(prefix->token());
+            token(prefix->prefix());
+            this->node(prefix->right());
+            break;
+        }
+        case KAstPostfixExpr: {
+            auto postfix = static_cast<PostfixExpression*>(node);
+            token(postfix->token());
+            token(postfix->postfix());
+            this->node(postfix->left());
+            break;
+        }
+        case KAstListOrDictAccess: {
+            auto access = static_cast<ListOrDictAccess*>(node);
+            token(access->token());
+            this->node(access->container());
+            nodes(access->keyOrIndex());
+            break;
+        }
+        case KAstImportStmt: {
+            auto import = static_cast<ImportStatement*>(node);
+            token(import->token());
+            this->node(import->moduleName());
+            pairs(import->importedSymbols());
+            boolean(import->importAll());
+            break;
+        }
+        case KAstVariableStmt: {
+            auto variable = static_cast<VariableStatement*>(node);
+            token(variable->token());
+            this->node(variable->varType());
+            this->node(variable->name());
+            this->node(variable->value());
+            break;
+        }
+        case KAstConstDecl: {
+            auto constant = static_cast<ConstDeclaration*>(node);
+            token(constant->token());
+            this->node(constant->constType());
+            this->node(constant->name());
+            this->node(constant->value());
+            break;
+        }
+        case KAstBlockStmt:
+            nodes(static_cast<BlockStatement*>(node)->statements());
+            break;
+        case KAstClassDef: {
+            auto class_ = static_cast<ClassDefinition*>(node);
+            token(class_->token());
+            this->node(class_->name());
+            nodes(class_->parent());
+            nodes(class_->attributes());
+            nodes(class_->methods());
+            nodes(class_->other());
+            string(class_->comment());
+            nodes(class_->generics());
+            break;
+        }
+        case KAstFunctionDef: {
+            auto function = static_cast<FunctionDefinition*>(node);
+            token(function->token());
+            this->node(function->returnType());
+            this->node(function->name());
+            params(function->parameters());
+            this->node(function->body());
+            string(function->comment());
+            nodes(function->generics());
+            break;
+        }
+        case KAstReturnStatement: {
+            auto return_ = static_cast<ReturnStatement*>(node);
+            token(return_->token());
+            this->node(return_->returnValue());
+            break;
+        }
+        case KAstFunctionCall: {
+            auto call = static_cast<FunctionCall*>(node);
+            token(call->token());
+            this->node(call->name());
+            nodes(call->arguments());
+            break;
+        }
+        case KAstDotExpression: {
+            auto dot = static_cast<DotExpression*>(node);
+            token(dot->token());
+            this->node(dot->owner());
+            this->node(dot->referenced());
+            break;
+        }
+        case KAstArrowExpression: {
+            auto arrow = static_cast<ArrowExpression*>(node);
+            token(arrow->token());
+            this->node(arrow->owner());
+            this->node(arrow->referenced());
+            break;
+        }
+        case KAstDefaultArg: {
+            auto arg = static_cast<DefaultArg*>(node);
+            token(arg->token());
+            this->node(arg->name());
+            this->node(arg->value());
+            break;
+        }
+        case KAstIfStmt: {
+            auto if_ = static_cast<IfStatement*>(node);
+            token(if_->token());
+            this->node(if_->condition());
+            this->node(if_->ifBody());
+            this->node(if_->elseBody());
+            pairs(if_->elifs());
+            break;
+        }
+        case KAstAssertStmt: {
+            auto assert_ = static_cast<AssertStatement*>(node);
+            token(assert_->token());
+            this->node(assert_->condition());
+            break;
+        }
+        case KAstStatic: {
+            auto static_ = static_cast<StaticStatement*>(node);
+            token(static_->token());
+            this->node(static_->body());
+            break;
+        }
+        case KAstExport: {
+            auto export_ = static_cast<ExportStatement*>(node);
+            token(export_->token());
+            this->node(export_->body());
+            break;
+        }
+        case KAstInline: {
+            auto inline_ = static_cast<InlineStatement*>(node);
+            token(inline_->token());
+            this->node(inline_->body());
+            break;
+        }
+        case KAstVirtual: {
+            auto virtual_ = static_cast<VirtualStatement*>(node);
+            token(virtual_->token());
+            this->node(virtual_->body());
+            break;
+        }
+        case KAstRaiseStmt: {
+            auto raise = static_cast<RaiseStatement*>(node);
+            token(raise->token());
+            this->node(raise->value());
+            break;
+        }
+        case KAstWhileStmt: {
+            auto while_ = static_cast<WhileStatement*>(node);
+            token(while_->token());
+            this->node(while_->condition());
+            this->node(while_->body());
+            break;
+        }
+        case KAstForStatement: {
+            auto for_ = static_cast<ForStatement*>(node);
+            token(for_->token());
+            nodes(for_->variable());
+            this->node(for_->sequence());
+            this->node(for_->body());
+            break;
+        }
+        case KAstScopeStmt: {
+            auto scope = static_cast<ScopeStatement*>(node);
+            token(scope->token());
+            this->node(scope->body());
+            break;
+        }
+        case KAstTypeDefinition: {
+            auto definition = static_cast<TypeDefinition*>(node);
+            token(definition->token());
+            this->node(definition->name());
+            this->node(definition->baseType());
+            nodes(definition->generics());
+            break;
+        }
+        case KAstMatchStmt: {
+            auto match = static_cast<MatchStatement*>(node);
+            token(match->token());
+            nodes(match->matchItem());
+            u32(match->caseBody().size());
+            for (auto& case_ : match->caseBody()) {
+                nodes(case_.first);
+                this->node(case_.second);
+            }
+            this->node(match->defaultBody());
+            break;
+        }
+        case KAstDecorator: {
+            auto decorator = static_cast<DecoratorStatement*>(node);
+            token(decorator->token());
+            nodes(decorator->decoratorItem());
+            this->node(decorator->body());
+            break;
+        }
+        case KAstWith: {
+            auto with = static_cast<WithStatement*>(node);
+            token(with->token());
+            nodes(with->variables());
+            nodes(with->values());
+            this->node(with->body());
+            break;
+        }
+        case KAstCast: {
+            auto cast = static_cast<CastStatement*>(node);
+            token(cast->token());
+            this->node(cast->cast_type());
+            this->node(cast->value());
+            break;
+        }
+        case KAstTernaryIf: {
+            auto ternary = static_cast<TernaryIf*>(node);
+            token(ternary->token());
+            this->node(ternary->if_value());
+            this->node(ternary->if_condition());
+            this->node(ternary->else_value());
+            break;
+        }
+        case KAstTryExcept: {
+            auto try_ = static_cast<TryExcept*>(node);
+            token(try_->token());
+            this->node(try_->body());
+            u32(try_->except_clauses().size());
+            for (auto& clause : try_->except_clauses()) {
+                nodes(clause.first.first);
+                this->node(clause.first.second);
+                this->node(clause.second);
+            }
+            this->node(try_->else_body());
+            break;
+        }
+        case KAstTypeTuple:
+            nodes(static_cast<TypeTuple*>(node)->items());
+            break;
+        case KAstExpressionTuple:
+            nodes(static_cast<ExpressionTuple*>(node)->items());
+            break;
+        case KAstExternStatement: {
+            auto extern_ = static_cast<ExternStatement*>(node);
+            token(extern_->token());
+            u32(extern_->libs().size());
+            for (auto& lib : extern_->libs()) {
+                string(lib);
+            }
+            string(extern_->name());
+            break;
+        }
+        case KAstSumType:
+            nodes(static_cast<SumType*>(node)->sum_types());
+            break;
+        case KAstMultipleAssign: {
+            auto assign = static_cast<MultipleAssign*>(node);
+            nodes(assign->names());
+            nodes(assign->values());
+            break;
+        }
+        case KAstAugAssign: {
+            auto assign = static_cast<AugAssign*>(node);
+            token(assign->token());
+            this->node(assign->name());
+            this->node(assign->value());
+            break;
+        }
+        case KAstMethodDef: {
+            auto method = static_cast<MethodDefinition*>(node);
+            token(method->token());
+            this->node(method->returnType());
+            this->node(method->name());
+            params(method->parameters());
+            param(method->reciever());
+            this->node(method->body());
+            string(method->comment());
+            nodes(method->generics());
+            break;
+        }
+        case KAstExternFuncDef: {
+            auto function = static_cast<ExternFuncDef*>(node);
+            token(function->token());
+            this->node(function->returnType());
+            this->node(function->name());
+            nodes(function->parameters());
+            string(function->owner());
+            break;
+        }
+        case KAstExternUnion: {
+            auto union_ = static_cast<ExternUnionLiteral*>(node);
+            token(union_->token());
+            pairs(union_->elements());
+            this->node(union_->name());
+            string(union_->owner());
+            break;
+        }
+        case KAstExternStruct: {
+            auto struct_ = static_cast<ExternStructLiteral*>(node);
+            token(struct_->token());
+            pairs(struct_->elements());
+            this->node(struct_->name());
+            string(struct_->owner());
+            break;
+        }
+        case KAstCompileTimeExpression: {
+            auto expression = static_cast<CompileTimeExpression*>(node);
+            token(expression->token());
+            this->node(expression->expression());
+            break;
+        }
+        case KAstTernaryFor: {
+            auto ternary = static_cast<TernaryFor*>(node);
+            token(ternary->token());
+            this->node(ternary->for_value());
+            this->node(ternary->for_iterate());
+            nodes(ternary->for_variable());
+            break;
+        }
+        case KAstPrivate: {
+            auto private_ = static_cast<PrivateDef*>(node);
+            token(private_->token());
+            this->node(private_->definition());
+            break;
+        }
+        case KAstInlineAsm: {
+            auto assembly = static_cast<InlineAsm*>(node);
+            token(assembly->token());
+            string(assembly->assembly());
+            this->node(assembly->output());
+            u32(assembly->inputs().size());
+            for (auto& input : assembly->inputs()) {
+                string(input.first);
+                this->node(input.second);
+            }
+            break;
+        }
+        case KAstLambda: {
+            auto lambda = static_cast<LambdaDefinition*>(node);
+            token(lambda->token());
+            params(lambda->parameters());
+            this->node(lambda->body());
+            break;
+        }
+        case KAstGenericCall: {
+            auto call = static_cast<GenericCall*>(node);
+            token(call->token());
+            nodes(call->generic_types());
+            this->node(call->identifier());
+            break;
+        }
+        case KAstFormatedStr: {
+            auto str = static_cast<FormatedStr*>(node);
+            token(str->token());
+            nodes(str->items());
+            break;
+        }
+        case KAstDictTypeExpr:
+            // no node has this kind
+            break;
+    }
+}
+
+class Reader {
+    std::string_view m_data;
+    size_t m_pos = 0;
+    bool m_failed = false;
+    uint16_t m_source;
+    std::vector<std::string_view> m_strings;
+    // index in the pool of the builtin source and of m_source that a pooled
+    // lexeme from the string table was stored at
+    std::vector<uint32_t> m_pooled[2];
+
+    bool has(size_t size) {
+        if (m_data.size() - m_pos < size) {
+            m_failed = true;
+        }
+        return !m_failed;
+    }
+
+    uint8_t u8() { return has(1) ? m_data[m_pos++] : 0; }
+
+    uint32_t u32() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35 && has(1); shift += 7) {
+            uint8_t byte = m_data[m_pos++];
+            value |= uint32_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        m_failed = true;
+        return 0;
+    }
+
+    bool boolean() { return u8() != 0; }
+
+    std::string_view string() {
+        uint32_t id = u32();
+        if (id >= m_strings.size()) {
+            m_failed = true;
+            return "";
+        }
+        return m_strings[id];
+    }
+
+    // a count of items that are at least `size` bytes each
+    uint32_t count(size_t size) {
+        uint32_t value = u32();
+        if (!has(size_t(value) * size)) {
+            return 0;
+        }
+        return value;
+    }
+
+    Token token() {
+        Token tok;
+        tok.tkType = TokenType(u8());
+        uint8_t flags = u8();
+        tok.location = u32();
+        tok.start = u32();
+        tok.line = u32();
+        tok.text = u32();
+        tok.length = u32();
+        bool in_source = flags & token_in_source;
+        tok.source = in_source ? m_source : 0;
+        tok.pooled = flags & token_pooled;
+        if (tok.pooled) {
+            if (tok.text >= m_strings.size()) {
+                m_failed = true;
+                tok.pooled = false;
+                return tok;
+            }
+            auto& pooled = m_pooled[in_source][tok.text];
+            if (pooled == UINT32_MAX) {
+                pooled = sources::get(tok.source).add_lexeme(m_strings[tok.text]);
+            }
+            tok.text = pooled;
+        }
+        return tok;
+    }
+
+    std::vector<AstNodePtr> nodes() {
+        std::vector<AstNodePtr> items(count(1));
+        for (auto& item : items) {
+            item = node();
+        }
+        return items;
+    }
+
+    std::vector<std::pair<AstNodePtr, AstNodePtr>> pairs() {
+        std::vector<std::pair<AstNodePtr, AstNodePtr>> items(count(2));
+        for (auto& item : items) {
+            item.first = node();
+            item.second = node();
+        }
+        return items;
+    }
+
+    parameter param() {
+        parameter item;
+        item.p_type = node();
+        item.p_name = node();
+        item.p_default = node();
+        item.is_const = boolean();
+        item.p_paramType = ParamType(u8());
+        return item;
+    }
+
+    std::vector<parameter> params() {
+        std::vector<parameter> items(count(5));
+        for (auto& item : items) {
+            item = param();
+        }
+        return items;
+    }
+
+  public:
+    Reader(std::string_view data, uint16_t source)
+        : m_data(data), m_source(source) {}
+
+    AstNodePtr node();
+
+    AstNodePtr read() {
+        if (!has(sizeof(magic)) ||
+            std::memcmp(m_data.data(), magic, sizeof(magic)) != 0) {
+            return nullptr;
+        }
+        m_pos += sizeof(magic);
+        if (u32() != serialize_version) {
+            return nullptr;
+        }
+        m_strings.resize(count(1));
+        for (auto& value : m_strings) {
+            uint32_t size = u32();
+            if (!has(size)) {
+                return nullptr;
+            }
+            value = m_data.substr(m_pos, size);
+            m_pos += size;
+        }
+        m_pooled[0].assign(m_strings.size(), UINT32_MAX);
+        m_pooled[1].assign(m_strings.size(), UINT32_MAX);
+
+        AstNodePtr program = node();
+        if (m_failed || m_pos != m_data.size() || program == nullptr ||
+            program->type() != KAstProgram) {
+            return nullptr;
+        }
+        return program;
+    }
+};
+
+AstNodePtr Reader::node() {
+    uint8_t kind = u8();
+    if (m_failed || kind == null_node) {
+        return nullptr;
+    }
+    // the fields are read into locals first, the order in which function
+    // arguments are evaluated is unspecified
+    switch (kind) {
+        case KAstProgram: {
+            auto statements = nodes();
+            auto comment = string();
+            return make<Program>(statements, std::string(comment));
+        }
+        case KAstInteger: {
+            auto tok = token();
+            auto value = string();
+            return make<IntegerLiteral>(tok, value);
+        }
+        case KAstDecimal: {
+            auto tok = token();
+            auto value = string();
+            return make<DecimalLiteral>(tok, value);
+        }
+        case KAstString: {
+            auto tok = token();
+            auto value = string();
+            auto raw = boolean();
+            return make<StringLiteral>(tok, value, raw);
+        }
+        case KAstBool: {
+            auto tok = token();
+            auto value = string();
+            return make<BoolLiteral>(tok, value);
+        }
+        case KAstNone:
+            return make<NoneLiteral>(token());
+        case KAstVarArgTypeExpr:
+            return make<VarArgTypeExpr>(token());
+        case KAstVarKwargTypeExpr:
+            return make<VarKwargTypeExpr>(token());
+        case KAstEllipsesTypeExpr:
+            return make<EllipsesTypeExpr>(token());
+        case KAstBreakStatement:
+            return make<BreakStatement>(token());
+        case KAstPassStatement:
+            return make<PassStatement>(token());
+        case KAstContinueStatement:
+            return make<ContinueStatement>(token());
+        case KAstNoLiteral:
+            return make<NoLiteral>();
+        case KAstIdentifier: {
+            auto tok = token();
+            auto value = string();
+            return make<IdentifierExpression>(tok, value);
+        }
+        case KAstTypeExpr: {
+            auto tok = token();
+            auto value = string();
+            auto generics = nodes();
+            return make<TypeExpression>(tok, value, generics);
+        }
+        case KAstListTypeExpr: {
+            auto tok = token();
+            auto elemType = node();
+            auto size = node();
+            return make<ListTypeExpr>(tok, elemType, size);
+        }
+        case KAstPointerTypeExpr: {
+            auto tok = token();
+            auto baseType = node();
+            return make<PointerTypeExpr>(tok, baseType);
+        }
+        case KAstRefTypeExpr: {
+            auto tok = token();
+            auto baseType = node();
+            return make<RefTypeExpr>(tok, baseType);
+        }
+        case KAstFuncTypeExpr: {
+            auto tok = token();
+            auto argTypes = nodes();
+            auto returnTypes = node();
+            return make<FunctionTypeExpr>(tok, argTypes, returnTypes);
+        }
+        case KAstList: {
+            auto tok = token();
+            auto elements = nodes();
+            return make<ListLiteral>(tok, elements);
+        }
+        case KAstDict: {
+            auto tok = token();
+            auto elements = pairs();
+            return make<DictLiteral>(tok, elements);
+        }
+        case KAstUnion: {
+            auto tok = token();
+            auto elements = pairs();
+            auto name = node();
+            auto comment = string();
+            auto generics = nodes();
+            return make<UnionLiteral>(tok, elements, name, std::string(comment),
+                                      generics);
+        }
+        case KAstEnum: {
+            auto tok = token();
+            auto fields = pairs();
+            auto name = node();
+            auto comment = string();
+            return make<EnumLiteral>(tok, fields, name, std::string(comment));
+        }
+        case KAstBinaryOp: {
+            auto tok = token();
+            auto left = node();
+            auto op = token();
+            auto right = node();
+            return make<BinaryOperation>(tok, left, op, right);
+        }
+        case KAstPrefixExpr: {
+            auto tok = token();
+            auto prefix = token();
+            auto right = node();
+            return make<PrefixExpression>(tok, prefix, right);
+        }
+        case KAstPostfixExpr: {
+            auto tok = token();
+            auto postfix = token();
+            auto left = node();
+            return make<PostfixExpression>(tok, postfix, left);
+        }
+        case KAstListOrDictAccess: {
+            auto tok = token();
+            auto container = node();
+            auto keyOrIndex = nodes();
+            return make<ListOrDictAccess>(tok, container, keyOrIndex);
+        }
+        case KAstImportStmt: {
+            auto tok = token();
+            auto moduleName = node();
+            auto importedSymbols = pairs();
+            auto importAll = boolean();
+            return make<ImportStatement>(tok, moduleName, importedSymbols,
+                                         importAll);
+        }
+        case KAstVariableStmt: {
+            auto tok = token();
+            auto type = node();
+            auto name = node();
+            auto value = node();
+            return make<VariableStatement>(tok, type, name, value);
+        }
+        case KAstConstDecl: {
+            auto tok = token();
+            auto type = node();
+            auto name = node();
+            auto value = node();
+            return make<ConstDeclaration>(tok, type, name, value);
+        }
+        case KAstBlockStmt:
+            return make<BlockStatement>(nodes());
+        case KAstClassDef: {
+            auto tok = token();
+            auto name = node();
+            auto parent = nodes();
+            auto attributes = nodes();
+            auto methods = nodes();
+            auto other = nodes();
+            auto comment = string();
+            auto generics = nodes();
+            return make<ClassDefinition>(tok, name, parent, attributes, methods,
+                                         other, std::string(comment), generics);
+        }
+        case KAstFunctionDef: {
+            auto tok = token();
+            auto returnType = node();
+            auto name = node();
+            auto parameters = params();
+            auto body = node();
+            auto comment = string();
+            auto generics = nodes();
+            return make<FunctionDefinition>(tok, returnType, name, parameters,
+                                            body, std::string(comment), generics);
+        }
+        case KAstReturnStatement: {
+            auto tok = token();
+            auto value = node();
+            return make<ReturnStatement>(tok, value);
+        }
+        case KAstFunctionCall: {
+            auto tok = token();
+            auto name = node();
+            auto arguments = nodes();
+            return make<FunctionCall>(tok, name, arguments);
+        }
+        case KAstDotExpression: {
+            auto tok = token();
+            auto owner = node();
+            auto referenced = node();
+            return make<DotExpression>(tok, owner, referenced);
+        }
+        case KAstArrowExpression: {
+            auto tok = token();
+            auto owner = node();
+            auto referenced = node();
+            return make<ArrowExpression>(tok, owner, referenced);
+        }
+        case KAstDefaultArg: {
+            auto tok = token();
+            auto name = node();
+            auto value = node();
+            return make<DefaultArg>(tok, name, value);
+        }
+        case KAstIfStmt: {
+            auto tok = token();
+            auto condition = node();
+            auto ifBody = node();
+            auto elseBody = node();
+            auto elifs = pairs();
+            return make<IfStatement>(tok, condition, ifBody, elseBody, elifs);
+        }
+        case KAstAssertStmt: {
+            auto tok = token();
+            auto condition = node();
+            return make<AssertStatement>(tok, condition);
+        }
+        case KAstStatic: {
+            auto tok = token();
+            auto body = node();
+            return make<StaticStatement>(tok, body);
+        }
+        case KAstExport: {
+            auto tok = token();
+            auto body = node();
+            return make<ExportStatement>(tok, body);
+        }
+        case KAstInline: {
+            auto tok = token();
+            auto body = node();
+            return make<InlineStatement>(tok, body);
+        }
+        case KAstVirtual: {
+            auto tok = token();
+            auto body = node();
+            return make<VirtualStatement>(tok, body);
+        }
+        case KAstRaiseStmt: {
+            auto tok = token();
+            auto value = node();
+            return make<RaiseStatement>(tok, value);
+        }
+        case KAstWhileStmt: {
+            auto tok = token();
+            auto condition = node();
+            auto body = node();
+            return make<WhileStatement>(tok, condition, body);
+        }
+        case KAstForStatement: {
+            auto tok = token();
+            auto variable = nodes();
+            auto sequence = node();
+            auto body = node();
+            return make<ForStatement>(tok, variable, sequence, body);
+        }
+        case KAstScopeStmt: {
+            auto tok = token();
+            auto body = node();
+            return make<ScopeStatement>(tok, body);
+        }
+        case KAstTypeDefinition: {
+            auto tok = token();
+            auto name = node();
+            auto baseType = node();
+            auto generics = nodes();
+            return make<TypeDefinition>(tok, name, baseType, generics);
+        }
+        case KAstMatchStmt: {
+            auto tok = token();
+            auto toMatch = nodes();
+            std::vector<std::pair<std::vector<AstNodePtr>, AstNodePtr>> cases(
+                count(2));
+            for (auto& case_ : cases) {
+                case_.first = nodes();
+                case_.second = node();
+            }
+            auto defaultBody = node();
+            return make<MatchStatement>(tok, toMatch, cases, defaultBody);
+        }
+        case KAstDecorator: {
+            auto tok = token();
+            auto decorators = nodes();
+            auto body = node();
+            return make<DecoratorStatement>(tok, decorators, body);
+        }
+        case KAstWith: {
+            auto tok = token();
+            auto variables = nodes();
+            auto values = nodes();
+            auto body = node();
+            return make<WithStatement>(tok, variables, values, body);
+        }
+        case KAstCast: {
+            auto tok = token();
+            auto type = node();
+            auto value = node();
+            return make<CastStatement>(tok, type, value);
+        }
+        case KAstTernaryIf: {
+            auto tok = token();
+            auto if_value = node();
+            auto if_condition = node();
+            auto else_value = node();
+            return make<TernaryIf>(tok, if_value, if_condition, else_value);
+        }
+        case KAstTryExcept: {
+            auto tok = token();
+            auto body = node();
+            std::vector<except_type> clauses(count(3));
+            for (auto& clause : clauses) {
+                clause.first.first = nodes();
+                clause.first.second = node();
+                clause.second = node();
+            }
+            auto else_body = node();
+            return make<TryExcept>(tok, body, clauses, else_body);
+        }
+        case KAstTypeTuple:
+            return make<TypeTuple>(nodes());
+        case KAstExpressionTuple:
+            return make<ExpressionTuple>(nodes());
+        case KAstExternStatement: {
+            auto tok = token();
+            std::vector<std::string> libs(count(1));
+            for (auto& lib : libs) {
+                lib = string();
+            }
+            auto name = string();
+            return make<ExternStatement>(tok, libs, std::string(name));
+        }
+        case KAstSumType:
+            return make<SumType>(nodes());
+        case KAstMultipleAssign: {
+            auto names = nodes();
+            auto values = nodes();
+            return make<MultipleAssign>(names, values);
+        }
+        case KAstAugAssign: {
+            auto tok = token();
+            auto name = node();
+            auto value = node();
+            return make<AugAssign>(tok, name, value);
+        }
+        case KAstMethodDef: {
+            auto tok = token();
+            auto returnType = node();
+            auto name = node();
+            auto parameters = params();
+            auto reciever = param();
+            auto body = node();
+            auto comment = string();
+            auto generics = nodes();
+            return make<MethodDefinition>(tok, returnType, name, parameters,
+                                          reciever, body, std::string(comment),
+                                          generics);
+        }
+        case KAstExternFuncDef: {
+            auto tok = token();
+            auto returnType = node();
+            auto name = node();
+            auto parameters = nodes();
+            auto owner = string();
+            return make<ExternFuncDef>(tok, returnType, name, parameters,
+                                       std::string(owner));
+        }
+        case KAstExternUnion: {
+            auto tok = token();
+            auto elements = pairs();
+            auto name = node();
+            auto owner = string();
+            return make<ExternUnionLiteral>(tok, elements, name,
+                                            std::string(owner));
+        }
+        case KAstExternStruct: {
+            auto tok = token();
+            auto elements = pairs();
+            auto name = node();
+            auto owner = string();
+            return make<ExternStructLiteral>(tok, elements, name,
+                                             std::string(owner));
+        }
+        case KAstCompileTimeExpression: {
+            auto tok = token();
+            auto expression = node();
+            return make<CompileTimeExpression>(tok, expression);
+        }
+        case KAstTernaryFor: {
+            auto tok = token();
+            auto for_value = node();
+            auto for_iterate = node();
+            auto for_variable = nodes();
+            return make<TernaryFor>(tok, for_value, for_iterate, for_variable);
+        }
+        case KAstPrivate: {
+            auto tok = token();
+            auto definition = node();
+            return make<PrivateDef>(tok, definition);
+        }
+        case KAstInlineAsm: {
+            auto tok = token();
+            auto assembly = string();
+            auto output = node();
+            std::vector<std::pair<std::string, AstNodePtr>> inputs(count(2));
+            for (auto& input : inputs) {
+                input.first = string();
+                input.second = node();
+            }
+            return make<InlineAsm>(tok, std::string(assembly), output, inputs);
+        }
+        case KAstLambda: {
+            auto tok = token();
+            auto parameters = params();
+            auto body = node();
+            return make<LambdaDefinition>(tok, parameters, body);
+        }
+        case KAstGenericCall: {
+            auto tok = token();
+            auto generic_types = nodes();
+            auto identifier = node();
+            return make<GenericCall>(tok, generic_types, identifier);
+        }
+        case KAstFormatedStr: {
+            auto tok = token();
+            auto items = nodes();
+            return make<FormatedStr>(tok, items);
+        }
+        default:
+            m_failed = true;
+            return nullptr;
+    }
+}
+
+} // namespace
+
+std::string serialize(AstNodePtr program, uint16_t source) {
+    Writer writer(source);
+    writer.node(program);
+    return writer.finish();
+}
+
+AstNodePtr deserialize(std::string_view data, uint16_t source) {
+    return Reader(data, source).read();
+}
+
+} // namespace ast
@@ -0,0 +1,27 @@
+#ifndef PEREGRINE_SERIALIZE_HPP
+#define PEREGRINE_SERIALIZE_HPP
+
+#include "ast.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ast {
+
+// bumped whenever the layout written by serialize() changes
+constexpr uint32_t serialize_version = 1;
+
+// compact binary form of the tree parsed from `source`. Nodes are written in
+// pre-order and strings go to a table of their own, so every identifier is
+// stored once
+std::string serialize(AstNodePtr program, uint16_t source);
+
+// rebuilds a tree written by serialize() in the current arena without
+// lexing or parsing, its tokens point into `source` which must hold the same
+// text as when it was written. Returns nullptr if `data` is not a tree
+AstNodePtr deserialize(std::string_view data, uint16_t source);
+
+} // namespace ast
+
+#endif
@@ -0,0 +1,173 @@
+#include "stats.hpp"
+#include "flat.hpp"
+
+namespace ast {
+
+KindInfo kind_info(AstKind kind) {
+    switch (kind) {
+        case KAstProgram:
+            return {"Program", sizeof(Program)};
+        case KAstBlockStmt:
+            return {"BlockStatement", sizeof(BlockStatement)};
+        case KAstClassDef:
+            return {"ClassDefinition", sizeof(ClassDefinition)};
+        case KAstImportStmt:
+            return {"ImportStatement", sizeof(ImportStatement)};
+        case KAstFunctionDef:
+            return {"FunctionDefinition", sizeof(FunctionDefinition)};
+        case KAstVariableStmt:
+            return {"VariableStatement", sizeof(VariableStatement)};
+        case KAstConstDecl:
+            return {"ConstDeclaration", sizeof(ConstDeclaration)};
+        case KAstTypeDefinition:
+            return {"TypeDefinition", sizeof(TypeDefinition)};
+        case KAstPassStatement:
+            return {"PassStatement", sizeof(PassStatement)};
+        case KAstIfStmt:
+            return {"IfStatement", sizeof(IfStatement)};
+        case KAstAssertStmt:
+            return {"AssertStatement", sizeof(AssertStatement)};
+        case KAstStatic:
+            return {"StaticStatement", sizeof(StaticStatement)};
+        case KAstExport:
+            return {"ExportStatement", sizeof(ExportStatement)};
+        case KAstInline:
+            return {"InlineStatement", sizeof(InlineStatement)};
+        case KAstRaiseStmt:
+            return {"RaiseStatement", sizeof(RaiseStatement)};
+        case KAstWhileStmt:
+            return {"WhileStatement", sizeof(WhileStatement)};
+        case KAstForStatement:
+            return {"ForStatement", sizeof(ForStatement)};
+        case KAstMatchStmt:
+            return {"MatchStatement", sizeof(MatchStatement)};
+        case KAstScopeStmt:
+            return {"ScopeStatement", sizeof(ScopeStatement)};
+        case KAstReturnStatement:
+            return {"ReturnStatement", sizeof(ReturnStatement)};
+        case KAstContinueStatement:
+            return {"ContinueStatement", sizeof(ContinueStatement)};
+        case KAstBreakStatement:
+            return {"BreakStatement", sizeof(BreakStatement)};
+        case KAstDecorator:
+            return {"DecoratorStatement", sizeof(DecoratorStatement)};
+        case KAstList:
+            return {"ListLiteral", sizeof(ListLiteral)};
+        case KAstDict:
+            return {"DictLiteral", sizeof(DictLiteral)};
+        case KAstListOrDictAccess:
+            return {"ListOrDictAccess", sizeof(ListOrDictAccess)};
+        case KAstBinaryOp:
+            return {"BinaryOperation", sizeof(BinaryOperation)};
+        case KAstPrefixExpr:
+            return {"PrefixExpression", sizeof(PrefixExpression)};
+        case KAstPostfixExpr:
+            return {"PostfixExpression", sizeof(PostfixExpression)};
+        case KAstFunctionCall:
+            return {"FunctionCall", sizeof(FunctionCall)};
+        case KAstDotExpression:
+            return {"DotExpression", sizeof(DotExpression)};
+        case KAstArrowExpression:
+            return {"ArrowExpression", sizeof(ArrowExpression)};
+        case KAstIdentifier:
+            return {"IdentifierExpression", sizeof(IdentifierExpression)};
+        case KAstTypeExpr:
+            return {"TypeExpression", sizeof(TypeExpression)};
+        case KAstListTypeExpr:
+            return {"ListTypeExpr", sizeof(ListTypeExpr)};
+        case KAstFuncTypeExpr:
+            return {"FunctionTypeExpr", sizeof(FunctionTypeExpr)};
+        case KAstNoLiteral:
+            return {"NoLiteral", sizeof(NoLiteral)};
+        case KAstInteger:
+            return {"IntegerLiteral", sizeof(IntegerLiteral)};
+        case KAstDecimal:
+            return {"DecimalLiteral", sizeof(DecimalLiteral)};
+        case KAstString:
+            return {"StringLiteral", sizeof(StringLiteral)};
+        case KAstBool:
+            return {"BoolLiteral", sizeof(BoolLiteral)};
+        case KAstNone:
+            return {"NoneLiteral", sizeof(NoneLiteral)};
+        case KAstUnion:
+            return {"UnionLiteral", sizeof(UnionLiteral)};
+        case KAstEnum:
+            return {"EnumLiteral", sizeof(EnumLiteral)};
+        case KAstWith:
+            return {"WithStatement", sizeof(WithStatement)};
+        case KAstVirtual:
+            return {"VirtualStatement", sizeof(VirtualStatement)};
+        case KAstCast:
+            return {"CastStatement", sizeof(CastStatement)};
+        case KAstPointerTypeExpr:
+            return {"PointerTypeExpr", sizeof(PointerTypeExpr)};
+        case KAstRefTypeExpr:
+            return {"RefTypeExpr", sizeof(RefTypeExpr)};
+        case KAstDefaultArg:
+            return {"DefaultArg", sizeof(DefaultArg)};
+        case KAstTernaryIf:
+            return {"TernaryIf", sizeof(TernaryIf)};
+        case KAstTryExcept:
+            return {"TryExcept", sizeof(TryExcept)};
+        case KAstExpressionTuple:
+            return {"ExpressionTuple", sizeof(ExpressionTuple)};
+        case KAstTypeTuple:
+            return {"TypeTuple", sizeof(TypeTuple)};
+        case KAstExternStatement:
+            return {"ExternStatement", sizeof(ExternStatement)};
+        case KAstSumType:
+            return {"SumType", sizeof(SumType)};
+        case KAstMultipleAssign:
+            return {"MultipleAssign", sizeof(MultipleAssign)};
+        case KAstAugAssign:
+            return {"AugAssign", sizeof(AugAssign)};
+        case KAstMethodDef:
+            return {"MethodDefinition", sizeof(MethodDefinition)};
+        case KAstExternFuncDef:
+            return {"ExternFuncDef", sizeof(ExternFuncDef)};
+        case KAstExternUnion:
+            return {"ExternUnionLiteral", sizeof(ExternUnionLiteral)};
+        case KAstExternStruct:
+            return {"ExternStructLiteral", sizeof(ExternStructLiteral)};
+        case KAstVarArgTypeExpr:
+            return {"VarArgTypeExpr", sizeof(VarArgTypeExpr)};
+        case KAstEllipsesTypeExpr:
+            return {"EllipsesTypeExpr", sizeof(EllipsesTypeExpr)};
+        case KAstVarKwargTypeExpr:
+            return {"VarKwargTypeExpr", sizeof(VarKwargTypeExpr)};
+        case KAstCompileTimeExpression:
+            return {"CompileTimeExpression", sizeof(CompileTimeExpression)};
+        case KAstTernaryFor:
+            return {"TernaryFor", sizeof(TernaryFor)};
+        case KAstPrivate:
+            return {"PrivateDef", sizeof(PrivateDef)};
+        case KAstInlineAsm:
+            return {"InlineAsm", sizeof(InlineAsm)};
+        case KAstLambda:
+            return {"LambdaDefinition", sizeof(LambdaDefinition)};
+        case KAstGenericCall:
+            return {"GenericCall", sizeof(GenericCall)};
+        case KAstFormatedStr:
+            return {"FormatedStr", sizeof(FormatedStr)};
+        case KAstDictTypeExpr:
+            // no node has this kind
+            return {"DictTypeExpr", 0};
+    }
+    return {"", 0};
+}
+
+std::vector<KindStats> kind_stats(AstNodePtr root) {
+    std::vector<KindStats> stats(KAstFormatedStr + 1);
+    std::vector<AstNodePtr> pending = {root};
+    while (!pending.empty()) {
+        AstNodePtr node = pending.back();
+        pending.pop_back();
+        auto& entry = stats[node->type()];
+        entry.count++;
+        entry.bytes += kind_info(node->type()).size;
+        children(node, pending);
+    }
+    return stats;
+}
+
+} // namespace ast
@@ -0,0 +1,29 @@
+#ifndef PEREGRINE_AST_STATS_HPP
+#define PEREGRINE_AST_STATS_HPP
+
+#include "ast.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace ast {
+
+struct KindInfo {
+    std::string_view name; // of the node class
+    size_t size;           // of one node, without the strings and vectors it owns
+};
+
+KindInfo kind_info(AstKind kind);
+
+struct KindStats {
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+// nodes reachable from `root` counted by kind, indexed by AstKind
+std::vector<KindStats> kind_stats(AstNodePtr root);
+
+} // namespace ast
+
+#endif
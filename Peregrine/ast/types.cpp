@@ -82,7 +82,8 @@ TypePtr IntType::prefixOperatorResult(Token op) const {
             return TypeProducer::integer(); // no
 
         case tk_ampersand:
-            return TypeProducer::pointer(std::make_shared<IntType>(*this));
+            return TypeProducer::pointer(
+                TypeProducer::integer(m_intSize, m_modifier));
 
         default:
             return nullptr;
@@ -151,11 +152,12 @@ ast::AstNodePtr IntType::getTypeAst() const {
                 res = "int";
             break;
     }
-    return std::make_shared<ast::TypeExpression>((Token){}, res);
+    return ast::make<ast::TypeExpression>((Token){}, res);
 }
 
 ast::AstNodePtr IntType::defaultValue() const {
-    return std::make_shared<ast::IntegerLiteral>((Token){.keyword="0",.tkType=tk_integer}, "0");
+    static const Token token=TokenUtils::makeToken(tk_integer,"0");
+    return ast::make<ast::IntegerLiteral>(token, "0");
 }
 
 DecimalType::DecimalType(DecimalSize decimalSize) {
@@ -222,7 +224,7 @@ ast::AstNodePtr DecimalType::getTypeAst() const {
             res += "f128";
             break;
     }
-    return std::make_shared<ast::TypeExpression>((Token){}, res);
+    return ast::make<ast::TypeExpression>((Token){}, res);
 }
 
 bool DecimalType::isFloat() const {
@@ -238,7 +240,7 @@ TypePtr DecimalType::prefixOperatorResult(Token op) const {
             return TypeProducer::decimal(); // no
 
         case tk_ampersand:
-            return TypeProducer::pointer(std::make_shared<DecimalType>(*this));
+            return TypeProducer::pointer(TypeProducer::decimal(m_decimalSize));
 
         default:
             return nullptr;
@@ -278,7 +280,8 @@ bool DecimalType::operator==(const Type& type) const {
     return false;
 }
 ast::AstNodePtr DecimalType::defaultValue() const {
-    return std::make_shared<ast::DecimalLiteral>((Token){.keyword="0",.tkType=tk_decimal}, "0");
+    static const Token token=TokenUtils::makeToken(tk_decimal,"0");
+    return ast::make<ast::DecimalLiteral>(token, "0");
 }
 TypeCategory StringType::category() const { return TypeCategory::String; }
 
@@ -340,10 +343,11 @@ TypePtr StringType::infixOperatorResult(Token op, const TypePtr type) const {
     }
 }
 ast::AstNodePtr StringType::getTypeAst() const {
-    return std::make_shared<ast::TypeExpression>((Token){}, "str");
+    return ast::make<ast::TypeExpression>((Token){}, "str");
 }
 ast::AstNodePtr StringType::defaultValue() const {
-    return std::make_shared<ast::StringLiteral>((Token){.keyword="\"\"",.tkType=tk_string}, "\"\"",false);
+    static const Token token=TokenUtils::makeToken(tk_string,"");
+    return ast::make<ast::StringLiteral>(token, "",false);
 }
 TypeCategory BoolType::category() const { return TypeCategory::Bool; }
 
@@ -374,11 +378,12 @@ bool BoolType::isCastableTo(const Type& type) const {
 std::string BoolType::stringify() const { return "bool"; }
 
 ast::AstNodePtr BoolType::getTypeAst() const {
-    return std::make_shared<ast::TypeExpression>((Token){}, "bool");
+    return ast::make<ast::TypeExpression>((Token){}, "bool");
 }
 
 ast::AstNodePtr BoolType::defaultValue() const {
-    return std::make_shared<ast::BoolLiteral>((Token){.keyword="False",.tkType=tk_false}, "False");
+    static const Token token=TokenUtils::makeToken(tk_false,"False");
+    return ast::make<ast::BoolLiteral>(token, "False");
 }
 
 PointerType::PointerType(TypePtr baseType) { m_baseType = baseType; }
@@ -428,7 +433,7 @@ TypePtr PointerType::prefixOperatorResult(Token op) const {
             return m_baseType;
 
         case tk_ampersand:
-            return TypeProducer::pointer(std::make_shared<PointerType>(*this));
+            return TypeProducer::pointer(TypeProducer::pointer(m_baseType));
 
         default:
             return nullptr;
@@ -457,11 +462,12 @@ TypePtr PointerType::infixOperatorResult(Token op, const TypePtr type) const {
 }
 
 ast::AstNodePtr PointerType::getTypeAst() const {
-    return std::make_shared<ast::PointerTypeExpr>((Token){}, m_baseType->getTypeAst());
+    return ast::make<ast::PointerTypeExpr>((Token){}, m_baseType->getTypeAst());
 }
 
 ast::AstNodePtr PointerType::defaultValue() const {
-    return std::make_shared<ast::NoneLiteral>((Token){.keyword="None",.tkType=tk_none});
+    static const Token token=TokenUtils::makeToken(tk_none,"None");
+    return ast::make<ast::NoneLiteral>(token);
 }
 
 TypeCategory VoidType::category() const { return TypeCategory::Void; }
@@ -473,10 +479,10 @@ bool VoidType::isCastableTo(const Type& type) const { return false; }
 std::string VoidType::stringify() const { return "void"; }
 
 ast::AstNodePtr VoidType::getTypeAst() const {
-    return std::make_shared<ast::TypeExpression>((Token){}, "void");
+    return ast::make<ast::TypeExpression>((Token){}, "void");
 }
 ast::AstNodePtr VoidType::defaultValue() const {
-    return std::make_shared<ast::NoLiteral>();
+    return ast::make<ast::NoLiteral>();
 }
 ListType::ListType(TypePtr elemType, std::string size) {
     m_elemType = elemType;
@@ -537,17 +543,17 @@ bool ListType::operator==(const Type& type) const {
 }
 
 ast::AstNodePtr ListType::getTypeAst() const {
-    ast::AstNodePtr size;
+    ast::AstNodePtr size = nullptr;
     if(m_size=="-1"){
-        size=std::make_shared<ast::NoLiteral>();
+        size=ast::make<ast::NoLiteral>();
     }
     else{
-        size=std::make_shared<ast::IntegerLiteral>((Token){}, m_size);
+        size=ast::make<ast::IntegerLiteral>((Token){}, m_size);
     }
-    return std::make_shared<ast::ListTypeExpr>((Token){}, m_elemType->getTypeAst(),size);
+    return ast::make<ast::ListTypeExpr>((Token){}, m_elemType->getTypeAst(),size);
 }
 ast::AstNodePtr ListType::defaultValue() const {
-    return std::make_shared<ast::ListLiteral>((Token){});
+    return ast::make<ast::ListLiteral>((Token){});
 }
 UserDefinedType::UserDefinedType(TypePtr baseType) { m_baseType = baseType; }
 
@@ -594,22 +600,31 @@ const std::vector<TypePtr>& FunctionType::parameterTypes() const {
 
 TypePtr FunctionType::returnType() const { return m_returnType; }
 
+// a part of a function type that is not known only matches itself
+static bool same(const TypePtr& a, const TypePtr& b) {
+    if (a == NULL || b == NULL)
+        return a == b;
+    return *a == *b;
+}
+
+static bool convertible(const TypePtr& from, const TypePtr& to) {
+    if (from == NULL || to == NULL)
+        return from == to;
+    return from->isConvertibleTo(*to) || to->isConvertibleTo(*from);
+}
+
 bool FunctionType::isConvertibleTo(const Type& type) const {
     if (type.category() != TypeCategory::Function)
         return false;
 
     auto& funcType = dynamic_cast<const FunctionType&>(type);
 
-    if (!m_returnType->isConvertibleTo(*funcType.returnType()) &&
-        !funcType.returnType()->isConvertibleTo(*m_returnType))
+    if (!convertible(m_returnType, funcType.returnType()) ||
+        funcType.parameterTypes().size() != m_parameterTypes.size())
         return false;
 
     for (size_t i = 0; i < m_parameterTypes.size(); i++) {
-        auto& thisParamType = *m_parameterTypes[i];
-        auto& thatParamType = *funcType.parameterTypes()[i];
-
-        if (!thisParamType.isConvertibleTo(thatParamType) &&
-            !thatParamType.isConvertibleTo(thisParamType))
+        if (!convertible(m_parameterTypes[i], funcType.parameterTypes()[i]))
             return false;
     }
 
@@ -619,14 +634,14 @@ bool FunctionType::isConvertibleTo(const Type& type) const {
 // TODO
 bool FunctionType::isCastableTo(const Type& type) const { return false; }
 // TODO
-ast::AstNodePtr FunctionType::defaultValue() const {return std::make_shared<ast::NoLiteral>();}
+ast::AstNodePtr FunctionType::defaultValue() const {return ast::make<ast::NoLiteral>();}
 std::string FunctionType::stringify() const { return "function"; }
 
 ast::AstNodePtr FunctionType::getTypeAst() const {
     std::vector<ast::AstNodePtr> params;
     for (auto& paramType : m_parameterTypes)
         params.push_back(paramType->getTypeAst());
-    return std::make_shared<ast::FunctionTypeExpr>((Token){},params, m_returnType->getTypeAst());
+    return ast::make<ast::FunctionTypeExpr>((Token){},params, m_returnType->getTypeAst());
 }
 
 bool FunctionType::operator==(const Type& type) const {
@@ -634,12 +649,12 @@ bool FunctionType::operator==(const Type& type) const {
         return false;
 
     auto& funcType = dynamic_cast<const FunctionType&>(type);
-    if (funcType.returnType()->operator!=(*m_returnType) ||
+    if (!same(funcType.returnType(), m_returnType) ||
         funcType.parameterTypes().size() != m_parameterTypes.size())
         return false;
 
     for (size_t i = 0; i < m_parameterTypes.size(); i++) {
-        if (*m_parameterTypes[i] != *funcType.parameterTypes()[i])
+        if (!same(m_parameterTypes[i], funcType.parameterTypes()[i]))
             return false;
     }
 
@@ -654,7 +669,7 @@ ast::AstNodePtr MultipleReturnType::getTypeAst() const{
     std::vector<ast::AstNodePtr> params;
     for (auto& paramType : m_returnTypes)
         params.push_back(paramType->getTypeAst());
-    return std::make_shared<ast::TypeTuple>(params);
+    return ast::make<ast::TypeTuple>(params);
 }
 
 TypeCategory MultipleReturnType::category() const{
@@ -719,7 +734,7 @@ EnumType::EnumType(std::string name,std::vector<std::string> items,std::string c
 }
 
 ast::AstNodePtr EnumType::getTypeAst() const{
-    return std::make_shared<ast::TypeExpression>((Token){},m_name.c_str());
+    return ast::make<ast::TypeExpression>((Token){},m_name.c_str());
 }
 
 TypeCategory EnumType::category() const{
@@ -753,9 +768,9 @@ bool EnumType::isCastableTo(const Type& type) const{
 }
 
 ast::AstNodePtr EnumType::defaultValue() const{
-    auto owner=std::make_shared<ast::IdentifierExpression>((Token){},m_name.c_str());
-    auto reference=std::make_shared<ast::IdentifierExpression>((Token){},m_items[0].c_str());
-    return std::make_shared<ast::DotExpression>((Token){},owner,reference);
+    auto owner=ast::make<ast::IdentifierExpression>((Token){},m_name.c_str());
+    auto reference=ast::make<ast::IdentifierExpression>((Token){},m_items[0].c_str());
+    return ast::make<ast::DotExpression>((Token){},owner,reference);
 }
 
 std::string EnumType::stringify() const{
@@ -797,7 +812,7 @@ UnionTypeDef::UnionTypeDef(std::string name,std::map<std::string,TypePtr> items)
 }
 
 ast::AstNodePtr UnionTypeDef::getTypeAst() const{
-    return std::make_shared<ast::TypeExpression>((Token){},m_name.c_str());
+    return ast::make<ast::TypeExpression>((Token){},m_name.c_str());
 }
 
 TypeCategory UnionTypeDef::category() const{
@@ -851,7 +866,7 @@ bool UnionTypeDef::operator==(const Type& type) const{
 }
 
 ast::AstNodePtr UnionTypeDef::defaultValue() const{
-    return std::make_shared<ast::NoLiteral>();
+    return ast::make<ast::NoLiteral>();
 }
 
 std::array<TypePtr, 8> TypeProducer::m_integer = {
@@ -869,14 +884,31 @@ std::array<TypePtr, 8> TypeProducer::m_integer = {
                               IntType::Modifier::Unsigned)};
 
 std::array<TypePtr, 3> TypeProducer::m_decimal = {
-    std::make_shared<DecimalType>(DecimalType::DecimalSize::Float64),
     std::make_shared<DecimalType>(DecimalType::DecimalSize::Float32),
+    std::make_shared<DecimalType>(DecimalType::DecimalSize::Float64),
     std::make_shared<DecimalType>(DecimalType::DecimalSize::Float128)};
 
 TypePtr TypeProducer::m_bool = std::make_shared<BoolType>();
 TypePtr TypeProducer::m_string = std::make_shared<StringType>();
 TypePtr TypeProducer::m_void = std::make_shared<VoidType>();
 
+std::map<const Type*, TypePtr> TypeProducer::m_pointers;
+std::map<const Type*, TypePtr> TypeProducer::m_userDefined;
+std::map<std::pair<const Type*, std::string>, TypePtr> TypeProducer::m_lists;
+std::map<std::vector<const Type*>, TypePtr> TypeProducer::m_functions;
+std::map<std::vector<const Type*>, TypePtr> TypeProducer::m_multipleReturns;
+std::map<std::tuple<std::string, std::vector<std::string>, std::string>,
+         TypePtr>
+    TypeProducer::m_enums;
+std::map<
+    std::pair<std::string, std::vector<std::pair<std::string, const Type*>>>,
+    TypePtr>
+    TypeProducer::m_unions;
+std::unordered_map<std::pair<const Type*, const Type*>, bool,
+                   TypeProducer::PairHash>
+    TypeProducer::m_convertible;
+std::mutex TypeProducer::m_mutex;
+
 TypePtr TypeProducer::integer(IntType::IntSizes intSize,
                               IntType::Modifier modifier) {
     if (modifier == IntType::Modifier::Signed) {
@@ -897,24 +929,86 @@ TypePtr TypeProducer::string() { return m_string; }
 TypePtr TypeProducer::voidT() { return m_void; }
 
 TypePtr TypeProducer::list(TypePtr elemType, std::string size) {
-    return std::make_shared<ListType>(elemType, size);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& type = m_lists[{elemType.get(), size}];
+    if (!type)
+        type = std::make_shared<ListType>(elemType, size);
+    return type;
 }
 
 TypePtr TypeProducer::function(std::vector<TypePtr> parameterTypes, TypePtr returnType){
-    return std::make_shared<FunctionType>(parameterTypes, returnType);
+    std::vector<const Type*> key;
+    key.reserve(parameterTypes.size() + 1);
+    key.push_back(returnType.get());
+    for (auto& param : parameterTypes)
+        key.push_back(param.get());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& type = m_functions[key];
+    if (!type)
+        type = std::make_shared<FunctionType>(parameterTypes, returnType);
+    return type;
 }
 
 TypePtr TypeProducer::pointer(TypePtr baseType) {
-    return std::make_shared<PointerType>(baseType);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& type = m_pointers[baseType.get()];
+    if (!type)
+        type = std::make_shared<PointerType>(baseType);
+    return type;
 }
 TypePtr TypeProducer::multipleReturn(std::vector<TypePtr> returnTypes){
-    return std::make_shared<MultipleReturnType>(returnTypes);
+    std::vector<const Type*> key;
+    key.reserve(returnTypes.size());
+    for (auto& returnType : returnTypes)
+        key.push_back(returnType.get());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& type = m_multipleReturns[key];
+    if (!type)
+        type = std::make_shared<MultipleReturnType>(returnTypes);
+    return type;
 }
 TypePtr TypeProducer::enumT(std::string name,std::vector<std::string> items,std::string curr_value){
-    return std::make_shared<EnumType>(name,items,curr_value);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& type = m_enums[{name, items, curr_value}];
+    if (!type)
+        type = std::make_shared<EnumType>(name, items, curr_value);
+    return type;
 }
 TypePtr TypeProducer::unionT(std::string name,std::map<std::string,TypePtr> items){
-    return std::make_shared<UnionTypeDef>(name,items);
+    std::vector<std::pair<std::string, const Type*>> key;
+    key.reserve(items.size());
+    for (auto& item : items)
+        key.emplace_back(item.first, item.second.get());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& type = m_unions[{name, key}];
+    if (!type)
+        type = std::make_shared<UnionTypeDef>(name, items);
+    return type;
+}
+TypePtr TypeProducer::userDefined(TypePtr baseType) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& type = m_userDefined[baseType.get()];
+    if (!type)
+        type = std::make_shared<UserDefinedType>(baseType);
+    return type;
+}
+
+bool TypeProducer::isConvertible(const Type& from, const Type& to) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_convertible.find({&from, &to});
+        if (it != m_convertible.end())
+            return it->second;
+    }
+    // computed without the lock, another thread may get the same answer
+    // meanwhile
+    bool convertible = from.isConvertibleTo(to);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_convertible.emplace(std::make_pair(&from, &to), convertible);
+    return convertible;
 }
 std::map<std::string, TypePtr> identifierToTypeMap = {
     {"i8", TypeProducer::integer(IntType::IntSizes::Int8)},
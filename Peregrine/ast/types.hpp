@@ -6,12 +6,16 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace ast{
     class AstNode;
-    using AstNodePtr = std::shared_ptr<AstNode>;
+    using AstNodePtr = AstNode*;
 }
 
 namespace types {
@@ -51,7 +55,8 @@ class Type {
     // using cast)
     virtual bool isCastableTo(const Type& type) const = 0;
 
-    //some default value for the type
+    //some default value for the type, a new node on every call. It is
+    //called from the threads that check function bodies as well
     virtual ast::AstNodePtr defaultValue() const = 0;
 
     virtual std::string stringify() const { return ""; }
@@ -74,7 +79,11 @@ class Type {
         return category() == type.category();
     }
 
-    bool operator!=(const Type& type) const { return !operator==(type); }
+    // types from TypeProducer are unique, the same instance is always equal
+    // to itself and only different ones have to be compared
+    bool operator!=(const Type& type) const {
+        return this != &type && !operator==(type);
+    }
 };
 
 class IntType : public Type {
@@ -303,6 +312,10 @@ class UnionTypeDef : public Type {
     std::string m_name;
 };
 
+// every type is built here and structurally equal types share one instance,
+// so the type checker does not allocate for the types it derives and can key
+// caches by address. The instances live until the program exits, and the
+// functions can be called from several threads
 class TypeProducer {
     static std::array<TypePtr, 8> m_integer;
     static std::array<TypePtr, 3> m_decimal;
@@ -311,6 +324,35 @@ class TypeProducer {
     static TypePtr m_string;
     static TypePtr m_void;
 
+    // the types built from other types are keyed by the address of their
+    // parts, which are unique themselves
+    static std::map<const Type*, TypePtr> m_pointers;
+    static std::map<const Type*, TypePtr> m_userDefined;
+    static std::map<std::pair<const Type*, std::string>, TypePtr> m_lists;
+    // the return type comes first, then the parameters
+    static std::map<std::vector<const Type*>, TypePtr> m_functions;
+    static std::map<std::vector<const Type*>, TypePtr> m_multipleReturns;
+    static std::map<
+        std::tuple<std::string, std::vector<std::string>, std::string>, TypePtr>
+        m_enums;
+    static std::map<std::pair<std::string,
+                              std::vector<std::pair<std::string, const Type*>>>,
+                    TypePtr>
+        m_unions;
+
+    struct PairHash {
+        size_t operator()(std::pair<const Type*, const Type*> key) const {
+            return std::hash<const Type*>()(key.first) * 31 +
+                   std::hash<const Type*>()(key.second);
+        }
+    };
+    static std::unordered_map<std::pair<const Type*, const Type*>, bool,
+                              PairHash>
+        m_convertible;
+
+    // guards the tables above
+    static std::mutex m_mutex;
+
   public:
     static TypePtr
     integer(IntType::IntSizes intSize = IntType::IntSizes::Int64,
@@ -326,6 +368,10 @@ class TypeProducer {
     static TypePtr pointer(TypePtr baseType);
     static TypePtr enumT(std::string name,std::vector<std::string> items,std::string curr_value="");
     static TypePtr unionT(std::string name,std::map<std::string,TypePtr> items);
+    static TypePtr userDefined(TypePtr baseType);
+
+    // from.isConvertibleTo(to), remembered for every pair asked before
+    static bool isConvertible(const Type& from, const Type& to);
 };
 
 extern std::map<std::string, TypePtr> identifierToTypeMap;
@@ -5,85 +5,332 @@
 
 namespace ast {
 
-class AstVisitor {
+// base of the passes over the ast. A pass derives from Visitor<Pass>, brings
+// these defaults in with `using Visitor<Pass>::visit` and overloads visit for
+// the nodes it handles. accept() picks the overload with a switch on the kind
+// of the node and a static_cast, so there is no virtual call per node.
+// When visit returns false for a program, block or class, accept goes on
+// into its statements.
+template <typename Derived> class Visitor {
   public:
-    virtual ~AstVisitor() = default;
-
-    virtual bool visit(const Program& node) { return false; };
-    virtual bool visit(const BlockStatement& node) { return false; };
-    virtual bool visit(const ClassDefinition& node){ return false; }
-    virtual bool visit(const ImportStatement& node) { return false; };
-    virtual bool visit(const FunctionDefinition& node) { return false; };
-    virtual bool visit(const VariableStatement& node) { return false; };
-    virtual bool visit(const ConstDeclaration& node) { return false; };
-    virtual bool visit(const TypeDefinition& node) { return false; };
-    virtual bool visit(const PassStatement& node) { return false; };
-    virtual bool visit(const IfStatement& node) { return false; };
-    virtual bool visit(const AssertStatement& node) { return false; };
-    virtual bool visit(const StaticStatement& node) { return false; };
-    virtual bool visit(const ExportStatement& node) { return false; };
-    virtual bool visit(const InlineStatement& node) { return false; };
-    virtual bool visit(const RaiseStatement& node) { return false; };
-    virtual bool visit(const WhileStatement& node) { return false; };
-    virtual bool visit(const ForStatement& node) { return false; };
-    virtual bool visit(const MatchStatement& node) { return false; };
-    virtual bool visit(const ScopeStatement& node) { return false; };
-    virtual bool visit(const ReturnStatement& node) { return false; };
-    virtual bool visit(const ContinueStatement& node) { return false; };
-    virtual bool visit(const BreakStatement& node) { return false; };
-    virtual bool visit(const DecoratorStatement& node) { return false; };
-    virtual bool visit(const ListLiteral& node) { return false; };
-    virtual bool visit(const DictLiteral& node) { return false; };
-    virtual bool visit(const ListOrDictAccess& node) { return false; };
-    virtual bool visit(const BinaryOperation& node) { return false; };
-    virtual bool visit(const PrefixExpression& node) { return false; };
-    virtual bool visit(const PostfixExpression& node) { return false; };
-    virtual bool visit(const FunctionCall& node) { return false; };
-    virtual bool visit(const DotExpression& node) { return false; };
-    virtual bool visit(const ArrowExpression& node) { return false; };
-    virtual bool visit(const IdentifierExpression& node) { return false; };
-    virtual bool visit(const TypeExpression& node) { return false; };
-    virtual bool visit(const ListTypeExpr& node) { return false; };
-    virtual bool visit(const FunctionTypeExpr& node) { return false; };
-    virtual bool visit(const NoLiteral& node) { return false; };
-    virtual bool visit(const IntegerLiteral& node) { return false; };
-    virtual bool visit(const DecimalLiteral& node) { return false; };
-    virtual bool visit(const StringLiteral& node) { return false; };
-    virtual bool visit(const BoolLiteral& node) { return false; };
-    virtual bool visit(const NoneLiteral& node) { return false; };
-    virtual bool visit(const UnionLiteral& node) { return false; };
-    virtual bool visit(const EnumLiteral& node) { return false; };
-    virtual bool visit(const WithStatement& node) { return false; };
-    virtual bool visit(const VirtualStatement& node) { return false; };
-    virtual bool visit(const CastStatement& node) { return false; };
-    virtual bool visit(const PointerTypeExpr& node) { return false; };
-    virtual bool visit(const RefTypeExpr& node) { return false; };
-    virtual bool visit(const DefaultArg& node) { return false; };
-    virtual bool visit(const TernaryIf& node) { return false; };
-    virtual bool visit(const TryExcept& node) { return false; };
-    virtual bool visit(const ExpressionTuple& node) { return false; };
-    virtual bool visit(const TypeTuple& node) { return false; };
-    virtual bool visit(const ExternStatement& node) { return false; };
-    virtual bool visit(const SumType& node) { return false; };
-    virtual bool visit(const MultipleAssign& node) { return false; };
-    virtual bool visit(const AugAssign& node) { return false; };
-    virtual bool visit(const MethodDefinition& node) { return false; };
-    virtual bool visit(const ExternFuncDef& node) { return false; };
-    virtual bool visit(const ExternUnionLiteral& node) { return false; };
-    virtual bool visit(const ExternStructLiteral& node) { return false; };
-    virtual bool visit(const VarArgTypeExpr& node) { return false; };
-    virtual bool visit(const EllipsesTypeExpr& node) { return false; };
-    virtual bool visit(const VarKwargTypeExpr& node) { return false; };
-    virtual bool visit(const CompileTimeExpression& node) { return false; };
-    virtual bool visit(const TernaryFor& node) { return false; };
-    virtual bool visit(const PrivateDef& node) { return false; };
-    virtual bool visit(const InlineAsm& node) { return false; };
-    virtual bool visit(const LambdaDefinition& node) { return false; };
-    virtual bool visit(const GenericCall& node) { return false; };
-    virtual bool visit(const FormatedStr& node) {return false;}
+    bool visit(const Program& node) { return false; }
+    bool visit(const BlockStatement& node) { return false; }
+    bool visit(const ClassDefinition& node) { return false; }
+    bool visit(const ImportStatement& node) { return false; }
+    bool visit(const FunctionDefinition& node) { return false; }
+    bool visit(const VariableStatement& node) { return false; }
+    bool visit(const ConstDeclaration& node) { return false; }
+    bool visit(const TypeDefinition& node) { return false; }
+    bool visit(const PassStatement& node) { return false; }
+    bool visit(const IfStatement& node) { return false; }
+    bool visit(const AssertStatement& node) { return false; }
+    bool visit(const StaticStatement& node) { return false; }
+    bool visit(const ExportStatement& node) { return false; }
+    bool visit(const InlineStatement& node) { return false; }
+    bool visit(const RaiseStatement& node) { return false; }
+    bool visit(const WhileStatement& node) { return false; }
+    bool visit(const ForStatement& node) { return false; }
+    bool visit(const MatchStatement& node) { return false; }
+    bool visit(const ScopeStatement& node) { return false; }
+    bool visit(const ReturnStatement& node) { return false; }
+    bool visit(const ContinueStatement& node) { return false; }
+    bool visit(const BreakStatement& node) { return false; }
+    bool visit(const DecoratorStatement& node) { return false; }
+    bool visit(const ListLiteral& node) { return false; }
+    bool visit(const DictLiteral& node) { return false; }
+    bool visit(const ListOrDictAccess& node) { return false; }
+    bool visit(const BinaryOperation& node) { return false; }
+    bool visit(const PrefixExpression& node) { return false; }
+    bool visit(const PostfixExpression& node) { return false; }
+    bool visit(const FunctionCall& node) { return false; }
+    bool visit(const DotExpression& node) { return false; }
+    bool visit(const ArrowExpression& node) { return false; }
+    bool visit(const IdentifierExpression& node) { return false; }
+    bool visit(const TypeExpression& node) { return false; }
+    bool visit(const ListTypeExpr& node) { return false; }
+    bool visit(const FunctionTypeExpr& node) { return false; }
+    bool visit(const NoLiteral& node) { return false; }
+    bool visit(const IntegerLiteral& node) { return false; }
+    bool visit(const DecimalLiteral& node) { return false; }
+    bool visit(const StringLiteral& node) { return false; }
+    bool visit(const BoolLiteral& node) { return false; }
+    bool visit(const NoneLiteral& node) { return false; }
+    bool visit(const UnionLiteral& node) { return false; }
+    bool visit(const EnumLiteral& node) { return false; }
+    bool visit(const WithStatement& node) { return false; }
+    bool visit(const VirtualStatement& node) { return false; }
+    bool visit(const CastStatement& node) { return false; }
+    bool visit(const PointerTypeExpr& node) { return false; }
+    bool visit(const RefTypeExpr& node) { return false; }
+    bool visit(const DefaultArg& node) { return false; }
+    bool visit(const TernaryIf& node) { return false; }
+    bool visit(const TryExcept& node) { return false; }
+    bool visit(const ExpressionTuple& node) { return false; }
+    bool visit(const TypeTuple& node) { return false; }
+    bool visit(const ExternStatement& node) { return false; }
+    bool visit(const SumType& node) { return false; }
+    bool visit(const MultipleAssign& node) { return false; }
+    bool visit(const AugAssign& node) { return false; }
+    bool visit(const MethodDefinition& node) { return false; }
+    bool visit(const ExternFuncDef& node) { return false; }
+    bool visit(const ExternUnionLiteral& node) { return false; }
+    bool visit(const ExternStructLiteral& node) { return false; }
+    bool visit(const VarArgTypeExpr& node) { return false; }
+    bool visit(const EllipsesTypeExpr& node) { return false; }
+    bool visit(const VarKwargTypeExpr& node) { return false; }
+    bool visit(const CompileTimeExpression& node) { return false; }
+    bool visit(const TernaryFor& node) { return false; }
+    bool visit(const PrivateDef& node) { return false; }
+    bool visit(const InlineAsm& node) { return false; }
+    bool visit(const LambdaDefinition& node) { return false; }
+    bool visit(const GenericCall& node) { return false; }
+    bool visit(const FormatedStr& node) { return false; }
 
+    void accept(AstNodePtr node);
 };
 
+template <typename Derived> void Visitor<Derived>::accept(AstNodePtr node) {
+    auto& pass = static_cast<Derived&>(*this);
+    switch (node->type()) {
+        case KAstProgram: {
+            auto& program = static_cast<const Program&>(*node);
+            if (!pass.visit(program))
+                for (auto& stmt : program.statements())
+                    accept(stmt);
+            break;
+        }
+        case KAstBlockStmt: {
+            auto& block = static_cast<const BlockStatement&>(*node);
+            if (!pass.visit(block))
+                for (auto& stmt : block.statements())
+                    accept(stmt);
+            break;
+        }
+        case KAstClassDef: {
+            auto& class_ = static_cast<const ClassDefinition&>(*node);
+            if (!pass.visit(class_)) {
+                for (auto& stmt : class_.attributes())
+                    accept(stmt);
+                for (auto& stmt : class_.methods())
+                    accept(stmt);
+                for (auto& stmt : class_.other())
+                    accept(stmt);
+            }
+            break;
+        }
+        case KAstImportStmt:
+            pass.visit(static_cast<const ImportStatement&>(*node));
+            break;
+        case KAstFunctionDef:
+            pass.visit(static_cast<const FunctionDefinition&>(*node));
+            break;
+        case KAstVariableStmt:
+            pass.visit(static_cast<const VariableStatement&>(*node));
+            break;
+        case KAstConstDecl:
+            pass.visit(static_cast<const ConstDeclaration&>(*node));
+            break;
+        case KAstTypeDefinition:
+            pass.visit(static_cast<const TypeDefinition&>(*node));
+            break;
+        case KAstPassStatement:
+            pass.visit(static_cast<const PassStatement&>(*node));
+            break;
+        case KAstIfStmt:
+            pass.visit(static_cast<const IfStatement&>(*node));
+            break;
+        case KAstAssertStmt:
+            pass.visit(static_cast<const AssertStatement&>(*node));
+            break;
+        case KAstStatic:
+            pass.visit(static_cast<const StaticStatement&>(*node));
+            break;
+        case KAstExport:
+            pass.visit(static_cast<const ExportStatement&>(*node));
+            break;
+        case KAstInline:
+            pass.visit(static_cast<const InlineStatement&>(*node));
+            break;
+        case KAstRaiseStmt:
+            pass.visit(static_cast<const RaiseStatement&>(*node));
+            break;
+        case KAstWhileStmt:
+            pass.visit(static_cast<const WhileStatement&>(*node));
+            break;
+        case KAstForStatement:
+            pass.visit(static_cast<const ForStatement&>(*node));
+            break;
+        case KAstMatchStmt:
+            pass.visit(static_cast<const MatchStatement&>(*node));
+            break;
+        case KAstScopeStmt:
+            pass.visit(static_cast<const ScopeStatement&>(*node));
+            break;
+        case KAstReturnStatement:
+            pass.visit(static_cast<const ReturnStatement&>(*node));
+            break;
+        case KAstContinueStatement:
+            pass.visit(static_cast<const ContinueStatement&>(*node));
+            break;
+        case KAstBreakStatement:
+            pass.visit(static_cast<const BreakStatement&>(*node));
+            break;
+        case KAstDecorator:
+            pass.visit(static_cast<const DecoratorStatement&>(*node));
+            break;
+        case KAstList:
+            pass.visit(static_cast<const ListLiteral&>(*node));
+            break;
+        case KAstDict:
+            pass.visit(static_cast<const DictLiteral&>(*node));
+            break;
+        case KAstListOrDictAccess:
+            pass.visit(static_cast<const ListOrDictAccess&>(*node));
+            break;
+        case KAstBinaryOp:
+            pass.visit(static_cast<const BinaryOperation&>(*node));
+            break;
+        case KAstPrefixExpr:
+            pass.visit(static_cast<const PrefixExpression&>(*node));
+            break;
+        case KAstPostfixExpr:
+            pass.visit(static_cast<const PostfixExpression&>(*node));
+            break;
+        case KAstFunctionCall:
+            pass.visit(static_cast<const FunctionCall&>(*node));
+            break;
+        case KAstDotExpression:
+            pass.visit(static_cast<const DotExpression&>(*node));
+            break;
+        case KAstArrowExpression:
+            pass.visit(static_cast<const ArrowExpression&>(*node));
+            break;
+        case KAstIdentifier:
+            pass.visit(static_cast<const IdentifierExpression&>(*node));
+            break;
+        case KAstTypeExpr:
+            pass.visit(static_cast<const TypeExpression&>(*node));
+            break;
+        case KAstListTypeExpr:
+            pass.visit(static_cast<const ListTypeExpr&>(*node));
+            break;
+        case KAstFuncTypeExpr:
+            pass.visit(static_cast<const FunctionTypeExpr&>(*node));
+            break;
+        case KAstNoLiteral:
+            pass.visit(static_cast<const NoLiteral&>(*node));
+            break;
+        case KAstInteger:
+            pass.visit(static_cast<const IntegerLiteral&>(*node));
+            break;
+        case KAstDecimal:
+            pass.visit(static_cast<const DecimalLiteral&>(*node));
+            break;
+        case KAstString:
+            pass.visit(static_cast<const StringLiteral&>(*node));
+            break;
+        case KAstBool:
+            pass.visit(static_cast<const BoolLiteral&>(*node));
+            break;
+        case KAstNone:
+            pass.visit(static_cast<const NoneLiteral&>(*node));
+            break;
+        case KAstUnion:
+            pass.visit(static_cast<const UnionLiteral&>(*node));
+            break;
+        case KAstEnum:
+            pass.visit(static_cast<const EnumLiteral&>(*node));
+            break;
+        case KAstWith:
+            pass.visit(static_cast<const WithStatement&>(*node));
+            break;
+        case KAstVirtual:
+            pass.visit(static_cast<const VirtualStatement&>(*node));
+            break;
+        case KAstCast:
+            pass.visit(static_cast<const CastStatement&>(*node));
+            break;
+        case KAstPointerTypeExpr:
+            pass.visit(static_cast<const PointerTypeExpr&>(*node));
+            break;
+        case KAstRefTypeExpr:
+            pass.visit(static_cast<const RefTypeExpr&>(*node));
+            break;
+        case KAstDefaultArg:
+            pass.visit(static_cast<const DefaultArg&>(*node));
+            break;
+        case KAstTernaryIf:
+            pass.visit(static_cast<const TernaryIf&>(*node));
+            break;
+        case KAstTryExcept:
+            pass.visit(static_cast<const TryExcept&>(*node));
+            break;
+        case KAstExpressionTuple:
+            pass.visit(static_cast<const ExpressionTuple&>(*node));
+            break;
+        case KAstTypeTuple:
+            pass.visit(static_cast<const TypeTuple&>(*node));
+            break;
+        case KAstExternStatement:
+            pass.visit(static_cast<const ExternStatement&>(*node));
+            break;
+        case KAstSumType:
+            pass.visit(static_cast<const SumType&>(*node));
+            break;
+        case KAstMultipleAssign:
+            pass.visit(static_cast<const MultipleAssign&>(*node));
+            break;
+        case KAstAugAssign:
+            pass.visit(static_cast<const AugAssign&>(*node));
+            break;
+        case KAstMethodDef:
+            pass.visit(static_cast<const MethodDefinition&>(*node));
+            break;
+        case KAstExternFuncDef:
+            pass.visit(static_cast<const ExternFuncDef&>(*node));
+            break;
+        case KAstExternUnion:
+            pass.visit(static_cast<const ExternUnionLiteral&>(*node));
+            break;
+        case KAstExternStruct:
+            pass.visit(static_cast<const ExternStructLiteral&>(*node));
+            break;
+        case KAstVarArgTypeExpr:
+            pass.visit(static_cast<const VarArgTypeExpr&>(*node));
+            break;
+        case KAstEllipsesTypeExpr:
+            pass.visit(static_cast<const EllipsesTypeExpr&>(*node));
+            break;
+        case KAstVarKwargTypeExpr:
+            pass.visit(static_cast<const VarKwargTypeExpr&>(*node));
+            break;
+        case KAstCompileTimeExpression:
+            pass.visit(static_cast<const CompileTimeExpression&>(*node));
+            break;
+        case KAstTernaryFor:
+            pass.visit(static_cast<const TernaryFor&>(*node));
+            break;
+        case KAstPrivate:
+            pass.visit(static_cast<const PrivateDef&>(*node));
+            break;
+        case KAstInlineAsm:
+            pass.visit(static_cast<const InlineAsm&>(*node));
+            break;
+        case KAstLambda:
+            pass.visit(static_cast<const LambdaDefinition&>(*node));
+            break;
+        case KAstGenericCall:
+            pass.visit(static_cast<const GenericCall&>(*node));
+            break;
+        case KAstFormatedStr:
+            pass.visit(static_cast<const FormatedStr&>(*node));
+            break;
+        case KAstDictTypeExpr:
+            // no node has this kind
+            break;
+    }
+}
+
 } // namespace ast
 
 #endif
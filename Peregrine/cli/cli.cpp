@@ -1,4 +1,7 @@
 #include "cli.hpp"
+#include "lexer/source.hpp"
+#include <filesystem>
+#include <sys/stat.h>
 #define println(x) std::cout << x << "\n"
 namespace cli{ 
     void help() {
@@ -18,9 +21,13 @@ namespace cli{
         println("\t-js              - generates javascript code");
         println("\t-html            - generates javascript code and embeds it in html");
         println("\t-doc_html        - generates html docs for a module");
+        println("\t-no_cache        - parse the file again instead of reusing the cached tree");
+        println("\t-mem_report      - print where the memory of the compiler went");
+        println("\t-stream          - generate C++ one statement at a time, for files too large to hold in memory");
         println("\t-o <output file> - select the output file");
         println("\nExample:");
         println("\tperegrine compile example.pe -o example");
+        println("\tperegrine compile - -emit_cpp -o example.cpp < example.pe");
     }
     CLI::CLI(int argc, char** argv){
         for (int i = 1; i < argc; ++i) {
@@ -53,6 +60,12 @@ namespace cli{
                 m_state.emit_html = true;
             }else if (curr_arg=="-doc_html"){
                 m_state.doc_html = true;
+            }else if (curr_arg=="-no_cache"){
+                m_state.use_cache = false;
+            }else if (curr_arg=="-mem_report"){
+                m_state.mem_report = true;
+            }else if (curr_arg=="-stream"){
+                m_state.stream = true;
             }else if(curr_arg=="-release"){
                 m_state.cpp_arg+=" -O2 ";
                 m_state.is_release=true;
@@ -68,7 +81,7 @@ namespace cli{
             }else if(curr_arg=="compile"){
                 advance();
                 checkargs("input file");
-                if (curr_arg.substr(curr_arg.size()-3, 3)!=".pe"){
+                if (curr_arg!="-" && (curr_arg.size()<3 || curr_arg.substr(curr_arg.size()-3, 3)!=".pe")){
                     println("Error: input file must be a .pe file");
                     exit(1);
                 }
@@ -77,6 +90,12 @@ namespace cli{
                     exit(1);
                 }
                 m_state.input_filename = curr_arg;
+            }else if(curr_arg=="-"){
+                if(m_state.input_filename!=""){
+                    println("Error: Only one input file can be specified");
+                    exit(1);
+                }
+                m_state.input_filename = curr_arg;
             }else if(curr_arg=="-dev_debug"){
                 m_state.dev_debug = true;
             }else if(curr_arg=="help"){
@@ -122,6 +141,11 @@ namespace cli{
             exit(1);
         }
         int check_state=0;
+        //the output is named after the input file, stdin has no name
+        if(m_state.output_filename=="" && m_state.input_filename=="-"){
+            println("No output file specified, -o is needed when reading from stdin.\nUse 'peregrine help' for more information");
+            exit(1);
+        }
         if(m_state.output_filename==""){
             if(m_state.emit_cpp){
                 m_state.output_filename=m_state.input_filename.substr(0, m_state.input_filename.size()-3)+".cpp";
@@ -178,8 +202,30 @@ namespace cli{
             }
             check_state++;
         }
+        if(m_state.stream && (m_state.emit_js||m_state.emit_html||m_state.doc_html)){
+            println("-stream only works when generating C++.\nUse 'peregrine help' for more information");
+            exit(1);
+        }
         if(m_state.cpp_compiler==""){
             m_state.cpp_compiler="clang++";//it will use clang that we are shiping with in the future
         }
     }
+    std::optional<uint16_t> load_input(const std::string& filename,std::string& path){
+        //stdin has no path to resolve
+        if(filename=="-"){
+            path=filename;
+            return sources::load(filename);
+        }
+        std::error_code ec;
+        path = std::filesystem::canonical(filename,ec).string();
+        if(ec){
+            return std::nullopt;
+        }
+        struct stat st;
+        if(stat(path.c_str(),&st) == 0 && S_ISDIR(st.st_mode)){
+            println("Error: "<<path<<" is a directory");
+            exit(1);
+        }
+        return sources::load(path);
+    }
 }
\ No newline at end of file
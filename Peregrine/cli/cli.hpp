@@ -1,6 +1,8 @@
 #ifndef PEREGRINE_CLI_HPP
 #define PEREGRINE_CLI_HPP
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <vector>
 namespace cli{
@@ -19,6 +21,9 @@ class state{
     bool doc_html=false;
     bool is_release=false;
     bool debug=false;
+    bool use_cache=true;
+    bool mem_report=false;
+    bool stream=false;
     bool dev_debug=false;//Will be removed later. It is for debugging the parser
     void validate_state();
 };
@@ -34,5 +39,10 @@ class CLI{
     state parse();
 };
 
+//registers the file to compile, "-" reads it from stdin. `path` is set to
+//the name the file goes by, its canonical path or "-". Nothing if it can not
+//be read, exits if it is a directory
+std::optional<uint16_t> load_input(const std::string& filename,std::string& path);
+
 }
 #endif
@@ -49,7 +49,13 @@ std::string global_name(std::string name)
 
 namespace cpp {
 
-Codegen::Codegen(std::string outputFilename, ast::AstNodePtr ast,std::string filename) {
+Codegen::Codegen(std::string outputFilename, ast::AstNodePtr ast,std::string filename)
+    : Codegen(outputFilename, filename) {
+    accept(ast);
+    finish();
+}
+
+Codegen::Codegen(std::string outputFilename, std::string filename) {
     m_filename=filename;
     m_file.open(outputFilename);
     m_file << "#include <setjmp.h>\n#include <cstdlib>\n#include <stdio.h>\n#include <stdint.h>\n#include <functional>\ntypedef enum{error________P____P____Error,error________P____P____AssertionError,error________P____P____ZeroDivisionError} error;\n";
@@ -59,10 +65,26 @@ Codegen::Codegen(std::string outputFilename, ast::AstNodePtr ast,std::string fil
             "error err;\n"
             "};\n";
     m_global_name=global_name(filename);
-    ast->accept(*this);
+}
+
+void Codegen::emit(ast::AstNodePtr stmt) {
+    accept(stmt);
+    write(";\n");
+}
+
+void Codegen::finish() {
+    m_output_bytes=std::max<std::streamoff>(m_file.tellp(),0);
     m_file.close();
 }
 
+size_t Codegen::output_bytes() const{
+    return m_output_bytes;
+}
+
+size_t Codegen::symbols() const{
+    return m_symbolMap.size();
+}
+
 
 std::string Codegen::write(std::string_view code) {
     if(save){
@@ -91,6 +113,23 @@ std::string Codegen::searchDefaultModule(std::string path,
     return "";
 }
 
+// a function with a parameter declared without a type is a template, the type
+// it returns is only known for each instantiation. A void one deduces void
+static bool returns_auto(const ast::FunctionDefinition& node) {
+    auto return_type=node.returnType();
+    if (return_type->type()!=ast::KAstTypeExpr||
+        static_cast<ast::TypeExpression*>(return_type)->value()!="void"){
+        return false;
+    }
+    for (auto& param : node.parameters()){
+        if (param.p_type->type()==ast::KAstNoLiteral&&
+            param.p_default->type()==ast::KAstNoLiteral){
+            return true;
+        }
+    }
+    return false;
+}
+
 void Codegen::codegenFuncParams(std::vector<ast::parameter> parameters,size_t start) {
     if ((parameters.size()-start)>0) {
         for (size_t i = start; i < parameters.size(); ++i) {
@@ -103,15 +142,15 @@ void Codegen::codegenFuncParams(std::vector<ast::parameter> parameters,size_t st
                 write("auto");
             }
             else{
-                parameters[i].p_type->accept(*this);
+                accept(parameters[i].p_type);
             }
             write(" ");
             is_define=true;
-            parameters[i].p_name->accept(*this);
+            accept(parameters[i].p_name);
             is_define=false;
             if(parameters[i].p_default->type()!=ast::KAstNoLiteral){
                 write("=");
-                parameters[i].p_default->accept(*this);
+                accept(parameters[i].p_default);
             }
             write(",");
         }
@@ -121,8 +160,7 @@ void Codegen::codegenFuncParams(std::vector<ast::parameter> parameters,size_t st
 
 bool Codegen::visit(const ast::Program& node) {
     for (auto& stmt : node.statements()) {
-        stmt->accept(*this);
-        write(";\n");
+        emit(stmt);
     }
     return true;
 }
@@ -130,7 +168,7 @@ bool Codegen::visit(const ast::Program& node) {
 bool Codegen::visit(const ast::BlockStatement& node) {
     for (auto& stmt : node.statements()) {
         write("    ");
-        stmt->accept(*this);
+        accept(stmt);
         write(";\n");
     }
     return true;
@@ -141,7 +179,7 @@ bool Codegen::visit(const ast::ImportStatement& node) { return true; }
 bool Codegen::visit(const ast::FunctionDefinition& node) {
     auto return_type=TurpleTypes(node.returnType());
     auto functionName =
-        std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())
+        static_cast<ast::IdentifierExpression*>(node.name())
             ->value();
     if (!is_func_def){
         is_func_def=true;
@@ -151,19 +189,22 @@ bool Codegen::visit(const ast::FunctionDefinition& node) {
             m_symbolMap.set_global("main","main");
             write("static ____P____exception_handler* ____Pexception_handlers=NULL;\n");
             local_mangle_start();
-            node.body()->accept(*this);
+            accept(node.body());
             write("return 0;\n}");
             local_mangle_end();
         } else {
-            if(return_type.size()==0){
-                node.returnType()->accept(*this);
+            if(returns_auto(node)){
+                write("auto");
+            }
+            else if(return_type.size()==0){
+                accept(node.returnType());
             }
             else{
                 write("int");
             }
             write(" ");
             is_define=true;
-            node.name()->accept(*this);
+            accept(node.name());
             is_define=false;
             write("(");
             local_mangle_start();
@@ -172,14 +213,14 @@ bool Codegen::visit(const ast::FunctionDefinition& node) {
                 write(",");
             }
             for(size_t i=0;i<return_type.size();i++){
-                return_type[i]->accept(*this);
+                accept(return_type[i]);
                 write("*____P____RETURN____"+std::to_string(i)+"=NULL");
                 if(i<return_type.size()-1){
                     write(",");
                 }
             }
             write(")  noexcept {\n");
-            node.body()->accept(*this);
+            accept(node.body());
             write("\n}");
             local_mangle_end();
         }
@@ -189,7 +230,7 @@ bool Codegen::visit(const ast::FunctionDefinition& node) {
         local_mangle_start();
         write("auto ");
         is_define=true;
-        node.name()->accept(*this);
+        accept(node.name());
         is_define=false;
         write("=[=](");
         codegenFuncParams(node.parameters());
@@ -197,7 +238,7 @@ bool Codegen::visit(const ast::FunctionDefinition& node) {
             write(",");
         }
         for(size_t i=0;i<return_type.size();i++){
-            return_type[i]->accept(*this);
+            accept(return_type[i]);
             write("*____P____RETURN____"+std::to_string(i)+"=NULL");
             if(i<return_type.size()-1){
                 write(",");
@@ -205,13 +246,13 @@ bool Codegen::visit(const ast::FunctionDefinition& node) {
         }
         write(")mutable noexcept ->");
         if(return_type.size()==0){
-                node.returnType()->accept(*this);
+                accept(node.returnType());
         }
         else{
             write("int ");
         }
         write(" {\n");
-        node.body()->accept(*this);
+        accept(node.body());
         write("\n}");
         local_mangle_end();
     }
@@ -220,18 +261,18 @@ bool Codegen::visit(const ast::FunctionDefinition& node) {
 
 bool Codegen::visit(const ast::VariableStatement& node) {
     if (node.varType()->type() != ast::KAstNoLiteral) {
-        node.varType()->accept(*this);
+        accept(node.varType());
         is_define=true;
         write(" ");
     }
 
     ast::AstNodePtr name=node.name();
-    name->accept(*this);
+    accept(name);
     is_define=false;
 
     if (node.value()->type() != ast::KAstNoLiteral) {
          write(" = ");
-          node.value()->accept(*this);
+          accept(node.value());
      }
     return true;
 }
@@ -239,23 +280,23 @@ bool Codegen::visit(const ast::VariableStatement& node) {
 bool Codegen::visit(const ast::ConstDeclaration& node) {
     write("const ");
     if (node.constType()->type()!=ast::KAstNoLiteral){
-        node.constType()->accept(*this);
+        accept(node.constType());
     }
     write(" ");
     is_define=true;
-    node.name()->accept(*this);
+    accept(node.name());
     is_define=false;
     write("=");
-    node.value()->accept(*this);
+    accept(node.value());
     return true;
 }
 
 bool Codegen::visit(const ast::TypeDefinition& node) {
     write("typedef ");
-    node.baseType()->accept(*this);
+    accept(node.baseType());
     write(" ");
     is_define=true;
-    node.name()->accept(*this);
+    accept(node.name());
     is_define=false;
     return true;
 }
@@ -271,22 +312,22 @@ bool Codegen::visit(const ast::PassStatement& node) {
 
 bool Codegen::visit(const ast::IfStatement& node) {
     write("if (");
-    node.condition()->accept(*this);
+    accept(node.condition());
     write(") {\n");
     local_mangle_start();
-    node.ifBody()->accept(*this);
+    accept(node.ifBody());
     local_mangle_end();
     write("}");
 
-    auto elifNode = node.elifs();
+    auto& elifNode = node.elifs();
     if (elifNode.size() != 0) {
         write("\n");
         for (auto& body : elifNode) { // making sure that elif exists
             write("else if (");
-            body.first->accept(*this);
+            accept(body.first);
             write(") {\n");
             local_mangle_start();
-            body.second->accept(*this);
+            accept(body.second);
             local_mangle_end();
             write("}");
         }
@@ -297,7 +338,7 @@ bool Codegen::visit(const ast::IfStatement& node) {
         ast::KAstBlockStmt) { // making sure that else exists
         write("\nelse {\n");
         local_mangle_start();
-        elseNode->accept(*this);
+        accept(elseNode);
         local_mangle_end();
         write("}");
     }
@@ -306,10 +347,10 @@ bool Codegen::visit(const ast::IfStatement& node) {
 
 bool Codegen::visit(const ast::WhileStatement& node) {
     write("while (");
-    node.condition()->accept(*this);
+    accept(node.condition());
     write(") {\n");
     local_mangle_start();
-    node.body()->accept(*this);
+    accept(node.body());
     local_mangle_end();
     write("}");
     return true;
@@ -317,14 +358,14 @@ bool Codegen::visit(const ast::WhileStatement& node) {
 
 bool Codegen::visit(const ast::ForStatement& node) {
     write("{\nauto ____P____VALUE=");
-    node.sequence()->accept(*this);
+    accept(node.sequence());
     write(";\n");
     write("for (size_t ____P____i=0;____P____i<____P____VALUE.____mem____P____P______iter__(____Pexception_handlers);++____P____i){\n");
     local_mangle_start();
     if (node.variable().size()==1){
         write("auto ");
         is_define=true;
-        node.variable()[0]->accept(*this);
+        accept(node.variable()[0]);
         is_define=false;
         write("=____P____VALUE.____mem____P____P______iterate__(____Pexception_handlers);\n");
     }
@@ -334,22 +375,22 @@ bool Codegen::visit(const ast::ForStatement& node) {
             auto x=node.variable()[i];
             write("auto ");
             is_define=true;
-            x->accept(*this);
+            accept(x);
             is_define=false;
             write("=____P____TEMP.____mem____P____P______getitem__(");
             write(std::to_string(i));
             write(",____Pexception_handlers);\n");
         }
     }
-    node.body()->accept(*this);
+    accept(node.body());
     local_mangle_end();
     write("\n}\n}");
     return true;
 }
 
 bool Codegen::visit(const ast::MatchStatement& node) {
-    auto toMatch = node.matchItem();
-    auto cases = node.caseBody();
+    auto& toMatch = node.matchItem();
+    auto& cases = node.caseBody();
     auto defaultBody = node.defaultBody();
     write("\nwhile (true) {\n");
     for (size_t i = 0; i < cases.size(); ++i) {
@@ -358,24 +399,24 @@ bool Codegen::visit(const ast::MatchStatement& node) {
         if (currCase.first.size() == 1 &&
             currCase.first[0]->type() == ast::KAstNoLiteral) {
             if (i == 0) {
-                currCase.second->accept(*this);
+                accept(currCase.second);
                 write("\n");
             } else {
                 write("else {\n");
-                currCase.second->accept(*this);
+                accept(currCase.second);
                 write("\n}\n");
             }
         } else if (i == 0) {
             write("if (");
             matchArg(toMatch, currCase.first);
             write(") {\n");
-            currCase.second->accept(*this);
+            accept(currCase.second);
             write("\n}\n");
         } else {
             write("else if (");
             matchArg(toMatch, currCase.first);
             write(") {\n");
-            currCase.second->accept(*this);
+            accept(currCase.second);
             write("\n}\n");
         }
         local_mangle_end();
@@ -383,7 +424,7 @@ bool Codegen::visit(const ast::MatchStatement& node) {
 
     if (defaultBody->type() != ast::KAstNoLiteral) {
         local_mangle_start();
-        defaultBody->accept(*this);
+        accept(defaultBody);
         local_mangle_end()
     }
     write("\nbreak;\n}");
@@ -393,7 +434,7 @@ bool Codegen::visit(const ast::MatchStatement& node) {
 bool Codegen::visit(const ast::ScopeStatement& node) {
     write("{\n");
     local_mangle_start();
-    node.body()->accept(*this);
+    accept(node.body());
     local_mangle_end();
     write("\n}");
     return true;
@@ -405,14 +446,14 @@ bool Codegen::visit(const ast::ReturnStatement& node) {
         auto return_values=TurpleExpression(node.returnValue()); 
         if(return_values.size()==0){
             write("return ");
-            node.returnValue()->accept(*this);
+            accept(node.returnValue());
         }
         else{
             write("if (____P____RETURN____0!=NULL){\n");
             for(size_t i=0;i<return_values.size();i++){
                 write("    ");
                 write("*____P____RETURN____"+std::to_string(i)+"=");
-                return_values[i]->accept(*this);
+                accept(return_values[i]);
                 write(";\n");
             }
             write("}\n");
@@ -436,7 +477,7 @@ bool Codegen::visit(const ast::BreakStatement& node) {
 }
 
 bool Codegen::visit(const ast::DecoratorStatement& node) {
-    auto items = node.decoratorItem();
+    auto& items = node.decoratorItem();
     auto body = node.body();
     std::string contains;
     std::string x;
@@ -447,19 +488,19 @@ bool Codegen::visit(const ast::DecoratorStatement& node) {
         res="";
     }
     if(body->type()==ast::KAstFunctionDef || body->type()==ast::KAstStatic){
-        std::shared_ptr<ast::FunctionDefinition> function;
+        ast::FunctionDefinition* function;
         if (body->type()==ast::KAstStatic){
             write("static ");
-            function = std::dynamic_pointer_cast<ast::FunctionDefinition>(
-                        std::dynamic_pointer_cast<ast::StaticStatement>(body)->body()
+            function = static_cast<ast::FunctionDefinition*>(
+                        static_cast<ast::StaticStatement*>(body)->body()
                         );
         }
         else{
-            function = std::dynamic_pointer_cast<ast::FunctionDefinition>(body);
+            function = static_cast<ast::FunctionDefinition*>(body);
         }
         write("auto ");
         is_define=true;
-        function->name()->accept(*this);
+        accept(function->name());
         is_define=false;
         write("=");
         x+=res;
@@ -477,7 +518,7 @@ bool Codegen::visit(const ast::DecoratorStatement& node) {
             write(",");
         }
         for(size_t i=0;i<return_type.size();i++){
-            return_type[i]->accept(*this);
+            accept(return_type[i]);
             write("*");
             write("____P____RETURN____"+std::to_string(i)+"=NULL");
             if(i<return_type.size()-1){
@@ -486,7 +527,7 @@ bool Codegen::visit(const ast::DecoratorStatement& node) {
         }
         write(")mutable noexcept ->");
         if(return_type.size()==0){
-            function->returnType()->accept(*this);
+            accept(function->returnType());
         }
         else{
             write("int");
@@ -494,11 +535,11 @@ bool Codegen::visit(const ast::DecoratorStatement& node) {
         write("{\n");
         if(!is_func_def){
             is_func_def=true;
-            function->body()->accept(*this);
+            accept(function->body());
             is_func_def=false;
         }
         else{
-            function->body()->accept(*this);
+            accept(function->body());
         }
         write("\n}");
         local_mangle_end();
@@ -521,10 +562,10 @@ bool Codegen::visit(const ast::DecoratorStatement& node) {
 
 bool Codegen::visit(const ast::ListLiteral& node) {
     write("{");
-    auto elements=node.elements();
+    auto& elements=node.elements();
     if (elements.size()>0){
         for (size_t i=0;i<elements.size();++i){
-            elements[i]->accept(*this);
+            accept(elements[i]);
             if (i<elements.size()-1){
                 write(",");
             }
@@ -537,13 +578,13 @@ bool Codegen::visit(const ast::ListLiteral& node) {
 bool Codegen::visit(const ast::DictLiteral& node) { return true; }
 
 bool Codegen::visit(const ast::ListOrDictAccess& node) {
-    node.container()->accept(*this);
+    accept(node.container());
     write(".____mem____P____P______getitem__(");
     handle_ref_start();
-    node.keyOrIndex()[0]->accept(*this);
+    accept(node.keyOrIndex()[0]);
     if(node.keyOrIndex().size()==2){
         write(",");
-        node.keyOrIndex()[1]->accept(*this);
+        accept(node.keyOrIndex()[1]);
     }
     handle_ref_end();
     if(is_func_def){
@@ -557,17 +598,17 @@ bool Codegen::visit(const ast::ListOrDictAccess& node) {
 
 bool Codegen::visit(const ast::BinaryOperation& node) {
     /*
-    if (node.op().keyword == "**") {
+    if (node.op().keyword() == "**") {
         write("_P_POWER(");
-        node.left()->accept(*this);
+        accept(node.left());
         write(",");
-        node.right()->accept(*this);
+        accept(node.right());
         write(")");
-    } else if (node.op().keyword == "//") {
+    } else if (node.op().keyword() == "//") {
         write("_P_FLOOR(");
-        node.left()->accept(*this);
+        accept(node.left());
         write("/");
-        node.right()->accept(*this);
+        accept(node.right());
         write(")");
     }
     */
@@ -576,9 +617,9 @@ bool Codegen::visit(const ast::BinaryOperation& node) {
     }
     else if(node.token().tkType==tk_in){
         write("(");
-        node.right()->accept(*this);
+        accept(node.right());
         write(".____mem____P____P______contains__(");
-        node.left()->accept(*this);
+        accept(node.left());
         if(is_func_def){
             write(",____Pexception_handlers))");
         }
@@ -588,9 +629,9 @@ bool Codegen::visit(const ast::BinaryOperation& node) {
     }
     else if(node.token().tkType==tk_not_in){
         write("(not ");
-        node.right()->accept(*this);
+        accept(node.right());
         write(".____mem____P____P______contains__(");
-        node.left()->accept(*this);
+        accept(node.left());
         if(is_func_def){
             write(",____Pexception_handlers))");
         }
@@ -600,35 +641,35 @@ bool Codegen::visit(const ast::BinaryOperation& node) {
     }
      else {
         write("(");
-        node.left()->accept(*this);
-        write(" " + node.op().keyword + " ");
-        node.right()->accept(*this);
+        accept(node.left());
+        write(" " + node.op().keyword() + " ");
+        accept(node.right());
         write(")");
     }
     return true;
 }
 
 bool Codegen::visit(const ast::PrefixExpression& node) {
-    write("(" + node.prefix().keyword + " ");
-    node.right()->accept(*this);
+    write("(" + node.prefix().keyword() + " ");
+    accept(node.right());
     write(")");
     return true;
 }
 bool Codegen::visit(const ast::PostfixExpression& node) {
-    node.left()->accept(*this);
-    write(node.postfix().keyword);
+    accept(node.left());
+    write(node.postfix().keyword());
     return true;
 }
 bool Codegen::visit(const ast::FunctionCall& node) {
-    node.name()->accept(*this);
+    accept(node.name());
     write("(");
     handle_ref_start()
-    auto args = node.arguments();
+    auto& args = node.arguments();
     if (args.size()) {
         for (size_t i = 0; i < args.size(); ++i) {
             if (i)
                 write(", ");
-            args[i]->accept(*this);
+            accept(args[i]);
         }
         write(",");
     }
@@ -646,11 +687,11 @@ bool Codegen::visit(const ast::ArrowExpression& node) {
     bool x=is_ref;
     if(node.owner()->type()!=ast::KAstDotExpression||node.owner()->type()!=ast::KAstArrowExpression){
         is_ref=false;
-        node.owner()->accept(*this);
+        accept(node.owner());
     }
     write("->");
     is_ref=true;
-    node.referenced()->accept(*this);
+    accept(node.referenced());
     is_ref=x;
     return true;
 }
@@ -664,34 +705,34 @@ bool Codegen::visit(const ast::DotExpression& node) {
     }
     if (!is_dot_exp){
         if (node.owner()->type()==ast::KAstIdentifier){
-            std::string name = std::dynamic_pointer_cast<ast::IdentifierExpression>(node.owner())->value();
+            std::string name = static_cast<ast::IdentifierExpression*>(node.owner())->value();
             if(std::count(enum_name.begin(), enum_name.end(), name)&&m_symbolMap.contains(name)){
                 write(m_symbolMap[name]+"________P____P____");
-                std::string enum_name=std::dynamic_pointer_cast<ast::IdentifierExpression>(node.referenced())->value();
+                std::string enum_name=static_cast<ast::IdentifierExpression*>(node.referenced())->value();
                 write(enum_name);
             }
             else{
                 is_dot_exp=true;
-                node.owner()->accept(*this);
+                accept(node.owner());
                 write(".");
                 is_ref=true;
-                node.referenced()->accept(*this);
+                accept(node.referenced());
             }
         }
         else {
             if(node.owner()->type()!=ast::KAstDotExpression){is_dot_exp=true;}
-            node.owner()->accept(*this);
+            accept(node.owner());
             write(".");
             is_ref=true;
-            node.referenced()->accept(*this);
+            accept(node.referenced());
         }
         is_dot_exp=false;
     }
     else{
-        node.owner()->accept(*this);
+        accept(node.owner());
         write(".");
         is_ref=true;
-        node.referenced()->accept(*this);
+        accept(node.referenced());
     }
     is_ref=x;
     return true;
@@ -699,14 +740,14 @@ bool Codegen::visit(const ast::DotExpression& node) {
 
 bool Codegen::visit(const ast::IdentifierExpression& node) {
     
-    auto x=node.value();
+    auto x=node.symbol();
     if(is_ref){
-        write("____mem____P____P____"+x);
+        write("____mem____P____P____"+x.str());
         return true;
     }
     if(curr_enum_name!=""){
         write(m_symbolMap[curr_enum_name]+"________P____P____");
-        write(x);
+        write(x.str());
         return true;
     }
     if(!m_symbolMap.contains(x)){
@@ -714,7 +755,7 @@ bool Codegen::visit(const ast::IdentifierExpression& node) {
             m_symbolMap.set_local(x);
         }
         else{
-            m_symbolMap.set_global(x,"____P____P____"+m_global_name+x);
+            m_symbolMap.set_global(x,"____P____P____"+m_global_name+x.str());
         }
     }
     else if(is_define && local){
@@ -725,9 +766,9 @@ bool Codegen::visit(const ast::IdentifierExpression& node) {
 }
 
 bool Codegen::visit(const ast::TypeExpression& node) {
-    auto x=node.value();
+    auto x=node.symbol();
     if(!m_symbolMap.contains(x)){
-        write(x);
+        write(x.str());
     }
     else{
         write(m_symbolMap[x]);
@@ -741,18 +782,18 @@ bool Codegen::visit(const ast::FunctionTypeExpr& node) {
     write("std::function<");
     auto return_type=TurpleTypes(node.returnTypes());
     if(return_type.size()==0){
-        node.returnTypes()->accept(*this);
+        accept(node.returnTypes());
         write("(");
     }
     else{
         write("int(");
     }
-    auto argTypes = node.argTypes();
+    auto& argTypes = node.argTypes();
     if (argTypes.size() > 0) {
         for (size_t i = 0; i < argTypes.size(); ++i) {
             if (i)
                 write(",");
-            argTypes[i]->accept(*this);
+            accept(argTypes[i]);
         }
         write(",");
     }
@@ -760,7 +801,7 @@ bool Codegen::visit(const ast::FunctionTypeExpr& node) {
     if(return_type.size()>0){
         write(",");
         for(size_t i=0;i<return_type.size();i++){
-            return_type[i]->accept(*this);
+            accept(return_type[i]);
             write("*");
             if(i<return_type.size()-1){
                 write(",");
@@ -802,53 +843,53 @@ bool Codegen::visit(const ast::NoneLiteral& node) {
 }
 bool Codegen::visit(const ast::AssertStatement& node){
     write("if(!(");
-    node.condition()->accept(*this);
+    accept(node.condition());
     write(")){\n");
     write("if(____Pexception_handlers!=NULL){\n");
     write("____Pexception_handlers->err=error________P____P____AssertionError;\n");
     write("____Pexception_handlers->handler=");
-    write("[](){printf(\"Exception : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+node.token().statement+"\\n\");fflush(stdout);exit(1);}\n");
+    write("[](){printf(\"Exception : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+escape_quotes(node.token().statement())+"\\n\");fflush(stdout);exit(1);}\n");
     write(";longjmp(*(____Pexception_handlers->buf),1);\n}else{\n");
-    write("printf(\"Exception : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+node.token().statement+"\\n\");fflush(stdout);exit(1);}\n");
+    write("printf(\"Exception : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+escape_quotes(node.token().statement())+"\\n\");fflush(stdout);exit(1);}\n");
     write("}\n");
     return true;
 }
 bool Codegen::visit(const ast::StaticStatement& node){
     write("static ");
-    node.body()->accept(*this);
+    accept(node.body());
     return true;
 }
 bool Codegen::visit(const ast::InlineStatement& node){
     write("inline __attribute__((always_inline)) ");
-    node.body()->accept(*this);
+    accept(node.body());
     return true;
 }
 bool Codegen::visit(const ast::RaiseStatement& node){
     write("if(____Pexception_handlers!=NULL){\n");
     write("____Pexception_handlers->err=");
     if(node.value()->type()!=ast::KAstNoLiteral){
-        node.value()->accept(*this);
+        accept(node.value());
     }
     else{
         write("error________P____P____Error");
     }
     write(";\n");
     write("____Pexception_handlers->handler=");
-    write("[](){printf(\"Exception : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+node.token().statement+"\\n\");fflush(stdout);exit(1);}\n");
+    write("[](){printf(\"Exception : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+escape_quotes(node.token().statement())+"\\n\");fflush(stdout);exit(1);}\n");
     write(";longjmp(*(____Pexception_handlers->buf),1);\n}else{\n");
-    write("printf(\"Exception : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+node.token().statement+"\\n\");fflush(stdout);exit(1);}\n");
+    write("printf(\"Exception : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+escape_quotes(node.token().statement())+"\\n\");fflush(stdout);exit(1);}\n");
     return true;
 }
 bool Codegen::visit(const ast::UnionLiteral& node){
     write("union ");
     is_define=true;
-    node.name()->accept(*this);
+    accept(node.name());
     is_define=false;
     write("{\n");
     local_mangle_start();
     for (auto& element:node.elements()){
-        element.first->accept(*this);
-        std::string mem = std::dynamic_pointer_cast<ast::IdentifierExpression>(element.second)->value();
+        accept(element.first);
+        std::string mem = static_cast<ast::IdentifierExpression*>(element.second)->value();
         write(" ____mem____P____P____"+mem);
         write(";\n");
     }
@@ -858,20 +899,20 @@ bool Codegen::visit(const ast::UnionLiteral& node){
 }
 bool Codegen::visit(const ast::EnumLiteral& node){
     write("enum ");
-    node.name()->accept(*this);
+    accept(node.name());
     write("{\n");
-    auto fields=node.fields();
-    std::string name=std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())->value();
+    auto& fields=node.fields();
+    std::string name=static_cast<ast::IdentifierExpression*>(node.name())->value();
     enum_name.push_back(name);
     local_mangle_start();
     for (size_t i=0;i<fields.size();++i){
         auto field=fields[i];        
-        std::string item=std::dynamic_pointer_cast<ast::IdentifierExpression>(field.first)->value();
+        std::string item=static_cast<ast::IdentifierExpression*>(field.first)->value();
         write(m_symbolMap[name]+"________P____P____"+item);
         m_symbolMap.set_local(item,m_symbolMap[name]+"________P____P____"+item);
         if (field.second->type()!=ast::KAstNoLiteral){
             write(" = ");
-            field.second->accept(*this);
+            accept(field.second);
         }
         if (i!=fields.size()-1){
             write(",\n");
@@ -883,82 +924,82 @@ bool Codegen::visit(const ast::EnumLiteral& node){
 }
 bool Codegen::visit(const ast::CastStatement& node){
     write("(");
-    node.cast_type()->accept(*this);
+    accept(node.cast_type());
     write(")(");
-    node.value()->accept(*this);
+    accept(node.value());
     write(")");
     return true;
 }
 bool Codegen::visit(const ast::PointerTypeExpr& node){
-    node.baseType()->accept(*this);
+    accept(node.baseType());
     write("*");
     return true;
 }
 bool Codegen::visit(const ast::RefTypeExpr& node){
-    node.baseType()->accept(*this);
+    accept(node.baseType());
     write("&");
     return true;
 }
 bool Codegen::visit(const ast::ClassDefinition& node){
     write("class ");
     is_define=true;
-    node.name()->accept(*this);
+    accept(node.name());
     is_define=false;
     auto name =m_symbolMap[
-        std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())
+        static_cast<ast::IdentifierExpression*>(node.name())
             ->value()];
-    auto parents=node.parent();
+    auto& parents=node.parent();
     if (parents.size()!=0){
         write(":");
     }
     for (size_t i=0;i<parents.size();++i){
         write("public ");
-        parents[i]->accept(*this);
+        accept(parents[i]);
         if(i<parents.size()-1){write(",");}
     }
     write("\n{");
     local_mangle_start();
     for (auto& x : node.other()){
-        x->accept(*this);
+        accept(x);
         write(";\n");
     }
     write("public:\n");
     {
         local_mangle_start();
-        for (auto& x : node.attributes()){
+        for (auto x : node.attributes()){
             if(x->type()==ast::KAstStatic){
-                x = std::dynamic_pointer_cast<ast::StaticStatement>(x)->body();
+                x = static_cast<ast::StaticStatement*>(x)->body();
                 write("static ");
             }
             else if(x->type()==ast::KAstPrivate){
-                x = std::dynamic_pointer_cast<ast::PrivateDef>(x)->definition();
+                x = static_cast<ast::PrivateDef*>(x)->definition();
             }
             switch(x->type()){
                 case ast::KAstVariableStmt:{
-                    std::shared_ptr<ast::VariableStatement> var = std::dynamic_pointer_cast<ast::VariableStatement>(x);
-                    var->varType()->accept(*this);
+                    ast::VariableStatement* var = static_cast<ast::VariableStatement*>(x);
+                    accept(var->varType());
                     write(" ____mem____P____P____");
-                    auto str=std::dynamic_pointer_cast<ast::IdentifierExpression>(var->name())->value();
+                    auto str=static_cast<ast::IdentifierExpression*>(var->name())->value();
                     write(str);
                     m_symbolMap.set_local(str,"____mem____P____P____"+str);
                     if(var->value()->type()!=ast::KAstNoLiteral){
                         write(" = ");
-                        var->value()->accept(*this);
+                        accept(var->value());
                     }
                     write(";\n");
                     break;
                 }
                 case ast::KAstConstDecl:{
-                    std::shared_ptr<ast::ConstDeclaration> var = std::dynamic_pointer_cast<ast::ConstDeclaration>(x);
+                    ast::ConstDeclaration* var = static_cast<ast::ConstDeclaration*>(x);
                     write("const ");
-                    var->constType()->accept(*this);
+                    accept(var->constType());
                     write(" ____mem____P____P____");
-                    auto str=std::dynamic_pointer_cast<ast::IdentifierExpression>(var->name())->value();
+                    auto str=static_cast<ast::IdentifierExpression*>(var->name())->value();
                     write(str);
                     m_symbolMap.set_local(str,"____mem____P____P____"+str);
                     if(var->value()->type()!=ast::KAstNoLiteral){
                         write(" = ");
-                        var->value()->accept(*this);
+                        accept(var->value());
                     }
                     write(";\n");
                     break;
@@ -968,9 +1009,9 @@ bool Codegen::visit(const ast::ClassDefinition& node){
         }
         local_mangle_end();
     }
-    for (auto& x : node.methods()){
+    for (auto x : node.methods()){
         if(x->type()==ast::KAstPrivate){
-            x = std::dynamic_pointer_cast<ast::PrivateDef>(x)->definition();
+            x = static_cast<ast::PrivateDef*>(x)->definition();
         }
         magic_method(x,name);
         write(";\n");
@@ -981,8 +1022,8 @@ bool Codegen::visit(const ast::ClassDefinition& node){
 }
 bool Codegen::visit(const ast::WithStatement& node) {
     write("{\n");
-    std::vector<ast::AstNodePtr> variables=node.variables();
-    std::vector<ast::AstNodePtr> values=node.values();
+    auto& variables=node.variables();
+    auto& values=node.values();
     std::vector<std::string> no_var;
     local_mangle_start();
     for(size_t i=0;i<values.size();++i){
@@ -990,12 +1031,12 @@ bool Codegen::visit(const ast::WithStatement& node) {
         no_var.push_back(std::to_string(i));
         write(std::to_string(i));
         write("=");
-        values[i]->accept(*this);
+        accept(values[i]);
         write(";\n");
         if(variables[i]->type()!=ast::KAstNoLiteral){
             write("auto ");
             is_define=true;
-            variables[i]->accept(*this);
+            accept(variables[i]);
             is_define=false;
             write("=");
             write("CONTEXT____MANAGER____P____"+no_var.back());
@@ -1007,7 +1048,7 @@ bool Codegen::visit(const ast::WithStatement& node) {
         }
         write(";\n");
     }
-    node.body()->accept(*this);
+    accept(node.body());
     local_mangle_end();
     for(auto& x:no_var){
         write("CONTEXT____MANAGER____P____"+x);
@@ -1019,26 +1060,26 @@ bool Codegen::visit(const ast::WithStatement& node) {
 bool Codegen::visit(const ast::DefaultArg& node){
     //TODO:
     // write(".");
-    // node.name()->accept(*this);
+    // accept(node.name());
     // write("=");
-    node.value()->accept(*this);
+    accept(node.value());
     return true;
 }
 bool Codegen::visit(const ast::ExportStatement& node){
     //dont mangle this name
     write("extern \"C\" ");
-    std::string name=std::dynamic_pointer_cast<ast::IdentifierExpression>(std::dynamic_pointer_cast<ast::FunctionDefinition>(node.body())->name())->value();
+    std::string name=static_cast<ast::IdentifierExpression*>(static_cast<ast::FunctionDefinition*>(node.body())->name())->value();
     m_symbolMap.set_global(name,name);
-    node.body()->accept(*this);
+    accept(node.body());
     return true;
 }
 bool Codegen::visit(const ast::TernaryIf& node){
     write("(");
-    node.if_condition()->accept(*this);
+    accept(node.if_condition());
     write(")?");
-    node.if_value()->accept(*this);
+    accept(node.if_value());
     write(":");
-    node.else_value()->accept(*this);
+    accept(node.else_value());
     return true;
 }
 bool Codegen::visit(const ast::TryExcept& node){
@@ -1052,7 +1093,7 @@ bool Codegen::visit(const ast::TryExcept& node){
     );
     write("if(!setjmp(*(____Pexception_handlers->buf))){\n");
     local_mangle_start();
-    node.body()->accept(*this);
+    accept(node.body());
     local_mangle_end();
     write(" ____P_____temp_handler=____Pexception_handlers;\n");
     write("}");
@@ -1066,18 +1107,18 @@ bool Codegen::visit(const ast::TryExcept& node){
         auto x=node.except_clauses()[0];
         for (size_t i=0;i<x.first.first.size();++i){
             write("__P__exception==");
-            x.first.first[i]->accept(*this);
+            accept(x.first.first[i]);
             if(i<x.first.first.size()-1){write(" or ");}
         }
         write("){\n");
         if(x.first.second->type()!=ast::KAstNoLiteral){
             write("auto ");
             is_define=true;
-            x.first.second->accept(*this);
+            accept(x.first.second);
             is_define=false;
             write("=__P__exception;\n");
         }
-        x.second->accept(*this);
+        accept(x.second);
         local_mangle_end();
         write("}\n");
         for(size_t i=1;i<node.except_clauses().size();++i){
@@ -1086,18 +1127,18 @@ bool Codegen::visit(const ast::TryExcept& node){
             auto x=node.except_clauses()[i];
             for (size_t i=0;i<x.first.first.size();++i){
                 write("__P__exception==");
-                x.first.first[i]->accept(*this);
+                accept(x.first.first[i]);
                 if(i<x.first.first.size()-1){write(" or ");}
             }
             write("){\n");
             if(x.first.second->type()!=ast::KAstNoLiteral){
                 write("auto ");
                 is_define=true;
-                x.first.second->accept(*this);
+                accept(x.first.second);
                 is_define=false;
                 write("=__P__exception;\n");
             }
-            x.second->accept(*this);
+            accept(x.second);
             write("}\n");
             local_mangle_end();
         }
@@ -1106,13 +1147,13 @@ bool Codegen::visit(const ast::TryExcept& node){
         if(node.except_clauses().size()>0){
             write("else{");
             local_mangle_start();
-            node.else_body()->accept(*this);
+            accept(node.else_body());
             local_mangle_end();
             write("}\n");
         }
         else{
             local_mangle_start();
-            node.else_body()->accept(*this);
+            accept(node.else_body());
             local_mangle_end();
         }
     }
@@ -1140,17 +1181,17 @@ bool Codegen::visit(const ast::TryExcept& node){
     return true; 
 }
 bool Codegen::visit(const ast::MultipleAssign& node){
-    auto values=node.values();
-    auto names=node.names();
+    auto& values=node.values();
+    auto& names=node.names();
     //TODO: Make it work with iterable and multiple function return 
     write("{");
     for(size_t i=0;i<values.size();++i){
         write("auto _____P____temp____"+std::to_string(i)+"=");
-        values[i]->accept(*this);
+        accept(values[i]);
         write(";");
     }
     for(size_t i=0;i<names.size();++i){
-        names[i]->accept(*this);
+        accept(names[i]);
         write("=_____P____temp____"+std::to_string(i));
         write(";");
     }
@@ -1158,27 +1199,27 @@ bool Codegen::visit(const ast::MultipleAssign& node){
     return true;
 }
 bool Codegen::visit(const ast::AugAssign& node){
-    node.name()->accept(*this);
+    accept(node.name());
     write(node.op());
-    node.value()->accept(*this);
+    accept(node.value());
     return true;
 }
 bool Codegen::visit(const ast::MethodDefinition& node){
     auto return_type=TurpleTypes(node.returnType());
     auto functionName =
-        std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())
+        static_cast<ast::IdentifierExpression*>(node.name())
             ->value();
     if (!is_func_def){
         is_func_def=true; 
         if(return_type.size()==0){
-            node.returnType()->accept(*this);
+            accept(node.returnType());
         }
         else{
             write("int");
         }
         write(" ");
         is_define=true;
-        node.name()->accept(*this);
+        accept(node.name());
         is_define=false;
         write("(");
         local_mangle_start();
@@ -1187,14 +1228,14 @@ bool Codegen::visit(const ast::MethodDefinition& node){
             write(",");
         }
         for(size_t i=0;i<return_type.size();i++){
-            return_type[i]->accept(*this);
+            accept(return_type[i]);
             write("*____P____RETURN____"+std::to_string(i)+"=NULL");
             if(i<return_type.size()-1){
                 write(",");
             }
         }
         write(") noexcept  {\n");
-        node.body()->accept(*this);
+        accept(node.body());
         write("\n}");
         local_mangle_end();
         is_func_def=false;
@@ -1203,7 +1244,7 @@ bool Codegen::visit(const ast::MethodDefinition& node){
         local_mangle_start();
         write("auto ");
         is_define=true;
-        node.name()->accept(*this);
+        accept(node.name());
         is_define=false;
         write("=[=](");
         codegenFuncParams(node.codegen_parameters());
@@ -1211,7 +1252,7 @@ bool Codegen::visit(const ast::MethodDefinition& node){
             write(",");
         }
         for(size_t i=0;i<return_type.size();i++){
-            return_type[i]->accept(*this);
+            accept(return_type[i]);
             write("*____P____RETURN____"+std::to_string(i)+"=NULL");
             if(i<return_type.size()-1){
                 write(",");
@@ -1219,13 +1260,13 @@ bool Codegen::visit(const ast::MethodDefinition& node){
         }
         write(")mutable noexcept ->");
         if(return_type.size()==0){
-                node.returnType()->accept(*this);
+                accept(node.returnType());
         }
         else{
             write("int");
         }
         write(" {\n");
-        node.body()->accept(*this);
+        accept(node.body());
         write("\n}");
         local_mangle_end();
     }
@@ -1233,15 +1274,15 @@ bool Codegen::visit(const ast::MethodDefinition& node){
 }
 bool Codegen::visit(const ast::ExternStructLiteral& node){
     write("extern \"C\" struct ");
-    std::string s_name=std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())->value();
+    std::string s_name=static_cast<ast::IdentifierExpression*>(node.name())->value();
     write(s_name);
     if(node.elements().size()>0){
         write("{\n");
-        auto elm=node.elements();
+        auto& elm=node.elements();
         for(auto& x:elm){
-            x.first->accept(*this);
+            accept(x.first);
             write(" ");
-            std::string f_name=std::dynamic_pointer_cast<ast::IdentifierExpression>(x.second)->value();
+            std::string f_name=static_cast<ast::IdentifierExpression*>(x.second)->value();
             write(f_name);
             write(";\n");
         }
@@ -1251,15 +1292,15 @@ bool Codegen::visit(const ast::ExternStructLiteral& node){
 }
 bool Codegen::visit(const ast::ExternUnionLiteral& node){
     write("extern \"C\" union ");
-    std::string s_name=std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())->value();
+    std::string s_name=static_cast<ast::IdentifierExpression*>(node.name())->value();
     write(s_name);
     if(node.elements().size()>0){
         write("{\n");
-        auto elm=node.elements();
+        auto& elm=node.elements();
         for(auto& x:elm){
-            x.first->accept(*this);
+            accept(x.first);
             write(" ");
-            std::string f_name=std::dynamic_pointer_cast<ast::IdentifierExpression>(x.second)->value();
+            std::string f_name=static_cast<ast::IdentifierExpression*>(x.second)->value();
             write(f_name);
             write(";\n");
         }
@@ -1269,17 +1310,17 @@ bool Codegen::visit(const ast::ExternUnionLiteral& node){
 }
 bool Codegen::visit(const ast::ExternFuncDef& node){
     write("extern \"C\" ");
-    node.returnType()->accept(*this);
-    std::string s_name=std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())->value();
+    accept(node.returnType());
+    std::string s_name=static_cast<ast::IdentifierExpression*>(node.name())->value();
     write(" "+s_name);
     write("(");
-    auto param=node.parameters();
+    auto& param=node.parameters();
     for(size_t i=0;i<param.size();i++){
         if(param[i]->type()==ast::KAstEllipsesTypeExpr){
             write("...");
         }
         else{
-            param[i]->accept(*this);
+            accept(param[i]);
         }
         if(i<param.size()-1){
             write(",");
@@ -1289,17 +1330,17 @@ bool Codegen::visit(const ast::ExternFuncDef& node){
     return true;
 }
 bool Codegen::visit(const ast::PrivateDef& node){
-    node.definition()->accept(*this);
+    accept(node.definition());
     return true;
 }
 bool Codegen::visit(const ast::InlineAsm& node){
     write("__asm__(\""+node.assembly()+"\"\n");
     if(node.output()->type()!=ast::KAstNoLiteral){
         write(": \"=r\" (");
-        node.output()->accept(*this);
+        accept(node.output());
         write(")\n");
     }
-    auto in=node.inputs();
+    auto& in=node.inputs();
     if(in.size()!=0){
         write(": ");
     }
@@ -1308,7 +1349,7 @@ bool Codegen::visit(const ast::InlineAsm& node){
         write("\"");
         write(x.first);
         write("\" (");
-        x.second->accept(*this);
+        accept(x.second);
         write(")\n");
         if(i<in.size()-1){
             write(",");
@@ -1327,7 +1368,7 @@ bool Codegen::visit(const ast::LambdaDefinition& node){
     codegenFuncParams(node.parameters());
     write(")mutable noexcept ->auto");
     write(" {\nreturn ");
-    node.body()->accept(*this);
+    accept(node.body());
     write(";\n}");
     return true;
 }
@@ -1335,9 +1376,9 @@ bool Codegen::pipeline(const ast::BinaryOperation& node){
     auto right=node.right();
     switch(right->type()){
         case ast::KAstIdentifier:{
-            right->accept(*this);
+            accept(right);
             write("(");
-            node.left()->accept(*this);
+            accept(node.left());
             if(is_func_def){
                 write(",____Pexception_handlers)");
             }
@@ -1347,17 +1388,17 @@ bool Codegen::pipeline(const ast::BinaryOperation& node){
             break;
         }
         case ast::KAstFunctionCall:{
-            auto function = std::dynamic_pointer_cast<ast::FunctionCall>(right);
-            function->name()->accept(*this);
+            auto function = static_cast<ast::FunctionCall*>(right);
+            accept(function->name());
             write("(");
-            node.left()->accept(*this);
-            auto args = function->arguments();
+            accept(node.left());
+            auto& args = function->arguments();
             if (args.size()) {
                 write(",");
                 for (size_t i = 0; i < args.size(); ++i) {
                     if (i)
                         write(", ");
-                    args[i]->accept(*this);
+                    accept(args[i]);
                 }
             }
             if(is_func_def){
@@ -1369,14 +1410,14 @@ bool Codegen::pipeline(const ast::BinaryOperation& node){
             break;
         }
         case ast::KAstDotExpression:{
-            auto exp = std::dynamic_pointer_cast<ast::DotExpression>(right);
-            exp->owner()->accept(*this);
+            auto exp = static_cast<ast::DotExpression*>(right);
+            accept(exp->owner());
             write(".");
             ast::AstNodePtr member=exp->referenced();
             if (member->type()==ast::KAstIdentifier){
-                auto attribute=std::dynamic_pointer_cast<ast::IdentifierExpression>(member)->value();
+                auto attribute=static_cast<ast::IdentifierExpression*>(member)->value();
                 write("____mem____P____P____"+attribute+"(");
-                node.left()->accept(*this);
+                accept(node.left());
                 if(is_func_def){
                     write(",____Pexception_handlers)");
                 }
@@ -1385,17 +1426,17 @@ bool Codegen::pipeline(const ast::BinaryOperation& node){
                 }
             }
             else if(member->type()==ast::KAstFunctionCall){
-                auto function = std::dynamic_pointer_cast<ast::FunctionCall>(member);
-                auto attribute=std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+                auto function = static_cast<ast::FunctionCall*>(member);
+                auto attribute=static_cast<ast::IdentifierExpression*>(function->name())->value();
                 write("____mem____P____P____"+attribute+"(");
-                node.left()->accept(*this);
-                auto args = function->arguments();
+                accept(node.left());
+                auto& args = function->arguments();
                 if (args.size()) {
                     write(", ");
                     for (size_t i = 0; i < args.size(); ++i) {
                         if (i)
                             write(", ");
-                        args[i]->accept(*this);
+                        accept(args[i]);
                     }
                 }
                 if(is_func_def){
@@ -1408,14 +1449,14 @@ bool Codegen::pipeline(const ast::BinaryOperation& node){
             break;
         }
         case ast::KAstArrowExpression:{
-            auto exp = std::dynamic_pointer_cast<ast::ArrowExpression>(right);
-            exp->owner()->accept(*this);
+            auto exp = static_cast<ast::ArrowExpression*>(right);
+            accept(exp->owner());
             write("->");
             ast::AstNodePtr member=exp->referenced();
             if (member->type()==ast::KAstIdentifier){
-                auto attribute=std::dynamic_pointer_cast<ast::IdentifierExpression>(member)->value();
+                auto attribute=static_cast<ast::IdentifierExpression*>(member)->value();
                 write("____mem____P____P____"+attribute+"(");
-                node.left()->accept(*this);
+                accept(node.left());
                 if(is_func_def){
                     write(",____Pexception_handlers)");
                 }
@@ -1424,17 +1465,17 @@ bool Codegen::pipeline(const ast::BinaryOperation& node){
                 }
             }
             else if(member->type()==ast::KAstFunctionCall){
-                auto function = std::dynamic_pointer_cast<ast::FunctionCall>(member);
-                auto attribute=std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+                auto function = static_cast<ast::FunctionCall*>(member);
+                auto attribute=static_cast<ast::IdentifierExpression*>(function->name())->value();
                 write("____mem____P____P____"+attribute+"(");
-                node.left()->accept(*this);
-                auto args = function->arguments();
+                accept(node.left());
+                auto& args = function->arguments();
                 if (args.size()) {
                     write(", ");
                     for (size_t i = 0; i < args.size(); ++i) {
                         if (i)
                             write(", ");
-                        args[i]->accept(*this);
+                        accept(args[i]);
                     }
                 }
                 if(is_func_def){
@@ -15,10 +15,21 @@ namespace cpp {
 using namespace Utils;
 typedef std::shared_ptr<SymbolTable<ast::AstNodePtr>> EnvPtr;
 
-class Codegen : public ast::AstVisitor {
+class Codegen : public ast::Visitor<Codegen> {
+    friend class ast::Visitor<Codegen>;
+    using ast::Visitor<Codegen>::visit;
+
   public:
     Codegen(std::string outputFilename, ast::AstNodePtr ast,std::string filename);
+    //for a file that is generated one top-level statement at a time, each
+    //statement is written out by emit() and finish() closes the output
+    Codegen(std::string outputFilename,std::string filename);
+    void emit(ast::AstNodePtr stmt);
+    void finish();
 
+    //bytes of C++ written and names in the mangling table, for -mem_report
+    size_t output_bytes() const;
+    size_t symbols() const;
 
   private:
     MangleName m_symbolMap;
@@ -33,6 +44,7 @@ class Codegen : public ast::AstVisitor {
     bool save=false;
     std::string m_filename;
     std::ofstream m_file;
+    size_t m_output_bytes=0;
     bool is_func_def=false;
     std::string write(std::string_view code);
 
@@ -41,7 +53,7 @@ class Codegen : public ast::AstVisitor {
     std::vector<ast::AstNodePtr> TurpleExpression(ast::AstNodePtr node);
     void codegenFuncParams(std::vector<ast::parameter> parameters,size_t start=0);
     void magic_method(ast::AstNodePtr& node,std::string name);
-    void write_name(std::shared_ptr<ast::FunctionDefinition> node,std::string name,std::string virtual_static_inline="",bool is_static=false);
+    void write_name(ast::FunctionDefinition* node,std::string name,std::string virtual_static_inline="",bool is_static=false);
     void matchArg(std::vector<ast::AstNodePtr> matchItem,
                   std::vector<ast::AstNodePtr> caseItem);
     std::string wrap(ast::AstNodePtr item,std::string contains);
@@ -12,7 +12,7 @@ namespace cpp {
 
 void Codegen::matchArg(std::vector<ast::AstNodePtr> matchItem,
                        std::vector<ast::AstNodePtr> caseItem) {
-    ast::AstNodePtr item;
+    ast::AstNodePtr item = nullptr;
     bool hasMatched = false;
 
     for (size_t i = 0; i < matchItem.size(); ++i) {
@@ -30,9 +30,9 @@ void Codegen::matchArg(std::vector<ast::AstNodePtr> matchItem,
             }
 
             write("(");
-            item->accept(*this);
+            accept(item);
             write("==");
-            caseItem[i]->accept(*this);
+            accept(caseItem[i]);
             write(")");
         }
     }
@@ -41,7 +41,7 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
     std::string var;
     switch(item->type()){
         case ast::KAstIdentifier:{
-            item->accept(*this);
+            accept(item);
             var+=res+"("+contains;
             if(is_func_def){
                 var+=",____Pexception_handlers)";
@@ -53,17 +53,17 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
             break;
         }
         case ast::KAstFunctionCall:{
-            auto function = std::dynamic_pointer_cast<ast::FunctionCall>(item);
-            function->name()->accept(*this);
+            auto function = static_cast<ast::FunctionCall*>(item);
+            accept(function->name());
             var+=res+"("+contains;
             res="";
-            auto args = function->arguments();
+            auto& args = function->arguments();
             if (args.size()) {
                 write(", ");
                 for (size_t i = 0; i < args.size(); ++i) {
                     if (i)
                         write(", ");
-                    args[i]->accept(*this);
+                    accept(args[i]);
                 }
             }
             var+=res;
@@ -77,15 +77,15 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
             break;
         }
         case ast::KAstDotExpression:{
-            auto exp = std::dynamic_pointer_cast<ast::DotExpression>(item);
-            exp->owner()->accept(*this);
+            auto exp = static_cast<ast::DotExpression*>(item);
+            accept(exp->owner());
             write(".");
             var+=res;
             res="";
             ast::AstNodePtr member=exp->referenced();
 
             if (member->type()==ast::KAstIdentifier){
-                auto attribute=std::dynamic_pointer_cast<ast::IdentifierExpression>(member)->value();
+                auto attribute=static_cast<ast::IdentifierExpression*>(member)->value();
                 write("____mem____P____P____"+attribute);
                 var+=res+"("+contains;
                 if(is_func_def){
@@ -97,18 +97,18 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
                 res="";
             }
             else if(member->type()==ast::KAstFunctionCall){
-                auto function = std::dynamic_pointer_cast<ast::FunctionCall>(member);
-                auto attribute=std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+                auto function = static_cast<ast::FunctionCall*>(member);
+                auto attribute=static_cast<ast::IdentifierExpression*>(function->name())->value();
                 write("____mem____P____P____"+attribute);
                 var+=res+"("+contains;
                 res="";
-                auto args = function->arguments();
+                auto& args = function->arguments();
                 if (args.size()) {
                     write(", ");
                     for (size_t i = 0; i < args.size(); ++i) {
                         if (i)
                             write(", ");
-                        args[i]->accept(*this);
+                        accept(args[i]);
                     }
                 }
                 var+=res;
@@ -123,15 +123,15 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
             break;
         }
         case ast::KAstArrowExpression:{
-            auto exp = std::dynamic_pointer_cast<ast::ArrowExpression>(item);
-            exp->owner()->accept(*this);
+            auto exp = static_cast<ast::ArrowExpression*>(item);
+            accept(exp->owner());
             write("->");
             var+=res;
             res="";
             ast::AstNodePtr member=exp->referenced();
 
             if (member->type()==ast::KAstIdentifier){
-                auto attribute=std::dynamic_pointer_cast<ast::IdentifierExpression>(member)->value();
+                auto attribute=static_cast<ast::IdentifierExpression*>(member)->value();
                 write("____mem____P____P____"+attribute);
                 var+=res+"("+contains;
                 if(is_func_def){
@@ -143,18 +143,18 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
                 res="";
             }
             else if(member->type()==ast::KAstFunctionCall){
-                auto function = std::dynamic_pointer_cast<ast::FunctionCall>(member);
-                auto attribute=std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+                auto function = static_cast<ast::FunctionCall*>(member);
+                auto attribute=static_cast<ast::IdentifierExpression*>(function->name())->value();
                 write("____mem____P____P____"+attribute);
                 var+=res+"("+contains;
                 res="";
-                auto args = function->arguments();
+                auto& args = function->arguments();
                 if (args.size()) {
                     write(", ");
                     for (size_t i = 0; i < args.size(); ++i) {
                         if (i)
                             write(", ");
-                        args[i]->accept(*this);
+                        accept(args[i]);
                     }
                 }
                 var+=res;
@@ -172,11 +172,11 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
     }
     return var;
 }
-void Codegen::write_name(std::shared_ptr<ast::FunctionDefinition> node,std::string name,std::string virtual_static_inline,bool is_static){
+void Codegen::write_name(ast::FunctionDefinition* node,std::string name,std::string virtual_static_inline,bool is_static){
     auto return_type=TurpleTypes(node->returnType());
     
     if(return_type.size()==0){
-        node->returnType()->accept(*this);
+        accept(node->returnType());
     }
     else{
         write("int");
@@ -194,7 +194,7 @@ void Codegen::write_name(std::shared_ptr<ast::FunctionDefinition> node,std::stri
         write(",");
     }
     for(size_t i=0;i<return_type.size();i++){
-        return_type[i]->accept(*this);
+        accept(return_type[i]);
         write("*____P____RETURN____"+std::to_string(i)+"=NULL");
         if(i<return_type.size()-1){
             write(",");
@@ -204,17 +204,17 @@ void Codegen::write_name(std::shared_ptr<ast::FunctionDefinition> node,std::stri
     if(!is_static){
         write("auto& ");
         is_define=true;
-        node->parameters()[0].p_name->accept(*this);
+        accept(node->parameters()[0].p_name);
         is_define=false;
         write("=*this;\n");
     }
     if(not is_func_def){
         is_func_def=true;
-        node->body()->accept(*this);
+        accept(node->body());
         is_func_def=false;
     }
     else{
-        node->body()->accept(*this);
+        accept(node->body());
     }
     local_mangle_end();
     write("\n}");
@@ -222,9 +222,9 @@ void Codegen::write_name(std::shared_ptr<ast::FunctionDefinition> node,std::stri
 void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
     switch(node->type()){
         case ast::KAstFunctionDef:{
-            std::shared_ptr<ast::FunctionDefinition> function =std::dynamic_pointer_cast<ast::FunctionDefinition>(node);
+            ast::FunctionDefinition* function =static_cast<ast::FunctionDefinition*>(node);
             assert(function->parameters().size()>0);
-            auto func_name =std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+            auto func_name =static_cast<ast::IdentifierExpression*>(function->name())->value();
             if(func_name=="__init__"){
                 write(name+"(");
                 local_mangle_start();
@@ -232,16 +232,16 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
                 write(") noexcept {\n");
                 write("auto& ");
                 is_define=true;
-                function->parameters()[0].p_name->accept(*this);
+                accept(function->parameters()[0].p_name);
                 is_define=false;
                 write("=*this;\n");
                 if(not is_func_def){
                     is_func_def=true;
-                    function->body()->accept(*this);
+                    accept(function->body());
                     is_func_def=false;
                 }
                 else{
-                    function->body()->accept(*this);
+                    accept(function->body());
                 }
                 write("\n}");
                 local_mangle_end();
@@ -253,16 +253,16 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
                 write("static ____P____exception_handler* ____Pexception_handlers=NULL;\n");
                 write("auto& ");
                 is_define=true;
-                function->parameters()[0].p_name->accept(*this);
+                accept(function->parameters()[0].p_name);
                 is_define=false;
                 write("=*this;\n");
                 if(not is_func_def){
                     is_func_def=true;
-                    function->body()->accept(*this);
+                    accept(function->body());
                     is_func_def=false;
                 }
                 else{
-                    function->body()->accept(*this);
+                    accept(function->body());
                 }
                 write("\n}");
                 local_mangle_end();
@@ -274,9 +274,9 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
         }
         case ast::KAstVirtual:{
             write("virtual ");
-            std::shared_ptr<ast::VirtualStatement> virtual_function =std::dynamic_pointer_cast<ast::VirtualStatement>(node);
-            std::shared_ptr<ast::FunctionDefinition> function =std::dynamic_pointer_cast<ast::FunctionDefinition>(virtual_function->body());
-            auto func_name =std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+            ast::VirtualStatement* virtual_function =static_cast<ast::VirtualStatement*>(node);
+            ast::FunctionDefinition* function =static_cast<ast::FunctionDefinition*>(virtual_function->body());
+            auto func_name =static_cast<ast::IdentifierExpression*>(function->name())->value();
             assert(function->parameters().size()>0);
             if(func_name=="__init__"){
                 write(name+"(");
@@ -285,16 +285,16 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
                 write(") noexcept {\n");
                 write("auto& ");
                 is_define=true;
-                function->parameters()[0].p_name->accept(*this);
+                accept(function->parameters()[0].p_name);
                 is_define=false;
                 write("=*this;\n");
                 if(not is_func_def){
                     is_func_def=true;
-                    function->body()->accept(*this);
+                    accept(function->body());
                     is_func_def=false;
                 }
                 else{
-                    function->body()->accept(*this);
+                    accept(function->body());
                 }
                 write("\n}");
                 local_mangle_end();
@@ -306,16 +306,16 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
                 write("static ____P____exception_handler* ____Pexception_handlers=NULL;\n");
                 write("auto& ");
                 is_define=true;
-                function->parameters()[0].p_name->accept(*this);
+                accept(function->parameters()[0].p_name);
                 is_define=false;
                 write("=*this;\n");
                 if(not is_func_def){
                     is_func_def=true;
-                    function->body()->accept(*this);
+                    accept(function->body());
                     is_func_def=false;
                 }
                 else{
-                    function->body()->accept(*this);
+                    accept(function->body());
                 }
                 write("\n}");
                 local_mangle_end();
@@ -327,9 +327,9 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
         }
         case ast::KAstInline:{
             write("inline ");
-            std::shared_ptr<ast::InlineStatement> inline_function =std::dynamic_pointer_cast<ast::InlineStatement>(node);
-            std::shared_ptr<ast::FunctionDefinition> function =std::dynamic_pointer_cast<ast::FunctionDefinition>(inline_function->body());
-            auto func_name =std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+            ast::InlineStatement* inline_function =static_cast<ast::InlineStatement*>(node);
+            ast::FunctionDefinition* function =static_cast<ast::FunctionDefinition*>(inline_function->body());
+            auto func_name =static_cast<ast::IdentifierExpression*>(function->name())->value();
             assert(function->parameters().size()>0);
             if(func_name=="__init__"){
                 write(name+"(");
@@ -338,16 +338,16 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
                 write(") noexcept {\n");
                 write("auto& ");
                 is_define=true;
-                function->parameters()[0].p_name->accept(*this);
+                accept(function->parameters()[0].p_name);
                 is_define=false;
                 write("=*this;\n");
                 if(not is_func_def){
                     is_func_def=true;
-                    function->body()->accept(*this);
+                    accept(function->body());
                     is_func_def=false;
                 }
                 else{
-                    function->body()->accept(*this);
+                    accept(function->body());
                 }
                 write("\n}");
                 local_mangle_end();
@@ -359,16 +359,16 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
                 write("static ____P____exception_handler* ____Pexception_handlers=NULL;\n");
                 write("auto& ");
                 is_define=true;
-                function->parameters()[0].p_name->accept(*this);
+                accept(function->parameters()[0].p_name);
                 is_define=false;
                 write("=*this;\n");
                 if(not is_func_def){
                     is_func_def=true;
-                    function->body()->accept(*this);
+                    accept(function->body());
                     is_func_def=false;
                 }
                 else{
-                    function->body()->accept(*this);
+                    accept(function->body());
                 }
                 write("\n}");
                 local_mangle_end();
@@ -380,23 +380,23 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
         }
         case ast::KAstStatic:{
             write("static ");
-            std::shared_ptr<ast::StaticStatement> static_function =std::dynamic_pointer_cast<ast::StaticStatement>(node);
+            ast::StaticStatement* static_function =static_cast<ast::StaticStatement*>(node);
             if (static_function->body()->type()==ast::KAstFunctionDef){
-                std::shared_ptr<ast::FunctionDefinition> function =std::dynamic_pointer_cast<ast::FunctionDefinition>(static_function->body());
-                auto func_name =std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+                ast::FunctionDefinition* function =static_cast<ast::FunctionDefinition*>(static_function->body());
+                auto func_name =static_cast<ast::IdentifierExpression*>(function->name())->value();
                 write_name(function,func_name,"static",true);
             }
             else if (static_function->body()->type()==ast::KAstInline){
                 write("inline ");
-                std::shared_ptr<ast::InlineStatement> inline_function =std::dynamic_pointer_cast<ast::InlineStatement>(static_function->body());
-                std::shared_ptr<ast::FunctionDefinition> function =std::dynamic_pointer_cast<ast::FunctionDefinition>(inline_function->body());
-                auto func_name =std::dynamic_pointer_cast<ast::IdentifierExpression>(function->name())->value();
+                ast::InlineStatement* inline_function =static_cast<ast::InlineStatement*>(static_function->body());
+                ast::FunctionDefinition* function =static_cast<ast::FunctionDefinition*>(inline_function->body());
+                auto func_name =static_cast<ast::IdentifierExpression*>(function->name())->value();
                 write_name(function,func_name,"static inline",true);
             }
             break;
         }
         case ast::KAstDecorator:{
-            node->accept(*this);
+            accept(node);
             break;
         }
         default:{}
@@ -405,7 +405,7 @@ void Codegen::magic_method(ast::AstNodePtr& node,std::string name){
 std::vector<ast::AstNodePtr> Codegen::TurpleTypes(ast::AstNodePtr node){
     std::vector<ast::AstNodePtr> turple_types;
     if(node->type()==ast::KAstTypeTuple){
-        std::shared_ptr<ast::TypeTuple> turple =std::dynamic_pointer_cast<ast::TypeTuple>(node);
+        ast::TypeTuple* turple =static_cast<ast::TypeTuple*>(node);
         turple_types=turple->items();
     }
     
@@ -414,7 +414,7 @@ std::vector<ast::AstNodePtr> Codegen::TurpleTypes(ast::AstNodePtr node){
 std::vector<ast::AstNodePtr> Codegen::TurpleExpression(ast::AstNodePtr node){
     std::vector<ast::AstNodePtr> turple_exp;
     if(node->type()==ast::KAstExpressionTuple){
-        std::shared_ptr<ast::ExpressionTuple> turple =std::dynamic_pointer_cast<ast::ExpressionTuple>(node);
+        ast::ExpressionTuple* turple =static_cast<ast::ExpressionTuple*>(node);
         turple_exp=turple->items();
     }
     
@@ -19,7 +19,7 @@ Codegen::Codegen(std::string outputFilename, ast::AstNodePtr ast, bool html, std
     }
     m_file << "function render(code){document.write(code);}error___AssertionError=0;error___ZeroDivisionError=1\n";
     m_env = createEnv();
-    ast->accept(*this);
+    accept(ast);
     m_file<<"\nmain();";
     if(html){
         m_file<<"</script></body></html>";
@@ -64,14 +64,14 @@ void Codegen::codegenFuncParams(std::vector<ast::parameter> parameters) {
         for (size_t i = 0; i < parameters.size(); ++i) {
             if (i)
                 write(", ");
-            parameters[i].p_name->accept(*this);
+            accept(parameters[i].p_name);
         }
     }
 }
 
 bool Codegen::visit(const ast::Program& node) {
     for (auto& stmt : node.statements()) {
-        stmt->accept(*this);
+        accept(stmt);
         write(";\n"); // TODO: will this break stuff later?
                      // no
     }
@@ -81,7 +81,7 @@ bool Codegen::visit(const ast::Program& node) {
 bool Codegen::visit(const ast::BlockStatement& node) {
     for (auto& stmt : node.statements()) {
         write("    ");
-        stmt->accept(*this);
+        accept(stmt);
         write(";\n");
     }
     return true;
@@ -91,7 +91,7 @@ bool Codegen::visit(const ast::ImportStatement& node) { return true; }
 
 bool Codegen::visit(const ast::FunctionDefinition& node) {
     auto functionName =
-        std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())
+        static_cast<ast::IdentifierExpression*>(node.name())
             ->value();
     if (!is_func_def){
         is_func_def = true;
@@ -100,26 +100,26 @@ bool Codegen::visit(const ast::FunctionDefinition& node) {
             write("function main (");
             codegenFuncParams(node.parameters());
             write(") {\n");
-            node.body()->accept(*this);
+            accept(node.body());
             write("return 0;\n}");
         } else {
             write("function ");
-            node.name()->accept(*this);
+            accept(node.name());
             write("(");
             codegenFuncParams(node.parameters());
             write(") {\n");
-            node.body()->accept(*this);
+            accept(node.body());
             write("\n}");
         }
         is_func_def=false;
     }
     else{
-        node.name()->accept(*this);
+        accept(node.name());
         write("=function(");
         codegenFuncParams(node.parameters());
         write(")");
         write("{\n");
-        node.body()->accept(*this);
+        accept(node.body());
         write("\n}");
     }
     return true;
@@ -129,10 +129,10 @@ bool Codegen::visit(const ast::VariableStatement& node) {
     if (node.varType()->type() != ast::KAstNoLiteral) {
         write("let ");
     }
-    node.name()->accept(*this);
+    accept(node.name());
     if (node.value()->type() != ast::KAstNoLiteral) {
         write(" = ");
-        node.value()->accept(*this);
+        accept(node.value());
     }
     return true;
 }
@@ -140,9 +140,9 @@ bool Codegen::visit(const ast::VariableStatement& node) {
 bool Codegen::visit(const ast::ConstDeclaration& node) {
     write("const ");
     write(" ");
-    node.name()->accept(*this);
+    accept(node.name());
     write("=");
-    node.value()->accept(*this);
+    accept(node.value());
     return true;
     }
 
@@ -167,19 +167,19 @@ bool Codegen::visit(const ast::PassStatement& node) {
 
 bool Codegen::visit(const ast::IfStatement& node) {
     write("if (");
-    node.condition()->accept(*this);
+    accept(node.condition());
     write(") {\n");
-    node.ifBody()->accept(*this);
+    accept(node.ifBody());
     write("}");
 
-    auto elifNode = node.elifs();
+    auto& elifNode = node.elifs();
     if (elifNode.size() != 0) {
         write("\n");
         for (auto& body : elifNode) { // making sure that elif exists
             write("else if (");
-            body.first->accept(*this);
+            accept(body.first);
             write(") {\n");
-            body.second->accept(*this);
+            accept(body.second);
             write("}");
         }
     }
@@ -188,7 +188,7 @@ bool Codegen::visit(const ast::IfStatement& node) {
     if (elseNode->type() ==
         ast::KAstBlockStmt) { // making sure that else exists
         write("\nelse {\n");
-        elseNode->accept(*this);
+        accept(elseNode);
         write("}");
     }
     return true;
@@ -196,9 +196,9 @@ bool Codegen::visit(const ast::IfStatement& node) {
 
 bool Codegen::visit(const ast::WhileStatement& node) {
     write("while (");
-    node.condition()->accept(*this);
+    accept(node.condition());
     write(") {\n");
-    node.body()->accept(*this);
+    accept(node.body());
     write("}");
     return true;
 }
@@ -206,8 +206,8 @@ bool Codegen::visit(const ast::WhileStatement& node) {
 bool Codegen::visit(const ast::ForStatement& node) { return true; }
 
 bool Codegen::visit(const ast::MatchStatement& node) {
-    auto toMatch = node.matchItem();
-    auto cases = node.caseBody();
+    auto& toMatch = node.matchItem();
+    auto& cases = node.caseBody();
     auto defaultBody = node.defaultBody();
     write("\nwhile (true) {\n");
     for (size_t i = 0; i < cases.size(); ++i) {
@@ -215,30 +215,30 @@ bool Codegen::visit(const ast::MatchStatement& node) {
         if (currCase.first.size() == 1 &&
             currCase.first[0]->type() == ast::KAstNoLiteral) {
             if (i == 0) {
-                currCase.second->accept(*this);
+                accept(currCase.second);
                 write("\n");
             } else {
                 write("else {\n");
-                currCase.second->accept(*this);
+                accept(currCase.second);
                 write("\n}\n");
             }
         } else if (i == 0) {
             write("if (");
             matchArg(toMatch, currCase.first);
             write(") {\n");
-            currCase.second->accept(*this);
+            accept(currCase.second);
             write("\n}\n");
         } else {
             write("else if (");
             matchArg(toMatch, currCase.first);
             write(") {\n");
-            currCase.second->accept(*this);
+            accept(currCase.second);
             write("\n}\n");
         }
     }
 
     if (defaultBody->type() != ast::KAstNoLiteral) {
-        defaultBody->accept(*this);
+        accept(defaultBody);
     }
     write("\nbreak;\n}");
     return true;
@@ -246,7 +246,7 @@ bool Codegen::visit(const ast::MatchStatement& node) {
 
 bool Codegen::visit(const ast::ScopeStatement& node) {
     write("{\n");
-    node.body()->accept(*this);
+    accept(node.body());
     write("\n}");
     return true;
 }
@@ -254,7 +254,7 @@ bool Codegen::visit(const ast::ScopeStatement& node) {
 bool Codegen::visit(const ast::ReturnStatement& node) {
     write("return ");
     if(node.returnValue()->type()!=ast::KAstNoLiteral){
-        node.returnValue()->accept(*this); 
+        accept(node.returnValue()); 
     }
     return true;
 }
@@ -270,7 +270,7 @@ bool Codegen::visit(const ast::BreakStatement& node) {
 }
 
 bool Codegen::visit(const ast::DecoratorStatement& node) {
-    auto items = node.decoratorItem();
+    auto& items = node.decoratorItem();
     auto body = node.body();
     std::string contains;
     std::string x;
@@ -281,9 +281,9 @@ bool Codegen::visit(const ast::DecoratorStatement& node) {
         res="";
     }
     if(body->type()==ast::KAstFunctionDef){
-        auto function = std::dynamic_pointer_cast<ast::FunctionDefinition>(body);
+        auto function = static_cast<ast::FunctionDefinition*>(body);
         write("let ");
-        function->name()->accept(*this);
+        accept(function->name());
         write("=");
         x+=res;
         res="";
@@ -293,11 +293,11 @@ bool Codegen::visit(const ast::DecoratorStatement& node) {
         write("{\n");
         if(!is_func_def){
             is_func_def=true;
-            function->body()->accept(*this);
+            accept(function->body());
             is_func_def=false;
         }
         else{
-            function->body()->accept(*this);
+            accept(function->body());
         }
         write("\n}");
         contains=res;
@@ -320,10 +320,10 @@ bool Codegen::visit(const ast::DecoratorStatement& node) {
 
 bool Codegen::visit(const ast::ListLiteral& node) {
     write("[");
-    auto elements=node.elements();
+    auto& elements=node.elements();
     if (elements.size()>0){
         for (size_t i=0;i<elements.size();++i){
-            elements[i]->accept(*this);
+            accept(elements[i]);
             if (i<elements.size()-1){
                 write(",");
             }
@@ -334,13 +334,13 @@ bool Codegen::visit(const ast::ListLiteral& node) {
 }
 
 bool Codegen::visit(const ast::DictLiteral& node) {
-    auto elements=node.elements();
+    auto& elements=node.elements();
     write("{");
     if (elements.size()>0){
         for (size_t i=0;i<elements.size();++i){
-            elements[i].first->accept(*this);
+            accept(elements[i].first);
             write(":");
-            elements[i].second->accept(*this);
+            accept(elements[i].second);
             if (i<elements.size()-1){
                 write(",");
             }
@@ -351,25 +351,25 @@ bool Codegen::visit(const ast::DictLiteral& node) {
 }
 
 bool Codegen::visit(const ast::ListOrDictAccess& node) {
-    node.container()->accept(*this);
+    accept(node.container());
     write("[");
-    node.keyOrIndex()[0]->accept(*this);//TODO: Wont work in the future
+    accept(node.keyOrIndex()[0]);//TODO: Wont work in the future
     write("]");
     return true;
 }
 
 bool Codegen::visit(const ast::BinaryOperation& node) {
-    // if (node.op().keyword == "**") {
+    // if (node.op().keyword() == "**") {
     //     write("_P_POWER(");
-    //     node.left()->accept(*this);
+    //     accept(node.left());
     //     write(",");
-    //     node.right()->accept(*this);
+    //     accept(node.right());
     //     write(")");
-    // } else if (node.op().keyword == "//") {
+    // } else if (node.op().keyword() == "//") {
     //     write("_P_FLOOR(");
-    //     node.left()->accept(*this);
+    //     accept(node.left());
     //     write("/");
-    //     node.right()->accept(*this);
+    //     accept(node.right());
     //     write(")");
     // }
     if(node.token().tkType==tk_pipeline){
@@ -377,36 +377,36 @@ bool Codegen::visit(const ast::BinaryOperation& node) {
     }
     else {
         write("(");
-        node.left()->accept(*this);
-        if (node.op().keyword=="=="){
+        accept(node.left());
+        if (node.op().keyword()=="=="){
             write(" === ");
         }
         else{
-            write(" " + node.op().keyword + " ");
+            write(" " + node.op().keyword() + " ");
         }
-        node.right()->accept(*this);
+        accept(node.right());
         write(")");
     }
     return true;
 }
 
 bool Codegen::visit(const ast::PrefixExpression& node) {
-    write("(" + node.prefix().keyword + " ");
-    node.right()->accept(*this);
+    write("(" + node.prefix().keyword() + " ");
+    accept(node.right());
     write(")");
     return true;
 }
 
 bool Codegen::visit(const ast::FunctionCall& node) {
-    node.name()->accept(*this);
+    accept(node.name());
     write("(");
 
-    auto args = node.arguments();
+    auto& args = node.arguments();
     if (args.size()) {
         for (size_t i = 0; i < args.size(); ++i) {
             if (i)
                 write(", ");
-            args[i]->accept(*this);
+            accept(args[i]);
         }
     }
 
@@ -419,29 +419,29 @@ bool Codegen::visit(const ast::DotExpression& node) {
     if (!is_dot_exp){
         is_dot_exp=true;
         if (node.owner()->type()==ast::KAstIdentifier){
-            std::string name = std::dynamic_pointer_cast<ast::IdentifierExpression>(node.owner())->value();
+            std::string name = static_cast<ast::IdentifierExpression*>(node.owner())->value();
             if(std::count(enum_name.begin(), enum_name.end(), name)){
                 write(name+"___");
-                node.referenced()->accept(*this);
+                accept(node.referenced());
             }
             else{
-                node.owner()->accept(*this);
+                accept(node.owner());
                 write(".");
-                node.referenced()->accept(*this);
+                accept(node.referenced());
             }
         is_dot_exp=false;
         }
         else {
-            node.owner()->accept(*this);
+            accept(node.owner());
             write(".");
-            node.referenced()->accept(*this);
+            accept(node.referenced());
         }
         is_dot_exp=false;
     }
     else{
-        node.owner()->accept(*this);
+        accept(node.owner());
         write(".");
-        node.referenced()->accept(*this);
+        accept(node.referenced());
     }
     return true;
 }
@@ -504,32 +504,32 @@ bool Codegen::visit(const ast::NoneLiteral& node) {
 }
 bool Codegen::visit(const ast::AssertStatement& node){
     write("if(! ");
-    node.condition()->accept(*this);
+    accept(node.condition());
     write("){\n");
-    write("console.log(\"AssertionError : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+node.token().statement+"\");throw error___AssertionError;");
+    write("console.log(\"AssertionError : in line "+std::to_string(node.token().line)+" in file "+m_filename+"\\n   "+escape_quotes(node.token().statement())+"\");throw error___AssertionError;");
     write("\n}");
     return true;
 }
 bool Codegen::visit(const ast::RaiseStatement& node){
     write("throw ");
     if(node.value()->type()!=ast::KAstNoLiteral){
-        node.value()->accept(*this);
+        accept(node.value());
     }
     return true;
 }
 bool Codegen::visit(const ast::EnumLiteral& node){
-    auto fields=node.fields();
-    std::string name=std::dynamic_pointer_cast<ast::IdentifierExpression>(node.name())->value();
+    auto& fields=node.fields();
+    std::string name=static_cast<ast::IdentifierExpression*>(node.name())->value();
     enum_name.push_back(name);
-    ast::AstNodePtr prev_element;
+    ast::AstNodePtr prev_element = nullptr;
     for (size_t i=0;i<fields.size();++i){
         auto field=fields[i];
         write(name+"___");
-        field.first->accept(*this);
+        accept(field.first);
         write(" = ");
         if (field.second->type()!=ast::KAstNoLiteral){
             is_enum=true;
-            field.second->accept(*this);
+            accept(field.second);
             is_enum=false;
         }
         else{
@@ -538,7 +538,7 @@ bool Codegen::visit(const ast::EnumLiteral& node){
             }
             else{
                 write(name+"___");
-                prev_element->accept(*this);
+                accept(prev_element);
                 write("+1");
             }
         }
@@ -549,21 +549,21 @@ bool Codegen::visit(const ast::EnumLiteral& node){
 }
 bool Codegen::visit(const ast::ExportStatement& node){
     //dont mangle this name
-    node.body()->accept(*this);
+    accept(node.body());
     return true;
 }
 bool Codegen::visit(const ast::TernaryIf& node){
     write("(");
-    node.if_condition()->accept(*this);
+    accept(node.if_condition());
     write(")?");
-    node.if_value()->accept(*this);
+    accept(node.if_value());
     write(":");
-    node.else_value()->accept(*this);
+    accept(node.else_value());
     return true;
 }
 bool Codegen::visit(const ast::TryExcept& node){
     write("try{\n");
-    node.body()->accept(*this);
+    accept(node.body());
     //TODO:This should be base exception
     write("}\ncatch(__P__exception){\n");
     if(node.except_clauses().size()>0){
@@ -571,43 +571,43 @@ bool Codegen::visit(const ast::TryExcept& node){
         auto x=node.except_clauses()[0];
         for (size_t i=0;i<x.first.first.size();++i){
             write("__P__exception===");
-            x.first.first[i]->accept(*this);
+            accept(x.first.first[i]);
             if(i<x.first.first.size()-1){write("||");}
         }
         write("){\n");
         if(x.first.second->type()!=ast::KAstNoLiteral){
             write("let ");
-            x.first.second->accept(*this);
+            accept(x.first.second);
             write("=__P__exception;\n");
         }
-        x.second->accept(*this);
+        accept(x.second);
         write("}\n");
         for(size_t i=1;i<node.except_clauses().size();++i){
             write("else if (");
             auto x=node.except_clauses()[i];
             for (size_t i=0;i<x.first.first.size();++i){
                 write("__P__exception===");
-                x.first.first[i]->accept(*this);
+                accept(x.first.first[i]);
                 if(i<x.first.first.size()-1){write("||");}
             }
             write("){\n");
             if(x.first.second->type()!=ast::KAstNoLiteral){
                 write("let ");
-                x.first.second->accept(*this);
+                accept(x.first.second);
                 write("=__P__exception;\n");
             }
-            x.second->accept(*this);
+            accept(x.second);
             write("}\n");
         }
     }
     if(node.else_body()->type()!=ast::KAstNoLiteral){
         if(node.except_clauses().size()>0){
             write("else{");
-            node.else_body()->accept(*this);
+            accept(node.else_body());
             write("}\n");
         }
         else{
-            node.else_body()->accept(*this);
+            accept(node.else_body());
         }
     }
     else{
@@ -624,22 +624,22 @@ bool Codegen::visit(const ast::TryExcept& node){
     return true; 
 }
 bool Codegen::visit(const ast::PostfixExpression& node) {
-    node.left()->accept(*this);
-    write(node.postfix().keyword);
+    accept(node.left());
+    write(node.postfix().keyword());
     return true;
 }
 bool Codegen::visit(const ast::MultipleAssign& node){
-    auto values=node.values();
-    auto names=node.names();
+    auto& values=node.values();
+    auto& names=node.names();
     //TODO: Make it work with iterable and multiple function return 
     write("{");
     for(size_t i=0;i<values.size();++i){
         write("let _____P____temp____"+std::to_string(i)+"=");
-        values[i]->accept(*this);
+        accept(values[i]);
         write(";");
     }
     for(size_t i=0;i<names.size();++i){
-        names[i]->accept(*this);
+        accept(names[i]);
         write("=_____P____temp____"+std::to_string(i));
         write(";");
     }
@@ -647,16 +647,16 @@ bool Codegen::visit(const ast::MultipleAssign& node){
     return true;
 }
 bool Codegen::visit(const ast::AugAssign& node){
-    node.name()->accept(*this);
+    accept(node.name());
     write(node.op());
-    node.value()->accept(*this);
+    accept(node.value());
     return true;
 }
 bool Codegen::visit(const ast::LambdaDefinition& node){
     write("function(");
     codegenFuncParams(node.parameters());
     write("){return");
-    node.body()->accept(*this);
+    accept(node.body());
     write(";}");
     return true;
 }
@@ -664,51 +664,51 @@ bool Codegen::pipeline(const ast::BinaryOperation& node){
     auto right=node.right();
     switch(right->type()){
         case ast::KAstIdentifier:{
-            right->accept(*this);
+            accept(right);
             write("(");
-            node.left()->accept(*this);
+            accept(node.left());
             write(")");
             break;
         }
         case ast::KAstFunctionCall:{
-            auto function = std::dynamic_pointer_cast<ast::FunctionCall>(right);
-            function->name()->accept(*this);
+            auto function = static_cast<ast::FunctionCall*>(right);
+            accept(function->name());
             write("(");
-            node.left()->accept(*this);
-            auto args = function->arguments();
+            accept(node.left());
+            auto& args = function->arguments();
             if (args.size()) {
                 write(",");
                 for (size_t i = 0; i < args.size(); ++i) {
                     if (i)
                         write(", ");
-                    args[i]->accept(*this);
+                    accept(args[i]);
                 }
             }
             write(")");
             break;
         }
         case ast::KAstDotExpression:{
-            auto exp = std::dynamic_pointer_cast<ast::DotExpression>(right);
-            exp->owner()->accept(*this);
+            auto exp = static_cast<ast::DotExpression*>(right);
+            accept(exp->owner());
             write(".");
             ast::AstNodePtr member=exp->referenced();
-            member->accept(*this);
+            accept(member);
             if (member->type()==ast::KAstIdentifier){
                 write("(");
-                node.left()->accept(*this);
+                accept(node.left());
                 write(")");
             }
             else if(member->type()==ast::KAstFunctionCall){
-                auto function = std::dynamic_pointer_cast<ast::FunctionCall>(member);
+                auto function = static_cast<ast::FunctionCall*>(member);
                 write("(");
-                node.left()->accept(*this);
-                auto args = function->arguments();
+                accept(node.left());
+                auto& args = function->arguments();
                 if (args.size()) {
                     write(", ");
                     for (size_t i = 0; i < args.size(); ++i) {
                         if (i)
                             write(", ");
-                        args[i]->accept(*this);
+                        accept(args[i]);
                     }
                 }
                 write(")");
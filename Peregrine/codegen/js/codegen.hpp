@@ -14,7 +14,10 @@ namespace js {
 using namespace Utils;
 typedef std::shared_ptr<SymbolTable<ast::AstNodePtr>> EnvPtr;
 
-class Codegen : public ast::AstVisitor {
+class Codegen : public ast::Visitor<Codegen> {
+    friend class ast::Visitor<Codegen>;
+    using ast::Visitor<Codegen>::visit;
+
   public:
     Codegen(std::string outputFilename, ast::AstNodePtr ast,bool html,std::string filename);
 
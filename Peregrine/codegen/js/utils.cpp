@@ -4,7 +4,7 @@ namespace js {
 
 void Codegen::matchArg(std::vector<ast::AstNodePtr> matchItem,
                        std::vector<ast::AstNodePtr> caseItem) {
-    ast::AstNodePtr item;
+    ast::AstNodePtr item = nullptr;
     bool hasMatched = false;
 
     for (size_t i = 0; i < matchItem.size(); ++i) {
@@ -22,9 +22,9 @@ void Codegen::matchArg(std::vector<ast::AstNodePtr> matchItem,
             }
 
             write("(");
-            item->accept(*this);
+            accept(item);
             write("===");
-            caseItem[i]->accept(*this);
+            accept(caseItem[i]);
             write(")");
         }
     }
@@ -33,22 +33,22 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
     std::string var;
     switch(item->type()){
         case ast::KAstIdentifier:{
-            item->accept(*this);
+            accept(item);
             var+=res+"("+contains+")";
             res="";
             break;
         }
         case ast::KAstFunctionCall:{
-            auto function = std::dynamic_pointer_cast<ast::FunctionCall>(item);
-            function->name()->accept(*this);
+            auto function = static_cast<ast::FunctionCall*>(item);
+            accept(function->name());
             var+=res+"("+contains;
             res="";
-            auto args = function->arguments();
+            auto& args = function->arguments();
             if (args.size()) {
                 for (size_t i = 0; i < args.size(); ++i) {
                     if (i)
                         write(", ");
-                    args[i]->accept(*this);
+                    accept(args[i]);
                 }
             }
             var+=res+")";
@@ -56,36 +56,36 @@ std::string Codegen::wrap(ast::AstNodePtr item,std::string contains){
             break;
         }
         case ast::KAstDotExpression:{
-            auto exp = std::dynamic_pointer_cast<ast::DotExpression>(item);
-            exp->owner()->accept(*this);
+            auto exp = static_cast<ast::DotExpression*>(item);
+            accept(exp->owner());
             write(".");
             var+=res;
             res="";
             ast::AstNodePtr member=exp->referenced();
 //            while(member->type()==ast::KAstDotExpression){
-//                auto curr = std::dynamic_pointer_cast<ast::DotExpression>(member);
-//                curr->owner()->accept(*this);
+//                auto curr = static_cast<ast::DotExpression*>(member);
+//                accept(curr->owner());
 //                write(".");
 //                var+=res;
 //                res="";
 //                member=curr->referenced();
 //            }
             if (member->type()==ast::KAstIdentifier){
-                member->accept(*this);
+                accept(member);
                 var+=res+"("+contains+")";
                 res="";
             }
             else if(member->type()==ast::KAstFunctionCall){
-                auto function = std::dynamic_pointer_cast<ast::FunctionCall>(member);
-                function->name()->accept(*this);
+                auto function = static_cast<ast::FunctionCall*>(member);
+                accept(function->name());
                 var+=res+"("+contains;
                 res="";
-                auto args = function->arguments();
+                auto& args = function->arguments();
                 if (args.size()) {
                     for (size_t i = 0; i < args.size(); ++i) {
                         if (i)
                             write(", ");
-                        args[i]->accept(*this);
+                        accept(args[i]);
                     }
                 }
                 var+=res+")";
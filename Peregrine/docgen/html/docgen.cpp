@@ -47,7 +47,7 @@ Docgen::Docgen(std::string outputFilename, ast::AstNodePtr ast,std::string file)
     style+="hr {border: none; height: 1px;background-color: #333;}";
     m_file<<"<html lang=\"en\"><head><meta charset=\"UTF-8\"><meta http-equiv=\"X-UA-Compatible\" content=\"IE=edge\"><meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\"><title>DOCS</title> <style type=\"text/css\">"+style+"</style></head><body>";
     res+="<h1 id=\"content\">"+module_name(file);
-    ast->accept(*this);
+    accept(ast);
     write(res);
     m_file<<"</body></html>";
     m_file.close();
@@ -70,7 +70,7 @@ bool Docgen::visit(const ast::Program& node) {
         case KAstDecorator:
         case KAstMethodDef:
         case KAstClassDef:{
-          stmt->accept(*this);
+          accept(stmt);
           break;
         }
         default:{}
@@ -87,7 +87,7 @@ bool Docgen::visit(const ClassDefinition& node) {
     res+="<a href=\"#"+str+"\" class=\"local\"> #</a></h2><hr>";
     res+="<h3><div class=\"code\"><font color=#63b3ed>class</font> ";
     res+="<font color=#45a4a0>"+class_name+"</font>(";
-    auto parents=node.parent();
+    auto& parents=node.parent();
     for (size_t i=0;i<parents.size();++i){
         res+="<font color=#45a4a0>"+parents[i]->stringify()+"</font>";
         if(i<parents.size()-1){res+=",";}
@@ -101,7 +101,7 @@ bool Docgen::visit(const ClassDefinition& node) {
       res+="None";
     }
     for (auto& x:node.methods()){
-      x->accept(*this);
+      accept(x);
     }
     if(node.methods().size()==0){
       res+="<hr>";
@@ -113,16 +113,16 @@ bool Docgen::visit(const ClassDefinition& node) {
 bool Docgen::visit(const DecoratorStatement& node) {
     std::string larger;
     std::string smaller;
-    std::shared_ptr<FunctionDefinition> body;
+    FunctionDefinition* body;
     std::string prefix="";
     if (node.body()->type()==KAstStatic){
       prefix="static ";
-      body=std::dynamic_pointer_cast<FunctionDefinition>(
-        std::dynamic_pointer_cast<StaticStatement>(node.body())->body()
+      body=static_cast<FunctionDefinition*>(
+        static_cast<StaticStatement*>(node.body())->body()
       );
     }
     else{
-      body=std::dynamic_pointer_cast<FunctionDefinition>(node.body());
+      body=static_cast<FunctionDefinition*>(node.body());
     }
     id++;
     auto str="id"+std::to_string(id);
@@ -193,16 +193,16 @@ bool Docgen::visit(const FunctionDefinition& node) {
 bool Docgen::visit(const StaticStatement& node) {
     std::string larger;
     std::string smaller;
-    std::shared_ptr<FunctionDefinition> body;
+    FunctionDefinition* body;
     std::string prefix="static";
     if (node.body()->type()==KAstInline){
       prefix="static inline";
-      body=std::dynamic_pointer_cast<FunctionDefinition>(
-        std::dynamic_pointer_cast<InlineStatement>(node.body())->body()
+      body=static_cast<FunctionDefinition*>(
+        static_cast<InlineStatement*>(node.body())->body()
       );
     }
     else if(node.body()->type()==KAstFunctionDef){
-      body=std::dynamic_pointer_cast<FunctionDefinition>(node.body());
+      body=static_cast<FunctionDefinition*>(node.body());
     }
     else{
       return true;
@@ -240,7 +240,7 @@ bool Docgen::visit(const StaticStatement& node) {
 bool Docgen::visit(const InlineStatement& node) {
     std::string larger;
     std::string smaller;
-    auto body=std::dynamic_pointer_cast<FunctionDefinition>(node.body());
+    auto body=static_cast<FunctionDefinition*>(node.body());
     id++;
     auto str="id"+std::to_string(id);
     if(is_class){
@@ -273,7 +273,7 @@ bool Docgen::visit(const InlineStatement& node) {
 bool Docgen::visit(const VirtualStatement& node) {
     std::string larger;
     std::string smaller;
-    auto body=std::dynamic_pointer_cast<FunctionDefinition>(node.body());
+    auto body=static_cast<FunctionDefinition*>(node.body());
     id++;
     auto str="id"+std::to_string(id);
     if(is_class){
@@ -8,7 +8,10 @@
 #include <string>
 #include <string_view>
 namespace html {
-class Docgen : public ast::AstVisitor {
+class Docgen : public ast::Visitor<Docgen> {
+    friend class ast::Visitor<Docgen>;
+    using ast::Visitor<Docgen>::visit;
+
   public:
     Docgen(std::string outputFilename, ast::AstNodePtr ast,std::string file);
   private:
@@ -2,6 +2,7 @@
 #define PEREGRINE_ERROR_HPP
 
 #include <string>
+#include <string_view>
 
 const std::string prefix = "\e[";
 const std::string suffix = "m";
@@ -34,4 +35,7 @@ std::string style(std::string text, std::string color);
 
 void display(PEError e);
 
+// escapes " so that a line of source can be put in a string literal
+std::string escape_quotes(std::string_view text);
+
 #endif
\ No newline at end of file
@@ -35,7 +35,20 @@ std::string style(std::string text, std::string color) {
     return prefix + color + suffix + text + reset;
 }
 
+std::string escape_quotes(std::string_view text) {
+    std::string res;
+    for (auto c : text) {
+        if (c == '"') {
+            res += "\\\"";
+        } else {
+            res += c;
+        }
+    }
+    return res;
+}
+
 void display(PEError e) {
+    e.loc.code = escape_quotes(e.loc.code);
     std::cout << "  ╭- "
               << fg(style("Error ---------------------------------------- " +
                               e.loc.file + ":" + std::to_string(e.loc.line) +
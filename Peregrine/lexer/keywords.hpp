@@ -0,0 +1,114 @@
+#ifndef PEREGRINE_KEYWORDS_HPP
+#define PEREGRINE_KEYWORDS_HPP
+
+#include "tokens.hpp"
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace keywords {
+
+struct Keyword {
+    std::string_view text;
+    TokenType type;
+};
+
+constexpr std::array<Keyword, 42> keyword_list{{
+    {"True", tk_true},
+    {"False", tk_false},
+    {"None", tk_none},
+    {"import", tk_import},
+    {"from", tk_from},
+    {"const", tk_const},
+    {"if", tk_if},
+    {"type", tk_type},
+    {"union", tk_union},
+    {"scope", tk_scope},
+    {"elif", tk_elif},
+    {"else", tk_else},
+    {"while", tk_while},
+    {"for", tk_for},
+    {"break", tk_break},
+    {"assert", tk_assert},
+    {"try", tk_try},
+    {"except", tk_except},
+    {"raise", tk_raise},
+    {"with", tk_with},
+    {"continue", tk_continue},
+    {"match", tk_match},
+    {"extern", tk_extern},
+    {"cast", tk_cast},
+    {"case", tk_case},
+    {"default", tk_default},
+    {"static", tk_static},
+    {"def", tk_def},
+    {"private", tk_private},
+    {"return", tk_return},
+    {"as", tk_as},
+    {"enum", tk_enum},
+    {"and", tk_and},
+    {"or", tk_or},
+    {"not", tk_not},
+    {"is", tk_is},
+    {"in", tk_in},
+    {"inline", tk_inline},
+    {"virtual", tk_virtual},
+    {"class", tk_class},
+    {"export", tk_export},
+    {"__asm__", tk_asm},
+}};
+
+constexpr size_t min_length = 2;
+constexpr size_t max_length = 8;
+constexpr size_t table_size = 128;
+
+// perfect hash over the length, the first and the last two characters,
+// the multipliers were picked so that no two keywords share a slot
+constexpr size_t hash(std::string_view word) {
+    return (word.size() * 45 + static_cast<unsigned char>(word[0]) * 56 +
+            static_cast<unsigned char>(word[word.size() - 2]) * 31 +
+            static_cast<unsigned char>(word.back()) * 38) %
+           table_size;
+}
+
+// index into keyword_list for every slot, -1 when the slot is empty
+constexpr std::array<int, table_size> build_table() {
+    std::array<int, table_size> table{};
+    for (auto& slot : table) {
+        slot = -1;
+    }
+    for (size_t i = 0; i < keyword_list.size(); ++i) {
+        table[hash(keyword_list[i].text)] = static_cast<int>(i);
+    }
+    return table;
+}
+
+constexpr std::array<int, table_size> table = build_table();
+
+constexpr bool is_perfect() {
+    for (size_t i = 0; i < keyword_list.size(); ++i) {
+        if (table[hash(keyword_list[i].text)] != static_cast<int>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(is_perfect(), "keyword hash has collisions, pick new multipliers");
+
+// returns the token type of the keyword or tk_identifier if `word` is not
+// a keyword, never allocates
+constexpr TokenType lookup(std::string_view word) {
+    if (word.size() < min_length || word.size() > max_length) {
+        return tk_identifier;
+    }
+    int index = table[hash(word)];
+    if (index < 0 || keyword_list[index].text != word) {
+        return tk_identifier;
+    }
+    return keyword_list[index].type;
+}
+
+} // namespace keywords
+
+#endif
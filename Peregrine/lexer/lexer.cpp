@@ -1,107 +1,267 @@
 #include "lexer.hpp"
 #include "tokens.hpp"
+#include "keywords.hpp"
+#include "scan.hpp"
+#include "utils/threadPool.hpp"
 #include <algorithm>
 #include <iostream>
-#include <map>
-#include <regex>
 #define not_tab()   m_is_tab=false;
 
 
-LEXER::LEXER(std::string input, std::string filename){
-    m_input = input;
-    m_filename = filename;
+LEXER::LEXER(std::string_view input, std::string filename){
+    m_source=sources::add(std::string(input),filename);
+    start();
+}
+
+LEXER::LEXER(uint16_t source){
+    m_source=source;
+    start();
+}
+
+size_t LEXER::parallel_threshold=1<<20;
+size_t LEXER::parallel_chunk=1<<18;
+
+void LEXER::start(){
+    m_input=sources::get(m_source).text();
+    m_filename=sources::get(m_source).filename();
     if(m_input.size()>0){
-        m_statments=split_ln(input);
         m_curr_item=m_input[0];
-        m_curr_line=m_statments[0];
-        lex();
-        complete_it();
     }
     else {
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "<tk_eof>",
-            m_curr_index,
-            m_curr_index+1,
-            m_line,
-            tk_eof,
-            m_tab_count
-        });
+        m_lexed_all=true;
+    }
+    m_parallel=m_input.size()>=parallel_threshold;
+}
+
+LEXER::LEXER(uint16_t source,size_t begin,size_t end,size_t line){
+    m_source=source;
+    m_is_chunk=true;
+    m_input=sources::get(m_source).text().substr(0,end);
+    m_filename=sources::get(m_source).filename();
+    m_curr_index=begin;
+    m_curr_item=m_input[begin];
+    m_line=line;
+    //the lexer is one past the line break when it starts a line
+    m_loc=begin==0 ? 0 : 1;
+}
+
+LexedChunk LEXER::lex_chunk(uint16_t source,size_t begin,size_t end,size_t line){
+    LEXER lexer(source,begin,end,line);
+    while(!lexer.m_lexed_all){
+        lexer.lex();
+    }
+    bool clean=lexer.m_error.empty() && lexer.m_keyword.empty()
+        && lexer.m_first_bracket_count==0
+        && lexer.m_second_bracket_count==0
+        && lexer.m_third_bracket_count==0;
+    return LexedChunk{std::move(lexer.m_result),std::move(lexer.m_token_tabs),
+        std::move(lexer.m_chunk_pool),lexer.m_line,clean};
+}
+
+size_t LEXER::split_after(size_t from){
+    //the first line at or after `from` that starts at column 0 with a token
+    size_t i=from;
+    while(i<m_input.size()){
+        i=scan::find(m_input,i,"\n")+1;
+        if(i>=m_input.size()){
+            break;
+        }
+        char c=m_input[i];
+        if(c!=' ' && c!='\t' && c!='#' && c!='\n' && c!='\r'){
+            return i;
+        }
+    }
+    return m_input.size();
+}
+
+void LEXER::plan_chunks(){
+    auto& pool=Utils::ThreadPool::shared();
+    while(m_chunks.size()<2*pool.size()){
+        size_t begin=m_planned>=m_curr_index ? m_planned : split_after(m_curr_index);
+        size_t end=split_after(begin+parallel_chunk);
+        if(end>=m_input.size()){
+            //the rest is lexed by this lexer, it has to finish the file anyway
+            m_planned=m_input.size();
+            break;
+        }
+        size_t line=sources::get(m_source).line_of(begin);
+        uint16_t source=m_source;
+        m_chunks.push_back(Chunk{begin,end,pool.submit([=]{
+            return lex_chunk(source,begin,end,line);
+        })});
+        m_planned=end;
+    }
+}
+
+bool LEXER::take_chunk(){
+    if(!m_parallel || m_lexed_all){
+        return false;
+    }
+    if(!m_error.empty()){
+        //the rest of the file is only lexed for its errors
+        m_parallel=false;
+        m_chunks.clear();
+        m_stop_at=SIZE_MAX;
+        return false;
+    }
+    //chunks this lexer already went past
+    while(!m_chunks.empty() && m_chunks.front().begin<m_curr_index){
+        m_chunks.pop_front();
+    }
+    plan_chunks();
+    if(m_chunks.empty()){
+        m_stop_at=SIZE_MAX;
+        return false;
+    }
+    auto& chunk=m_chunks.front();
+    m_stop_at=chunk.begin;
+    //the chunk was lexed assuming a fresh line at depth 0
+    if(m_curr_index!=chunk.begin || !m_keyword.empty()
+        || !m_is_tab || m_tab_count!=0
+        || m_first_bracket_count!=0
+        || m_second_bracket_count!=0
+        || m_third_bracket_count!=0){
+        return false;
+    }
+    auto lexed=chunk.result.get();
+    size_t end=chunk.end;
+    m_chunks.pop_front();
+    if(!lexed.clean){
+        //the split was inside a bracket or a string, lex it here instead
+        m_stop_at=end;
+        return false;
     }
+    release(m_result.size());
+    for(size_t i=0;i<lexed.tokens.size();++i){
+        auto& tok=lexed.tokens[i];
+        if(tok.pooled){
+            set_keyword(tok,lexed.pool[tok.text]);
+        }
+        complete_it(tok,lexed.tabs[i]);
+    }
+    m_curr_index=end;
+    m_curr_item=m_input[end];
+    m_line=lexed.end_line;
+    m_loc=1;
+    return true;
+}
+
+Token LEXER::next_token(){
+    fill();
+    if(m_ready.empty()){
+        return m_last;
+    }
+    Token tok=m_ready.front();
+    m_ready.pop_front();
+    return tok;
+}
+
+void LEXER::fill(){
+    while(m_ready.empty() && !m_finished){
+        if(take_chunk()){
+            continue;
+        }
+        if(!m_lexed_all){
+            lex();
+        }
+        if(m_lexed_all){
+            finish();
+        }
+        else if(m_error.empty() && m_result.size()>1){
+            release(m_result.size()-1);
+        }
+    }
+}
+
+void LEXER::release(size_t count){
+    for(size_t i=0;i<count;++i){
+        complete_it(m_result[i],m_token_tabs[i]);
+    }
+    m_result.erase(m_result.begin(),m_result.begin()+count);
+    m_token_tabs.erase(m_token_tabs.begin(),m_token_tabs.begin()+count);
+}
+
+void LEXER::emit(const Token& tok){
+    m_ready.push_back(tok);
+    m_emitted++;
+    m_last=tok;
+    m_has_last=true;
+}
+
+Token LEXER::make_token(TokenType type,size_t start,std::string_view keyword){
+    Token tok;
+    tok.location=m_loc;
+    tok.start=start;
+    tok.line=m_line;
+    tok.source=m_source;
+    tok.tkType=type;
+    set_keyword(tok,keyword);
+    return tok;
+}
+
+Token LEXER::synthetic_token(const Token& at,TokenType type,std::string_view keyword){
+    Token tok=at;
+    tok.tkType=type;
+    set_keyword(tok,keyword);
+    return tok;
+}
+
+void LEXER::set_keyword(Token& tok,std::string_view keyword){
+    //most lexemes are a slice of the input, the rest go to the pool of the source
+    if(m_input.substr(std::min<size_t>(tok.start,m_input.size()),keyword.size())==keyword){
+        tok.text=tok.start;
+        tok.pooled=false;
+    }
+    else if(m_is_chunk){
+        tok.text=m_chunk_pool.size();
+        tok.pooled=true;
+        m_chunk_pool.emplace_back(keyword);
+    }
+    else{
+        auto it=m_pooled.find(keyword);
+        if(it==m_pooled.end()){
+            it=m_pooled.emplace(keyword,sources::get(m_source).add_lexeme(keyword)).first;
+        }
+        tok.text=it->second;
+        tok.pooled=true;
+    }
+    tok.length=keyword.size();
+}
+
+void LEXER::add_token(TokenType type,size_t start){
+    add_token(type,start,m_input.substr(start,m_curr_index+1-start));
+}
+
+void LEXER::add_token(TokenType type,size_t start,std::string_view keyword){
+    m_result.push_back(make_token(type,start,keyword));
+    m_token_tabs.push_back(m_tab_count);
 }
 
 void LEXER::add_unknown(){
     TokenType type;
-    std::map<std::string,TokenType> key_map={
-        {"True",tk_true},
-        {"False",tk_false},
-        {"None",tk_none},
-        {"import",tk_import},
-        {"from",tk_from},
-        {"const",tk_const},
-        {"if",tk_if},
-        {"type",tk_type},
-        {"union",tk_union},
-        {"scope",tk_scope},
-        {"elif",tk_elif},
-        {"else",tk_else},
-        {"while",tk_while},
-        {"for",tk_for},
-        {"break",tk_break},
-        {"assert",tk_assert},
-        {"try",tk_try},
-        {"except",tk_except},
-        {"raise",tk_raise},
-        {"with",tk_with},
-        {"continue",tk_continue},
-        {"match",tk_match},
-        {"extern",tk_extern},
-        {"cast",tk_cast},
-        {"case",tk_case},
-        {"default",tk_default},
-        {"static",tk_static},
-        {"def",tk_def},
-        {"private",tk_private},
-        {"return",tk_return},
-        {"as",tk_as},
-        {"enum",tk_enum},
-        {"and",tk_and},
-        {"or",tk_or},
-        {"not",tk_not},
-        {"is",tk_is},
-        {"in",tk_in},
-        {"inline",tk_inline},
-        {"virtual",tk_virtual},
-        {"class",tk_class},
-        {"export",tk_export},
-        {"__asm__",tk_asm}
-    };
     if(m_keyword=="f" && (m_curr_item=='"'||m_curr_item=='\'')){
         type=tk_format;
     }
     else if(m_keyword=="r" && (m_curr_item=='"'||m_curr_item=='\'')){
         type=tk_raw;
     }
-    else if (key_map.count(m_keyword) > 0) {
-        type = key_map[m_keyword];
-    }
     else if(m_keyword!=""){
-        if(is_int(m_keyword)||is_hex(m_keyword)){
-            type=tk_integer;
-        }
-        else if(std::regex_match(m_keyword,std::regex(R"(^^\s*[-+]?((\d+(\.\d+)?)|(\d+\.)|(\.\d+))(e[-+]?\d+)?\s*$)"))){
-            type=tk_decimal;
-        }
-        else{
-            type=tk_identifier;
-            if(!std::regex_match(m_keyword,std::regex("^[a-zA-Z_][a-zA-Z0-9_]*$"))){
+        type=keywords::lookup(m_keyword);
+        if(type==tk_identifier){
+            auto word=classify(m_keyword);
+            if(word==wc_integer){
+                type=tk_integer;
+            }
+            else if(word==wc_decimal){
+                type=tk_decimal;
+            }
+            else if(word==wc_invalid){
                 m_error.push_back(PEError(
                     PEError({.loc = Location({.line = m_line,
                                           .col = m_loc,
                                           .loc=m_loc,
                                           .file = m_filename,
-                                          .code = m_curr_line}),
+                                          .code = current_line()}),
                          .msg = "Invalid identifier: "+m_keyword,
                          .ecode = ""})
                 ));
@@ -109,98 +269,65 @@ void LEXER::add_unknown(){
         }
     } 
     if(m_keyword!=""){
-        auto res = Token{
-                        m_loc,
-                        m_curr_line,
-                        m_keyword,
-                        m_curr_index-m_keyword.length(),
-                        m_curr_index+1,
-                        m_line,
-                        type,
-                        m_tab_count
-        };
-        if(m_result.size()>0 && type==tk_in){
-            if(m_result.back().tkType==tk_not){
-                m_result[m_result.size()-1].keyword="not in";
-                m_result[m_result.size()-1].tkType=tk_not_in;
-                m_result[m_result.size()-1].end=m_curr_index+1;
-                m_result[m_result.size()-1].location=m_loc;
-            }
-            else{
-                m_result.push_back(res);
-            }
+        if(m_result.size()>0 && type==tk_in && m_result.back().tkType==tk_not){
+            set_keyword(m_result.back(),"not in");
+            m_result.back().tkType=tk_not_in;
+            m_result.back().location=m_loc;
         }
-        else if(m_result.size()>0 && type==tk_not){
-            if(m_result.back().tkType==tk_is){
-                m_result[m_result.size()-1].keyword="is not";
-                m_result[m_result.size()-1].tkType=tk_is_not;
-                m_result[m_result.size()-1].end=m_curr_index+1;
-                m_result[m_result.size()-1].location=m_loc;
-            }
-            else{
-                m_result.push_back(res);
-            }
+        else if(m_result.size()>0 && type==tk_not && m_result.back().tkType==tk_is){
+            set_keyword(m_result.back(),"is not");
+            m_result.back().tkType=tk_is_not;
+            m_result.back().location=m_loc;
         }
         else{
-            m_result.push_back(res);
+            add_token(type,m_curr_index-m_keyword.length(),m_keyword);
         }
     }
     m_keyword = "";
 }
-void LEXER::complete_it(){
-    auto result=m_result;
-    m_result.clear();
-    size_t previous_ident=0;
-    size_t current_ident=0;
-    for(auto item:result){
-        current_ident=item.tab;
-        if(current_ident>previous_ident){
-            m_result.push_back(Token{
-                item.location,
-                item.statement,
-                "<ident>",
-                item.start,
-                item.end,
-                item.line,
-                tk_ident,
-            });
-            m_tabs.push_back(item.tab);
-        }
-        else if(current_ident<previous_ident){
-            while (current_ident < previous_ident) {
-                m_tabs.pop_back();
-                m_result.push_back(Token{
-                    item.location,
-                    item.statement,
-                    "<dedent>",
-                    item.start,
-                    item.end,
-                    item.line,
-                    tk_dedent,
-                });
-                if (m_tabs.size() != 0) {
-                    if (current_ident >=m_tabs.back()) {
-                        break;
-                    }
-                    previous_ident = m_tabs.back();
-                } else {
-                    previous_ident = 0;
+void LEXER::complete_it(const Token& item,size_t tab){
+    size_t current_ident=tab;
+    if(current_ident>m_previous_ident){
+        emit(synthetic_token(item,tk_ident,"<ident>"));
+        m_tabs.push_back(tab);
+    }
+    else if(current_ident<m_previous_ident){
+        while (current_ident < m_previous_ident) {
+            m_tabs.pop_back();
+            emit(synthetic_token(item,tk_dedent,"<dedent>"));
+            if (m_tabs.size() != 0) {
+                if (current_ident >=m_tabs.back()) {
+                    break;
                 }
-            }    
-        }
-        m_result.push_back(item);
-        previous_ident=current_ident;
+                m_previous_ident = m_tabs.back();
+            } else {
+                m_previous_ident = 0;
+            }
+        }    
     }
+    emit(item);
+    m_previous_ident=current_ident;
+}
+
+void LEXER::finish(){
+    size_t lexed=m_result.size();
     if(m_keyword!=""){
         add_unknown();
     }
+    release(lexed);
+    //a word that ends the file does not take part in the indentation
+    for(auto& item:m_result){
+        emit(item);
+    }
+    m_result.clear();
+    m_token_tabs.clear();
     if(m_first_bracket_count!=0){
         m_error.push_back(PEError(
             PEError({.loc = Location({.line = m_line,
                                   .col = m_loc,
                                   .loc=m_loc,
                                   .file = m_filename,
-                                  .code = m_curr_line}),
+                                  .code = current_line()}),
                  .msg = "Unexpected end of file",
                  .submsg = "Expecting a ')'",
                  .ecode = "e1"})
@@ -212,7 +339,7 @@ void LEXER::complete_it(){
                                   .col = m_loc,
                                   .loc=m_loc,
                                   .file = m_filename,
-                                  .code = m_curr_line}),
+                                  .code = current_line()}),
                  .msg = "Unexpected end of file",
                  .submsg = "Expecting a '}'",
                  .ecode = "e1"})
@@ -224,69 +351,42 @@ void LEXER::complete_it(){
                                   .col = m_loc,
                                   .loc=m_loc,
                                   .file = m_filename,
-                                  .code = m_curr_line}),
+                                  .code = current_line()}),
                  .msg = "Unexpected end of file",
                  .submsg = "Expecting a ']'",
                  .ecode = "e1"})
         ));
     }
-    if(m_error.size()>0){
+    if(m_error.size()>0 && !m_keep_errors){
         for (auto& x: m_error) {
             display(x);
         }
         exit(1);
     }
-    if(m_result.size()>0){
-        if(m_result.back().tkType!=tk_new_line
-            && m_result.back().tkType!=tk_dedent
+    if(m_has_last){
+        if(m_last.tkType!=tk_new_line
+            && m_last.tkType!=tk_dedent
             ){
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                "<tk_new_line>",
-                m_curr_index,
-                m_curr_index+1,
-                m_line,
-                tk_new_line,
-                m_tab_count
-            });
+            emit(make_token(tk_new_line,m_curr_index,"<tk_new_line>"));
+        }
+        auto item=m_last;
+        for(size_t i=0;i<m_tabs.size();++i){
+            emit(synthetic_token(item,tk_dedent,"<dedent>"));
         }
     }
-    auto item=m_result.back();
-    for(size_t i=0;i<m_tabs.size();++i){
-        m_result.push_back(Token{
-                item.location,
-                item.statement,
-                "<dedent>",
-                item.start,
-                item.end,
-                item.line,
-                tk_dedent,
-        });
-    }
-    m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "<tk_eof>",
-            m_curr_index,
-            m_curr_index+1,
-            m_line,
-            tk_eof,
-            m_tab_count
-    });
-    
+    emit(make_token(tk_eof,m_curr_index,"<tk_eof>"));
+    m_finished=true;
 }
 
+
 void LEXER::lex(){
     while (true){
         switch(m_curr_item){
             case '#':{
                 add_unknown();
-                while(next()!='\n' && next()!='\0' && next()!='\r'){
-                    if(!advance()){
-                        break;
-                    }
-                }
+                //the comment runs up to the line break, stop right before it
+                size_t end=scan::find(m_input,m_curr_index+1,std::string_view("\n\r\0",3));
+                skip_to(end-1);
                 break;
             }
             case '\"':
@@ -310,48 +410,21 @@ void LEXER::lex(){
                 not_tab();
                 add_unknown();
                 m_first_bracket_count++;
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_l_paren,
-                            m_tab_count
-                });
+                add_token(tk_l_paren,m_curr_index);
                 break;
             }
             case '{':{
                 not_tab();
                 add_unknown();
                 m_second_bracket_count++;
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_dict_open,
-                            m_tab_count
-                });
+                add_token(tk_dict_open,m_curr_index);
                 break;
             }
             case '[':{
                 not_tab();
                 add_unknown();
                 m_third_bracket_count++;
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_list_open,
-                            m_tab_count
-                });
+                add_token(tk_list_open,m_curr_index);
                 break;
             }
             case ')':{
@@ -362,22 +435,13 @@ void LEXER::lex(){
                                           .col = m_loc,
                                           .loc=m_loc,
                                           .file = m_filename,
-                                          .code = m_curr_line}),
+                                          .code = current_line()}),
                          .msg = "')' without a previous '(' token"}));
                 }
                 else{
                     m_first_bracket_count--;
                 }
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_r_paren,
-                            m_tab_count
-                });
+                add_token(tk_r_paren,m_curr_index);
                 break;
             }
             case '}':{
@@ -388,22 +452,13 @@ void LEXER::lex(){
                                           .col = m_loc,
                                           .loc=m_loc,
                                           .file = m_filename,
-                                          .code = m_curr_line}),
+                                          .code = current_line()}),
                          .msg = "'}' without a previous '{' token"}));
                 }
                 else{
                     m_second_bracket_count--;
                 }
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_dict_close,
-                            m_tab_count
-                });
+                add_token(tk_dict_close,m_curr_index);
                 break;
             }
             case ']':{
@@ -414,22 +469,13 @@ void LEXER::lex(){
                                           .col = m_loc,
                                           .loc=m_loc,
                                           .file = m_filename,
-                                          .code = m_curr_line}),
+                                          .code = current_line()}),
                          .msg = "']' without a previous '[' token"}));
                 }
                 else{
                     m_third_bracket_count--;
                 }
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_list_close,
-                            m_tab_count
-                });
+                add_token(tk_list_close,m_curr_index);
                 break;
             }
             case '.':{
@@ -524,46 +570,19 @@ void LEXER::lex(){
             case ':':{
                 not_tab();
                 add_unknown();
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_colon,
-                            m_tab_count
-                });
+                add_token(tk_colon,m_curr_index);
                 break;
             }
             case ',':{
                 not_tab();
                 add_unknown();
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_comma,
-                            m_tab_count
-                });
+                add_token(tk_comma,m_curr_index);
                 break;
             }
             case '@':{
                 not_tab();
                 add_unknown();
-                m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            std::string(1,m_curr_item),
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_at,
-                            m_tab_count
-                });
+                add_token(tk_at,m_curr_index);
                 break;
             }
             case ' ':{
@@ -594,21 +613,11 @@ void LEXER::lex(){
                         && m_first_bracket_count==0 
                         && m_second_bracket_count==0
                         && m_third_bracket_count==0){
-                        m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            "<tk_new_line>",
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_new_line,
-                            m_tab_count
-                        });
+                        add_token(tk_new_line,m_curr_index,"<tk_new_line>");
                     }
                 }
                 m_line++;
                 m_loc=0;
-                m_curr_line=m_statments[m_line-1];
                 if(m_first_bracket_count==0&&
                     m_second_bracket_count==0&&
                     m_third_bracket_count==0){
@@ -628,16 +637,7 @@ void LEXER::lex(){
                         && m_first_bracket_count==0 
                         && m_second_bracket_count==0
                         && m_third_bracket_count==0){
-                        m_result.push_back(Token{
-                            m_loc,
-                            m_curr_line,
-                            "<tk_new_line>",
-                            m_curr_index,
-                            m_curr_index+1,
-                            m_line,
-                            tk_new_line,
-                            m_tab_count
-                        });
+                        add_token(tk_new_line,m_curr_index,"<tk_new_line>");
                     }
                 }
                 if(m_first_bracket_count==0&&
@@ -648,7 +648,6 @@ void LEXER::lex(){
                 }
                 m_line++;
                 m_loc=0;
-                m_curr_line=m_statments[m_line-1];
                 break;
             }
             default:{
@@ -658,88 +657,50 @@ void LEXER::lex(){
             }
         }
         if(!advance()){
+            m_lexed_all=true;
             break;
         }
         if(m_is_formated_str&&m_curr_item=='}'){
             add_unknown();
             break;
         }
+        //hand out what is safe to, after an error keep going so that every
+        //error in the file gets reported
+        if(!m_is_formated_str && 
+            (m_curr_index>=m_stop_at || (m_error.empty() && m_result.size()>1))){
+            break;
+        }
     }
 }
 
 void LEXER::lex_dollar(){
-    m_result.push_back(Token{
-        m_loc,
-        m_curr_line,
-        std::string(1,m_curr_item),
-        m_curr_index,
-        m_curr_index+1,
-        m_line,
-        tk_dollar,
-        m_tab_count
-    });
+    add_token(tk_dollar,m_curr_index);
 }
 void LEXER::lex_tilde(){
-    m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    std::string(1,m_curr_item),
-                    m_curr_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_bit_not,
-                    m_tab_count
-        });
+    add_token(tk_bit_not,m_curr_index);
 }
 void LEXER::lex_ampersand(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    "&=",
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_bit_and_equal,
-                    m_tab_count
-        });
+        add_token(tk_bit_and_equal,start_index);
     }
     else{
-        m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    std::string(1,m_curr_item),
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_ampersand,
-                     m_tab_count
-        });
+        add_token(tk_ampersand,start_index);
     }
 }
 void LEXER::lex_bang(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    "!=",
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_not_equal,
-                    m_tab_count
-        });
+        add_token(tk_not_equal,start_index);
     }
     else{
         m_error.push_back(PEError({.loc = Location({.line = m_line,
                                             .col = m_loc,
                                             .loc=m_loc,
                                             .file = m_filename,
-                                            .code = m_curr_line}),
+                                            .code = current_line()}),
                             .msg = "Error: Expected '=' after '!'"
                             }));
     }
@@ -748,28 +709,10 @@ void LEXER::lex_percent(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    "%=",
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_mod_equal,
-                    m_tab_count
-        });
+        add_token(tk_mod_equal,start_index);
     }
     else{
-        m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    std::string(1,m_curr_item),
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_modulo,
-                    m_tab_count
-        });
+        add_token(tk_modulo,start_index);
     }
 }
 void LEXER::lex_string(){
@@ -784,11 +727,12 @@ void LEXER::lex_string(){
                                           .col = m_loc,
                                           .loc=m_loc,
                                           .file = m_filename,
-                                          .code = m_curr_line}),
+                                          .code = current_line()}),
                          .msg = "Unexpected end of file",
                          .submsg = temp,
                          .ecode = "e1"}));
     }
+    const char needles[]={quote,'\n','\r'};
     while(m_curr_item!=quote){
         if(loc>=m_loc && m_is_tab){
             if(m_curr_item!=' '&&m_curr_item!='\t'){
@@ -796,13 +740,18 @@ void LEXER::lex_string(){
                 m_is_tab=false;
             }
         }
+        else if(m_curr_item!='\n'&&m_curr_item!='\r'){
+            //copy everything up to the next quote or line break at once
+            size_t end=scan::find(m_input,m_curr_index,std::string_view(needles,3));
+            str.append(m_input.substr(m_curr_index,end-m_curr_index));
+            skip_to(end-1);
+        }
         else{
             str.push_back(m_curr_item);
         }
         if(m_curr_item=='\n'){
             m_line++;
             m_loc=0;
-            m_curr_line=m_statments[m_line-1];
             m_is_tab=true;
         }
         else if(m_curr_item=='\r'){
@@ -812,7 +761,6 @@ void LEXER::lex_string(){
             }
             m_line++;
             m_loc=0;
-            m_curr_line=m_statments[m_line-1];
             m_is_tab=true;
         }
         redo:{}
@@ -821,7 +769,7 @@ void LEXER::lex_string(){
                                             .col = m_loc,
                                             .loc=m_loc,
                                             .file = m_filename,
-                                            .code = m_curr_line}),
+                                            .code = current_line()}),
                             .msg = "Unexpected end of file",
                             .submsg = temp,
                             .ecode = "e1"}));
@@ -834,375 +782,132 @@ void LEXER::lex_string(){
             }
         }
     }
-    m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                str,
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_string,
-                m_tab_count
-            });
+    add_token(tk_string,start_index,str);
 }
 void LEXER::lex_plus(){
     size_t start_index=m_curr_index;
     if(next()=='+'){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "++",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_increment,
-            m_tab_count
-        });
+        add_token(tk_increment,start_index);
     }
     else if(next()=='='){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "+=",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_plus_equal,
-            m_tab_count
-        });
+        add_token(tk_plus_equal,start_index);
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_plus,
-            m_tab_count
-        });
+        add_token(tk_plus,start_index);
     }
 }
 void LEXER::lex_minus(){
     size_t start_index=m_curr_index;
     if(next()=='-'){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "--",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_decrement,
-            m_tab_count
-        });
+        add_token(tk_decrement,start_index);
     }
     else if(next()=='='){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "-=",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_minus_equal,
-            m_tab_count
-        });
+        add_token(tk_minus_equal,start_index);
     }
     else if(next()=='>'){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "->",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_arrow,
-            m_tab_count
-        });
+        add_token(tk_arrow,start_index);
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_minus,
-            m_tab_count
-        });
+        add_token(tk_minus,start_index);
     }
 }
 void LEXER::lex_greater(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            ">=",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_gr_or_equ,
-            m_tab_count
-        });
+        add_token(tk_gr_or_equ,start_index);
     }
     else if(next()=='>'){
         advance();
         if(next()=='='){
             advance();
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                ">>=",
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_shift_right_equal,
-                m_tab_count
-            });
+            add_token(tk_shift_right_equal,start_index);
         }
         else{
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                ">>",
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_shift_right,
-                m_tab_count
-            });
+            add_token(tk_shift_right,start_index);
         }
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_greater,
-            m_tab_count
-        });
+        add_token(tk_greater,start_index);
     }
 }
 void LEXER::lex_less(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "<=",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_less_or_equ,
-            m_tab_count
-        });
+        add_token(tk_less_or_equ,start_index,"<=");
     }
     else if(next()=='<'){
         advance();
         if(next()=='='){
             advance();
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                "<<=",
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_shift_left_equal,
-                m_tab_count
-            });
+            add_token(tk_shift_left_equal,start_index,"<<=");
         }
         else{
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                "<<",
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_shift_left,
-                m_tab_count
-            });
+            add_token(tk_shift_left,start_index,"<<");
         }
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_less,
-            m_tab_count
-        });
+        add_token(tk_less,start_index);
     }
 }
 void LEXER::lex_equal(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "==",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_equal,
-            m_tab_count
-        });
+        add_token(tk_equal,start_index);
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_assign,
-            m_tab_count
-        });
+        add_token(tk_assign,start_index);
     }
 }
 void LEXER::lex_slash(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "/=",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_slash_equal,
-            m_tab_count
-        });
+        add_token(tk_slash_equal,start_index);
     }
     else if(next()=='/'){
         advance();
         if(next()=='='){
             advance();
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                "//=",
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_floor_equal,
-                m_tab_count
-            });
+            add_token(tk_floor_equal,start_index);
         }
         else{
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                "//",
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_floor,
-                m_tab_count
-            });
+            add_token(tk_floor,start_index);
         }
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_divide,
-            m_tab_count
-        });
+        add_token(tk_divide,start_index);
     }
 }
 void LEXER::lex_caret(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "^=",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_bit_xor_equal,
-            m_tab_count
-        });
+        add_token(tk_bit_xor_equal,start_index);
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_xor,
-            m_tab_count
-        });
+        add_token(tk_xor,start_index);
     }
 }
 void LEXER::lex_pipeline(){
     size_t start_index=m_curr_index;
     if(next()=='='){
         advance();
-        m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    "|=",
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_bit_or_equal,
-                    m_tab_count
-        });
+        add_token(tk_bit_or_equal,start_index);
     }
     else if(next()=='>'){
         advance();
-        m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    "|>",
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_pipeline,
-                    m_tab_count
-        });
+        add_token(tk_pipeline,start_index);
     }
     else{
-        m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    std::string(1,m_curr_item),
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_bit_or,
-                    m_tab_count
-        });
+        add_token(tk_bit_or,start_index);
     }
 }
 void LEXER::lex_dot(){
@@ -1215,41 +920,14 @@ void LEXER::lex_dot(){
         advance(); 
         if (next()=='.'){
             advance();
-            m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    "...",
-                    m_curr_index-2,
-                    m_curr_index+1,
-                    m_line,
-                    tk_ellipses,
-                    m_tab_count
-            });
+            add_token(tk_ellipses,m_curr_index-2);
         }
         else{
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                "..",
-                m_curr_index-1,
-                m_curr_index+1,
-                m_line,
-                tk_double_dot,
-                m_tab_count
-            });
+            add_token(tk_double_dot,m_curr_index-1);
         }               
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            m_curr_index,
-            m_curr_index+1,
-            m_line,
-            tk_dot,
-            m_tab_count
-        });
+        add_token(tk_dot,m_curr_index);
     }
 }
 void LEXER::lex_star(){
@@ -1269,69 +947,24 @@ void LEXER::lex_star(){
         }
     }
     if(is_ptr){
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_multiply,
-            m_tab_count
-        });  
+        add_token(tk_multiply,start_index);  
     }
     else if(next()=='='){
         advance();
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "*=",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_times_equal,
-            m_tab_count
-        });
+        add_token(tk_times_equal,start_index);
     }
     else if(next()=='*'){
         advance();
         if(next()=='='){
             advance();
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                "**=",
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_exponent_equal,
-                m_tab_count
-            });
+            add_token(tk_exponent_equal,start_index);
         }
         else{
-            m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                "**",
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_exponent,
-                m_tab_count
-            });
+            add_token(tk_exponent,start_index);
         }
     }
     else{
-        m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            std::string(1,m_curr_item),
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_multiply,
-            m_tab_count
-        });
+        add_token(tk_multiply,start_index);
     }
 }
 
@@ -1340,7 +973,7 @@ void LEXER::lex_star(){
                                                             .col = m_loc,\
                                                             .loc=m_loc,\
                                                             .file = m_filename,\
-                                                            .code = m_curr_line}),\
+                                                            .code = current_line()}),\
                                             .msg = "Unexpected end of file",\
                                             .submsg = temp,\
                                             .ecode = "e1"}));\
@@ -1361,12 +994,13 @@ void LEXER::lex_formated_string(){
                                           .col = m_loc,
                                           .loc=m_loc,
                                           .file = m_filename,
-                                          .code = m_curr_line}),
+                                          .code = current_line()}),
                          .msg = "Unexpected end of file",
                          .submsg = temp,
                          .ecode = "e1"}));
     }
     bool has_value=false;//to check if the str is empty or not
+    const char needles[]={quote,'\n','\r','{'};
     while(m_curr_item!=quote){
         if(loc>=m_loc && m_is_tab){
             if(m_curr_item!=' '&&m_curr_item!='\t'){
@@ -1374,13 +1008,18 @@ void LEXER::lex_formated_string(){
                 m_is_tab=false;
             }
         }
+        else if(m_curr_item!='\n'&&m_curr_item!='\r'&&m_curr_item!='{'){
+            //copy everything up to the next quote, brace or line break at once
+            size_t end=scan::find(m_input,m_curr_index,std::string_view(needles,4));
+            str.append(m_input.substr(m_curr_index,end-m_curr_index));
+            skip_to(end-1);
+        }
         else{
             str.push_back(m_curr_item);
         }
         if(m_curr_item=='\n'){
             m_line++;
             m_loc=0;
-            m_curr_line=m_statments[m_line-1];
             m_is_tab=true;
         }
         else if(m_curr_item=='\r'){
@@ -1390,7 +1029,6 @@ void LEXER::lex_formated_string(){
             }
             m_line++;
             m_loc=0;
-            m_curr_line=m_statments[m_line-1];
             m_is_tab=true;
         }
         redo:{}
@@ -1404,16 +1042,7 @@ void LEXER::lex_formated_string(){
         else if(m_curr_item=='{'&& str.size()>0){
             if(str.back()!='\\'){
                 has_value=true;
-                m_result.push_back(Token{
-                    m_loc,
-                    m_curr_line,
-                    str,
-                    start_index,
-                    m_curr_index+1,
-                    m_line,
-                    tk_format_str,
-                    m_tab_count
-                });
+                add_token(tk_format_str,start_index,str);
                 str.clear();
                 _show_error();
                 lex();
@@ -1422,27 +1051,9 @@ void LEXER::lex_formated_string(){
         }
     }
     if(str!=""||!has_value){
-        m_result.push_back(Token{
-                m_loc,
-                m_curr_line,
-                str,
-                start_index,
-                m_curr_index+1,
-                m_line,
-                tk_format_str,
-                m_tab_count
-        });
-    }
-    m_result.push_back(Token{
-            m_loc,
-            m_curr_line,
-            "",
-            start_index,
-            m_curr_index+1,
-            m_line,
-            tk_format_str_stopper,
-            m_tab_count
-    });
+        add_token(tk_format_str,start_index,str);
+    }
+    add_token(tk_format_str_stopper,start_index,"");
     m_is_formated_str=x;
 }
 
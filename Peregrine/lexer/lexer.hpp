@@ -2,22 +2,61 @@
 #define PEREGRINE_LEXER_HPP
 #define LEXEME std::vector<Token>
 #include "tokens.hpp"
+#include "source.hpp"
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <map>
 #include <vector>
 #include <string>
+#include <string_view>
 #include "errors/error.hpp"
 #define LEXEME std::vector<Token>
+
+//what a word that is not a keyword turned out to be
+enum WordClass {
+    wc_integer,
+    wc_decimal,
+    wc_identifier,
+    wc_invalid
+};
+
+//tokens of one chunk of a large file, lexed on a worker thread
+struct LexedChunk{
+    LEXEME tokens;
+    std::vector<size_t> tabs;
+    //cooked lexemes, pooled tokens index into this until they are handed out
+    std::vector<std::string> pool;
+    size_t end_line;
+    //false if the chunk did not end at depth 0 without errors, the split
+    //was then not a top-level boundary and the chunk has to be lexed again
+    bool clean;
+};
+
 class LEXER{
+    //tokens that were lexed but not handed out yet, the last one is kept
+    //back until the next one is lexed as "not in"/"is not" rewrite it
     LEXEME m_result;
+    //tokens with their indentation resolved, waiting for next_token()
+    std::deque<Token> m_ready;
+    //tokens emitted so far, for -mem_report
+    size_t m_emitted=0;
+    Token m_last;
+    bool m_has_last=false;
+    bool m_lexed_all=false;
+    bool m_finished=false;
+    size_t m_previous_ident=0;
     size_t m_curr_index=0;
-    std::string m_input;
+    uint16_t m_source=0;
+    std::string_view m_input;
     std::string m_filename;
     std::string m_keyword="";
-    std::string m_curr_line;
     bool m_is_formated_str=false;
     size_t m_line=1;
     size_t m_loc=0;
-    std::vector<std::string> m_statments;
     std::vector<PEError> m_error;
+    //set while result(errors) runs, finish() then leaves the errors to it
+    bool m_keep_errors=false;
     size_t m_first_bracket_count = 0;
     size_t m_second_bracket_count = 0;
     size_t m_third_bracket_count = 0;
@@ -25,14 +64,55 @@ class LEXER{
     bool m_is_tab = true;
     size_t m_tab_count = 0;
     std::vector<size_t> m_tabs;
+    //indentation of every token in m_result
+    std::vector<size_t> m_token_tabs;
+    //lexemes already stored in the pool of the source
+    std::map<std::string,uint32_t,std::less<>> m_pooled;
 
+    //parallel lexing of large files, see take_chunk()
+    struct Chunk{
+        size_t begin;
+        size_t end;
+        std::future<LexedChunk> result;
+    };
+    bool m_parallel=false;
+    std::deque<Chunk> m_chunks;
+    size_t m_planned=0;
+    //lex() stops here so that a lexed chunk can take over
+    size_t m_stop_at=SIZE_MAX;
+    //set for the lexers of a chunk, they do not touch the pool of the source
+    bool m_is_chunk=false;
+    std::vector<std::string> m_chunk_pool;
+
+    LEXER(uint16_t source,size_t begin,size_t end,size_t line);
+    static LexedChunk lex_chunk(uint16_t source,size_t begin,size_t end,size_t line);
+    size_t split_after(size_t from);
+    void plan_chunks();
+    bool take_chunk();
+
+    void start();
     void lex();
+    void fill();
+    void release(size_t count);
+    void emit(const Token& tok);
+    void finish();
+
+    Token make_token(TokenType type,size_t start,std::string_view keyword);
+    Token synthetic_token(const Token& at,TokenType type,std::string_view keyword);
+    void set_keyword(Token& tok,std::string_view keyword);
+    //the lexeme is everything from start to the current character
+    void add_token(TokenType type,size_t start);
+    void add_token(TokenType type,size_t start,std::string_view keyword);
 
     char next();
     bool advance();
-    std::vector<std::string> split_ln(std::string code);
-    bool is_int(const std::string s);
-    bool is_hex(const std::string s);
+    //moves to `index` like repeated advance() calls would, there must not
+    //be a line break in between
+    void skip_to(size_t index);
+    //text of the line being lexed, for error messages
+    std::string current_line();
+    bool is_int(const std::string& s);
+    WordClass classify(std::string_view s);
     
 
     void lex_string();
@@ -52,11 +132,30 @@ class LEXER{
     void lex_greater();
     void lex_less();
     void lex_dot();
-    void complete_it();
+    void complete_it(const Token& item,size_t tab);
     void lex_formated_string();
     public:
-    LEXER(std::string input, std::string filename);
+    LEXER(std::string_view input, std::string filename);
+    //lexes a file registered with sources::add or sources::load in place
+    explicit LEXER(uint16_t source);
+    //lexes just enough of the input to return the next token, keeps
+    //returning tk_eof once the input is exhausted
+    Token next_token();
+    //lexes whatever is left of the input
     LEXEME result();
+    //the same, but the errors are returned in `errors` instead of being
+    //reported, for a caller with errors of its own that come first
+    LEXEME result(std::vector<PEError>& errors);
+    //size of the input in bytes
+    size_t size() const;
+    //tokens lexed so far
+    size_t token_count() const;
+
+    //inputs of at least parallel_threshold bytes are split into chunks of
+    //about parallel_chunk bytes at top-level lines and lexed on the shared
+    //thread pool
+    static size_t parallel_threshold;
+    static size_t parallel_chunk;
 };
 
 #endif
\ No newline at end of file
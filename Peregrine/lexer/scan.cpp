@@ -0,0 +1,112 @@
+#include "scan.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PEREGRINE_SCAN_X86
+#include <immintrin.h>
+#endif
+
+namespace scan {
+
+static size_t find_scalar(const char* data, size_t size, size_t from,
+                          std::string_view needles) {
+    for (size_t i = from; i < size; ++i) {
+        for (char needle : needles) {
+            if (data[i] == needle) {
+                return i;
+            }
+        }
+    }
+    return size;
+}
+
+#ifdef PEREGRINE_SCAN_X86
+
+__attribute__((target("sse2"))) static size_t
+find_sse2(const char* data, size_t size, size_t from,
+          std::string_view needles) {
+    __m128i wanted[4];
+    for (size_t k = 0; k < needles.size(); ++k) {
+        wanted[k] = _mm_set1_epi8(needles[k]);
+    }
+    size_t i = from;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hits = _mm_cmpeq_epi8(chunk, wanted[0]);
+        for (size_t k = 1; k < needles.size(); ++k) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, wanted[k]));
+        }
+        unsigned mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_scalar(data, size, i, needles);
+}
+
+__attribute__((target("avx2"))) static size_t
+find_avx2(const char* data, size_t size, size_t from,
+          std::string_view needles) {
+    __m256i wanted[4];
+    for (size_t k = 0; k < needles.size(); ++k) {
+        wanted[k] = _mm256_set1_epi8(needles[k]);
+    }
+    size_t i = from;
+    for (; i + 32 <= size; i += 32) {
+        __m256i chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hits = _mm256_cmpeq_epi8(chunk, wanted[0]);
+        for (size_t k = 1; k < needles.size(); ++k) {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, wanted[k]));
+        }
+        unsigned mask = _mm256_movemask_epi8(hits);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_sse2(data, size, i, needles);
+}
+
+#endif
+
+Isa detected() {
+    static const Isa isa = [] {
+#ifdef PEREGRINE_SCAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return isa_avx2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return isa_sse2;
+        }
+#endif
+        return isa_scalar;
+    }();
+    return isa;
+}
+
+size_t find(std::string_view text, size_t from, std::string_view needles,
+            Isa isa) {
+    if (from >= text.size() || needles.empty()) {
+        return text.size();
+    }
+    if (needles.size() > 4) {
+        isa = isa_scalar;
+    }
+    switch (isa) {
+#ifdef PEREGRINE_SCAN_X86
+        case isa_avx2:
+            return find_avx2(text.data(), text.size(), from, needles);
+        case isa_sse2:
+            return find_sse2(text.data(), text.size(), from, needles);
+#endif
+        default:
+            return find_scalar(text.data(), text.size(), from, needles);
+    }
+}
+
+size_t find(std::string_view text, size_t from, std::string_view needles) {
+    return find(text, from, needles, detected());
+}
+
+} // namespace scan
@@ -0,0 +1,31 @@
+#ifndef PEREGRINE_SCAN_HPP
+#define PEREGRINE_SCAN_HPP
+
+#include <cstddef>
+#include <string_view>
+
+// vectorised search for the next byte the lexer has to look at, used to
+// skip over comments, string bodies and ordinary text in one go
+namespace scan {
+
+enum Isa {
+    isa_scalar,
+    isa_sse2,
+    isa_avx2
+};
+
+// the widest instruction set the cpu supports, checked once
+Isa detected();
+
+// returns the index of the first byte at or after `from` that is one of
+// `needles` (at most 4 of them), or text.size() if there is none
+size_t find(std::string_view text, size_t from, std::string_view needles);
+
+// same as above but with a fixed instruction set, `isa` must not be wider
+// than detected()
+size_t find(std::string_view text, size_t from, std::string_view needles,
+            Isa isa);
+
+} // namespace scan
+
+#endif
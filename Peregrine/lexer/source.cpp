@@ -0,0 +1,176 @@
+#include "source.hpp"
+#include "scan.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceFile::SourceFile(std::string text, std::string filename)
+    : m_filename(std::move(filename)), m_owned(std::move(text)) {
+    m_text = m_owned;
+    index_lines();
+}
+
+SourceFile::SourceFile(void* data, size_t size, std::string filename)
+    : m_filename(std::move(filename)), m_mapping(data), m_mapping_size(size) {
+    m_text = std::string_view(static_cast<const char*>(data), size);
+    index_lines();
+}
+
+SourceFile::~SourceFile() {
+    if (m_mapping != nullptr) {
+        munmap(m_mapping, m_mapping_size);
+    }
+}
+
+void SourceFile::index_lines() {
+    m_line_starts.push_back(0);
+    size_t i = scan::find(m_text, 0, "\n\r");
+    while (i < m_text.size()) {
+        // \r\n is a single line break
+        if (m_text[i] == '\r' && i + 1 < m_text.size() &&
+            m_text[i + 1] == '\n') {
+            ++i;
+        }
+        m_line_starts.push_back(i + 1);
+        i = scan::find(m_text, i + 1, "\n\r");
+    }
+}
+
+std::string_view SourceFile::text() const { return m_text; }
+
+std::string_view SourceFile::filename() const { return m_filename; }
+
+uint32_t SourceFile::add_lexeme(std::string_view lexeme) {
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    m_pool.emplace_back(lexeme);
+    return m_pool.size() - 1;
+}
+
+std::string_view SourceFile::lexeme(uint32_t index) const {
+    // a deque does not move its elements when it grows, only finding them
+    // needs the lock
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    return m_pool[index];
+}
+
+std::string_view SourceFile::line(size_t line) const {
+    if (line == 0 || line > m_line_starts.size()) {
+        return "";
+    }
+    size_t start = m_line_starts[line - 1];
+    size_t end = m_text.size();
+    if (line < m_line_starts.size()) {
+        end = m_line_starts[line] - 1;
+        if (m_text[end] == '\n' && end > start && m_text[end - 1] == '\r') {
+            end--;
+        }
+    }
+    return m_text.substr(start, end - start);
+}
+
+size_t SourceFile::line_count() const { return m_line_starts.size(); }
+
+size_t SourceFile::line_of(size_t offset) const {
+    // the first line start past `offset` is one after the line it is on
+    return std::upper_bound(m_line_starts.begin(), m_line_starts.end(),
+                            offset) -
+           m_line_starts.begin();
+}
+
+namespace sources {
+
+// the text of the tokens the compiler makes up most often, like the default
+// values of variables declared without one. TokenUtils::makeToken slices
+// them out of it instead of pooling a copy for every token
+static constexpr std::string_view builtin_text = "0 False True None";
+
+// tokens refer to their file with a 16 bit id
+static constexpr size_t max_files = size_t(UINT16_MAX) + 1;
+
+// room for every id is reserved up front so that the files never move, get()
+// does not need the lock that add() takes
+static std::vector<std::unique_ptr<SourceFile>>& files() {
+    static std::vector<std::unique_ptr<SourceFile>> files = [] {
+        std::vector<std::unique_ptr<SourceFile>> builtin;
+        builtin.reserve(max_files);
+        builtin.push_back(std::make_unique<SourceFile>(
+            std::string(builtin_text), "<builtin>"));
+        return builtin;
+    }();
+    return files;
+}
+
+static uint16_t add(std::unique_ptr<SourceFile> file) {
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& all = files();
+    if (all.size() == max_files) {
+        std::cerr << "Error: more than " << max_files - 1
+                  << " source files, " << file->filename()
+                  << " can not be added" << std::endl;
+        exit(1);
+    }
+    all.push_back(std::move(file));
+    return all.size() - 1;
+}
+
+uint16_t add(std::string text, std::string filename) {
+    return add(
+        std::make_unique<SourceFile>(std::move(text), std::move(filename)));
+}
+
+SourceFile& get(uint16_t id) { return *files()[id]; }
+
+// reads everything left in `fd`, used for pipes and stdin where the size is
+// not known up front
+static bool read_all(int fd, std::string& out) {
+    char buf[65536];
+    while (true) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n < 0) {
+            return false;
+        }
+        if (n == 0) {
+            return true;
+        }
+        out.append(buf, n);
+    }
+}
+
+std::optional<uint16_t> load(const std::string& path) {
+    bool is_stdin = path == "-";
+    int fd = is_stdin ? STDIN_FILENO : open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            if (!is_stdin) {
+                close(fd);
+            }
+            return add(std::make_unique<SourceFile>(data, st.st_size, path));
+        }
+    }
+
+    std::string text;
+    bool ok = read_all(fd, text);
+    if (!is_stdin) {
+        close(fd);
+    }
+    if (!ok) {
+        return std::nullopt;
+    }
+    return add(std::move(text), path);
+}
+
+} // namespace sources
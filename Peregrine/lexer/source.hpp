@@ -0,0 +1,77 @@
+#ifndef PEREGRINE_SOURCE_HPP
+#define PEREGRINE_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// a source file held in memory for the whole compilation, tokens only keep
+// offsets into it and resolve their text through it when it is needed
+class SourceFile {
+    std::string m_filename;
+    // set when the text was read into memory instead of mapped
+    std::string m_owned;
+    void* m_mapping = nullptr;
+    size_t m_mapping_size = 0;
+    std::string_view m_text;
+    // lexemes that are not a slice of m_text, like the synthetic <ident>
+    // tokens or multi-line strings with their indentation removed
+    std::deque<std::string> m_pool;
+    // the builtin source is pooled into while function bodies are checked
+    // on other threads
+    mutable std::mutex m_pool_mutex;
+    // offset of the first character of every line
+    std::vector<uint32_t> m_line_starts;
+
+    void index_lines();
+
+  public:
+    SourceFile(std::string text, std::string filename);
+    // maps `data` which must have been returned by mmap, the mapping is
+    // released with the file
+    SourceFile(void* data, size_t size, std::string filename);
+    ~SourceFile();
+
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+
+    std::string_view text() const;
+    std::string_view filename() const;
+
+    // stores a lexeme that can not be sliced out of the text, returns its
+    // index. Lexemes can be added and read from any thread
+    uint32_t add_lexeme(std::string_view lexeme);
+    std::string_view lexeme(uint32_t index) const;
+
+    // 1-based, the line break is not included
+    std::string_view line(size_t line) const;
+    size_t line_count() const;
+    // 1-based line that the byte at `offset` is on
+    size_t line_of(size_t offset) const;
+};
+
+namespace sources {
+
+// registers a file and returns the id tokens use to refer to it, id 0 is
+// reserved for text the compiler makes up itself. Files can be registered
+// from any thread, the compiler exits when there are more than the 16 bit
+// ids can tell apart
+uint16_t add(std::string text, std::string filename);
+
+// maps the file at `path` read-only, files that can not be mapped like
+// pipes or "-" (stdin) are read once into memory instead. returns nothing
+// if the file could not be opened
+std::optional<uint16_t> load(const std::string& path);
+
+// the file with an id returned by add or load, the file does not move while
+// others are registered
+SourceFile& get(uint16_t id);
+
+} // namespace sources
+
+#endif
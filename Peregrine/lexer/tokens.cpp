@@ -1,7 +1,50 @@
 #include "tokens.hpp"
+#include "source.hpp"
+#include <map>
+#include <mutex>
+
+std::string Token::keyword() const { return std::string(lexeme()); }
+
+std::string_view Token::lexeme() const {
+    auto& file = sources::get(source);
+    if (pooled) {
+        return file.lexeme(text);
+    }
+    return file.text().substr(text, length);
+}
+
+std::string Token::statement() const {
+    return std::string(sources::get(source).line(line));
+}
 
 namespace TokenUtils {
 
+Token makeToken(TokenType type, std::string_view keyword) {
+    auto& builtin = sources::get(0);
+    Token tok;
+    tok.tkType = type;
+    tok.length = keyword.size();
+    // the texts made up most often are part of the builtin source already
+    size_t offset = builtin.text().find(keyword);
+    if (offset != std::string_view::npos) {
+        tok.text = offset;
+        return tok;
+    }
+    // any other text is pooled once, however many tokens are made for it.
+    // Tokens are made on the threads that check function bodies too, the
+    // lock keeps two of them from pooling the same text
+    static std::mutex mutex;
+    static std::map<std::string, uint32_t, std::less<>> pooled;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = pooled.find(keyword);
+    if (it == pooled.end()) {
+        it = pooled.emplace(keyword, builtin.add_lexeme(keyword)).first;
+    }
+    tok.text = it->second;
+    tok.pooled = true;
+    return tok;
+}
+
 bool isArithmeticToken(Token tok) {
     switch (tok.tkType) {
         case tk_plus:
@@ -1,10 +1,12 @@
 #ifndef PEREGRINE_TOKENS_HPP
 #define PEREGRINE_TOKENS_HPP
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 // Create a string variable
-enum TokenType {
+enum TokenType : uint8_t {
     tk_eof, // end of file
     // Some operators
     tk_dollar,     // $
@@ -123,19 +125,29 @@ enum TokenType {
     tk_format_str_stopper //end of formated str
 };
 
+// 24 bytes, the text of the token lives in the SourceFile it came from
 struct Token {
-    size_t location;
-    std::string statement;
-    std::string keyword;
-    size_t start;
-    size_t end;
-    size_t line;
-    TokenType tkType;
-    size_t tab=0;
+    uint32_t location=0;
+    uint32_t start=0;
+    uint32_t line=0;
+    uint32_t text=0;   // offset of the lexeme in the source, or index in its pool
+    uint32_t length=0; // length of the lexeme
+    uint16_t source=0; // id of the SourceFile, see sources::get
+    TokenType tkType=tk_eof;
+    bool pooled=false; // the lexeme is stored in the pool of the source
+
+    std::string keyword() const;
+    // the text of the token without copying it, valid as long as its source
+    std::string_view lexeme() const;
+    // the line the token is on
+    std::string statement() const;
 };
 
 namespace TokenUtils {
 
+// a token for text that does not come from any source file
+Token makeToken(TokenType type, std::string_view keyword);
+
 // +, -, *, etc
 bool isArithmeticToken(Token tok);
 
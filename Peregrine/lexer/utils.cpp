@@ -12,44 +12,156 @@ bool LEXER::advance(){
     }
 }
 
-std::vector<std::string> LEXER::split_ln(std::string code) {
-    std::vector<std::string> split_code;
-    std::string character;
-    std::string prev;
-    std::string temp;
-    size_t index = 0;
-    while (index < code.length()) {
-        character = code.at(index);
-        if (character == "\n" || character == "\r") {
-            //To prevent counting \r\n as 2 diffrent lines
-            if(prev=="\r" && character=="\n"){}
-            else{
-                split_code.push_back(temp);
-                temp = "";
-            }
-        } else if (character == "\"") {
-            temp += "\\\"";
-        }else{
-            temp += character;
-        }
-        index++;
-        prev=character;
-    }
-    split_code.push_back(temp);
-    return split_code;
+void LEXER::skip_to(size_t index){
+    m_loc+=index-m_curr_index;
+    m_curr_index=index;
+    m_curr_item=m_input[m_curr_index];
 }
 
-bool LEXER::is_int(const std::string s)
+std::string LEXER::current_line(){
+    return std::string(sources::get(m_source).line(m_line));
+}
+
+bool LEXER::is_int(const std::string& s)
 {
     return !s.empty() && std::find_if(s.begin(), 
         s.end(), [](unsigned char c) { return !std::isdigit(c); }) == s.end();
 }
 
-bool LEXER::is_hex(const std::string s)
-{
-  return !s.empty()&&(s.compare(0, 2, "0x") == 0||s.compare(0, 2, "0X") == 0)
-      && s.size() > 2
-      && s.find_first_not_of("0123456789abcdefABCDEF", 2) == std::string::npos;
+static bool is_space(char c){
+    return c==' '||c=='\t'||c=='\n'||c=='\v'||c=='\f'||c=='\r';
+}
+
+static bool is_digit(char c){
+    return c>='0'&&c<='9';
+}
+
+static bool is_ident_start(char c){
+    return (c>='a'&&c<='z')||(c>='A'&&c<='Z')||c=='_';
+}
+
+static bool is_hex_digit(char c){
+    return is_digit(c)||(c>='a'&&c<='f')||(c>='A'&&c<='F');
+}
+
+/*
+single pass over the word, accepts:
+    integer     [0-9]+ | 0[xX][0-9a-fA-F]+
+    decimal     \s*[-+]?(\d+(\.\d+)?|\d+\.|\.\d+)(e[-+]?\d+)?\s*
+    identifier  [a-zA-Z_][a-zA-Z0-9_]*
+anything else is invalid
+*/
+WordClass LEXER::classify(std::string_view s){
+    enum State {
+        st_start,   // nothing read yet
+        st_space,   // leading whitespace
+        st_sign,    // leading + or -
+        st_zero,    // a leading 0, may start a hex literal
+        st_hex_x,   // 0x
+        st_hex,     // 0x followed by hex digits
+        st_int,     // digits
+        st_int_dot, // digits followed by a .
+        st_dot,     // a leading .
+        st_frac,    // digits after the .
+        st_exp,     // e
+        st_exp_sign,// e followed by + or -
+        st_exp_int, // digits after the e
+        st_trail,   // trailing whitespace
+        st_ident    // identifier
+    };
+    State state=st_start;
+    bool is_plain=true;// no whitespace or sign, so digits only are an integer
+    for(char c:s){
+        switch(state){
+            case st_start:
+                if(is_ident_start(c)) state=st_ident;
+                else if(c=='0') state=st_zero;
+                else if(is_digit(c)) state=st_int;
+                else if(c=='.') state=st_dot;
+                else if(c=='+'||c=='-') {state=st_sign;is_plain=false;}
+                else if(is_space(c)) {state=st_space;is_plain=false;}
+                else return wc_invalid;
+                break;
+            case st_space:
+                if(is_digit(c)) state=st_int;
+                else if(c=='.') state=st_dot;
+                else if(c=='+'||c=='-') state=st_sign;
+                else if(!is_space(c)) return wc_invalid;
+                break;
+            case st_sign:
+                if(is_digit(c)) state=st_int;
+                else if(c=='.') state=st_dot;
+                else return wc_invalid;
+                break;
+            case st_zero:
+                if(c=='x'||c=='X') state=st_hex_x;
+                else if(is_digit(c)) state=st_int;
+                else if(c=='.') state=st_int_dot;
+                else if(c=='e') state=st_exp;
+                else if(is_space(c)) state=st_trail;
+                else return wc_invalid;
+                break;
+            case st_hex_x:
+            case st_hex:
+                if(is_hex_digit(c)) state=st_hex;
+                else return wc_invalid;
+                break;
+            case st_int:
+                if(is_digit(c)) {}
+                else if(c=='.') state=st_int_dot;
+                else if(c=='e') state=st_exp;
+                else if(is_space(c)) state=st_trail;
+                else return wc_invalid;
+                break;
+            case st_int_dot:
+            case st_frac:
+                if(is_digit(c)) state=st_frac;
+                else if(c=='e') state=st_exp;
+                else if(is_space(c)) state=st_trail;
+                else return wc_invalid;
+                break;
+            case st_dot:
+                if(is_digit(c)) state=st_frac;
+                else return wc_invalid;
+                break;
+            case st_exp:
+                if(is_digit(c)) state=st_exp_int;
+                else if(c=='+'||c=='-') state=st_exp_sign;
+                else return wc_invalid;
+                break;
+            case st_exp_sign:
+                if(is_digit(c)) state=st_exp_int;
+                else return wc_invalid;
+                break;
+            case st_exp_int:
+                if(is_digit(c)) state=st_exp_int;
+                else if(is_space(c)) state=st_trail;
+                else return wc_invalid;
+                break;
+            case st_trail:
+                if(!is_space(c)) return wc_invalid;
+                break;
+            case st_ident:
+                if(!is_ident_start(c)&&!is_digit(c)) return wc_invalid;
+                break;
+        }
+    }
+    switch(state){
+        case st_ident:
+            return wc_identifier;
+        case st_hex:
+            return wc_integer;
+        case st_zero:
+        case st_int:
+            return is_plain?wc_integer:wc_decimal;
+        case st_int_dot:
+        case st_frac:
+        case st_exp_int:
+        case st_trail:
+            return wc_decimal;
+        default:
+            return wc_invalid;
+    }
 }
 
 char LEXER::next(){
@@ -61,5 +173,23 @@ char LEXER::next(){
     }
 }
 LEXEME LEXER::result(){
-    return m_result;
+    LEXEME result;
+    do{
+        result.push_back(next_token());
+    }while(result.back().tkType!=tk_eof);
+    return result;
+}
+LEXEME LEXER::result(std::vector<PEError>& errors){
+    m_keep_errors=true;
+    auto tokens=result();
+    m_keep_errors=false;
+    errors=std::move(m_error);
+    m_error.clear();
+    return tokens;
+}
+size_t LEXER::size() const{
+    return m_input.size();
+}
+size_t LEXER::token_count() const{
+    return m_emitted;
 }
\ No newline at end of file
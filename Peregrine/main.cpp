@@ -1,77 +1,200 @@
-#include "analyzer/typeChecker.hpp"
+#include "analyzer/fold.hpp"
+#include "analyzer/semantic.hpp"
 #include "docgen/html/docgen.hpp"
 #include "codegen/cpp/codegen.hpp"
 #include "analyzer/ast_validate.hpp"
+#include "ast/cache.hpp"
+#include "ast/stats.hpp"
 #include "cli/cli.hpp"
 #include "codegen/js/codegen.hpp"
 #include "lexer/lexer.hpp"
+#include "lexer/source.hpp"
 #include "lexer/tokens.hpp"
 #include "parser/parser.hpp"
+#include "utils/memReport.hpp"
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string.h>
 #include <vector>
-#include <sys/stat.h>
 #include <filesystem>
 
+static void report_codegen(Utils::MemReport& report,const cpp::Codegen& codegen){
+    report.phase("codegen");
+    report.add("generated code","C++ output",1,codegen.output_bytes());
+    report.add("symbol tables","mangled names",codegen.symbols(),
+               codegen.symbols()*2*sizeof(Utils::Symbol));
+}
+
+static void report_tree(Utils::MemReport& report,ast::AstNodePtr program,
+                        const ast::Arena& arena){
+    //there is no tree left at the end of a streamed compilation
+    if(program!=nullptr){
+        auto stats=ast::kind_stats(program);
+        for(size_t kind=0;kind<stats.size();++kind){
+            if(stats[kind].count>0){
+                report.add("ast nodes",ast::kind_info(ast::AstKind(kind)).name,
+                           stats[kind].count,stats[kind].bytes);
+            }
+        }
+    }
+    //nodes the parser dropped are still in the arena, so it holds more
+    //nodes than the tree
+    report.add("arena","in use",ast::AstNode::created(),arena.bytes());
+    report.add("arena","free",0,arena.reserved()-arena.bytes());
+    report.add("symbol tables","interned names",Utils::Symbol::count(),
+               Utils::Symbol::bytes());
+}
+
+//the analyzed tree of the file, from the cache if it has one
+static ast::AstNodePtr load_program(uint16_t source,const std::string& path,
+                                    const cli::state& s,Utils::MemReport& report){
+    //only the C++ backend uses the types the checker infers
+    auto types=analyzer::Semantic::Types::None;
+    std::string options;
+    if(s.emit_js){
+        options="js";
+    }else if(s.emit_html){
+        options="html";
+    }else if(s.doc_html){
+        options="doc";
+    }else{
+        types=analyzer::Semantic::Types::Annotate;
+        options="cpp";
+    }
+    // the analysis is the only step before codegen whose result
+    // depends on the options
+    if(s.has_main){
+        options+=",main";
+    }
+    ast::AstCache cache(source,options);
+    ast::AstNodePtr program = s.use_cache ? cache.load() : nullptr;
+    if (program!=nullptr){
+        report.phase("cache load");
+        return program;
+    }
+    auto lex=LEXER(source);
+    Parser::Parser parser(lex,path);
+    program = parser.parse();
+    report.phase("parse");
+    report.add("tokens","Token",lex.token_count(),
+               lex.token_count()*sizeof(Token));
+    analyzer::Semantic semantic(path,s.emit_js,s.has_main,types);
+    for(auto stmt:static_cast<ast::Program*>(program)->statements()){
+        semantic.analyze(stmt);
+    }
+    semantic.finish();
+    report.phase("analyze");
+    if (s.use_cache){
+        cache.store(program);
+    }
+    return program;
+}
+
+//the tree with what is known before the program runs folded, for the
+//backends
+static ast::AstNodePtr fold(ast::AstNodePtr program,Utils::MemReport& report){
+    program=analyzer::ConstantFolder(program).fold(program);
+    report.phase("fold");
+    return program;
+}
+
+//parses, validates and generates the file one top-level statement at a
+//time. The nodes of a statement are freed before the next one is parsed, so
+//memory does not grow with the size of the file
+static void stream_cpp(uint16_t source,const std::string& path,
+                       const std::string& output,const cli::state& s,
+                       ast::Arena& arena,Utils::MemReport& report){
+    auto lex=LEXER(source);
+    Parser::Parser parser(lex,path);
+    astValidator::Validator val(path,false,s.has_main);
+    //without the whole file constants are not propagated
+    analyzer::ConstantFolder folder;
+    TypeCheck::TypeChecker checker(path,true,true);
+    cpp::Codegen codegen(output,path);
+    while(auto stmt=parser.parseNext()){
+        val.validate(stmt);
+        //the rest of the file is still validated to report all of its errors
+        if(!val.has_errors()){
+            if(auto folded=folder.fold(stmt)){
+                checker.checkStatement(folded);
+                codegen.emit(folded);
+            }
+        }
+        arena.reset();
+    }
+    codegen.finish();
+    report.add("tokens","Token",lex.token_count(),
+               lex.token_count()*sizeof(Token));
+    if(!val.passed()){
+        std::filesystem::remove(output);
+    }
+    val.finish();
+    report_codegen(report,codegen);
+}
+
 void compile(cli::state s){
+    ast::Arena arena;
+    ast::Arena::Scope arena_scope(arena);
     if (s.dev_debug){
-        std::ifstream file("../Peregrine/test.pe");
-        std::stringstream buf;
-        buf << file.rdbuf();
-
-        auto lex=LEXER(buf.str(), "test");
-        std::vector<Token> tokens = lex.result(); 
+        auto source=sources::load("../Peregrine/test.pe");
+        auto lex=source ? LEXER(*source) : LEXER("", "test");
 
         // for (auto& token : tokens) {
-        //     std::cout << "Keyword= " << token.keyword
+        //     std::cout << "Keyword= " << token.keyword()
         //               << " Type= " << token.tkType <<" Line= "<<token.line<<" Loc="<<token.location<<"\n";
         // }
-        Parser::Parser parser(tokens, "test");
+        Parser::Parser parser(lex, "test");
         ast::AstNodePtr program = parser.parse();
         std::cout << program->stringify() << "\n";
-        TypeCheck::TypeChecker typeChecker(program);
-        // astValidator::Validator val(program,"test");
+        analyzer::Semantic semantic("test");
+        for(auto stmt:static_cast<ast::Program*>(program)->statements()){
+            semantic.analyze(stmt);
+        }
+        semantic.finish();
         std::cout <<"Typed Ast:- \n"<<program->stringify() << "\n";
     }
     else{
-        std::ifstream file(s.input_filename);
-        if (file){
-            std::stringstream buf;
-            buf << file.rdbuf();
-            auto filename=s.input_filename;
-            std::string path = std::filesystem::canonical(filename).string();
-            auto lex=LEXER(buf.str(), path);
-            std::vector<Token> tokens = lex.result(); 
-            struct stat st;
-            if( stat(path.c_str(),&st) == 0 ){
-                if( st.st_mode & S_IFDIR ){
-                    std::cout<<"Error: "<<path<<" is a directory"<<std::endl;
-                    exit(1);
+        std::string path;
+        auto source=cli::load_input(s.input_filename,path);
+        if (source){
+            Utils::MemReport report;
+            report.phase("load");
+            //when streaming the file is parsed while C++ is generated
+            ast::AstNodePtr program=nullptr;
+            if(!s.stream){
+                program=load_program(*source,path,s,report);
+                if(!s.doc_html){
+                    program=fold(program,report);
                 }
             }
-            Parser::Parser parser(tokens,path);
-            ast::AstNodePtr program = parser.parse();
-            astValidator::Validator val(program,path,s.emit_js,s.has_main);
+            auto generate_cpp=[&](const std::string& output){
+                if(s.stream){
+                    stream_cpp(*source,path,output,s,arena,report);
+                }else{
+                    cpp::Codegen codegen(output, program,path);
+                    report_codegen(report,codegen);
+                }
+            };
             auto output=s.output_filename;
             
             if (s.emit_js){
                 js::Codegen codegen(output, program, false, path);
+                report.phase("codegen");
             }else if(s.emit_html){
                 js::Codegen codegen(output, program, true, path);
+                report.phase("codegen");
             }else if(s.doc_html){
                 html::Docgen Docgen(output, program, path);
+                report.phase("docgen");
             }else if(s.emit_cpp){
-                cpp::Codegen codegen(output, program,path);
+                generate_cpp(output);
             }else if(s.emit_obj){
-                cpp::Codegen codegen("temp.cc", program,path);
+                generate_cpp("temp.cc");
                 auto cmd=s.cpp_compiler+"  -c -std=c++20 temp.cc -fpermissive -w "+s.cpp_arg+" -o "+output;
                 system(cmd.c_str());
                 system("rm temp.cc");
             }else{
-                cpp::Codegen codegen("temp.cc", program,path);
+                generate_cpp("temp.cc");
                 if(s.is_release){
                     s.cpp_arg+=" -flto -s ";
                 }
@@ -79,6 +202,10 @@ void compile(cli::state s){
                 system(cmd.c_str());
                 system("rm temp.cc");
             }
+            if(s.mem_report){
+                report_tree(report,program,arena);
+                report.print(std::cout);
+            }
         }
         else{
             std::cout << "error: file with name of \"" << s.input_filename << "\" does not exist"<<std::endl;
@@ -24,7 +24,7 @@ AstNodePtr Parser::parseFunctionDef() {
         return parseMethodDef();
     }
     Token tok = m_currentToken;
-    expect(tk_identifier, "Expected a name but got "+next().keyword+" instead","Add a name here","","");
+    expect(tk_identifier, "Expected a name but got "+next().keyword()+" instead","Add a name here","","");
     if(next().tkType==tk_dot){
         /*
         It's an external function
@@ -37,7 +37,7 @@ AstNodePtr Parser::parseFunctionDef() {
     if(next().tkType==tk_dict_open){
         generics=parseGenericsDef();
     }
-    expect(tk_l_paren,"Expected a ( but got "+next().keyword+" instead");
+    expect(tk_l_paren,"Expected a ( but got "+next().keyword()+" instead");
     std::vector<parameter> parameters;
 
     advance();
@@ -52,10 +52,10 @@ AstNodePtr Parser::parseFunctionDef() {
 
     if (m_currentToken.tkType != tk_r_paren) {
         error(m_currentToken,
-              "expected ), got " + m_currentToken.keyword + " instead");
+              "expected ), got " + m_currentToken.keyword() + " instead");
     }
 
-    AstNodePtr returnType=std::make_shared<TypeExpression>(Token{},"void");
+    AstNodePtr returnType=ast::make<TypeExpression>(Token{},"void");
 
     if (next().tkType == tk_arrow) {
         advance();
@@ -66,23 +66,23 @@ AstNodePtr Parser::parseFunctionDef() {
         }
     }
     std::string comment;
-    expect(tk_colon,"Expected a : but got "+next().keyword+" instead","Add a : here","","");
+    expect(tk_colon,"Expected a : but got "+next().keyword()+" instead","Add a : here","","");
     size_t line=m_currentToken.line;
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     if(next().tkType!=tk_ident && next().line==line){
       advance();
       std::vector<AstNodePtr> x;
       x.push_back(parseStatement());
-      body = std::make_shared<BlockStatement>(x);
+      body = ast::make<BlockStatement>(x);
     }
     else{
-      expect(tk_ident, "Expected an ident but got "+next().keyword+" instead");
+      expect(tk_ident, "Expected an ident but got "+next().keyword()+" instead");
       if (next().tkType==tk_string){
-        comment=next().keyword;
+        comment=next().keyword();
       }
       body = parseBlockStatement();
     }
-    return std::make_shared<FunctionDefinition>(tok, returnType, name,
+    return ast::make<FunctionDefinition>(tok, returnType, name,
                                                 parameters, body,comment,generics);
 }
 
@@ -95,7 +95,7 @@ AstNodePtr Parser::parseMultipleAssign(AstNodePtr left){
     std::vector<AstNodePtr> names;
     std::vector<AstNodePtr> values;
     names.push_back(left);
-    expect(tk_comma,"Expected , but got "+next().keyword+" instead","","","");
+    expect(tk_comma,"Expected , but got "+next().keyword()+" instead","","","");
     while (m_currentToken.tkType==tk_comma){
         advance();
         names.push_back(parseExpression());
@@ -103,7 +103,7 @@ AstNodePtr Parser::parseMultipleAssign(AstNodePtr left){
             advance();
         }
     }
-    expect(tk_assign,"Expected = but got "+next().keyword+" instead","","","");
+    expect(tk_assign,"Expected = but got "+next().keyword()+" instead","","","");
     advance();
     values.push_back(parseExpression());
     if(next().tkType==tk_comma){
@@ -119,7 +119,7 @@ AstNodePtr Parser::parseMultipleAssign(AstNodePtr left){
             break;
         }
     }
-    return std::make_shared<MultipleAssign>(names,values);
+    return ast::make<MultipleAssign>(names,values);
 }
 
 AstNodePtr Parser::parseMethodDef() {
@@ -137,7 +137,7 @@ AstNodePtr Parser::parseMethodDef() {
         is_const=true;
     }
     parameter reciever;
-    reciever.p_default=std::make_shared<NoLiteral>();;
+    reciever.p_default=ast::make<NoLiteral>();;
     reciever.p_name=parseName();
     if(next().tkType==tk_colon){
         advance();
@@ -145,19 +145,19 @@ AstNodePtr Parser::parseMethodDef() {
         reciever.p_type=parseType();
     }
     else{
-        reciever.p_type=std::make_shared<NoLiteral>();
+        reciever.p_type=ast::make<NoLiteral>();
     }
     reciever.is_const=is_const;
-    expect(tk_r_paren,"Expected ) but got "+next().keyword+" instead","","","");
+    expect(tk_r_paren,"Expected ) but got "+next().keyword()+" instead","","","");
     // advance();
-    expect(tk_identifier, "Expected a name but got "+next().keyword+" instead","Add a name here","","");
+    expect(tk_identifier, "Expected a name but got "+next().keyword()+" instead","Add a name here","","");
 
     AstNodePtr name = parseName();
     std::vector<AstNodePtr> generics;
     if(next().tkType==tk_dict_open){
         generics=parseGenericsDef();
     }
-    expect(tk_l_paren,"Expected a ( but got "+next().keyword+" instead");
+    expect(tk_l_paren,"Expected a ( but got "+next().keyword()+" instead");
     std::vector<parameter> parameters;
 
     advance();
@@ -172,10 +172,10 @@ AstNodePtr Parser::parseMethodDef() {
 
     if (m_currentToken.tkType != tk_r_paren) {
         error(m_currentToken,
-              "expected ), got " + m_currentToken.keyword + " instead");
+              "expected ), got " + m_currentToken.keyword() + " instead");
     }
 
-    AstNodePtr returnType=std::make_shared<TypeExpression>(Token{},"void");
+    AstNodePtr returnType=ast::make<TypeExpression>(Token{},"void");
 
     if (next().tkType == tk_arrow) {
         advance();
@@ -186,23 +186,23 @@ AstNodePtr Parser::parseMethodDef() {
         }
     }
     std::string comment;
-    expect(tk_colon,"Expected a : but got "+next().keyword+" instead","Add a : here","","");
+    expect(tk_colon,"Expected a : but got "+next().keyword()+" instead","Add a : here","","");
     size_t line=m_currentToken.line;
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     if(next().tkType!=tk_ident && next().line==line){
       advance();
       std::vector<AstNodePtr> x;
       x.push_back(parseStatement());
-      body = std::make_shared<BlockStatement>(x);
+      body = ast::make<BlockStatement>(x);
     }
     else{
-      expect(tk_ident, "Expected an ident but got "+next().keyword+" instead");
+      expect(tk_ident, "Expected an ident but got "+next().keyword()+" instead");
       if (next().tkType==tk_string){
-        comment=next().keyword;
+        comment=next().keyword();
       }
       body = parseBlockStatement();
     }
-    return std::make_shared<MethodDefinition>(tok, returnType, name,
+    return ast::make<MethodDefinition>(tok, returnType, name,
                                                 parameters,reciever, body,comment,generics);
 }
 
@@ -212,16 +212,16 @@ AstNodePtr Parser::parseExternFuncDef(Token tok){
     Parses external function from a c library
     def c.external_function(another_arg)->return_type
     */
-    auto owner=m_currentToken.keyword;
+    auto owner=m_currentToken.keyword();
     advance();
-    expect(tk_identifier,"Expected identifier but got "+next().keyword+" instead","","","");
+    expect(tk_identifier,"Expected identifier but got "+next().keyword()+" instead","","","");
     AstNodePtr name=parseName();
-    expect(tk_l_paren,"Expected ( but got "+next().keyword+" instead","","","");
+    expect(tk_l_paren,"Expected ( but got "+next().keyword()+" instead","","","");
     std::vector<AstNodePtr> parameters;
     advance();
     while (m_currentToken.tkType != tk_r_paren) {
         if(m_currentToken.tkType==tk_ellipses){
-            parameters.push_back(std::make_shared<EllipsesTypeExpr>(m_currentToken));
+            parameters.push_back(ast::make<EllipsesTypeExpr>(m_currentToken));
             advance();
             break;
         }else{
@@ -235,17 +235,17 @@ AstNodePtr Parser::parseExternFuncDef(Token tok){
             break;
         }
         else{
-            error(m_currentToken,"Expected , or ) but got "+m_currentToken.keyword+" instead");
+            error(m_currentToken,"Expected , or ) but got "+m_currentToken.keyword()+" instead");
         }
     }
     advance();
-    AstNodePtr returnType=std::make_shared<TypeExpression>(Token{},"void");
+    AstNodePtr returnType=ast::make<TypeExpression>(Token{},"void");
     if(m_currentToken.tkType==tk_arrow){
         advance();
         returnType=parseType();
     }
     advanceOnNewLine();
-    return std::make_shared<ExternFuncDef>(tok,returnType,name,parameters,owner);
+    return ast::make<ExternFuncDef>(tok,returnType,name,parameters,owner);
 }
 AstNodePtr Parser::parseExternUnion(Token tok) {
     /*
@@ -255,20 +255,20 @@ AstNodePtr Parser::parseExternUnion(Token tok) {
         item1:type1
         item2:type2
     */
-    auto owner=m_currentToken.keyword;
+    auto owner=m_currentToken.keyword();
     advance();
     expect(tk_identifier, "Expected an identifier, got " +
-                                  next().keyword +
+                                  next().keyword() +
                                   " instead");
     AstNodePtr union_name = parseName();
     std::vector<std::pair<AstNodePtr, AstNodePtr>> elements;
     if(next().tkType!=tk_colon){
         //it is an incomplete defination
         advanceOnNewLine();
-        return std::make_shared<ExternUnionLiteral>(tok, elements, union_name,owner);
+        return ast::make<ExternUnionLiteral>(tok, elements, union_name,owner);
     }
-    expect(tk_colon, "Expected : but got "+next().keyword+" instead","Add a : here","","");
-    expect(tk_ident, "Expected identation but got "+next().keyword+" instead","","","");
+    expect(tk_colon, "Expected : but got "+next().keyword()+" instead","Add a : here","","");
+    expect(tk_ident, "Expected identation but got "+next().keyword()+" instead","","","");
     advance();
     while (m_currentToken.tkType != tk_dedent) {
         while(m_currentToken.tkType==tk_string){
@@ -286,10 +286,10 @@ AstNodePtr Parser::parseExternUnion(Token tok) {
         }
         else if(m_currentToken.tkType==tk_dedent){}
         else{
-            error(m_currentToken, "Expected new line or dedent but got "+m_currentToken.keyword+" instead","","","");
+            error(m_currentToken, "Expected new line or dedent but got "+m_currentToken.keyword()+" instead","","","");
         }
     }
-    return std::make_shared<ExternUnionLiteral>(tok, elements, union_name,owner);
+    return ast::make<ExternUnionLiteral>(tok, elements, union_name,owner);
 }
 
 AstNodePtr Parser::parseExternStruct(Token tok) {
@@ -300,20 +300,20 @@ AstNodePtr Parser::parseExternStruct(Token tok) {
         item1:type1
         item2:type2
     */
-    auto owner=m_currentToken.keyword;
+    auto owner=m_currentToken.keyword();
     advance();
     expect(tk_identifier, "Expected an identifier, got " +
-                                  next().keyword +
+                                  next().keyword() +
                                   " instead");
     AstNodePtr union_name = parseName();
     std::vector<std::pair<AstNodePtr, AstNodePtr>> elements;
     if(next().tkType!=tk_colon){
         //it is an incomplete defination
         advanceOnNewLine();
-        return std::make_shared<ExternStructLiteral>(tok, elements, union_name,owner);
+        return ast::make<ExternStructLiteral>(tok, elements, union_name,owner);
     }
-    expect(tk_colon, "Expected : but got "+next().keyword+" instead","Add a : here","","");
-    expect(tk_ident, "Expected identation but got "+next().keyword+" instead","","","");
+    expect(tk_colon, "Expected : but got "+next().keyword()+" instead","Add a : here","","");
+    expect(tk_ident, "Expected identation but got "+next().keyword()+" instead","","","");
     advance();
     while (m_currentToken.tkType != tk_dedent) {
         while(m_currentToken.tkType==tk_string){
@@ -331,10 +331,10 @@ AstNodePtr Parser::parseExternStruct(Token tok) {
         }
         else if(m_currentToken.tkType==tk_dedent){}
         else{
-            error(m_currentToken, "Expected new line or dedent but got "+m_currentToken.keyword+" instead","","","");
+            error(m_currentToken, "Expected new line or dedent but got "+m_currentToken.keyword()+" instead","","","");
         }
     }
-    return std::make_shared<ExternStructLiteral>(tok, elements, union_name,owner);
+    return ast::make<ExternStructLiteral>(tok, elements, union_name,owner);
 }
 AstNodePtr Parser::parseClassDefinition() {
     /*
@@ -354,7 +354,7 @@ AstNodePtr Parser::parseClassDefinition() {
     std::vector<AstNodePtr> dec_methods;
 
     expect(tk_identifier,
-                "Expected the name of the class but got "+next().keyword+" instead","Add a name here","","e2");
+                "Expected the name of the class but got "+next().keyword()+" instead","Add a name here","","e2");
     if(next().tkType==tk_dot){
         return parseExternStruct(tok);
     }
@@ -379,13 +379,13 @@ AstNodePtr Parser::parseClassDefinition() {
     }
 
     expect(tk_colon,
-    "Expected : but got "+next().keyword+" instead","Add a : here","","e2");
+    "Expected : but got "+next().keyword()+" instead","Add a : here","","e2");
 
-    expect(tk_ident,"Expected an ident but got "+next().keyword+" instead");
+    expect(tk_ident,"Expected an ident but got "+next().keyword()+" instead");
     advance();
     std::string comment;
     if(m_currentToken.tkType==tk_string){
-      comment=m_currentToken.keyword;
+      comment=m_currentToken.keyword();
     }
     while (m_currentToken.tkType != tk_dedent) {
         switch (m_currentToken.tkType) {
@@ -403,7 +403,7 @@ AstNodePtr Parser::parseClassDefinition() {
                     attributes.push_back(parsePrivate(true));
                 }
                 else if (next().tkType==tk_static) {
-                    if(m_tokens[m_tokIndex+2].tkType==tk_const||m_tokens[m_tokIndex+2].tkType==tk_identifier){
+                    if(peek(2).tkType==tk_const||peek(2).tkType==tk_identifier){
                         attributes.push_back(parsePrivate(true));
                     }
                     else{
@@ -478,13 +478,13 @@ AstNodePtr Parser::parseClassDefinition() {
             default: {
                 error(m_currentToken,
                       "Expected a method or variable declaration or enums or nested class/union but got " +
-                          m_currentToken.keyword + " instead" ,"A class can only contain methods(functions) or variable declaration or enums or nested class/union ","","e3");
+                          m_currentToken.keyword() + " instead" ,"A class can only contain methods(functions) or variable declaration or enums or nested class/union ","","e3");
             }
         }
 
         advance();
     }
-    return std::make_shared<ClassDefinition>(tok, name, parent, attributes,
+    return ast::make<ClassDefinition>(tok, name, parent, attributes,
                                              methods, other,comment,generics);
 }
 
@@ -496,7 +496,7 @@ AstNodePtr Parser::parseVariableStatement() {
     var_name:var_type
     */
     Token tok = m_currentToken;
-    AstNodePtr varType = std::make_shared<NoLiteral>();
+    AstNodePtr varType = ast::make<NoLiteral>();
     AstNodePtr name = parseName();
     bool has_value=false;
     advance();
@@ -507,20 +507,20 @@ AstNodePtr Parser::parseVariableStatement() {
         advance();
     }
     
-    AstNodePtr value = std::make_shared<NoLiteral>();
+    AstNodePtr value = ast::make<NoLiteral>();
     if (m_currentToken.tkType == tk_assign||has_value) {
         advance();
         value = parseExpression();
     } else {
         if(m_currentToken.tkType!=tk_new_line){
             error(m_currentToken,
-                    "Expected a new line or =  but got "+m_currentToken.keyword+" instead","","","");
+                    "Expected a new line or =  but got "+m_currentToken.keyword()+" instead","","","");
         }
         //not necessary ig because the current token the one after a 
         // advanceOnNewLine();
     }
 
-    return std::make_shared<VariableStatement>(tok, varType, name, value);
+    return ast::make<VariableStatement>(tok, varType, name, value);
 }
 
 AstNodePtr Parser::parseConstDeclaration() {
@@ -532,17 +532,17 @@ AstNodePtr Parser::parseConstDeclaration() {
     expect(tk_identifier);
     AstNodePtr name = parseName();
     // advance();
-    AstNodePtr constType = std::make_shared<NoLiteral>();
+    AstNodePtr constType = ast::make<NoLiteral>();
     if (next().tkType == tk_colon) {
         advance();
         advance();
         constType = parseType();
     }
-    expect(tk_assign,"Expected an assignment but got "+next().keyword+" instead","Constants can't have uninitialised value","","");
+    expect(tk_assign,"Expected an assignment but got "+next().keyword()+" instead","Constants can't have uninitialised value","","");
     advance();
 
     AstNodePtr value = parseExpression();
-    return std::make_shared<ConstDeclaration>(tok, constType, name, value);
+    return ast::make<ConstDeclaration>(tok, constType, name, value);
 }
 AstNodePtr Parser::parseDecoratorCall() {
     /*
@@ -553,11 +553,11 @@ AstNodePtr Parser::parseDecoratorCall() {
     */
     auto tok = m_currentToken;
     std::vector<AstNodePtr> decorators;
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     while (m_currentToken.tkType == tk_at) {
         if (next().tkType != tk_identifier) {
             error(next(), "Expected an identifier, got " +
-                                  next().keyword +
+                                  next().keyword() +
                                   " instead");
         }
         advance();
@@ -577,9 +577,9 @@ AstNodePtr Parser::parseDecoratorCall() {
         error(m_currentToken,"Can't use decorators with virtual function","","","");
     }
     else{
-        error(m_currentToken, "Expected a function declaration but got "+m_currentToken.keyword+" instead","","","");
+        error(m_currentToken, "Expected a function declaration but got "+m_currentToken.keyword()+" instead","","","");
     }
-    return std::make_shared<DecoratorStatement>(tok, decorators, body);
+    return ast::make<DecoratorStatement>(tok, decorators, body);
 }
 AstNodePtr Parser::parseUnion() {
     /*
@@ -590,7 +590,7 @@ AstNodePtr Parser::parseUnion() {
     */
     auto tok = m_currentToken;
     expect(tk_identifier, "Expected an identifier, got " +
-                                  next().keyword +
+                                  next().keyword() +
                                   " instead");
     if(next().tkType==tk_dot){
         return parseExternUnion(tok);
@@ -600,15 +600,15 @@ AstNodePtr Parser::parseUnion() {
     if(next().tkType==tk_dict_open){
         generics=parseGenericsDef();
     }
-    expect(tk_colon, "Expected : but got "+next().keyword+" instead","Add a : here","","");
-    expect(tk_ident, "Expected identation but got "+next().keyword+" instead","","","");
+    expect(tk_colon, "Expected : but got "+next().keyword()+" instead","Add a : here","","");
+    expect(tk_ident, "Expected identation but got "+next().keyword()+" instead","","","");
     advance();
     std::vector<std::pair<AstNodePtr, AstNodePtr>> elements;
     std::string comment;
     while (m_currentToken.tkType != tk_dedent) {
         while(m_currentToken.tkType==tk_string){
           if(comment=="" && elements.size()==0){
-            comment=m_currentToken.keyword;
+            comment=m_currentToken.keyword();
           }
           advance();
           if(m_currentToken.tkType==tk_new_line){advance();}
@@ -624,10 +624,10 @@ AstNodePtr Parser::parseUnion() {
         }
         else if(m_currentToken.tkType==tk_dedent){}
         else{
-            error(m_currentToken, "Expected new line or dedent but got "+m_currentToken.keyword+" instead","","","");
+            error(m_currentToken, "Expected new line or dedent but got "+m_currentToken.keyword()+" instead","","","");
         }
     }
-    return std::make_shared<UnionLiteral>(tok, elements, union_name,comment,generics);
+    return ast::make<UnionLiteral>(tok, elements, union_name,comment,generics);
 }
 
 AstNodePtr Parser::parseEnum() {
@@ -639,23 +639,23 @@ AstNodePtr Parser::parseEnum() {
     */
     auto token = m_currentToken;
     expect(tk_identifier, "Expected an identifier, got " +
-                                  next().keyword +
+                                  next().keyword() +
                                   " instead");
     AstNodePtr enum_name = parseName();
-    expect(tk_colon, "Expected : but got "+next().keyword+" instead","Add a : here","","");
+    expect(tk_colon, "Expected : but got "+next().keyword()+" instead","Add a : here","","");
     auto line=m_currentToken.line;
     TokenType stopat=tk_dedent;
     if(next().tkType!=tk_ident && next().line==line && next().tkType!=tk_new_line){stopat=tk_new_line;}
     else{
-        expect(tk_ident,"Expected identation but got "+next().keyword+" instead","","","");
+        expect(tk_ident,"Expected identation but got "+next().keyword()+" instead","","","");
         }
     advance();
     std::string comment;
     if (m_currentToken.tkType==tk_string){
-      comment=m_currentToken.keyword;
+      comment=m_currentToken.keyword();
     }
     std::vector<std::pair<AstNodePtr, AstNodePtr>> fields;
-    AstNodePtr val;
+    AstNodePtr val = nullptr;
 
     while (m_currentToken.tkType != stopat) {
         while(m_currentToken.tkType==tk_string){
@@ -668,7 +668,7 @@ AstNodePtr Parser::parseEnum() {
             advance();
             val = parseExpression();
         } else {
-            val = std::make_shared<NoLiteral>();
+            val = ast::make<NoLiteral>();
         }
         if(stopat==tk_dedent){
           advance();
@@ -682,7 +682,7 @@ AstNodePtr Parser::parseEnum() {
         }
     }
 
-    return std::make_shared<EnumLiteral>(token, fields, enum_name,comment);
+    return ast::make<EnumLiteral>(token, fields, enum_name,comment);
 }
 AstNodePtr Parser::parseTypeDef() {
     /*
@@ -701,14 +701,14 @@ AstNodePtr Parser::parseTypeDef() {
         advance();
     }
     else{
-        expect(tk_assign, "Expected an = but got "+next().keyword+" instead","","","");
+        expect(tk_assign, "Expected an = but got "+next().keyword()+" instead","","","");
     }
     advance();
 
     AstNodePtr type = parseType();
 
     advanceOnNewLine();
-    return std::make_shared<TypeDefinition>(tok, name, type, generics);
+    return ast::make<TypeDefinition>(tok, name, type, generics);
 }
 
 std::vector<AstNodePtr> Parser::parseGenericsDef(){
@@ -720,13 +720,13 @@ std::vector<AstNodePtr> Parser::parseGenericsDef(){
     advance();//on the { after advance
     std::vector<AstNodePtr> generics;
     while(m_currentToken.tkType!=tk_dict_close){
-        expect(tk_identifier,"Expected an identifier but got "+next().keyword+" instead","","","");
+        expect(tk_identifier,"Expected an identifier but got "+next().keyword()+" instead","","","");
         generics.push_back(parseName());
         if(next().tkType==tk_comma||next().tkType==tk_dict_close){
             advance();
         }
         else{
-            expect(tk_dict_close,"Expected '>' but got "+next().keyword+" instead","","","");
+            expect(tk_dict_close,"Expected '>' but got "+next().keyword()+" instead","","","");
         }
     }
     return generics;
@@ -11,7 +11,7 @@ namespace Parser{
 
 AstNodePtr Parser::parseExpression(PrecedenceType currPrecedence) {
     //regular expression
-    AstNodePtr left;
+    AstNodePtr left = nullptr;
 
     switch (m_currentToken.tkType) {
         case tk_integer: {
@@ -22,7 +22,7 @@ AstNodePtr Parser::parseExpression(PrecedenceType currPrecedence) {
             auto tok=m_currentToken;
             advance();
             left=parseExpression(pr_prefix);
-            left=std::make_shared<CompileTimeExpression>(tok,left);
+            left=ast::make<CompileTimeExpression>(tok,left);
             break;
         }
         case tk_decimal: {
@@ -115,13 +115,13 @@ AstNodePtr Parser::parseExpression(PrecedenceType currPrecedence) {
             break;
         }
         case tk_eof: {
-            error(m_tokens[m_tokens.size() - 2],
+            error(m_previousToken,
                   "Unexpected end of file","","","e1");
             break;
         }
         default: {
             error(m_currentToken,
-                  m_currentToken.keyword + " is not an expression");
+                  m_currentToken.keyword() + " is not an expression");
             break;
         }
     }
@@ -176,11 +176,11 @@ AstNodePtr Parser::parseExpression(PrecedenceType currPrecedence) {
 AstNodePtr Parser::parseBinaryOperation(AstNodePtr left) {
     //binary operator
     Token op = m_currentToken;
-    PrecedenceType precedence = precedenceMap[m_currentToken.tkType];
+    PrecedenceType precedence = precedenceTable[m_currentToken.tkType];
 
     advance();
     AstNodePtr right = parseExpression(precedence);
-    return std::make_shared<BinaryOperation>(op, left, op, right);
+    return ast::make<BinaryOperation>(op, left, op, right);
 }
 
 AstNodePtr Parser::parseFunctionCall(AstNodePtr left) {
@@ -207,12 +207,12 @@ AstNodePtr Parser::parseFunctionCall(AstNodePtr left) {
 
     if (m_currentToken.tkType != tk_r_paren) {
         error(m_currentToken,
-              "expected ), got " + m_currentToken.keyword + " instead");
+              "expected ), got " + m_currentToken.keyword() + " instead");
     }
 
     advanceOnNewLine();
 
-    return std::make_shared<FunctionCall>(tok, left, arguments);
+    return ast::make<FunctionCall>(tok, left, arguments);
 }
 
 AstNodePtr Parser::parseListOrDictAccess(AstNodePtr left) {
@@ -232,9 +232,9 @@ AstNodePtr Parser::parseListOrDictAccess(AstNodePtr left) {
         advance();
         keyOrIndex.push_back(parseExpression());
     }
-    expect(tk_list_close, "Expected ] but got "+next().keyword+" instead","Add a ] here","","");
+    expect(tk_list_close, "Expected ] but got "+next().keyword()+" instead","Add a ] here","","");
 
-    AstNodePtr node = std::make_shared<ListOrDictAccess>(tok, left, keyOrIndex);
+    AstNodePtr node = ast::make<ListOrDictAccess>(tok, left, keyOrIndex);
     return node;
 }
 
@@ -242,11 +242,11 @@ AstNodePtr Parser::parseDotExpression(AstNodePtr left) {
     //dot expression
     //object.attribute
     Token tok = m_currentToken;
-    PrecedenceType currentPrecedence = precedenceMap[tok.tkType];
+    PrecedenceType currentPrecedence = precedenceTable[tok.tkType];
     advance();
-    AstNodePtr referenced;
+    AstNodePtr referenced = nullptr;
     referenced = parseExpression(currentPrecedence);
-    return std::make_shared<DotExpression>(tok, left, referenced);
+    return ast::make<DotExpression>(tok, left, referenced);
 }
 
 AstNodePtr Parser::parsePrefixExpression() {
@@ -258,7 +258,7 @@ AstNodePtr Parser::parsePrefixExpression() {
 
     AstNodePtr right = parseExpression(precedence);
 
-    return std::make_shared<PrefixExpression>(prefix, prefix, right);
+    return ast::make<PrefixExpression>(prefix, prefix, right);
 }
 
 AstNodePtr Parser::parsePostfixExpression(AstNodePtr left) {
@@ -266,7 +266,7 @@ AstNodePtr Parser::parsePostfixExpression(AstNodePtr left) {
     //i++
     //i--
     Token prefix = m_currentToken;
-    return std::make_shared<PostfixExpression>(prefix, prefix, left);
+    return ast::make<PostfixExpression>(prefix, prefix, left);
 }
 
 AstNodePtr Parser::parseGroupedExpr() {
@@ -274,7 +274,7 @@ AstNodePtr Parser::parseGroupedExpr() {
     advance();
 
     AstNodePtr expr = parseExpression();
-    expect(tk_r_paren, "Expected ) but got "+next().keyword+" instead","Add a ) here","","");
+    expect(tk_r_paren, "Expected ) but got "+next().keyword()+" instead","Add a ) here","","");
 
     return expr;
 }
@@ -292,7 +292,7 @@ AstNodePtr Parser::parseTernaryIf(AstNodePtr left){
         }
         else{
             error(next(),"Expected else but got "+
-                            next().keyword+
+                            next().keyword()+
                             " instead",
                             "Ternary if statement not possible without an else body",
                             "Add an else body here","");
@@ -301,7 +301,7 @@ AstNodePtr Parser::parseTernaryIf(AstNodePtr left){
     advance();
     advance();
     AstNodePtr else_value=parseExpression(pr_conditional);
-    return std::make_shared<TernaryIf>(tok,left,if_condition,else_value);
+    return ast::make<TernaryIf>(tok,left,if_condition,else_value);
 }
 AstNodePtr Parser::parseTernaryFor(AstNodePtr left){
     //terenary for
@@ -317,24 +317,24 @@ AstNodePtr Parser::parseTernaryFor(AstNodePtr left){
             advance();
         } else if (m_currentToken.tkType != tk_in) {
             error(m_currentToken,
-                "Expected an in after the variable but got "+m_currentToken.keyword+" instead","Add an in here","","e5");
+                "Expected an in after the variable but got "+m_currentToken.keyword()+" instead","Add an in here","","e5");
         }
     }
     advance();
 
     AstNodePtr sequence = parseExpression(pr_conditional);
     advanceOnNewLine();
-    return std::make_shared<TernaryFor>(tok,left,sequence,variable);
+    return ast::make<TernaryFor>(tok,left,sequence,variable);
 }
 AstNodePtr Parser::parseArrowExpression(AstNodePtr left) {
     //arrow
     //ptr->attribute
     Token tok = m_currentToken;
-    PrecedenceType currentPrecedence = precedenceMap[tok.tkType];
+    PrecedenceType currentPrecedence = precedenceTable[tok.tkType];
     advance();
-    AstNodePtr referenced;
+    AstNodePtr referenced = nullptr;
     referenced = parseExpression(currentPrecedence);
-    return std::make_shared<ArrowExpression>(tok, left, referenced);
+    return ast::make<ArrowExpression>(tok, left, referenced);
 }
 AstNodePtr Parser::parseReturnExprTurple(AstNodePtr item){
     //returns in the fore of 1,2,3
@@ -348,7 +348,7 @@ AstNodePtr Parser::parseReturnExprTurple(AstNodePtr item){
             advance();
         }
     }
-    return std::make_shared<ExpressionTuple>(items);
+    return ast::make<ExpressionTuple>(items);
 }
 
 AstNodePtr Parser::parseReturnTypeTurple(AstNodePtr item){
@@ -363,32 +363,32 @@ AstNodePtr Parser::parseReturnTypeTurple(AstNodePtr item){
             advance();
         }
     }
-    return std::make_shared<TypeTuple>(items);
+    return ast::make<TypeTuple>(items);
 }
 AstNodePtr Parser::parseCast() {
     //parsing cast expression
     //cast<type>(expr)
     auto tok = m_currentToken;
     expect(tk_less, "Expected < but got " +
-                         next().keyword +
+                         next().keyword() +
                          " instead");
     advance();
     AstNodePtr type = parseType();
     expect(tk_greater, "Expected > but got " +
-                            next().keyword +
+                            next().keyword() +
                             " instead");
-    expect(tk_l_paren,"Expected ( but got "+next().keyword+" instead","","","");
+    expect(tk_l_paren,"Expected ( but got "+next().keyword()+" instead","","","");
     advance();
 
     AstNodePtr value = parseExpression();
-    expect(tk_r_paren,"Expected ) but got "+next().keyword+" instead","","","");
-    return std::make_shared<CastStatement>(tok, type, value);
+    expect(tk_r_paren,"Expected ) but got "+next().keyword()+" instead","","","");
+    return ast::make<CastStatement>(tok, type, value);
 }
 AstNodePtr Parser::parseLambda(){
     //parses lambda expression
     //def (arg2:type):value_to_return
     auto tok=m_currentToken;
-    expect(tk_l_paren,"Expected a ( but got "+next().keyword+" instead");
+    expect(tk_l_paren,"Expected a ( but got "+next().keyword()+" instead");
     std::vector<parameter> parameters;
 
     advance();
@@ -405,12 +405,12 @@ AstNodePtr Parser::parseLambda(){
     }
     if (m_currentToken.tkType != tk_r_paren) {
         error(m_currentToken,
-              "expected ), got " + m_currentToken.keyword + " instead");
+              "expected ), got " + m_currentToken.keyword() + " instead");
     }
-    expect(tk_colon,"Expected a : but got "+next().keyword+" instead","Add a : here","","");
+    expect(tk_colon,"Expected a : but got "+next().keyword()+" instead","Add a : here","","");
     advance();
     AstNodePtr body=parseExpression(pr_lambda);
-    return std::make_shared<LambdaDefinition>(tok,parameters,body);
+    return ast::make<LambdaDefinition>(tok,parameters,body);
 }
 
 
@@ -431,10 +431,10 @@ AstNodePtr Parser::parseGeneric(AstNodePtr identifier){
         } else if (m_currentToken.tkType == tk_dict_close) {
             break;
         }else{
-            error(m_currentToken,"Expected { or , but got "+m_currentToken.keyword+" instead","","","");
+            error(m_currentToken,"Expected { or , but got "+m_currentToken.keyword()+" instead","","","");
         }
     }
-    return std::make_shared<GenericCall>(tok,generic_types,identifier);
+    return ast::make<GenericCall>(tok,generic_types,identifier);
 }
 AstNodePtr Parser::parseFormatString(){
     auto tok = m_currentToken;
@@ -444,7 +444,7 @@ AstNodePtr Parser::parseFormatString(){
         items.push_back(parseExpression());
         advance();
     }
-    return std::make_shared<FormatedStr>(tok,items);
+    return ast::make<FormatedStr>(tok,items);
 }
 
 }
\ No newline at end of file
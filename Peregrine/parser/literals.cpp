@@ -8,26 +8,26 @@ using namespace ast;
 
 AstNodePtr Parser::parseInteger() {
     //746
-    return std::make_shared<IntegerLiteral>(m_currentToken,
-                                            m_currentToken.keyword);
+    return ast::make<IntegerLiteral>(m_currentToken,
+                                            m_currentToken.lexeme());
 }
 
 AstNodePtr Parser::parseDecimal() {
     //2.56
-    return std::make_shared<DecimalLiteral>(m_currentToken,
-                                            m_currentToken.keyword);
+    return ast::make<DecimalLiteral>(m_currentToken,
+                                            m_currentToken.lexeme());
 }
 
 AstNodePtr Parser::parseString(bool isRaw) {
     //"string "
-    return std::make_shared<StringLiteral>(
-        m_currentToken, m_currentToken.keyword,isRaw);
+    return ast::make<StringLiteral>(
+        m_currentToken, m_currentToken.lexeme(),isRaw);
 }
 
 AstNodePtr Parser::parseBool() {
     //True or False
-    return std::make_shared<BoolLiteral>(m_currentToken,
-                                         m_currentToken.keyword);
+    return ast::make<BoolLiteral>(m_currentToken,
+                                         m_currentToken.lexeme());
 }
 
 AstNodePtr Parser::parseList() {
@@ -50,12 +50,12 @@ AstNodePtr Parser::parseList() {
 
     if (m_currentToken.tkType != tk_list_close) {
         error(m_currentToken,
-              "expected ], got " + m_currentToken.keyword + " instead");
+              "expected ], got " + m_currentToken.keyword() + " instead");
     }
 
     advanceOnNewLine();
 
-    return std::make_shared<ListLiteral>(tok, elements);
+    return ast::make<ListLiteral>(tok, elements);
 }
 
 AstNodePtr Parser::parseDict() {
@@ -82,29 +82,29 @@ AstNodePtr Parser::parseDict() {
 
     if (m_currentToken.tkType != tk_dict_close) {
         error(m_currentToken,
-              "expected }, got " + m_currentToken.keyword + " instead");
+              "expected }, got " + m_currentToken.keyword() + " instead");
     }
 
     advanceOnNewLine();
 
-    return std::make_shared<DictLiteral>(tok, elements);
+    return ast::make<DictLiteral>(tok, elements);
 }
 
 AstNodePtr Parser::parseIdentifier() {
     //identifier name
     if (m_currentToken.tkType!=tk_identifier){
         error(m_currentToken,
-              "Expected identifier but got " + m_currentToken.keyword + " instead");
+              "Expected identifier but got " + m_currentToken.keyword() + " instead");
     }
-    return std::make_shared<IdentifierExpression>(m_currentToken,
-                                                  m_currentToken.keyword);
+    return ast::make<IdentifierExpression>(m_currentToken,
+                                                  m_currentToken.lexeme());
 }
 
 AstNodePtr Parser::parseName() {
     //identifier name
     if (m_currentToken.tkType != tk_identifier) {
         error(m_currentToken, "expected an identifier, got " +
-                                  m_currentToken.keyword +
+                                  m_currentToken.keyword() +
                                   " instead");
     }
 
@@ -113,6 +113,6 @@ AstNodePtr Parser::parseName() {
 
 AstNodePtr Parser::parseNone() {
     //None
-    return std::make_shared<NoneLiteral>(m_currentToken);
+    return ast::make<NoneLiteral>(m_currentToken);
 }
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "parser.hpp"
 #include "lexer/lexer.hpp"
 #include "lexer/tokens.hpp"
+#include "utils/threadPool.hpp"
 #include <algorithm>
+#include <future>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -9,43 +11,214 @@
 #include <vector>
 namespace Parser{
 
-Parser::Parser(const std::vector<Token>& tokens,std::string filename) : m_tokens(tokens) {
+size_t Parser::parallel_threshold=1<<20;
+size_t Parser::parallel_chunk=1<<14;
+
+Parser::Parser(LEXER& lexer,std::string filename) : m_lexer(&lexer) {
     //initializer of parser class
-    m_currentToken = tokens[0];
+    m_currentToken = m_lexer->next_token();
+    m_filename=filename;
+}
+
+Parser::Parser(const Token* begin,const Token* end,const Token& eof,std::string filename)
+    : m_lexer(nullptr), m_tokens(begin), m_tokensEnd(end), m_eof(eof) {
+    //parser of the tokens begin..end, eof stands in for the token after them
+    m_eof.tkType = tk_eof;
+    m_currentToken = pull();
     m_filename=filename;
 }
 
 Parser::~Parser() {}
 
 AstNodePtr Parser::parse() {
-    //start parsing
-    std::vector<AstNodePtr> statements;
+    //start parsing, large files in parallel unless there is only one core
+    if (m_lexer->size() >= parallel_threshold &&
+        Utils::ThreadPool::shared().size() > 1) {
+        return parseParallel();
+    }
     std::string comment;
-    while (m_currentToken.tkType != tk_eof) {
-        if(m_currentToken.tkType==tk_string && statements.size()==0 && comment==""){
-          comment=m_currentToken.keyword;
-          if(next().tkType==tk_new_line){
-            advance();
-            advance();
-            if(m_currentToken.tkType==tk_eof){
+    auto statements = parseStatements(comment);
+    return ast::make<Program>(statements,comment);
+}
+
+std::vector<AstNodePtr> Parser::parseStatements(std::string& comment) {
+    //top-level statements up to the end of the tokens
+    std::vector<AstNodePtr> statements;
+    while (auto stmt = parseTopLevel(comment, statements.empty())) {
+        statements.push_back(stmt);
+    }
+    return statements;
+}
+
+AstNodePtr Parser::parseTopLevel(std::string& comment, bool first) {
+    //the next top-level statement, nullptr at the end of the tokens. A
+    //string before the first statement is the doc comment of the file
+    if (m_currentToken.tkType == tk_eof) {
+        return nullptr;
+    }
+    if(m_currentToken.tkType==tk_string && first && comment==""){
+      comment=m_currentToken.keyword();
+      if(next().tkType==tk_new_line){
+        advance();
+        advance();
+        if(m_currentToken.tkType==tk_eof){
+            return nullptr;
+        }
+      }
+    }
+    auto stmt = parseStatement();
+    if(m_currentToken.tkType!=tk_new_line && m_currentToken.tkType!=tk_dedent){
+        error(m_currentToken,"Expected newline after statement");
+    }
+    advance();
+    return stmt;
+}
+
+AstNodePtr Parser::parseNext() {
+    auto stmt = parseTopLevel(m_comment, !m_parsedAny);
+    m_parsedAny = true;
+    return stmt;
+}
+
+const std::string& Parser::comment() const { return m_comment; }
+
+std::vector<size_t> Parser::chunkBounds(const std::vector<Token>& tokens) {
+    //the first token of every chunk and then tokens.size(). A chunk only
+    //starts at a def, class, enum, union or type at indentation zero, and
+    //not right after a decorator or a string, which take the definition
+    //after them as part of their statement
+    std::vector<size_t> bounds{0};
+    size_t depth = 0;
+    size_t brackets = 0;
+    bool at_start = true;
+    TokenType previous = tk_eof;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        auto type = tokens[i].tkType;
+        switch (type) {
+            case tk_ident:
+                depth++;
+                continue;
+            case tk_dedent:
+                depth -= depth > 0;
+                at_start = depth == 0 && brackets == 0;
+                continue;
+            case tk_new_line:
+                at_start = depth == 0 && brackets == 0;
+                continue;
+            case tk_l_paren:
+            case tk_list_open:
+            case tk_dict_open:
+                brackets++;
+                break;
+            case tk_r_paren:
+            case tk_list_close:
+            case tk_dict_close:
+                brackets -= brackets > 0;
+                break;
+            default:
                 break;
-            }
-          }
         }
-        statements.push_back(parseStatement());
-        if(m_currentToken.tkType!=tk_new_line && m_currentToken.tkType!=tk_dedent){
-            error(m_currentToken,"Expected newline after statement");
+        if (!at_start) {
+            continue;
         }
-        advance();
+        at_start = false;
+        bool definition = type == tk_def || type == tk_class ||
+                          type == tk_enum || type == tk_union || type == tk_type;
+        if (definition && previous != tk_at && previous != tk_string &&
+            i - bounds.back() >= parallel_chunk) {
+            bounds.push_back(i);
+        }
+        previous = type;
+    }
+    bounds.push_back(tokens.size());
+    return bounds;
+}
+
+Parser::ParsedChunk Parser::parseChunk(const std::vector<Token>& tokens,size_t begin,size_t end,std::string filename) {
+    //parses tokens[begin..end) into an arena of its own
+    ParsedChunk chunk;
+    chunk.arena = std::make_unique<ast::Arena>();
+    ast::Arena::Scope scope(*chunk.arena);
+    const Token& eof = end < tokens.size() ? tokens[end] : tokens.back();
+    Parser parser(tokens.data() + begin, tokens.data() + end, eof, filename);
+    try {
+        chunk.statements = parser.parseStatements(chunk.comment);
+    } catch (const PEError& err) {
+        chunk.error = err;
+    }
+    return chunk;
+}
+
+AstNodePtr Parser::parseParallel() {
+    //the rest of the file is lexed first, including the tokens that were
+    //already looked at
+    std::vector<Token> tokens{m_currentToken};
+    for (size_t i = 1; i <= m_lookaheadCount; ++i) {
+        tokens.push_back(peek(i));
+    }
+    std::vector<PEError> lexErrors;
+    if (tokens.back().tkType != tk_eof) {
+        auto rest = m_lexer->result(lexErrors);
+        tokens.insert(tokens.end(), rest.begin(), rest.end());
+    }
+    auto bounds = chunkBounds(tokens);
+
+    auto& pool = Utils::ThreadPool::shared();
+    std::vector<std::future<ParsedChunk>> later;
+    for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+        later.push_back(pool.submit([&tokens, begin = bounds[i],
+                                     end = bounds[i + 1], filename = m_filename] {
+            return parseChunk(tokens, begin, end, filename);
+        }));
+    }
+    //the first chunk is parsed on this thread while the others are queued
+    auto first = parseChunk(tokens, bounds[0], bounds[1], m_filename);
+    std::vector<ParsedChunk> chunks;
+    chunks.push_back(std::move(first));
+    for (auto& chunk : later) {
+        chunks.push_back(chunk.get());
     }
-    
 
-    return std::make_shared<Program>(statements,comment);
+    //the lexer reports its errors once it reaches the end of the file, so a
+    //sequential parse runs into those of the parser first unless they are
+    //on the last line
+    size_t lastLine = 0;
+    for (auto it = tokens.rbegin(); it != tokens.rend(); ++it) {
+        if (it->tkType != tk_new_line && it->tkType != tk_dedent &&
+            it->tkType != tk_eof) {
+            lastLine = it->line;
+            break;
+        }
+    }
+
+    //the chunks are put together in source order, so the error reported is
+    //the first one a sequential parse would have run into
+    auto& arena = ast::Arena::current();
+    std::vector<AstNodePtr> statements;
+    for (auto& chunk : chunks) {
+        if (chunk.error) {
+            if (!lexErrors.empty() && chunk.error->loc.line >= lastLine) {
+                break;
+            }
+            display(*chunk.error);
+            exit(1);
+        }
+        arena.adopt(*chunk.arena);
+        statements.insert(statements.end(), chunk.statements.begin(),
+                          chunk.statements.end());
+    }
+    if (!lexErrors.empty()) {
+        for (auto& err : lexErrors) {
+            display(err);
+        }
+        exit(1);
+    }
+    return ast::make<Program>(statements, chunks.front().comment);
 }
 
 AstNodePtr Parser::parseStatement() {
     //statements
-    AstNodePtr stmt;
+    AstNodePtr stmt = nullptr;
 
     switch (m_currentToken.tkType) {
         case tk_string: {
@@ -63,7 +236,7 @@ AstNodePtr Parser::parseStatement() {
             is_compile_time=true;
             stmt=parseStatement();
             is_compile_time=x;
-            stmt=std::make_shared<CompileTimeExpression>(tok,stmt);
+            stmt=ast::make<CompileTimeExpression>(tok,stmt);
             break;
         }
         case tk_static: {
@@ -126,7 +299,7 @@ AstNodePtr Parser::parseStatement() {
         }
 
         case tk_break: {
-            stmt = std::make_shared<BreakStatement>(m_currentToken);
+            stmt = ast::make<BreakStatement>(m_currentToken);
             advanceOnNewLine();
             break;
         }
@@ -138,7 +311,7 @@ AstNodePtr Parser::parseStatement() {
         }
 
         case tk_ellipses:{
-            stmt = std::make_shared<PassStatement>(m_currentToken);
+            stmt = ast::make<PassStatement>(m_currentToken);
             advanceOnNewLine();
             break;
         }
@@ -149,7 +322,7 @@ AstNodePtr Parser::parseStatement() {
         }
 
         case tk_continue: {
-            stmt = std::make_shared<ContinueStatement>(m_currentToken);
+            stmt = ast::make<ContinueStatement>(m_currentToken);
             advanceOnNewLine();
             break;
         }
@@ -245,8 +418,8 @@ AstNodePtr Parser::parseStatement() {
                 auto tok=m_currentToken;
                 advance();
                 auto value=parseExpression();
-                AstNodePtr varType = std::make_shared<NoLiteral>();
-                stmt = std::make_shared<VariableStatement>(tok, varType, stmt, value);
+                AstNodePtr varType = ast::make<NoLiteral>();
+                stmt = ast::make<VariableStatement>(tok, varType, stmt, value);
             }
             else if (next().tkType==tk_comma){
                 stmt = parseMultipleAssign(stmt);
@@ -256,7 +429,7 @@ AstNodePtr Parser::parseStatement() {
                 auto tok=m_currentToken;
                 advance();
                 auto value=parseExpression();
-                stmt = std::make_shared<AugAssign>(tok,stmt,value);
+                stmt = ast::make<AugAssign>(tok,stmt,value);
             }
             break;
         }
@@ -281,7 +454,7 @@ AstNodePtr Parser::parseBlockStatement() {
         advance();
     }
 
-    return std::make_shared<BlockStatement>(statements);
+    return ast::make<BlockStatement>(statements);
 }
 
 AstNodePtr Parser::parseVirtual() {
@@ -289,9 +462,9 @@ AstNodePtr Parser::parseVirtual() {
     //virtual def function()->return_type:...
     auto tok = m_currentToken;
     expect(tk_def,
-           "Expected a function declaration but got "+next().keyword+" instead","Declare a function here","","e4");
+           "Expected a function declaration but got "+next().keyword()+" instead","Declare a function here","","e4");
     AstNodePtr body = parseFunctionDef();
-    return std::make_shared<VirtualStatement>(tok, body);
+    return ast::make<VirtualStatement>(tok, body);
 }
 
 AstNodePtr Parser::parseImport() {
@@ -304,8 +477,8 @@ AstNodePtr Parser::parseImport() {
 
     advance(); // skip from or import token
 
-    AstNodePtr moduleName=std::make_shared<NoLiteral>();
-    std::pair<AstNodePtr, AstNodePtr> tmpmoduleName={std::make_shared<NoLiteral>(),std::make_shared<NoLiteral>()};
+    AstNodePtr moduleName=ast::make<NoLiteral>();
+    std::pair<AstNodePtr, AstNodePtr> tmpmoduleName={ast::make<NoLiteral>(),ast::make<NoLiteral>()};
     std::vector<std::pair<AstNodePtr, AstNodePtr>> importedSymbols;
     do {
         if (m_currentToken.tkType==tk_comma){
@@ -316,8 +489,8 @@ AstNodePtr Parser::parseImport() {
             advance();
             while(m_currentToken.tkType==tk_dot){
                 auto tok=m_currentToken;
-                expect(tk_identifier,next().keyword+" is not a identifier","","","");
-                tmpmoduleName.first=std::make_shared<DotExpression>(tok,tmpmoduleName.first,parseName());
+                expect(tk_identifier,next().keyword()+" is not a identifier","","","");
+                tmpmoduleName.first=ast::make<DotExpression>(tok,tmpmoduleName.first,parseName());
                 advance();
                 if(m_currentToken.tkType!=tk_dot){
                     break;
@@ -332,7 +505,7 @@ AstNodePtr Parser::parseImport() {
                 tmpmoduleName.second = parseName();
             }
             else{
-                tmpmoduleName.second = std::make_shared<NoLiteral>();
+                tmpmoduleName.second = ast::make<NoLiteral>();
             }
             advanceOnNewLine();
             importedSymbols.push_back(tmpmoduleName);
@@ -345,7 +518,7 @@ AstNodePtr Parser::parseImport() {
         }
     }while (m_currentToken.tkType == tk_comma);
     if(!hasFrom){
-        return std::make_shared<ImportStatement>(tok, moduleName,
+        return ast::make<ImportStatement>(tok, moduleName,
                                                     importedSymbols);
     }
     moduleName=tmpmoduleName.first;
@@ -353,7 +526,7 @@ AstNodePtr Parser::parseImport() {
     if(next().tkType==tk_multiply){
         advance();
         advance();
-        return std::make_shared<ImportStatement>(tok, moduleName,
+        return ast::make<ImportStatement>(tok, moduleName,
                                                     importedSymbols,true);
     }
     do {
@@ -370,7 +543,7 @@ AstNodePtr Parser::parseImport() {
             importedSymbol.second = parseName();
         }
         else{
-            importedSymbol.second = std::make_shared<NoLiteral>();
+            importedSymbol.second = ast::make<NoLiteral>();
         }
         importedSymbols.push_back(importedSymbol);
 
@@ -380,14 +553,14 @@ AstNodePtr Parser::parseImport() {
     } while (m_currentToken.tkType == tk_comma);
 
     advanceOnNewLine();
-    return std::make_shared<ImportStatement>(tok, moduleName, importedSymbols);
+    return ast::make<ImportStatement>(tok, moduleName, importedSymbols);
 }
 
 AstNodePtr Parser::parseStatic() {
     //Static function and variable
     auto tok = m_currentToken;
     advance();
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     switch (m_currentToken.tkType) {
         case tk_def: {
             body = parseFunctionDef();
@@ -410,10 +583,10 @@ AstNodePtr Parser::parseStatic() {
             // case. DO NOT add another case below this one
         }
         default: {
-            error(m_currentToken , "Expected a function or variable or constant declaration but got "+m_currentToken.keyword+" instead","","","");
+            error(m_currentToken , "Expected a function or variable or constant declaration but got "+m_currentToken.keyword()+" instead","","","");
         }
     }
-    return std::make_shared<StaticStatement>(tok, body);
+    return ast::make<StaticStatement>(tok, body);
 }
 
 AstNodePtr Parser::parseInline() {
@@ -421,11 +594,11 @@ AstNodePtr Parser::parseInline() {
     //inline def function()->type:...
     auto tok = m_currentToken;
     expect(tk_def, "Expected function defination but got " +
-                          next().keyword +
+                          next().keyword() +
                           " instead");
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     body = parseFunctionDef();
-    return std::make_shared<InlineStatement>(tok, body);
+    return ast::make<InlineStatement>(tok, body);
 }
 
 AstNodePtr Parser::parseDefaultArg(){
@@ -436,7 +609,7 @@ AstNodePtr Parser::parseDefaultArg(){
     advance();
     advance();
     AstNodePtr value=parseExpression();
-    return std::make_shared<DefaultArg>(tok,name, value);
+    return ast::make<DefaultArg>(tok,name, value);
 }
 
 AstNodePtr Parser::parseExport() {
@@ -444,36 +617,36 @@ AstNodePtr Parser::parseExport() {
     //export def function():...
     auto tok = m_currentToken;
     expect(tk_def, "Expected function defination but got " +
-                          next().keyword +
+                          next().keyword() +
                           " instead");
     AstNodePtr body=parseFunctionDef();
-    return std::make_shared<ExportStatement>(tok, body);
+    return ast::make<ExportStatement>(tok, body);
 }
 
 AstNodePtr Parser::parseExtern(){
     //use external c library
     //extern c=import("lib1","lib2")
     auto tok=m_currentToken;
-    expect(tk_identifier,"Expected identifier but got "+next().keyword+" instead","","","");
-    auto name=m_currentToken.keyword;
+    expect(tk_identifier,"Expected identifier but got "+next().keyword()+" instead","","","");
+    auto name=m_currentToken.keyword();
     std::vector<std::string> libs;
-    expect(tk_assign,"Expected = but got "+next().keyword+" instead","","","");
-    expect(tk_import,"Expected = but got "+next().keyword+" instead","","","");
-    expect(tk_l_paren,"Expected = but got "+next().keyword+" instead","","","");
+    expect(tk_assign,"Expected = but got "+next().keyword()+" instead","","","");
+    expect(tk_import,"Expected = but got "+next().keyword()+" instead","","","");
+    expect(tk_l_paren,"Expected = but got "+next().keyword()+" instead","","","");
     while(m_currentToken.tkType!=tk_r_paren){
-        expect(tk_string,"Expected string but got "+next().keyword+" instead","","","");
-        libs.push_back(m_currentToken.keyword);
+        expect(tk_string,"Expected string but got "+next().keyword()+" instead","","","");
+        libs.push_back(m_currentToken.keyword());
         advance();
     }
     advanceOnNewLine();
-    return std::make_shared<ExternStatement>(tok,libs,name);
+    return ast::make<ExternStatement>(tok,libs,name);
 }
 
 AstNodePtr Parser::parsePrivate(bool is_class){
     //private defination
     auto tok=m_currentToken;
     advance();
-    AstNodePtr exp;
+    AstNodePtr exp = nullptr;
     switch (m_currentToken.tkType){
         case tk_identifier:{
             exp=parseVariableStatement();
@@ -519,9 +692,9 @@ AstNodePtr Parser::parsePrivate(bool is_class){
             break;
         }
         default:{
-            error(m_currentToken,"Expected a defination of a class,function,union or variable but got "+m_currentToken.keyword+" instead","","","");
+            error(m_currentToken,"Expected a defination of a class,function,union or variable but got "+m_currentToken.keyword()+" instead","","","");
         }
     }
-    return std::make_shared<PrivateDef>(tok,exp);
+    return ast::make<PrivateDef>(tok,exp);
 }
 }
\ No newline at end of file
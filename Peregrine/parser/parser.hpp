@@ -5,7 +5,10 @@
 #include "errors/error.hpp"
 #include "lexer/lexer.hpp"
 #include "lexer/tokens.hpp"
+#include <array>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 namespace Parser{
@@ -34,15 +37,72 @@ enum PrecedenceType {
     pr_postfix      // x++
 };
 
-std::map<TokenType, PrecedenceType> createMap();
+//precedence of every operator token, indexed by its type. Anything that is
+//not an operator binds with pr_lowest
+constexpr std::array<PrecedenceType, 256> precedenceTable = [] {
+    std::array<PrecedenceType, 256> table{};
+    table[tk_for] = pr_conditional;
+    table[tk_double_dot] = pr_range;
+    table[tk_dollar] = pr_prefix;
+    table[tk_bit_not] = pr_prefix;
+    table[tk_if] = pr_conditional;
+    table[tk_else] = pr_conditional;
+    table[tk_and] = pr_and;
+    table[tk_or] = pr_or;
+    table[tk_not] = pr_not;
+    table[tk_not_equal] = pr_compare;
+    table[tk_is_not] = pr_compare;
+    table[tk_is] = pr_compare;
+    table[tk_not_in] = pr_compare;
+    table[tk_in] = pr_compare;
+    table[tk_greater] = pr_compare;
+    table[tk_less] = pr_compare;
+    table[tk_gr_or_equ] = pr_compare;
+    table[tk_less_or_equ] = pr_compare;
+    table[tk_equal] = pr_compare;
+    table[tk_bit_or] = pr_bit_or;
+    table[tk_xor] = pr_bit_xor;
+    table[tk_ampersand] = pr_bit_and;
+    table[tk_shift_left] = pr_bit_shift_pipeline;
+    table[tk_shift_right] = pr_bit_shift_pipeline;
+    table[tk_pipeline] = pr_bit_shift_pipeline;
+    table[tk_plus] = pr_sum_minus;
+    table[tk_minus] = pr_sum_minus;
+    table[tk_multiply] = pr_mul_div;
+    table[tk_divide] = pr_mul_div;
+    table[tk_modulo] = pr_mul_div;
+    table[tk_floor] = pr_mul_div;
+    table[tk_exponent] = pr_expo;
+    table[tk_dot] = pr_dot_arrow_ref;
+    table[tk_arrow] = pr_dot_arrow_ref;
+    table[tk_list_open] = pr_list_access;
+    table[tk_l_paren] = pr_call;
+    table[tk_increment] = pr_postfix;
+    table[tk_decrement] = pr_postfix;
+    return table;
+}();
 
 class Parser {
   private:
-    size_t m_tokIndex{0};
     bool is_compile_time=false;
+    //null for the parsers of a chunk, they read the tokens from
+    //m_tokens..m_tokensEnd and throw their errors instead of exiting
+    LEXER* m_lexer;
+    const Token* m_tokens=nullptr;
+    const Token* m_tokensEnd=nullptr;
+    Token m_eof;
     Token m_currentToken;
-    std::vector<Token> m_tokens;
+    Token m_previousToken;
+    //ring buffer of the tokens after m_currentToken that were already
+    //pulled from the lexer, the parser never looks further than two ahead
+    static constexpr size_t lookahead_size=2;
+    std::array<Token,lookahead_size> m_lookahead;
+    size_t m_lookaheadStart{0};
+    size_t m_lookaheadCount{0};
     std::string m_filename;
+    //state of parseNext()
+    std::string m_comment;
+    bool m_parsedAny=false;
     const std::vector<TokenType> aug_operators{
                                             tk_slash_equal,
                                             tk_floor_equal,
@@ -57,11 +117,26 @@ class Parser {
                                             tk_bit_xor_equal,
                                             tk_exponent_equal
                                         };
-    std::map<TokenType, PrecedenceType> precedenceMap = createMap();
+    //subtree of one chunk of a large file, parsed on a worker thread
+    struct ParsedChunk{
+        std::unique_ptr<ast::Arena> arena;
+        std::vector<AstNodePtr> statements;
+        std::string comment;
+        std::optional<PEError> error;
+    };
+    Parser(const Token* begin,const Token* end,const Token& eof,std::string filename);
+    static ParsedChunk parseChunk(const std::vector<Token>& tokens,size_t begin,size_t end,std::string filename);
+    static std::vector<size_t> chunkBounds(const std::vector<Token>& tokens);
+    AstNodePtr parseParallel();
+    std::vector<AstNodePtr> parseStatements(std::string& comment);
+    AstNodePtr parseTopLevel(std::string& comment,bool first);
+
+    Token pull();
     void advance();
     void advanceOnNewLine();
     void expect(TokenType expectedType, std::string msg="",std::string submsg="",std::string hint="",std::string ecode="");
-    Token next();
+    const Token& next();
+    const Token& peek(size_t n);
     PrecedenceType nextPrecedence();
 
     void error(Token tok, std::string msg,std::string submsg="",std::string hint="",std::string ecode="");
@@ -148,10 +223,22 @@ class Parser {
     AstNodePtr parsePrivate(bool is_class=false);
 
   public:
-    Parser(const std::vector<Token>& tokens,std::string filename);
+    Parser(LEXER& lexer,std::string filename);
     ~Parser();
 
     AstNodePtr parse();
+
+    //parses the file one top-level statement at a time, so a caller can be
+    //done with a statement before the next one exists. Returns nullptr at
+    //the end of the file, comment() is the doc comment of the file
+    AstNodePtr parseNext();
+    const std::string& comment() const;
+
+    //files of at least parallel_threshold bytes are lexed up front and
+    //split before top-level definitions into chunks of at least
+    //parallel_chunk tokens, which are parsed on the shared thread pool
+    static size_t parallel_threshold;
+    static size_t parallel_chunk;
 };
 }
 #endif
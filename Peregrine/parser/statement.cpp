@@ -17,22 +17,22 @@ AstNodePtr Parser::parseAsm(){
         "b"=arg2
     */
     auto tok=m_currentToken;
-    expect(tk_colon,"Expected an ':' but got "+next().keyword+" instead","","","");
-    expect(tk_ident,"Expected an indentation but got "+next().keyword+" instead","","","");
+    expect(tk_colon,"Expected an ':' but got "+next().keyword()+" instead","","","");
+    expect(tk_ident,"Expected an indentation but got "+next().keyword()+" instead","","","");
     advance();
     std::string assembly="";
-    AstNodePtr output=std::make_shared<NoLiteral>();
+    AstNodePtr output=ast::make<NoLiteral>();
     std::vector<std::pair<std::string,AstNodePtr>> inputs;
     while(m_currentToken.tkType!=tk_dedent){
         if(m_currentToken.tkType==tk_identifier){
             output=parseExpression();
-            expect(tk_assign,"Expected an '=' but got "+next().keyword+" instead","","","");
+            expect(tk_assign,"Expected an '=' but got "+next().keyword()+" instead","","","");
             advance();
             if(assembly.size()!=0){
                 error(m_currentToken,"Error: Can't have multiple result variable","","","");
             }
             else{
-                assembly=m_currentToken.keyword;
+                assembly=m_currentToken.keyword();
             }
         }
         else if(m_currentToken.tkType==tk_string){
@@ -40,24 +40,24 @@ AstNodePtr Parser::parseAsm(){
                 error(m_currentToken,"Error: Can't have multiple result variable","","","");
             }
             else if(next().tkType==tk_assign){
-                auto reg=m_currentToken.keyword;
+                auto reg=m_currentToken.keyword();
                 advance();
                 advance();
                 auto exp=parseExpression();
                 inputs.push_back(std::make_pair(reg,exp));
             }
             else{
-                assembly=m_currentToken.keyword;
+                assembly=m_currentToken.keyword();
             }
         }
         else{
-            error(m_currentToken,"Expected an identifier or string but got "+m_currentToken.keyword+" instead","","","");
+            error(m_currentToken,"Expected an identifier or string but got "+m_currentToken.keyword()+" instead","","","");
         }
         advance();
         if(m_currentToken.tkType==tk_dedent){break;}
         if(m_currentToken.tkType==tk_new_line){advance();}
     }
-    return std::make_shared<InlineAsm>(tok,assembly,output,inputs);
+    return ast::make<InlineAsm>(tok,assembly,output,inputs);
 }
 AstNodePtr Parser::parseWith() {
     /* 
@@ -69,18 +69,18 @@ AstNodePtr Parser::parseWith() {
     advance();
     std::vector<AstNodePtr> variables;
     std::vector<AstNodePtr> values;
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     while (m_currentToken.tkType != tk_colon) {
         values.push_back(parseExpression());
         if(next().tkType==tk_colon||next().tkType==tk_comma){
-            variables.push_back(std::make_shared<NoLiteral>());
+            variables.push_back(ast::make<NoLiteral>());
         }
         else{
             expect(tk_as, "Expected as but got " +
-                               next().keyword +
+                               next().keyword() +
                                " instead");
             expect(tk_identifier, "Expected an identifier, got " +
-                                          next().keyword +
+                                          next().keyword() +
                                           " instead");
             variables.push_back(parseName());
         }
@@ -94,13 +94,13 @@ AstNodePtr Parser::parseWith() {
       advance();
       std::vector<AstNodePtr> x;
       x.push_back(parseStatement());
-      body = std::make_shared<BlockStatement>(x);
+      body = ast::make<BlockStatement>(x);
     }
     else{
-      expect(tk_ident,"Expected identation but got "+next().keyword+" instead","","","");
+      expect(tk_ident,"Expected identation but got "+next().keyword()+" instead","","","");
       body = parseBlockStatement();
     }
-    return std::make_shared<WithStatement>(tok, variables, values, body);
+    return ast::make<WithStatement>(tok, variables, values, body);
 }
 AstNodePtr Parser::parseRaise() {
     //raise an error
@@ -108,11 +108,11 @@ AstNodePtr Parser::parseRaise() {
     //raise error_name
     auto tok = m_currentToken;
     advance();
-    AstNodePtr value = std::make_shared<NoLiteral>();
+    AstNodePtr value = ast::make<NoLiteral>();
     if(m_currentToken.tkType!=tk_new_line){
         value = parseExpression();
     }
-    return std::make_shared<RaiseStatement>(tok, value);
+    return ast::make<RaiseStatement>(tok, value);
 }
 AstNodePtr Parser::parseIf() {
     //if statements
@@ -125,41 +125,41 @@ AstNodePtr Parser::parseIf() {
     AstNodePtr condition = parseExpression();
     if (next().tkType!=tk_colon){
         error(m_currentToken,
-                "Expected a : after the condition but got "+m_currentToken.keyword+" instead","Add a : here","","");
+                "Expected a : after the condition but got "+m_currentToken.keyword()+" instead","Add a : here","","");
     }
     advance();
 
-    AstNodePtr ifBody;
+    AstNodePtr ifBody = nullptr;
     auto line=m_currentToken.line;
     if(next().tkType!=tk_ident && next().line==line){
       advance();
       std::vector<AstNodePtr> x;
       x.push_back(parseStatement());
-      ifBody = std::make_shared<BlockStatement>(x);
+      ifBody = ast::make<BlockStatement>(x);
     }
     else{
-      expect(tk_ident, "Expected an ident but got "+next().keyword+" instead");
+      expect(tk_ident, "Expected an ident but got "+next().keyword()+" instead");
       ifBody = parseBlockStatement();
     }
     std::vector<std::pair<AstNodePtr, AstNodePtr>> elifs;
-    AstNodePtr elseBody = std::make_shared<NoLiteral>();
+    AstNodePtr elseBody = ast::make<NoLiteral>();
     if(is_compile_time){
         //compile time if else
         //$if condition1:...
         //$elif condition2:...
         //$else:...
         if(next().tkType==tk_dollar){
-            if(m_tokens[m_tokIndex+2].tkType==tk_elif){
+            if(peek(2).tkType==tk_elif){
                 advance();
             }
-            else if(m_tokens[m_tokIndex+2].tkType==tk_else){}
+            else if(peek(2).tkType==tk_else){}
             else{
-                return std::make_shared<IfStatement>(tok, condition, ifBody, elseBody,
+                return ast::make<IfStatement>(tok, condition, ifBody, elseBody,
                                          elifs);
             }
         }
         else{
-             return std::make_shared<IfStatement>(tok, condition, ifBody, elseBody,
+             return ast::make<IfStatement>(tok, condition, ifBody, elseBody,
                                          elifs);
         }
     }
@@ -171,54 +171,54 @@ AstNodePtr Parser::parseIf() {
 
         if (next().tkType!=tk_colon){
             error(m_currentToken,
-                "Expected a : after the condition but got "+m_currentToken.keyword+" instead","Add a : here","","");
+                "Expected a : after the condition but got "+m_currentToken.keyword()+" instead","Add a : here","","");
         }
         advance();
-        AstNodePtr body;
+        AstNodePtr body = nullptr;
         auto line=m_currentToken.line;
         if(next().tkType!=tk_ident && next().line==line){
           advance();
           std::vector<AstNodePtr> x;
           x.push_back(parseStatement());
-          body = std::make_shared<BlockStatement>(x);
+          body = ast::make<BlockStatement>(x);
         }
         else{
-            expect(tk_ident, "Expected an ident but got "+next().keyword+" instead");
+            expect(tk_ident, "Expected an ident but got "+next().keyword()+" instead");
             body = parseBlockStatement();
         }
 
         elifs.push_back(std::pair(condition, body));
         if(is_compile_time){
             if(next().tkType==tk_dollar){
-                if(m_tokens[m_tokIndex+2].tkType==tk_elif){
+                if(peek(2).tkType==tk_elif){
                     advance();
                 }
-                else if (m_tokens[m_tokIndex+2].tkType==tk_else){
+                else if (peek(2).tkType==tk_else){
                     break;
                 }
                 else{
-                    return std::make_shared<IfStatement>(tok, condition, ifBody, elseBody,
+                    return ast::make<IfStatement>(tok, condition, ifBody, elseBody,
                                             elifs);
                 }
             }
             else{
-                return std::make_shared<IfStatement>(tok, condition, ifBody, elseBody,
+                return ast::make<IfStatement>(tok, condition, ifBody, elseBody,
                                             elifs);
             }
         }
     }
     if(is_compile_time){
         if(next().tkType==tk_dollar){
-            if(m_tokens[m_tokIndex+2].tkType==tk_else){
+            if(peek(2).tkType==tk_else){
                 advance();
             }
             else{
-                return std::make_shared<IfStatement>(tok, condition, ifBody, elseBody,
+                return ast::make<IfStatement>(tok, condition, ifBody, elseBody,
                                          elifs);
             }
         }
         else{
-             return std::make_shared<IfStatement>(tok, condition, ifBody, elseBody,
+             return ast::make<IfStatement>(tok, condition, ifBody, elseBody,
                                          elifs);
         }
     }
@@ -226,7 +226,7 @@ AstNodePtr Parser::parseIf() {
         advance();
         if (next().tkType!=tk_colon){
             error(next(),
-                "Expected a : after else but got "+next().keyword+" instead","Add a : here","","");
+                "Expected a : after else but got "+next().keyword()+" instead","Add a : here","","");
         }
         advance();
         auto line=m_currentToken.line;
@@ -234,16 +234,16 @@ AstNodePtr Parser::parseIf() {
           advance();
           std::vector<AstNodePtr> x;
           x.push_back(parseStatement());
-          elseBody = std::make_shared<BlockStatement>(x);
+          elseBody = ast::make<BlockStatement>(x);
         }
         else{
-          expect(tk_ident, "Expected an ident but got "+next().keyword+" instead");
+          expect(tk_ident, "Expected an ident but got "+next().keyword()+" instead");
           elseBody = parseBlockStatement();
         }
 
     }
 
-    return std::make_shared<IfStatement>(tok, condition, ifBody, elseBody,
+    return ast::make<IfStatement>(tok, condition, ifBody, elseBody,
                                          elifs);
 }
 
@@ -253,7 +253,7 @@ AstNodePtr Parser::parseAssert() {
     auto tok = m_currentToken;
     advance();
     auto condition = parseExpression();
-    return std::make_shared<AssertStatement>(tok, condition);
+    return ast::make<AssertStatement>(tok, condition);
 }
 
 AstNodePtr Parser::parseMatch() {
@@ -286,15 +286,15 @@ AstNodePtr Parser::parseMatch() {
             advance();
         }
     }
-    expect(tk_ident, "Expected identation but got "+next().keyword+" instead","","","");
+    expect(tk_ident, "Expected identation but got "+next().keyword()+" instead","","","");
     std::vector<std::pair<std::vector<AstNodePtr>, AstNodePtr>> cases;
     while (next().tkType == tk_case) {
         advance();
         advance();
         std::vector<AstNodePtr> cases_arg;
         while (m_currentToken.tkType != tk_colon) {
-            if (m_currentToken.keyword == "_") {
-                cases_arg.push_back(std::make_shared<NoLiteral>());
+            if (m_currentToken.keyword() == "_") {
+                cases_arg.push_back(ast::make<NoLiteral>());
             } else {
                 cases_arg.push_back(parseExpression());
             }
@@ -307,7 +307,7 @@ AstNodePtr Parser::parseMatch() {
                 break;
             }
             else{
-                error(m_currentToken, "Expected , or : but got "+m_currentToken.keyword+" instead","","","");
+                error(m_currentToken, "Expected , or : but got "+m_currentToken.keyword()+" instead","","","");
             }
         }
         if(cases_arg.size()>toMatch.size()){
@@ -319,27 +319,27 @@ AstNodePtr Parser::parseMatch() {
         else if(cases_arg.size()<toMatch.size()&&cases_arg.back()->type()!=KAstNoLiteral){
             error(m_currentToken, "Too few arguments in case","","","");
         }
-        AstNodePtr body;
+        AstNodePtr body = nullptr;
         size_t line=m_currentToken.line;
         if(next().tkType!=tk_ident && next().line==line){
             advance();
             std::vector<AstNodePtr> x;
             x.push_back(parseStatement());
-            body = std::make_shared<BlockStatement>(x);
+            body = ast::make<BlockStatement>(x);
         }
         else{
-            expect(tk_ident, "Expected identation but got "+next().keyword+" instead","","","");
+            expect(tk_ident, "Expected identation but got "+next().keyword()+" instead","","","");
             body = parseBlockStatement();
         }
         cases.push_back(
             std::pair<std::vector<AstNodePtr>, AstNodePtr>(cases_arg, body));
     }
-    AstNodePtr default_body = std::make_shared<NoLiteral>();
+    AstNodePtr default_body = ast::make<NoLiteral>();
 
     if (next().tkType == tk_default) {
         advance();
         if(next().tkType!=tk_colon){
-            error(next(), "Expected : but got "+next().keyword+" instead","Add a : here","","");
+            error(next(), "Expected : but got "+next().keyword()+" instead","Add a : here","","");
         }
         advance();
         size_t line=m_currentToken.line;
@@ -347,15 +347,15 @@ AstNodePtr Parser::parseMatch() {
             advance();
             std::vector<AstNodePtr> x;
             x.push_back(parseStatement());
-            default_body = std::make_shared<BlockStatement>(x);
+            default_body = ast::make<BlockStatement>(x);
         }
         else{
-            expect(tk_ident, "Expected identation but got "+next().keyword+" instead","","","");
+            expect(tk_ident, "Expected identation but got "+next().keyword()+" instead","","","");
             default_body = parseBlockStatement();
         }
     }
     expect(tk_dedent);
-    return std::make_shared<MatchStatement>(tok, toMatch, cases, default_body);
+    return ast::make<MatchStatement>(tok, toMatch, cases, default_body);
 }
 AstNodePtr Parser::parseScope() {
     //create new scope
@@ -363,22 +363,22 @@ AstNodePtr Parser::parseScope() {
     Token tok = m_currentToken;
     if (next().tkType!=tk_colon){
             error(next(),
-                "Expected a : after scope but got "+next().keyword+" instead","Add a : here","","");
+                "Expected a : after scope but got "+next().keyword()+" instead","Add a : here","","");
     }
     advance();
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     auto line=m_currentToken.line;
     if(next().tkType!=tk_ident && next().line==line){
       advance();
       std::vector<AstNodePtr> x;
       x.push_back(parseStatement());
-      body = std::make_shared<BlockStatement>(x);
+      body = ast::make<BlockStatement>(x);
     }
     else{
-      expect(tk_ident, "Expected an ident but got "+next().keyword+" instead");
+      expect(tk_ident, "Expected an ident but got "+next().keyword()+" instead");
       body = parseBlockStatement();
     }
-    return std::make_shared<ScopeStatement>(tok, body);
+    return ast::make<ScopeStatement>(tok, body);
 }
 
 
@@ -392,23 +392,23 @@ AstNodePtr Parser::parseWhile() {
 
     if (next().tkType!=tk_colon){
             error(m_currentToken,
-                "Expected a : after the condition but got "+m_currentToken.keyword+" instead","Add a : here","","");
+                "Expected a : after the condition but got "+m_currentToken.keyword()+" instead","Add a : here","","");
     }
     advance();
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     auto line=m_currentToken.line;
     if(next().tkType!=tk_ident && next().line==line){
       advance();
       std::vector<AstNodePtr> x;
       x.push_back(parseStatement());
-      body = std::make_shared<BlockStatement>(x);
+      body = ast::make<BlockStatement>(x);
     }
     else{
-      expect(tk_ident, "Expected an ident but got "+next().keyword+" instead");
+      expect(tk_ident, "Expected an ident but got "+next().keyword()+" instead");
       body = parseBlockStatement();
     }
 
-    return std::make_shared<WhileStatement>(tok, condition, body);
+    return ast::make<WhileStatement>(tok, condition, body);
 }
 
 AstNodePtr Parser::parseFor() {
@@ -425,7 +425,7 @@ AstNodePtr Parser::parseFor() {
             advance();
         } else if (m_currentToken.tkType != tk_in) {
             error(m_currentToken,
-                "Expected an in after the variable but got "+m_currentToken.keyword+" instead","Add an in here","","e5");
+                "Expected an in after the variable but got "+m_currentToken.keyword()+" instead","Add an in here","","e5");
         }
     }
     advance();
@@ -433,23 +433,23 @@ AstNodePtr Parser::parseFor() {
     AstNodePtr sequence = parseExpression();
     if (next().tkType!=tk_colon){
             error(m_currentToken,
-                "Expected a : but got "+m_currentToken.keyword+" instead","Add a : here","","");
+                "Expected a : but got "+m_currentToken.keyword()+" instead","Add a : here","","");
     }
     advance();
-    AstNodePtr body;
+    AstNodePtr body = nullptr;
     auto line=m_currentToken.line;
     if(next().tkType!=tk_ident && next().line==line){
       advance();
       std::vector<AstNodePtr> x;
       x.push_back(parseStatement());
-      body = std::make_shared<BlockStatement>(x);
+      body = ast::make<BlockStatement>(x);
     }
     else{
-      expect(tk_ident, "Expected an ident but got "+next().keyword+" instead");
+      expect(tk_ident, "Expected an ident but got "+next().keyword()+" instead");
       body = parseBlockStatement();
     }
 
-    return std::make_shared<ForStatement>(tok, variable, sequence, body);
+    return ast::make<ForStatement>(tok, variable, sequence, body);
 }
 
 AstNodePtr Parser::parseReturn() {
@@ -457,7 +457,7 @@ AstNodePtr Parser::parseReturn() {
     //return value
     //return value1,value2
     Token tok = m_currentToken;
-    AstNodePtr returnValue=std::make_shared<NoLiteral>();
+    AstNodePtr returnValue=ast::make<NoLiteral>();
     advance();
     if (m_currentToken.tkType != tk_new_line) {
         returnValue = parseExpression();
@@ -465,7 +465,7 @@ AstNodePtr Parser::parseReturn() {
             returnValue=parseReturnExprTurple(returnValue);
         }
     }
-    return std::make_shared<ReturnStatement>(tok, returnValue);
+    return ast::make<ReturnStatement>(tok, returnValue);
 }
 
 AstNodePtr Parser::parseTryExcept(){
@@ -485,21 +485,21 @@ AstNodePtr Parser::parseTryExcept(){
         printf("Exception caught %lld\n",e)
     */
     auto tok=m_currentToken;
-    expect(tk_colon,"Expected : but got "+next().keyword+" instead","Add a : here","","");
+    expect(tk_colon,"Expected : but got "+next().keyword()+" instead","Add a : here","","");
     auto line=m_currentToken.line;
-    AstNodePtr try_body;
+    AstNodePtr try_body = nullptr;
     if(next().tkType!=tk_ident && next().line==line){
       advance();
       std::vector<AstNodePtr> x;
       x.push_back(parseStatement());
-      try_body = std::make_shared<BlockStatement>(x);
+      try_body = ast::make<BlockStatement>(x);
     }
     else{
-      expect(tk_ident,"Expected identation but got "+next().keyword+" instead","","","");
+      expect(tk_ident,"Expected identation but got "+next().keyword()+" instead","","","");
       try_body = parseBlockStatement();
     }
-    expect(tk_except,"Expected except but got "+next().keyword+" instead","Atleast one except is necessary","","");
-    AstNodePtr else_body=std::make_shared<NoLiteral>();
+    expect(tk_except,"Expected except but got "+next().keyword()+" instead","Atleast one except is necessary","","");
+    AstNodePtr else_body=ast::make<NoLiteral>();
     std::vector<except_type> m_except_clauses;
     while(m_currentToken.tkType==tk_except){
         if(next().tkType==tk_colon){
@@ -509,18 +509,18 @@ AstNodePtr Parser::parseTryExcept(){
               advance();
               std::vector<AstNodePtr> x;
               x.push_back(parseStatement());
-              else_body = std::make_shared<BlockStatement>(x);
+              else_body = ast::make<BlockStatement>(x);
             }
             else{
-              expect(tk_ident,"Expected identation but got "+next().keyword+" instead","","","");
+              expect(tk_ident,"Expected identation but got "+next().keyword()+" instead","","","");
               else_body = parseBlockStatement();
             }
             break;
         }
         else{
 
-            AstNodePtr name=std::make_shared<NoLiteral>();
-            AstNodePtr except_body=std::make_shared<NoLiteral>();
+            AstNodePtr name=ast::make<NoLiteral>();
+            AstNodePtr except_body=ast::make<NoLiteral>();
             std::vector<AstNodePtr> exceptions;
             advance();
             while(m_currentToken.tkType!=tk_colon && m_currentToken.tkType!=tk_as){
@@ -534,24 +534,24 @@ AstNodePtr Parser::parseTryExcept(){
                 }
                 else{
                     error(next(),"Expected ',' or 'as' or ':' but got "+
-                                    next().keyword+
+                                    next().keyword()+
                                     " instead","","","");
                 }
             }
             if(m_currentToken.tkType==tk_as){
                 advance();
                 name=parseName();
-                expect(tk_colon,"Expected : but got "+next().keyword+" instead","Add a : here","","");
+                expect(tk_colon,"Expected : but got "+next().keyword()+" instead","Add a : here","","");
             }
             auto line=m_currentToken.line;
             if(next().tkType!=tk_ident && next().line==line){
               advance();
               std::vector<AstNodePtr> x;
               x.push_back(parseStatement());
-              except_body = std::make_shared<BlockStatement>(x);
+              except_body = ast::make<BlockStatement>(x);
             }
             else{
-              expect(tk_ident,"Expected identation but got "+next().keyword+" instead","","","");
+              expect(tk_ident,"Expected identation but got "+next().keyword()+" instead","","","");
               except_body = parseBlockStatement();
             }
             if (next().tkType==tk_except){
@@ -560,6 +560,6 @@ AstNodePtr Parser::parseTryExcept(){
             m_except_clauses.push_back(std::make_pair(std::make_pair(exceptions,name),except_body));
         }
     }
-    return std::make_shared<TryExcept>(tok,try_body,m_except_clauses,else_body);
+    return ast::make<TryExcept>(tok,try_body,m_except_clauses,else_body);
 }
 }
\ No newline at end of file
@@ -10,7 +10,7 @@
 namespace Parser{
 AstNodePtr Parser::parseType(bool can_be_sumtype) {
     //parse types
-    ast::AstNodePtr res;
+    ast::AstNodePtr res = nullptr;
     switch (m_currentToken.tkType) {
         
         case tk_def:{
@@ -46,21 +46,21 @@ AstNodePtr Parser::parseType(bool can_be_sumtype) {
                     } else if (m_currentToken.tkType == tk_dict_close) {
                         break;
                     }else{
-                        error(m_currentToken,"Expected { or , but got "+m_currentToken.keyword+" instead","","","");
+                        error(m_currentToken,"Expected { or , but got "+m_currentToken.keyword()+" instead","","","");
                     }
                 }
-                res = std::make_shared<TypeExpression>(tok,
-                                                    tok.keyword,generic_types);
+                res = ast::make<TypeExpression>(tok,
+                                                    tok.lexeme(),generic_types);
             }
             else{
-                res = std::make_shared<TypeExpression>(m_currentToken,
-                                                        m_currentToken.keyword);
+                res = ast::make<TypeExpression>(m_currentToken,
+                                                        m_currentToken.lexeme());
             }
             break;
         }
 
         default: {
-            error(m_currentToken, m_currentToken.keyword + " is not a type");
+            error(m_currentToken, m_currentToken.keyword() + " is not a type");
         }
     }
     if(next().tkType==tk_bit_or && can_be_sumtype){
@@ -74,7 +74,7 @@ AstNodePtr Parser::parseType(bool can_be_sumtype) {
                 advance();
             }
         } 
-        res=std::make_shared<SumType>(sum_types);   
+        res=ast::make<SumType>(sum_types);   
     }
     return res;
 }
@@ -84,16 +84,16 @@ AstNodePtr Parser::parseListType() {
     //[]typename
     //[fixed_val]typename
     Token tok = m_currentToken;
-    AstNodePtr size=std::make_shared<NoLiteral>();
+    AstNodePtr size=ast::make<NoLiteral>();
     if (next().tkType != tk_list_close) {   
         advance();
         size = parseExpression();
     }
-    expect(tk_list_close, "Expected ] but got "+next().keyword+" instead","Add a ] here","","");
+    expect(tk_list_close, "Expected ] but got "+next().keyword()+" instead","Add a ] here","","");
     advance();
 
     AstNodePtr elemType = parseType(false);
-    return std::make_shared<ListTypeExpr>(tok, elemType, size);
+    return ast::make<ListTypeExpr>(tok, elemType, size);
 }
 
 AstNodePtr Parser::parsePointerType() {
@@ -102,7 +102,7 @@ AstNodePtr Parser::parsePointerType() {
     Token tok = m_currentToken;
     advance();
     AstNodePtr typePtr = parseType(false);
-    return std::make_shared<PointerTypeExpr>(tok, typePtr);
+    return ast::make<PointerTypeExpr>(tok, typePtr);
 }
 
 AstNodePtr Parser::parseRefType() {
@@ -111,7 +111,7 @@ AstNodePtr Parser::parseRefType() {
     Token tok = m_currentToken;
     advance();
     AstNodePtr typePtr = parseType(false);
-    return std::make_shared<RefTypeExpr>(tok, typePtr);
+    return ast::make<RefTypeExpr>(tok, typePtr);
 }
 AstNodePtr Parser::parseImportedType(){
     //imported type name
@@ -120,13 +120,13 @@ AstNodePtr Parser::parseImportedType(){
     advance();
     while(m_currentToken.tkType==tk_dot){
         auto tok=m_currentToken;
-        expect(tk_identifier,next().keyword+" is not a type","","","");
+        expect(tk_identifier,next().keyword()+" is not a type","","","");
         if(next().tkType!=tk_dot){
-            name=std::make_shared<DotExpression>(tok,name,parseType(false));
+            name=ast::make<DotExpression>(tok,name,parseType(false));
             break;
         }
         else{
-            name=std::make_shared<DotExpression>(tok,name,parseName());
+            name=ast::make<DotExpression>(tok,name,parseName());
             advance();
         }
     }
@@ -137,19 +137,19 @@ AstNodePtr Parser::parseFuncType() {
     //lambda types
     //def(arg_type)->return_type
     auto tok = m_currentToken;
-    expect(tk_l_paren,"Expected ( but got "+next().keyword+" instead","Add a ( here","","");
+    expect(tk_l_paren,"Expected ( but got "+next().keyword()+" instead","Add a ( here","","");
     std::vector<AstNodePtr> types; // arg types
-    AstNodePtr returnTypes=std::make_shared<TypeExpression>(Token(), "void");
+    AstNodePtr returnTypes=ast::make<TypeExpression>(Token(), "void");
     while (m_currentToken.tkType != tk_r_paren) {
         advance();
         if (m_currentToken.tkType == tk_comma) {
             advance();
             if(m_currentToken.tkType==tk_multiply && (next().tkType==tk_comma||next().tkType==tk_r_paren)){
-                types.push_back(std::make_shared<VarArgTypeExpr>(m_currentToken));
+                types.push_back(ast::make<VarArgTypeExpr>(m_currentToken));
             }
             else if(m_currentToken.tkType==tk_multiply && next().tkType==tk_multiply){
-                if(m_tokens[m_tokIndex+2].tkType==tk_comma||m_tokens[m_tokIndex+2].tkType==tk_r_paren){
-                    types.push_back(std::make_shared<VarKwargTypeExpr>(m_currentToken));
+                if(peek(2).tkType==tk_comma||peek(2).tkType==tk_r_paren){
+                    types.push_back(ast::make<VarKwargTypeExpr>(m_currentToken));
                     advance();
                 }
                 else{
@@ -157,7 +157,7 @@ AstNodePtr Parser::parseFuncType() {
                 }   
             }
             else if(m_currentToken.tkType==tk_ellipses){
-                types.push_back(std::make_shared<EllipsesTypeExpr>(m_currentToken));
+                types.push_back(ast::make<EllipsesTypeExpr>(m_currentToken));
             }
             else{
                 types.push_back(parseType());
@@ -166,11 +166,11 @@ AstNodePtr Parser::parseFuncType() {
             break;
         } else {
             if(m_currentToken.tkType==tk_multiply && (next().tkType==tk_comma||next().tkType==tk_r_paren)){
-                types.push_back(std::make_shared<VarArgTypeExpr>(m_currentToken));
+                types.push_back(ast::make<VarArgTypeExpr>(m_currentToken));
             }
             else if(m_currentToken.tkType==tk_multiply && next().tkType==tk_multiply){
-                if(m_tokens[m_tokIndex+2].tkType==tk_comma||m_tokens[m_tokIndex+2].tkType==tk_r_paren){
-                    types.push_back(std::make_shared<VarKwargTypeExpr>(m_currentToken));
+                if(peek(2).tkType==tk_comma||peek(2).tkType==tk_r_paren){
+                    types.push_back(ast::make<VarKwargTypeExpr>(m_currentToken));
                     advance();
                 }
                 else{
@@ -178,7 +178,7 @@ AstNodePtr Parser::parseFuncType() {
                 }   
             }
             else if(m_currentToken.tkType==tk_ellipses){
-                types.push_back(std::make_shared<EllipsesTypeExpr>(m_currentToken));
+                types.push_back(ast::make<EllipsesTypeExpr>(m_currentToken));
             }
             else{
                 types.push_back(parseType());
@@ -188,7 +188,7 @@ AstNodePtr Parser::parseFuncType() {
             advance();
         }
         else{
-            expect(tk_r_paren,"Expected ) but got "+next().keyword+" instead","Add a ) here","","");
+            expect(tk_r_paren,"Expected ) but got "+next().keyword()+" instead","Add a ) here","","");
         }
     }
     if (next().tkType == tk_arrow) {
@@ -199,6 +199,6 @@ AstNodePtr Parser::parseFuncType() {
             returnTypes=parseReturnTypeTurple(returnTypes);
         }
     }
-    return std::make_shared<FunctionTypeExpr>(tok, types, returnTypes);
+    return ast::make<FunctionTypeExpr>(tok, types, returnTypes);
 }
 }
\ No newline at end of file
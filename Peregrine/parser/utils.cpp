@@ -6,10 +6,11 @@ namespace Parser{
 
 void Parser::advance() {
     //go to next token
-    m_tokIndex++;
-
-    if (m_tokIndex < m_tokens.size()) {
-        m_currentToken = m_tokens[m_tokIndex];
+    if (m_currentToken.tkType != tk_eof) {
+        m_previousToken = m_currentToken;
+        m_currentToken = peek(1);
+        m_lookaheadStart = (m_lookaheadStart + 1) % lookahead_size;
+        m_lookaheadCount--;
     }
 }
 
@@ -20,15 +21,31 @@ void Parser::advanceOnNewLine() {
     }
 }
 
-Token Parser::next() {
+Token Parser::pull() {
+    //the token after the ones already looked at
+    if (m_lexer != nullptr) {
+        return m_lexer->next_token();
+    }
+    if (m_tokens == m_tokensEnd) {
+        return m_eof;
+    }
+    return *m_tokens++;
+}
+
+const Token& Parser::next() {
     //check the next token
-    Token token;
+    return peek(1);
+}
 
-    if (m_tokIndex + 1 < m_tokens.size()) {
-        token = m_tokens[m_tokIndex + 1];
+const Token& Parser::peek(size_t n) {
+    //check the token n places after the current one, pulling it from the
+    //lexer if it was not needed before
+    while (m_lookaheadCount < n) {
+        m_lookahead[(m_lookaheadStart + m_lookaheadCount) % lookahead_size] =
+            pull();
+        m_lookaheadCount++;
     }
-
-    return token;
+    return m_lookahead[(m_lookaheadStart + n - 1) % lookahead_size];
 }
 
 PrecedenceType Parser::nextPrecedence() {
@@ -36,20 +53,21 @@ PrecedenceType Parser::nextPrecedence() {
     if(m_currentToken.tkType == tk_new_line||m_currentToken.tkType == tk_dedent) {
         return pr_lowest;
     }
-    else if (precedenceMap.count(next().tkType) > 0) {
-        return precedenceMap[next().tkType];
-    }
-    return pr_lowest;
+    return precedenceTable[next().tkType];
 }
 
 void Parser::error(Token tok, std::string msg,std::string submsg,std::string hint,std::string ecode) {
     //display error
-    PEError err = {{tok.line, tok.location,tok.location, m_filename, tok.statement},
+    PEError err = {{tok.line, tok.location,tok.location, m_filename, tok.statement()},
                    std::string(msg),
                    submsg,
                    hint,
                    ecode};
 
+    if (m_lexer == nullptr) {
+        //a chunk, parseParallel() reports the first error of the file
+        throw err;
+    }
     display(err);
     exit(1);
 }
@@ -70,55 +88,11 @@ void Parser::expect(TokenType expectedType, std::string msg,std::string submsg,s
     advance();
 }
 
-std::map<TokenType, PrecedenceType> createMap() {
-    //precedence map
-    std::map<TokenType, PrecedenceType> precedenceMap;
-    precedenceMap[tk_for] = pr_conditional;
-    precedenceMap[tk_double_dot] = pr_range;
-    precedenceMap[tk_dollar] = pr_prefix;
-    precedenceMap[tk_bit_not] = pr_prefix;
-    precedenceMap[tk_if] = pr_conditional;
-    precedenceMap[tk_else] = pr_conditional;
-    precedenceMap[tk_and] = pr_and;
-    precedenceMap[tk_or] = pr_or;
-    precedenceMap[tk_not] = pr_not;
-    precedenceMap[tk_not_equal] = pr_compare;
-    precedenceMap[tk_is_not] = pr_compare;
-    precedenceMap[tk_is] = pr_compare;
-    precedenceMap[tk_not_in] = pr_compare;
-    precedenceMap[tk_in] = pr_compare;
-    precedenceMap[tk_greater] = pr_compare;
-    precedenceMap[tk_less] = pr_compare;
-    precedenceMap[tk_gr_or_equ] = pr_compare;
-    precedenceMap[tk_less_or_equ] = pr_compare;
-    precedenceMap[tk_equal] = pr_compare;
-    precedenceMap[tk_bit_or] = pr_bit_or;
-    precedenceMap[tk_xor] = pr_bit_xor;
-    precedenceMap[tk_ampersand] = pr_bit_and;
-    precedenceMap[tk_shift_left] = pr_bit_shift_pipeline;
-    precedenceMap[tk_shift_right] = pr_bit_shift_pipeline;
-    precedenceMap[tk_pipeline] = pr_bit_shift_pipeline;
-    precedenceMap[tk_plus] = pr_sum_minus;
-    precedenceMap[tk_minus] = pr_sum_minus;
-    precedenceMap[tk_multiply] = pr_mul_div;
-    precedenceMap[tk_divide] = pr_mul_div;
-    precedenceMap[tk_modulo] = pr_mul_div;
-    precedenceMap[tk_floor] = pr_mul_div;
-    precedenceMap[tk_exponent] = pr_expo;
-    precedenceMap[tk_dot] = pr_dot_arrow_ref;
-    precedenceMap[tk_arrow] = pr_dot_arrow_ref;
-    precedenceMap[tk_list_open] = pr_list_access;
-    precedenceMap[tk_l_paren] = pr_call;
-    precedenceMap[tk_increment] = pr_postfix;
-    precedenceMap[tk_decrement] = pr_postfix;
-
-    return precedenceMap;
-}
 parameter Parser::parseParameter(){
     //parse function parameter
-    AstNodePtr paramType = std::make_shared<NoLiteral>();
-    AstNodePtr paramDefault = std::make_shared<NoLiteral>();
-    AstNodePtr paramName = std::make_shared<NoLiteral>();
+    AstNodePtr paramType = ast::make<NoLiteral>();
+    AstNodePtr paramDefault = ast::make<NoLiteral>();
+    AstNodePtr paramName = ast::make<NoLiteral>();
     bool is_const = false;
     if(m_currentToken.tkType==tk_const){
         is_const=true;
@@ -129,25 +103,25 @@ parameter Parser::parseParameter(){
         advance();
         ParamType x;
         if(m_currentToken.tkType==tk_multiply){
-            paramType=std::make_shared<VarKwargTypeExpr>(tok);
-            expect(tk_identifier,"Expected identifier but got "+next().keyword,"","","");
+            paramType=ast::make<VarKwargTypeExpr>(tok);
+            expect(tk_identifier,"Expected identifier but got "+next().keyword(),"","","");
             x=VarKwarg;
             paramName=parseName();
         }
         else if(m_currentToken.tkType==tk_identifier){
-            paramType=std::make_shared<VarArgTypeExpr>(tok);
+            paramType=ast::make<VarArgTypeExpr>(tok);
             paramName=parseName();
             x=VarArg;
         }
         else{
-            error(m_currentToken,"Expected identifier but got "+m_currentToken.keyword,"","","");
+            error(m_currentToken,"Expected identifier but got "+m_currentToken.keyword(),"","","");
         }
         advance();
         return parameter{paramType, paramName,paramDefault,is_const,x};
     }
     else if(m_currentToken.tkType==tk_ellipses){
         ParamType x=Ellipses;
-        paramType=std::make_shared<EllipsesTypeExpr>(tok);
+        paramType=ast::make<EllipsesTypeExpr>(tok);
         if(next().tkType==tk_identifier){
             advance();
             paramName=parseName();
@@ -158,7 +132,7 @@ parameter Parser::parseParameter(){
     paramName = parseName();
     if(next().tkType==tk_comma || next().tkType==tk_r_paren|| next().tkType==tk_assign){}
     else{
-        expect(tk_colon,"Expected a : but got "+next().keyword+" instead");
+        expect(tk_colon,"Expected a : but got "+next().keyword()+" instead");
         advance();
         paramType = parseType();
     }
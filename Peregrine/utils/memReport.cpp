@@ -0,0 +1,63 @@
+#include "memReport.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sys/resource.h>
+
+namespace Utils {
+
+size_t MemReport::peak_rss() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    // kilobytes on linux
+    return size_t(usage.ru_maxrss) * 1024;
+}
+
+void MemReport::phase(std::string_view name) {
+    m_phases.emplace_back(name, peak_rss());
+}
+
+void MemReport::add(std::string_view section, std::string_view name,
+                    size_t count, size_t bytes) {
+    m_rows.push_back({std::string(section), std::string(name), count, bytes});
+}
+
+void MemReport::print(std::ostream& out) const {
+    out << "peak rss after\n";
+    for (auto& [name, bytes] : m_phases) {
+        out << "  " << std::left << std::setw(24) << name << std::right
+            << std::setw(14) << bytes << " bytes\n";
+    }
+    out << std::left << std::setw(26) << "" << std::right << std::setw(12)
+        << "count" << std::setw(14) << "bytes" << "\n";
+    std::vector<std::string_view> sections;
+    for (auto& row : m_rows) {
+        if (std::find(sections.begin(), sections.end(), row.section) ==
+            sections.end()) {
+            sections.push_back(row.section);
+        }
+    }
+    for (auto section : sections) {
+        out << section << "\n";
+        size_t rows = 0, count = 0, bytes = 0;
+        for (auto& row : m_rows) {
+            if (row.section != section) {
+                continue;
+            }
+            out << "  " << std::left << std::setw(24) << row.name << std::right
+                << std::setw(12) << row.count << std::setw(14) << row.bytes
+                << "\n";
+            rows++;
+            count += row.count;
+            bytes += row.bytes;
+        }
+        if (rows > 1) {
+            out << "  " << std::left << std::setw(24) << "total" << std::right
+                << std::setw(12) << count << std::setw(14) << bytes << "\n";
+        }
+    }
+}
+
+} // namespace Utils
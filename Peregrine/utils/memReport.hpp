@@ -0,0 +1,41 @@
+#ifndef PEREGRINE_MEM_REPORT_HPP
+#define PEREGRINE_MEM_REPORT_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Utils {
+
+// what -mem_report prints, the peak resident memory of the compiler after
+// every phase and the size of the structures it built
+class MemReport {
+    struct Row {
+        std::string section;
+        std::string name;
+        size_t count;
+        size_t bytes;
+    };
+    std::vector<std::pair<std::string, size_t>> m_phases;
+    std::vector<Row> m_rows;
+
+  public:
+    // peak resident set size of the process so far, in bytes
+    static size_t peak_rss();
+
+    // records the peak rss once `name` is done
+    void phase(std::string_view name);
+
+    // rows are printed grouped by section, sections in the order they first
+    // appear
+    void add(std::string_view section, std::string_view name, size_t count,
+             size_t bytes);
+
+    void print(std::ostream& out) const;
+};
+
+} // namespace Utils
+
+#endif
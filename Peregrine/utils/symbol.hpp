@@ -0,0 +1,100 @@
+#ifndef PEREGRINE_SYMBOL_HPP
+#define PEREGRINE_SYMBOL_HPP
+
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Utils {
+
+// an interned identifier. Every distinct name gets one 32-bit id for the
+// whole compilation, so comparing and hashing names is an integer operation.
+// Interning is thread-safe and names are never freed.
+class Symbol {
+    uint32_t m_id = 0;
+
+    struct Interner {
+        std::shared_mutex mutex;
+        // a deque never moves its elements, the views below point into them
+        std::deque<std::string> names{""};
+        std::unordered_map<std::string_view, uint32_t> ids{{"", 0}};
+    };
+
+    static Interner& interner() {
+        static Interner table;
+        return table;
+    }
+
+  public:
+    // the empty name
+    Symbol() = default;
+
+    Symbol(std::string_view name) {
+        auto& table = interner();
+        {
+            std::shared_lock<std::shared_mutex> lock(table.mutex);
+            auto it = table.ids.find(name);
+            if (it != table.ids.end()) {
+                m_id = it->second;
+                return;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(table.mutex);
+        auto it = table.ids.find(name);
+        if (it != table.ids.end()) {
+            m_id = it->second;
+            return;
+        }
+        m_id = table.names.size();
+        table.ids.emplace(table.names.emplace_back(name), m_id);
+    }
+
+    Symbol(const std::string& name) : Symbol(std::string_view(name)) {}
+    Symbol(const char* name) : Symbol(std::string_view(name)) {}
+
+    uint32_t id() const { return m_id; }
+
+    const std::string& str() const {
+        auto& table = interner();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        return table.names[m_id];
+    }
+
+    bool empty() const { return m_id == 0; }
+
+    // distinct names interned so far and the bytes their text takes
+    static size_t count() {
+        auto& table = interner();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        return table.names.size();
+    }
+
+    static size_t bytes() {
+        auto& table = interner();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        size_t bytes = 0;
+        for (auto& name : table.names) {
+            bytes += sizeof(name) + name.capacity();
+        }
+        return bytes;
+    }
+
+    bool operator==(const Symbol& other) const = default;
+    auto operator<=>(const Symbol& other) const = default;
+};
+
+} // namespace Utils
+
+template <> struct std::hash<Utils::Symbol> {
+    size_t operator()(Utils::Symbol symbol) const noexcept {
+        return symbol.id();
+    }
+};
+
+#endif
@@ -3,16 +3,16 @@ namespace Utils{
 MangleName::MangleName(MangleName const &other){
     *this=other;
 }
-void MangleName::set_local(std::string original){
-    m_local_names[original]="____P____P____"+original;
+void MangleName::set_local(Symbol original){
+    m_local_names[original]="____P____P____"+original.str();
 }
-void MangleName::set_local(std::string original,std::string mangled){
+void MangleName::set_local(Symbol original,Symbol mangled){
     m_local_names[original]=mangled;
 }
-void MangleName::set_global(std::string original,std::string mangled){
+void MangleName::set_global(Symbol original,Symbol mangled){
     m_global_names[original]=mangled;
 }
-bool MangleName::contains(std::string name){
+bool MangleName::contains(Symbol name){
     if(m_local_names.count(name)!=0){
         return true;
     }
@@ -21,26 +21,29 @@ bool MangleName::contains(std::string name){
     }
     return false;
 }
-std::string MangleName::operator[](std::string name){
-    if(m_local_names.count(name)!=0){
-        return m_local_names[name];
-    }
-    else if(m_global_names.count(name)!=0){
-        return m_global_names[name];
+const std::string& MangleName::operator[](Symbol name){
+    auto local=m_local_names.find(name);
+    if(local!=m_local_names.end()){
+        return local->second.str();
     }
-    else{
-        return name;
+    auto global=m_global_names.find(name);
+    if(global!=m_global_names.end()){
+        return global->second.str();
     }
+    return name.str();
+}
+size_t MangleName::size() const{
+    return m_global_names.size()+m_local_names.size();
 }
 void MangleName::print(){
     std::cout<<"Local{\n";
     for(auto const &p:m_local_names){
-        std::cout<<"    "<<p.first<<":"<<p.second<<std::endl;
+        std::cout<<"    "<<p.first.str()<<":"<<p.second.str()<<std::endl;
     }
     std::cout<<"}\nGLOBAL{\n";
     for(auto const &p:m_global_names){
-        std::cout<<"    "<<p.first<<":"<<p.second<<std::endl;
+        std::cout<<"    "<<p.first.str()<<":"<<p.second.str()<<std::endl;
     }
     std::cout<<"}";
 }
-}
\ No newline at end of file
+}
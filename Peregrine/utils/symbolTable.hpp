@@ -2,6 +2,7 @@
 #define PEREGRINE_SYM_TABLE_HPP
 
 #include "ast/ast.hpp"
+#include "symbol.hpp"
 
 #include <iostream>
 #include <assert.h>
@@ -10,78 +11,250 @@
 #include <algorithm>
 #include <string>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 namespace Utils{
+//open addressing hash map from interned names to values. Symbols are
+//already unique integers, so a slot only holds the id and the value and a
+//lookup never compares strings
 template<typename T>
-class SymbolTable {
-    std::map<std::string, T> m_symbols;
-    std::shared_ptr<SymbolTable<T>> m_parent;
-    std::map<std::string, T> m_enumMap;
-    std::map<std::string, T> m_unionMap;
+class SymbolMap {
+    struct Slot {
+        uint32_t key = 0; //id of the symbol + 1, 0 marks an empty slot
+        T value{};
+    };
+    std::vector<Slot> m_slots;
+    size_t m_size = 0;
+
+    size_t mask() const { return m_slots.size() - 1; }
+
+    size_t index(uint32_t key) const {
+        //fibonacci hashing spreads consecutive ids over the table
+        return (key * 0x9E3779B1u) & mask();
+    }
+
+    Slot* slot(Symbol name) {
+        if (m_size == 0) {
+            return nullptr;
+        }
+        uint32_t key = name.id() + 1;
+        for (size_t i = index(key);; i = (i + 1) & mask()) {
+            if (m_slots[i].key == key) {
+                return &m_slots[i];
+            }
+            if (m_slots[i].key == 0) {
+                return nullptr;
+            }
+        }
+    }
+
+    void grow() {
+        std::vector<Slot> old(m_slots.size() == 0 ? 16 : m_slots.size() * 2);
+        old.swap(m_slots);
+        for (auto& entry : old) {
+            if (entry.key != 0) {
+                size_t i = index(entry.key);
+                while (m_slots[i].key != 0) {
+                    i = (i + 1) & mask();
+                }
+                m_slots[i] = std::move(entry);
+            }
+        }
+    }
 
   public:
-    SymbolTable(std::shared_ptr<SymbolTable> parent) {
-        m_parent = parent;
-        if(m_parent!=nullptr){
-            m_enumMap = parent->getEnumMap();
-            m_unionMap = parent->getUnionMap();
+    //never changes the map, so threads may look up names at the same time
+    //while nobody defines any
+    T* find(Symbol name) {
+        Slot* found = slot(name);
+        return found ? &found->value : nullptr;
+    }
+
+    void set(Symbol name, T value) {
+        if (T* existing = find(name)) {
+            *existing = std::move(value);
+            return;
         }
+        //at most three quarters full, so probe sequences stay short
+        if ((m_size + 1) * 4 > m_slots.size() * 3) {
+            grow();
+        }
+        uint32_t key = name.id() + 1;
+        size_t i = index(key);
+        while (m_slots[i].key != 0) {
+            i = (i + 1) & mask();
+        }
+        m_slots[i].key = key;
+        m_slots[i].value = std::move(value);
+        m_size++;
     }
 
-    std::optional<T> get(std::string name) {
-        if (m_symbols.find(name) == m_symbols.end()) {
-            if (!m_parent) {
-                return std::nullopt; // the symbol was not found
+    void erase(Symbol name) {
+        Slot* found = slot(name);
+        if (found == nullptr) {
+            return;
+        }
+        size_t hole = found - m_slots.data();
+        m_slots[hole] = Slot{};
+        m_size--;
+        //moves back the entries after the hole that would no longer be
+        //reachable from their home slot
+        for (size_t i = (hole + 1) & mask(); m_slots[i].key != 0; i = (i + 1) & mask()) {
+            size_t home = index(m_slots[i].key);
+            bool reachable = hole < i ? (home > hole && home <= i)
+                                      : (home > hole || home <= i);
+            if (!reachable) {
+                m_slots[hole] = std::move(m_slots[i]);
+                m_slots[i] = Slot{};
+                hole = i;
             }
+        }
+    }
+
+    size_t size() const { return m_size; }
+};
 
-            return m_parent->get(name);
+//one scope of a chain of nested scopes. All scopes of a chain share one set
+//of tables that holds the definitions of every open scope, and each scope
+//logs what it defined so that it can take it out again when it is
+//destroyed. Opening a scope is O(1) and finding a name is a single hash
+//lookup however deep the scope is, where walking the chain made deeply
+//nested code quadratic.
+//Scopes have to be used like a stack: only the innermost scope of a chain
+//is used to look up or define names and a scope gets no second child while
+//the first one is alive. A child keeps its parent alive, so scopes are
+//always destroyed innermost first
+template<typename T>
+class SymbolTable {
+    struct Chain {
+        SymbolMap<T> symbols;
+        SymbolMap<T> enums;
+        SymbolMap<T> unions;
+        //names not defined in this chain are looked up here, see fork()
+        std::shared_ptr<SymbolTable<T>> outer;
+        //a definition to take out when its scope closes, along with the
+        //definition of an outer scope that it hid
+        struct Undo {
+            SymbolMap<T> Chain::*map;
+            Symbol name;
+            std::optional<T> hidden;
+        };
+        std::vector<Undo> log;
+        size_t depth = 0; //scopes open
+    };
+    std::shared_ptr<Chain> m_chain;
+    std::shared_ptr<SymbolTable<T>> m_parent;
+    size_t m_depth;
+    size_t m_logStart; //the undo entries of this scope start here
+
+    bool innermost() const { return m_chain->depth == m_depth; }
+
+    void define(SymbolMap<T> Chain::*map, Symbol name, T value) {
+        assert(innermost());
+        auto& table = (*m_chain).*map;
+        std::optional<T> hidden;
+        if (T* existing = table.find(name)) {
+            hidden = *existing;
         }
-        
-        return m_symbols[name];
+        m_chain->log.push_back({map, name, std::move(hidden)});
+        table.set(name, std::move(value));
     }
 
-    std::map<std::string, T> getEnumMap(){
-        return m_enumMap;
+    static T* find(Chain& chain, SymbolMap<T> Chain::*map, Symbol name) {
+        if (T* value = (chain.*map).find(name)) {
+            return value;
+        }
+        return chain.outer ? find(*chain.outer->m_chain, map, name) : nullptr;
     }
 
-    void add_enum(std::string key,T value){
-        m_enumMap[key]=value;
+    std::optional<T> lookup(SymbolMap<T> Chain::*map, Symbol name) {
+        assert(innermost());
+        if (T* value = find(*m_chain, map, name)) {
+            return *value;
+        }
+        return std::nullopt; // the symbol was not found
     }
 
-    std::map<std::string, T> getUnionMap(){
-        return m_unionMap;
+  public:
+    SymbolTable(std::shared_ptr<SymbolTable> parent) : m_parent(std::move(parent)) {
+        m_chain = m_parent ? m_parent->m_chain : std::make_shared<Chain>();
+        m_depth = m_parent ? m_parent->m_depth + 1 : 1;
+        assert(m_chain->depth == m_depth - 1);
+        m_chain->depth = m_depth;
+        m_logStart = m_chain->log.size();
+    }
+
+    ~SymbolTable() {
+        auto& log = m_chain->log;
+        while (log.size() > m_logStart) {
+            auto& undo = log.back();
+            auto& table = (*m_chain).*undo.map;
+            if (undo.hidden) {
+                table.set(undo.name, std::move(*undo.hidden));
+            } else {
+                table.erase(undo.name);
+            }
+            log.pop_back();
+        }
+        m_chain->depth = m_depth - 1;
+    }
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    //the first scope of a new chain that sees every name of `outer` without
+    //ever changing it, so that each thread can open scopes of its own over
+    //the same outer scope. Nothing may be defined in `outer` while a fork of
+    //it is alive
+    static std::shared_ptr<SymbolTable<T>> fork(std::shared_ptr<SymbolTable<T>> outer) {
+        auto table = std::make_shared<SymbolTable<T>>(nullptr);
+        table->m_chain->outer = std::move(outer);
+        return table;
     }
 
-    void add_union(std::string key,T value){
-        m_unionMap[key]=value;
+    std::optional<T> get(Symbol name) {
+        return lookup(&Chain::symbols, name);
     }
 
-    bool set(std::string name, T value) {
+    std::optional<T> get_enum(Symbol name) {
+        return lookup(&Chain::enums, name);
+    }
+
+    void add_enum(Symbol key,T value){
+        define(&Chain::enums, key, value);
+    }
+
+    std::optional<T> get_union(Symbol name) {
+        return lookup(&Chain::unions, name);
+    }
+
+    void add_union(Symbol key,T value){
+        define(&Chain::unions, key, value);
+    }
+
+    bool set(Symbol name, T value) {
         if (get(name)) {
             return false; // the symbol has been defined already
         }
 
-        m_symbols[name] = value;
-        get(name);
+        define(&Chain::symbols, name, value);
         return true;
     }
 
     bool set(ast::AstNodePtr name, T value) {
         assert(name->type() == ast::KAstIdentifier);
-        auto identifier=std::dynamic_pointer_cast<ast::IdentifierExpression>(name);
-        return set(identifier->value(), value);
+        auto identifier=static_cast<ast::IdentifierExpression*>(name);
+        return set(identifier->symbol(), value);
     }
 
-    bool reassign(std::string name, T value) {
-        if (m_symbols.find(name) == m_symbols.end()) {
-            if (!m_parent) {
-                return false; // the symbol was not found
-            }
-
-            return m_parent->reassign(name, value);
+    //only names of this chain can be reassigned, not those of a forked scope
+    bool reassign(Symbol name, T value) {
+        assert(innermost());
+        if (T* existing = m_chain->symbols.find(name)) {
+            *existing = value;
+            return true;
         }
-
-        m_symbols[name] = value;
-        return true;
+        return false; // the symbol was not found
     }
 
     std::shared_ptr<SymbolTable<T>> parent() {
@@ -89,8 +262,10 @@ class SymbolTable {
     }
 };
 
+//maps identifiers to the names they get in the generated code, both sides
+//are interned so copying the map for every scope copies integers only
 class MangleName{
-    std::map<std::string, std::string> m_global_names={
+    std::unordered_map<Symbol, Symbol> m_global_names={
                                                         {"error","error"},
                                                         {"printf","printf"},
                                                         {"i8","int8_t"},
@@ -105,17 +280,19 @@ class MangleName{
                                                         {"float","double"},
                                                         {"f128","long double"},
                                                         };
-    std::map<std::string, std::string> m_local_names;
+    std::unordered_map<Symbol, Symbol> m_local_names;
     public:
     MangleName()=default;
     MangleName(MangleName const &other);
-    void set_local(std::string original);
-    void set_local(std::string original,std::string mangled);
-    void set_global(std::string original,std::string mangled);
+    void set_local(Symbol original);
+    void set_local(Symbol original,Symbol mangled);
+    void set_global(Symbol original,Symbol mangled);
     
-    bool contains(std::string name);
-    std::string operator[](std::string name);
+    bool contains(Symbol name);
+    const std::string& operator[](Symbol name);
     void print();
+    //names in the global and the local table
+    size_t size() const;
 };
 }
 
@@ -0,0 +1,95 @@
+#ifndef PEREGRINE_THREAD_POOL_HPP
+#define PEREGRINE_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+
+// fixed set of worker threads that run submitted jobs in order
+class ThreadPool {
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+
+    void work() {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock,
+                            [this] { return m_stopping || !m_jobs.empty(); });
+                if (m_jobs.empty()) {
+                    return;
+                }
+                job = std::move(m_jobs.front());
+                m_jobs.pop();
+            }
+            job();
+        }
+    }
+
+  public:
+    explicit ThreadPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            m_workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return m_workers.size(); }
+
+    // queues `job`, the future holds its result once a worker ran it
+    template <typename F> auto submit(F job) -> std::future<decltype(job())> {
+        auto task =
+            std::make_shared<std::packaged_task<decltype(job())()>>(std::move(job));
+        auto result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.push([task] { (*task)(); });
+        }
+        m_wake.notify_one();
+        return result;
+    }
+
+    // pool shared by the whole compiler, one thread per core unless the
+    // PEREGRINE_THREADS environment variable sets how many
+    static ThreadPool& shared() {
+        static ThreadPool pool([] {
+            const char* threads = std::getenv("PEREGRINE_THREADS");
+            size_t count = threads ? std::strtoul(threads, nullptr, 10) : 0;
+            if (count == 0) {
+                count = std::thread::hardware_concurrency();
+            }
+            return std::max<size_t>(1, count);
+        }());
+        return pool;
+    }
+};
+
+} // namespace Utils
+
+#endif
@@ -0,0 +1,158 @@
+// Front-end benchmark, times every stage of the compiler on its own.
+// usage: frontend_bench.elf <file.pe> [rounds]
+// The parser pulls its tokens from the lexer, so the parser row is the time
+// of lexing and parsing together minus the time of lexing alone.
+#include "analyzer/ast_validate.hpp"
+#include "ast/arena.hpp"
+#include "ast/ast.hpp"
+#include "ast/flat.hpp"
+#include "codegen/cpp/codegen.hpp"
+#include "lexer/lexer.hpp"
+#include "lexer/source.hpp"
+#include "parser/parser.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct Result {
+    std::string name;
+    double best = 0;
+    double total = 0;
+    size_t rounds = 0;
+};
+
+// runs `setup` untimed and `body` timed, `rounds` times, keeps the best run
+static Result run(std::string name, size_t rounds, std::function<void()> setup,
+                  std::function<void()> body) {
+    Result res{name};
+    for (size_t i = 0; i < rounds; ++i) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (i == 0 || elapsed.count() < res.best) {
+            res.best = elapsed.count();
+        }
+        res.total += elapsed.count();
+        res.rounds++;
+    }
+    return res;
+}
+
+// the kind of every node, the way a pass over the linked tree reaches them
+static size_t walk(ast::AstNodePtr node, std::vector<ast::AstNodePtr>& scratch,
+                   size_t* kinds) {
+    kinds[node->type()]++;
+    size_t start = scratch.size();
+    ast::children(node, scratch);
+    size_t count = 1;
+    for (size_t i = start; i < scratch.size(); ++i) {
+        count += walk(scratch[i], scratch, kinds);
+    }
+    scratch.resize(start);
+    return count;
+}
+
+// nodes is 0 for stages that do not work on the ast
+static void report(const Result& res, size_t bytes, size_t nodes) {
+    std::printf("%-24s %10.3f ms %10.3f ms %8zu %10.2f MB/s", res.name.c_str(),
+                res.best * 1e3, res.total / res.rounds * 1e3, res.rounds,
+                bytes / res.best / 1e6);
+    if (nodes != 0) {
+        std::printf(" %12.0f nodes/s", nodes / res.best);
+    }
+    std::printf("\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "usage: " << argv[0] << " <file.pe> [rounds]\n";
+        return 1;
+    }
+    auto source = sources::load(argv[1]);
+    if (!source) {
+        std::cout << "error: could not open " << argv[1] << "\n";
+        return 1;
+    }
+    size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 5;
+    size_t bytes = sources::get(*source).text().size();
+    std::string filename = argv[1];
+
+    // every parse replaces the previous tree
+    ast::Arena arena;
+    ast::Arena::Scope scope(arena);
+    auto parse = [&] {
+        arena.reset();
+        LEXER lexer(*source);
+        Parser::Parser parser(lexer, filename);
+        return parser.parse();
+    };
+
+    size_t before = ast::AstNode::created();
+    parse();
+    size_t nodes = ast::AstNode::created() - before;
+
+    ast::AstNodePtr program;
+    auto nothing = [] {};
+
+    auto lexer = run("lexer", rounds, nothing, [&] {
+        LEXER lexer(*source);
+        while (lexer.next_token().tkType != tk_eof) {
+        }
+    });
+    auto lex_parse = run("lexer+parser", rounds, nothing, [&] { parse(); });
+    auto validator = run(
+        "validator", rounds, [&] { program = parse(); },
+        [&] { astValidator::Validator val(program, filename); });
+    auto codegen = run(
+        "cpp codegen", rounds,
+        [&] {
+            program = parse();
+            astValidator::Validator val(program, filename);
+        },
+        [&] { cpp::Codegen codegen("/dev/null", program, filename); });
+
+    ast::FlatAst flat;
+    size_t kinds[256] = {};
+    std::vector<ast::AstNodePtr> scratch;
+    auto flatten = run(
+        "flatten", rounds, [&] { program = parse(); },
+        [&] { flat = ast::FlatAst(program); });
+    auto linked_walk = run("linked walk", rounds, nothing,
+                           [&] { walk(program, scratch, kinds); });
+    auto flat_walk = run("flat walk", rounds, nothing, [&] {
+        for (auto kind : flat.kinds()) {
+            kinds[kind]++;
+        }
+    });
+
+    if (walk(program, scratch, kinds) != flat.size()) {
+        std::cout << "error: the flat ast does not match the linked one\n";
+        return 1;
+    }
+
+    Result parser{"parser", lex_parse.best - lexer.best,
+                  lex_parse.total - lexer.total, rounds};
+
+    std::printf("input: %zu bytes, %zu ast nodes\n", bytes, nodes);
+    std::printf("%-24s %13s %13s %8s %15s\n", "Benchmark", "Best", "Mean",
+                "Rounds", "Throughput");
+    report(lexer, bytes, 0);
+    report(parser, bytes, nodes);
+    report(lex_parse, bytes, nodes);
+    report(validator, bytes, nodes);
+    report(codegen, bytes, nodes);
+    report(flatten, bytes, nodes);
+    report(linked_walk, bytes, nodes);
+    report(flat_walk, bytes, nodes);
+    std::printf("linked ast: %zu bytes in nodes, %zu reserved\n", arena.bytes(),
+                arena.reserved());
+    std::printf("flat ast:   %zu bytes\n", flat.bytes());
+    return 0;
+}
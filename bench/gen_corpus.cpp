@@ -0,0 +1,181 @@
+// Generates a synthetic but valid .pe program for the front-end benchmarks.
+// usage: gen_corpus.elf [-o file.pe] [-size kb] [-depth n] [-seed n]
+//                       [-classes w] [-functions w] [-fstrings w] [-matches w]
+// -size is the size of the output in kilobytes, -depth how deeply blocks
+// nest inside a function. The weights decide how often each construct is
+// picked, 0 turns it off.
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+struct Options {
+    std::string output = "";
+    size_t size = 1024;
+    size_t depth = 4;
+    unsigned seed = 1;
+    unsigned classes = 2;
+    unsigned functions = 4;
+    unsigned fstrings = 1;
+    unsigned matches = 1;
+};
+
+class Generator {
+    Options m_options;
+    std::mt19937 m_rng;
+    std::string m_out;
+    size_t m_classes = 0;
+    size_t m_functions = 0;
+
+    size_t pick(size_t n) { return m_rng() % n; }
+
+    void line(size_t indent, const std::string& text) {
+        m_out.append(indent * 4, ' ');
+        m_out += text;
+        m_out += "\n";
+    }
+
+    std::string expression(size_t terms) {
+        static const char* ops[] = {"+", "-", "*"};
+        std::string expr = "a";
+        for (size_t i = 0; i < terms; ++i) {
+            expr += ops[pick(3)];
+            expr += pick(2) ? "b" : std::to_string(pick(100));
+        }
+        return expr;
+    }
+
+    void statement(size_t indent, size_t depth) {
+        // weights of the plain statements, blocks only while depth allows
+        unsigned simple = 4;
+        unsigned blocks = depth < m_options.depth ? 2 : 0;
+        unsigned fstrings = m_options.fstrings;
+        unsigned matches = depth < m_options.depth ? m_options.matches : 0;
+        size_t choice = pick(simple + blocks + fstrings + matches);
+
+        if (choice < simple) {
+            if (pick(2)) {
+                line(indent, "a=" + expression(1 + pick(4)));
+            } else {
+                line(indent, "printf(\"%lld\\n\"," + expression(pick(3)) + ")");
+            }
+        } else if (choice < simple + blocks) {
+            if (pick(2)) {
+                line(indent, "if a>" + std::to_string(pick(50)) + ":");
+                block(indent + 1, depth + 1);
+                line(indent, "else:");
+                block(indent + 1, depth + 1);
+            } else {
+                line(indent, "while a>" + std::to_string(pick(50)) + ":");
+                line(indent + 1, "a=a-1");
+                block(indent + 1, depth + 1);
+            }
+        } else if (choice < simple + blocks + fstrings) {
+            line(indent, "s=f\"a is {a} and b is {" + expression(1) + "}\"");
+        } else {
+            line(indent, "match a:");
+            for (size_t i = 0, n = 1 + pick(3); i < n; ++i) {
+                line(indent + 1, "case " + std::to_string(i) + ":");
+                block(indent + 2, depth + 1);
+            }
+            line(indent + 1, "case _:");
+            line(indent + 2, "a=0");
+        }
+    }
+
+    void block(size_t indent, size_t depth) {
+        for (size_t i = 0, n = 1 + pick(3); i < n; ++i) {
+            statement(indent, depth);
+        }
+    }
+
+    void function(size_t indent, const std::string& name, bool method) {
+        line(indent, "def " + name + "(" + (method ? "self," : "") +
+                         "a:int,b:int)->int:");
+        line(indent + 1, "s:str=\"\"");
+        block(indent + 1, 0);
+        line(indent + 1, "return a");
+    }
+
+    void function() { function(0, "func" + std::to_string(m_functions++), false); }
+
+    void klass() {
+        auto name = "class" + std::to_string(m_classes++);
+        line(0, "class " + name + ":");
+        line(1, "x:int=0");
+        line(1, "y:int=0");
+        line(1, "def __init__(self,x:int):");
+        line(2, "self.x=x");
+        for (size_t i = 0, n = 1 + pick(3); i < n; ++i) {
+            function(1, "method" + std::to_string(i), true);
+        }
+    }
+
+  public:
+    Generator(Options options) : m_options(options), m_rng(options.seed) {}
+
+    std::string run() {
+        unsigned total = m_options.classes + m_options.functions;
+        if (total == 0) {
+            total = m_options.functions = 1;
+        }
+        while (m_out.size() < m_options.size * 1024) {
+            if (pick(total) < m_options.classes) {
+                klass();
+            } else {
+                function();
+            }
+        }
+        line(0, "def main():");
+        line(1, "printf(\"done\\n\")");
+        return m_out;
+    }
+};
+
+int main(int argc, char** argv) {
+    Options options;
+    if (argc % 2 == 0) {
+        std::cout << "usage: " << argv[0]
+                  << " [-o file.pe] [-size kb] [-depth n] [-seed n] [-classes w]"
+                     " [-functions w] [-fstrings w] [-matches w]\n";
+        return 1;
+    }
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        unsigned long value = std::strtoul(argv[i + 1], nullptr, 10);
+        if (arg == "-o") {
+            options.output = argv[i + 1];
+        } else if (arg == "-size") {
+            options.size = value;
+        } else if (arg == "-depth") {
+            options.depth = value;
+        } else if (arg == "-seed") {
+            options.seed = value;
+        } else if (arg == "-classes") {
+            options.classes = value;
+        } else if (arg == "-functions") {
+            options.functions = value;
+        } else if (arg == "-fstrings") {
+            options.fstrings = value;
+        } else if (arg == "-matches") {
+            options.matches = value;
+        } else {
+            std::cout << "Invalid argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    auto program = Generator(options).run();
+    if (options.output == "") {
+        std::cout << program;
+        return 0;
+    }
+    std::ofstream file(options.output);
+    if (!file) {
+        std::cout << "error: could not write " << options.output << "\n";
+        return 1;
+    }
+    file << program;
+    return 0;
+}
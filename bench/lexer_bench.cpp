@@ -0,0 +1,55 @@
+// Lexer microbenchmark, measures how many tokens per second LEXER produces.
+// usage: lexer_bench.elf <file.pe> [copies] [rounds]
+#include "lexer/lexer.hpp"
+#include "lexer/tokens.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "usage: " << argv[0] << " <file.pe> [copies] [rounds]\n";
+        return 1;
+    }
+    std::ifstream file(argv[1]);
+    if (!file) {
+        std::cout << "error: could not open " << argv[1] << "\n";
+        return 1;
+    }
+    std::stringstream buf;
+    buf << file.rdbuf();
+
+    size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    size_t rounds = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+
+    // repeat the file so that the input is large enough to time reliably
+    std::string input;
+    for (size_t i = 0; i < copies; ++i) {
+        input += buf.str();
+        input += "\n";
+    }
+
+    size_t tokens = 0;
+    double best = 0;
+    for (size_t i = 0; i < rounds; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        auto result = LEXER(input, argv[1]).result();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        tokens = result.size();
+        if (i == 0 || elapsed.count() < best) {
+            best = elapsed.count();
+        }
+    }
+
+    std::cout << "input:      " << input.size() << " bytes\n";
+    std::cout << "tokens:     " << tokens << "\n";
+    std::cout << "best time:  " << best * 1000 << " ms\n";
+    std::cout << "tokens/sec: " << static_cast<size_t>(tokens / best) << "\n";
+    std::cout << "MB/sec:     " << input.size() / best / (1024 * 1024) << "\n";
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "doctest.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <analyzer/fold.hpp>
+#include <analyzer/semantic.hpp>
+#include <analyzer/typeChecker.hpp>
+#include <ast/ast.hpp>
+#include <lexer/lexer.hpp>
+#include <parser/parser.hpp>
+#include <utils/threadPool.hpp>
+
+// the shared pool is made the first time it is used, which is after this.
+// With more than one worker the function bodies below are checked in
+// parallel on any machine
+static const int threads = setenv("PEREGRINE_THREADS", "4", 1);
+
+static ast::AstNodePtr parse(const std::string& source) {
+    auto lex = LEXER(source, "test.pe");
+    Parser::Parser parser(lex, "test.pe");
+    return parser.parse();
+}
+
+TEST_SUITE_BEGIN("Analyzer");
+
+TEST_CASE("Check function bodies in parallel") {
+    REQUIRE(Utils::ThreadPool::shared().size() > 1);
+
+    std::string source;
+    for (int i = 0; i < 40; ++i) {
+        source += "def f" + std::to_string(i) + "()->int:\n"
+                  "    x:int\n"
+                  "    y:bool\n"
+                  "    z:str\n"
+                  "    return x\n\n";
+    }
+    auto program = parse(source);
+    TypeCheck::TypeChecker checker(program);
+
+    // every local declared without a value got the default of its type
+    for (auto stmt : static_cast<ast::Program*>(program)->statements()) {
+        auto function = static_cast<ast::FunctionDefinition*>(stmt);
+        auto& body =
+            static_cast<ast::BlockStatement*>(function->body())->statements();
+        auto x = static_cast<ast::VariableStatement*>(body[0])->value();
+        auto y = static_cast<ast::VariableStatement*>(body[1])->value();
+        auto z = static_cast<ast::VariableStatement*>(body[2])->value();
+        REQUIRE(x->type() == ast::KAstInteger);
+        CHECK(x->token().lexeme() == "0");
+        REQUIRE(y->type() == ast::KAstBool);
+        CHECK(y->token().lexeme() == "False");
+        REQUIRE(z->type() == ast::KAstString);
+    }
+}
+
+// the statements of the body of the first function in `program`
+static const std::vector<ast::AstNodePtr>& body(ast::AstNodePtr program) {
+    auto function = static_cast<ast::FunctionDefinition*>(
+        static_cast<ast::Program*>(program)->statements()[0]);
+    return static_cast<ast::BlockStatement*>(function->body())->statements();
+}
+
+TEST_CASE("Annotate the types of a valid program while validating it") {
+    auto program = parse("def main():\n"
+                         "    x = 1.5\n"
+                         "    y:int\n");
+    analyzer::Semantic semantic("test.pe", false, false,
+                                analyzer::Semantic::Types::Annotate);
+    for (auto stmt : static_cast<ast::Program*>(program)->statements()) {
+        semantic.analyze(stmt);
+    }
+    semantic.finish();
+
+    auto x = static_cast<ast::VariableStatement*>(body(program)[0]);
+    auto y = static_cast<ast::VariableStatement*>(body(program)[1]);
+    CHECK(x->varType()->stringify() == "float");
+    REQUIRE(y->value()->type() == ast::KAstInteger);
+    CHECK(y->value()->token().lexeme() == "0");
+}
+
+TEST_CASE("Only validate for the backends that do not use the types") {
+    auto program = parse("def main():\n"
+                         "    x = 1.5\n"
+                         "    y:int\n");
+    auto type = static_cast<ast::VariableStatement*>(body(program)[0])->varType();
+    analyzer::Semantic semantic("test.pe", true, false,
+                                analyzer::Semantic::Types::None);
+    for (auto stmt : static_cast<ast::Program*>(program)->statements()) {
+        semantic.analyze(stmt);
+    }
+    semantic.finish();
+
+    auto x = static_cast<ast::VariableStatement*>(body(program)[0]);
+    auto y = static_cast<ast::VariableStatement*>(body(program)[1]);
+    CHECK(x->varType() == type);
+    CHECK(y->value()->type() == ast::KAstNoLiteral);
+}
+
+// the statements of `main` in `source` once the program is folded
+static std::vector<ast::AstNodePtr> foldMain(const std::string& source) {
+    auto program = parse(source);
+    program = analyzer::ConstantFolder(program).fold(program);
+    for (auto stmt : static_cast<ast::Program*>(program)->statements()) {
+        if (stmt->type() != ast::KAstFunctionDef) {
+            continue;
+        }
+        auto function = static_cast<ast::FunctionDefinition*>(stmt);
+        auto name = static_cast<ast::IdentifierExpression*>(function->name());
+        if (name->value() == "main") {
+            return static_cast<ast::BlockStatement*>(function->body())
+                ->statements();
+        }
+    }
+    return {};
+}
+
+// what `expression` folds to: the text of an integer or bool, a string in
+// quotes, or nothing when it is not folded to a literal
+static std::string fold(const std::string& expression) {
+    auto body = foldMain("def main():\n    x = " + expression + "\n");
+    REQUIRE(body.size() == 1);
+    auto value = static_cast<ast::VariableStatement*>(body[0])->value();
+    switch (value->type()) {
+        case ast::KAstInteger:
+            return static_cast<ast::IntegerLiteral*>(value)->value();
+        case ast::KAstBool:
+            return static_cast<ast::BoolLiteral*>(value)->value();
+        case ast::KAstString:
+            return "\"" + static_cast<ast::StringLiteral*>(value)->value() +
+                   "\"";
+        default:
+            return "";
+    }
+}
+
+TEST_CASE("Fold integer arithmetic") {
+    CHECK(fold("(3 + 4) * 3") == "21");
+    CHECK(fold("2 ** 10") == "1024");
+    CHECK(fold("1 < 2") == "True");
+
+    // floor division rounds towards negative infinity
+    CHECK(fold("7 // 2") == "3");
+    CHECK(fold("7 // -2") == "-4");
+    CHECK(fold("-7 // 2") == "-4");
+    CHECK(fold("-7 // -2") == "3");
+    CHECK(fold("7 // 0") == "");
+    // the backends do not agree on `/` of integers
+    CHECK(fold("7 / 2") == "");
+}
+
+TEST_CASE("Leave modulo of negative operands to the program") {
+    CHECK(fold("7 % 3") == "1");
+    CHECK(fold("-7 % 3") == "");
+    CHECK(fold("7 % -3") == "");
+    CHECK(fold("7 % 0") == "");
+}
+
+TEST_CASE("Leave overflowing arithmetic to the program") {
+    CHECK(fold("9223372036854775806 + 1") == "9223372036854775807");
+    CHECK(fold("9223372036854775807 + 1") == "");
+    CHECK(fold("-9223372036854775807 - 2") == "");
+    CHECK(fold("4611686018427387904 * 2") == "");
+    CHECK(fold("2 ** 63") == "");
+}
+
+TEST_CASE("Fold bitwise operators only within 32 bits") {
+    CHECK(fold("6 & 3") == "2");
+    CHECK(fold("1 << 4") == "16");
+    CHECK(fold("1 << 31") == "");
+    CHECK(fold("4294967296 | 1") == "");
+    CHECK(fold("-1 & 3") == "");
+}
+
+TEST_CASE("Join strings without escapes") {
+    CHECK(fold("\"ab\" + \"cd\"") == "\"abcd\"");
+    // "\x4" "1" is not "\x41", and "\1" "2" is not "\12"
+    CHECK(fold("\"\\x4\" + \"1\"") == "");
+    CHECK(fold("\"\\1\" + \"2\"") == "");
+}
+
+TEST_CASE("Remove branches and loops that never run") {
+    auto body = foldMain("def main():\n"
+                         "    if False:\n"
+                         "        print(1)\n"
+                         "    while False:\n"
+                         "        print(2)\n"
+                         "    print(3)\n");
+    REQUIRE(body.size() == 1);
+    CHECK(body[0]->type() == ast::KAstFunctionCall);
+
+    body = foldMain("def main():\n"
+                    "    if 1 > 2:\n"
+                    "        print(1)\n"
+                    "    else:\n"
+                    "        print(2)\n");
+    REQUIRE(body.size() == 1);
+    CHECK(body[0]->type() == ast::KAstScopeStmt);
+}
+
+TEST_CASE("Propagate constants declared once") {
+    auto body = foldMain("const A:int = 6\n"
+                         "def main():\n"
+                         "    x = A * 7\n");
+    REQUIRE(body.size() == 1);
+    auto value = static_cast<ast::VariableStatement*>(body[0])->value();
+    REQUIRE(value->type() == ast::KAstInteger);
+    CHECK(static_cast<ast::IntegerLiteral*>(value)->value() == "42");
+
+    // a local of the same name shadows the constant in main
+    body = foldMain("const A:int = 6\n"
+                    "def main():\n"
+                    "    A:int = 1\n"
+                    "    x = A * 7\n");
+    REQUIRE(body.size() == 2);
+    value = static_cast<ast::VariableStatement*>(body[1])->value();
+    CHECK(value->type() == ast::KAstBinaryOp);
+}
+
+TEST_SUITE_END();
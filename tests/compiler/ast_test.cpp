@@ -0,0 +1,157 @@
+#include "doctest.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include <ast/ast.hpp>
+#include <ast/cache.hpp>
+#include <ast/serialize.hpp>
+#include <ast/stats.hpp>
+#include <lexer/lexer.hpp>
+#include <lexer/source.hpp>
+#include <parser/parser.hpp>
+
+// a program with a node of every kind the parser makes
+static const char* every_kind =
+    "import math\n"
+    "from os import path as p\n"
+    "extern c=import(\"stdio.h\")\n"
+    "def c.printf(*char,...)->int\n"
+    "union c.incomplete\n"
+    "union c.pair:\n"
+    "    first:int\n"
+    "    second:int\n"
+    "class c.point:\n"
+    "    x:int\n"
+    "    y:int\n"
+    "type number = int | float\n"
+    "type callback = def(int,...)->int\n"
+    "type var_args = def(*,**)\n"
+    "def args(items:[]int, n:*int):\n"
+    "    ...\n"
+    "def main():\n"
+    "    x:int = 1\n"
+    "    y = None\n"
+    "    l = [1, 2]\n"
+    "    d = {1: 2}\n"
+    "    while x < 3:\n"
+    "        x += 1\n"
+    "        continue\n"
+    "    squares = x*x for x in l\n"
+    "    size = $len(l)\n"
+    "    s = f\"{x} and {y}\"\n"
+    "    v = vector{int}()\n"
+    "    __asm__:\n"
+    "        x=\"nop\"\n"
+    "        \"a\"=x\n"
+    "const limit:int = 10\n"
+    "enum colour:\n"
+    "    RED = 1,\n"
+    "    GREEN\n"
+    "union value:\n"
+    "    i:int\n"
+    "    f:float\n"
+    "static count:int = 0\n"
+    "inline def twice(n:int)->int:\n"
+    "    return n*2\n"
+    "export def exported():\n"
+    "    ...\n"
+    "private def hidden():\n"
+    "    ...\n"
+    "def pair()->int,int:\n"
+    "    return 1, 2\n"
+    "class shape:\n"
+    "    size:int = 0\n"
+    "    def __init__(self):\n"
+    "        ...\n"
+    "    virtual def area(self)->float:\n"
+    "        return 1.5\n"
+    "def (self:shape)grow(by:int=1):\n"
+    "    self.size += by\n"
+    "@twice\n"
+    "def decorated():\n"
+    "    ...\n"
+    "def flow(n:int, r:&int, p:*shape):\n"
+    "    a, b = pair()\n"
+    "    twice(n=2)\n"
+    "    ok = True\n"
+    "    neg = -n\n"
+    "    n++\n"
+    "    first = l[0]\n"
+    "    sz = p->size\n"
+    "    z = cast<float>(n)\n"
+    "    t = 1 if ok else 2\n"
+    "    f = def(k:int):k+1\n"
+    "    assert ok\n"
+    "    if n > 1:\n"
+    "        ...\n"
+    "    elif n < 0:\n"
+    "        return\n"
+    "    else:\n"
+    "        ...\n"
+    "    for i in l:\n"
+    "        break\n"
+    "    match n:\n"
+    "        case 1:\n"
+    "            ...\n"
+    "        case _:\n"
+    "            ...\n"
+    "    scope:\n"
+    "        ...\n"
+    "    with shape() as s:\n"
+    "        ...\n"
+    "    try:\n"
+    "        raise error.ZeroDivisionError\n"
+    "    except error.ZeroDivisionError as e:\n"
+    "        ...\n";
+
+static ast::AstNodePtr parse(uint16_t source) {
+    auto lex = LEXER(source);
+    Parser::Parser parser(lex, "test.pe");
+    return parser.parse();
+}
+
+TEST_SUITE_BEGIN("AST");
+
+TEST_CASE("Serialize a node of every kind") {
+    auto source = sources::add(every_kind, "test.pe");
+    auto program = parse(source);
+
+    auto stats = ast::kind_stats(program);
+    for (size_t kind = 0; kind < stats.size(); ++kind) {
+        // no node has this kind
+        if (kind == ast::KAstDictTypeExpr) {
+            continue;
+        }
+        INFO(ast::kind_info(ast::AstKind(kind)).name);
+        CHECK(stats[kind].count > 0);
+    }
+
+    auto copy = ast::deserialize(ast::serialize(program, source), source);
+    REQUIRE(copy != nullptr);
+    CHECK(copy->stringify() == program->stringify());
+}
+
+TEST_CASE("Only load cached trees built with the same options") {
+    auto dir = std::filesystem::temp_directory_path() /
+               ("ast_test_cache." + std::to_string(getpid()));
+    setenv("PEREGRINE_CACHE_DIR", dir.c_str(), 1);
+    auto source = sources::add("def main():\n    print(1)\n", "test.pe");
+    auto program = parse(source);
+    ast::AstCache(source, "cpp").store(program);
+
+    auto cached = ast::AstCache(source, "cpp").load();
+    REQUIRE(cached != nullptr);
+    CHECK(cached->stringify() == program->stringify());
+    CHECK(ast::AstCache(source, "js").load() == nullptr);
+    CHECK(ast::AstCache(source, "cpp,main").load() == nullptr);
+    // nor with the same options for a different text
+    auto other = sources::add("def main():\n    print(2)\n", "test.pe");
+    CHECK(ast::AstCache(other, "cpp").load() == nullptr);
+
+    unsetenv("PEREGRINE_CACHE_DIR");
+    std::filesystem::remove_all(dir);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,72 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cli/cli.hpp>
+#include <lexer/source.hpp>
+
+// loads "-" with `fd` in place of stdin
+static std::optional<uint16_t> loadStdin(int fd, std::string& path) {
+    int saved = dup(STDIN_FILENO);
+    dup2(fd, STDIN_FILENO);
+    close(fd);
+    auto source = cli::load_input("-", path);
+    dup2(saved, STDIN_FILENO);
+    close(saved);
+    return source;
+}
+
+TEST_SUITE_BEGIN("CLI");
+
+TEST_CASE("Take - as the input file") {
+    std::vector<std::string> args = {"peregrine", "compile", "-", "-emit_cpp",
+                                     "-o", "out.cpp"};
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    cli::CLI cli(argv.size(), argv.data());
+    auto state = cli.parse();
+    CHECK(state.input_filename == "-");
+    CHECK(state.output_filename == "out.cpp");
+}
+
+TEST_CASE("Read the input file from stdin") {
+    std::string text = "def main():\n    print(1)\n";
+
+    SUBCASE("Redirected from a file") {
+        auto file =
+            (std::filesystem::temp_directory_path() / "cli_test.pe").string();
+        std::ofstream(file) << text;
+        std::string path;
+        auto source = loadStdin(open(file.c_str(), O_RDONLY), path);
+        std::filesystem::remove(file);
+        REQUIRE(source);
+        CHECK(path == "-");
+        CHECK(sources::get(*source).text() == text);
+    }
+
+    SUBCASE("Piped") {
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+        REQUIRE(write(fds[1], text.data(), text.size()) == (ssize_t)text.size());
+        close(fds[1]);
+        std::string path;
+        auto source = loadStdin(fds[0], path);
+        REQUIRE(source);
+        CHECK(path == "-");
+        CHECK(sources::get(*source).text() == text);
+    }
+}
+
+TEST_CASE("Fail to load a file that does not exist") {
+    std::string path;
+    CHECK_FALSE(cli::load_input("does/not/exist.pe", path));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,101 @@
+#include "doctest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <analyzer/fold.hpp>
+#include <analyzer/semantic.hpp>
+#include <ast/ast.hpp>
+#include <codegen/cpp/codegen.hpp>
+#include <lexer/lexer.hpp>
+#include <parser/parser.hpp>
+
+// the C++ generated for `source` the way the compile command generates it
+static std::string compileCpp(const std::string& source) {
+    auto output =
+        (std::filesystem::temp_directory_path() / "codegen_test.cc").string();
+    auto lex = LEXER(source, "test.pe");
+    Parser::Parser parser(lex, "test.pe");
+    auto program = parser.parse();
+    analyzer::Semantic semantic("test.pe", false, false,
+                                analyzer::Semantic::Types::Annotate);
+    for (auto stmt : static_cast<ast::Program*>(program)->statements()) {
+        semantic.analyze(stmt);
+    }
+    semantic.finish();
+    program = analyzer::ConstantFolder(program).fold(program);
+    { cpp::Codegen codegen(output, program, "test.pe"); }
+
+    std::ifstream file(output);
+    std::stringstream buf;
+    buf << file.rdbuf();
+    std::filesystem::remove(output);
+    return buf.str();
+}
+
+// the whole line of `code` that `part` is on
+static std::string lineOf(const std::string& code, const std::string& part) {
+    size_t at = code.find(part);
+    if (at == std::string::npos) {
+        return "";
+    }
+    size_t begin = code.rfind('\n', at) + 1;
+    return code.substr(begin, code.find('\n', at) - begin);
+}
+
+TEST_SUITE_BEGIN("Codegen");
+
+TEST_CASE("Declare locals without a value with their default") {
+    auto code = compileCpp("def main():\n"
+                           "    x:int\n"
+                           "    y:bool\n"
+                           "    s:str\n");
+    CHECK(code.find("int64_t ____P____P____x = 0;") != std::string::npos);
+    CHECK(code.find("bool ____P____P____y = false;") != std::string::npos);
+    CHECK(code.find("str ____P____P____s = \"\";") != std::string::npos);
+}
+
+TEST_CASE("Infer untyped parameters from direct calls") {
+    auto code = compileCpp("def add(a, b):\n"
+                           "    return a + b\n"
+                           "\n"
+                           "def main():\n"
+                           "    n = add(1, 2)\n");
+    auto add = lineOf(code, "add(");
+    CHECK(add.find("int64_t ____P____P____a,int64_t ____P____P____b") !=
+          std::string::npos);
+    CHECK(add.rfind("int64_t ", 0) == 0);
+    CHECK(code.find("int64_t ____P____P____n = ") != std::string::npos);
+}
+
+TEST_CASE("Return auto from functions with untyped parameters") {
+    // the calls disagree on the type, so it stays unknown
+    auto code = compileCpp("def twice(x):\n"
+                           "    return x * 2\n"
+                           "\n"
+                           "def main():\n"
+                           "    print(twice(1))\n"
+                           "    print(twice(1.5))\n");
+    auto twice = lineOf(code, "twice(auto ____P____P____x");
+    REQUIRE(twice != "");
+    CHECK(twice.rfind("auto ", 0) == 0);
+}
+
+TEST_CASE("Declare decimal locals as double") {
+    auto code = compileCpp("def main():\n"
+                           "    x = 1.5\n"
+                           "    y:float\n");
+    CHECK(code.find("double ____P____P____x = 1.5;") != std::string::npos);
+    CHECK(code.find("double ____P____P____y = ") != std::string::npos);
+}
+
+TEST_CASE("Point to decimals with double pointers") {
+    auto code = compileCpp("def main():\n"
+                           "    x = 1.5\n"
+                           "    p = &x\n");
+    CHECK(code.find("double ____P____P____x = 1.5;") != std::string::npos);
+    CHECK(code.find("double* ____P____P____p = ") != std::string::npos);
+}
+
+TEST_SUITE_END();
@@ -1,7 +1,11 @@
 #include "doctest.h"
 
+#include <string>
+#include <thread>
 #include <vector>
 #include <lexer/lexer.hpp>
+#include <lexer/scan.hpp>
+#include <lexer/source.hpp>
 #include <lexer/tokens.hpp>
 
 TEST_CASE("Tokenize basic primitives") {
@@ -9,20 +13,54 @@ TEST_CASE("Tokenize basic primitives") {
 
     res = LEXER("69420", "").result();
     CHECK(res[0].tkType == tk_integer);
-    CHECK(res[0].keyword == "69420");
+    CHECK(res[0].keyword() == "69420");
 
     res = LEXER("5.32006", "").result();
     CHECK(res[0].tkType == tk_decimal);
-    CHECK(res[0].keyword == "5.32006");
+    CHECK(res[0].keyword() == "5.32006");
 
     res = LEXER("\"A blazing fast language\"", "").result();
     CHECK(res[0].tkType == tk_string);
-    CHECK(res[0].keyword == std::string("A blazing fast language"));
+    CHECK(res[0].keyword() == std::string("A blazing fast language"));
 
     res = LEXER("True", "").result();
     CHECK(res[0].tkType == tk_true);
 }
 
+TEST_CASE("Tokenize numbers") {
+    std::vector<Token> res;
+
+    res = LEXER("0x1F 0XaB 007 1e5 1.5e3 2.5", "").result();
+    CHECK(res[0].tkType == tk_integer);
+    CHECK(res[1].tkType == tk_integer);
+    CHECK(res[2].tkType == tk_integer);
+    CHECK(res[3].tkType == tk_decimal);
+    CHECK(res[4].tkType == tk_decimal);
+    CHECK(res[4].keyword() == "1.5e3");
+    CHECK(res[5].tkType == tk_decimal);
+
+    res = LEXER("_x9 x1", "").result();
+    CHECK(res[0].tkType == tk_identifier);
+    CHECK(res[1].tkType == tk_identifier);
+}
+
+TEST_CASE("Tokenize keywords") {
+    std::vector<Token> res;
+
+    res = LEXER("def class continue __asm__ is", "").result();
+    CHECK(res[0].tkType == tk_def);
+    CHECK(res[1].tkType == tk_class);
+    CHECK(res[2].tkType == tk_continue);
+    CHECK(res[3].tkType == tk_asm);
+    CHECK(res[4].tkType == tk_is);
+
+    res = LEXER("classes Tru extrn exports", "").result();
+    CHECK(res[0].tkType == tk_identifier);
+    CHECK(res[1].tkType == tk_identifier);
+    CHECK(res[2].tkType == tk_identifier);
+    CHECK(res[3].tkType == tk_identifier);
+}
+
 TEST_CASE("Tokenize variable declarations") {
   std::vector<Token> res = LEXER("int test = 23", "").result();
 
@@ -57,3 +95,132 @@ TEST_CASE("Tokenize if-else statements") {
     CHECK(res[10].tkType == tk_colon);
   }
 }
+
+TEST_CASE("Stream tokens on demand") {
+    LEXER lexer("if x not in y:\n    pass\nz\n", "");
+
+    CHECK(lexer.next_token().tkType == tk_if);
+    CHECK(lexer.next_token().tkType == tk_identifier);
+    CHECK(lexer.next_token().tkType == tk_not_in);
+    CHECK(lexer.next_token().tkType == tk_identifier);
+    CHECK(lexer.next_token().tkType == tk_colon);
+    CHECK(lexer.next_token().tkType == tk_ident);
+    CHECK(lexer.next_token().tkType == tk_identifier);
+    CHECK(lexer.next_token().tkType == tk_new_line);
+    CHECK(lexer.next_token().tkType == tk_dedent);
+    CHECK(lexer.next_token().tkType == tk_identifier);
+    CHECK(lexer.next_token().tkType == tk_new_line);
+    CHECK(lexer.next_token().tkType == tk_eof);
+    CHECK(lexer.next_token().tkType == tk_eof);
+}
+
+TEST_CASE("Scan for the next interesting byte") {
+    std::string text(100, 'a');
+    text[37] = '"';
+    text[70] = '\n';
+    text[99] = '{';
+
+    for (int isa = scan::isa_scalar; isa <= scan::detected(); ++isa) {
+        auto level = static_cast<scan::Isa>(isa);
+        CHECK(scan::find(text, 0, "\"\n", level) == 37);
+        CHECK(scan::find(text, 37, "\"\n", level) == 37);
+        CHECK(scan::find(text, 38, "\"\n", level) == 70);
+        CHECK(scan::find(text, 71, "\"\n", level) == 100);
+        CHECK(scan::find(text, 71, "\"\n{", level) == 99);
+        CHECK(scan::find(text, 100, "{", level) == 100);
+    }
+}
+
+TEST_CASE("Index the lines of a source file") {
+    SourceFile file("a = 1\nb = \"x\"\r\n\nc", "");
+
+    REQUIRE(file.line_count() == 4);
+    CHECK(file.line(1) == "a = 1");
+    CHECK(file.line(2) == "b = \"x\"");
+    CHECK(file.line(3) == "");
+    CHECK(file.line(4) == "c");
+
+    CHECK(file.line_of(0) == 1);
+    CHECK(file.line_of(5) == 1);
+    CHECK(file.line_of(6) == 2);
+    CHECK(file.line_of(15) == 3);
+    CHECK(file.line_of(16) == 4);
+}
+
+TEST_CASE("Register source files from several threads") {
+    std::vector<uint16_t> ids(400);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&ids, t] {
+            for (size_t i = t; i < ids.size(); i += 4) {
+                ids[i] = sources::add(std::to_string(i), "");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        CHECK(sources::get(ids[i]).text() == std::to_string(i));
+    }
+}
+
+TEST_CASE("Make up tokens while others read them") {
+    // per thread, the lexemes that did not read back as they were made
+    std::vector<size_t> wrong(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < wrong.size(); ++t) {
+        threads.emplace_back([&wrong, t] {
+            std::vector<std::string> texts;
+            std::vector<Token> made;
+            for (size_t i = 0; i < 200; ++i) {
+                texts.push_back("made_up_" + std::to_string(t) + "_" +
+                                std::to_string(i));
+                made.push_back(TokenUtils::makeToken(tk_identifier, texts[i]));
+                // the tokens made before this one, while the other
+                // threads keep pooling theirs
+                for (size_t j = 0; j < made.size(); ++j) {
+                    wrong[t] += made[j].lexeme() != texts[j];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto count : wrong) {
+        CHECK(count == 0);
+    }
+}
+
+TEST_CASE("Lex large files in parallel") {
+    std::string input;
+    for (int i = 0; i < 50; ++i) {
+        input += "def f" + std::to_string(i) + "(a:int)->int:\n";
+        input += "    x = g(a,\n1,\n    2)\n";
+        input += "# comment\n";
+        input += "    return x\n";
+    }
+    input += "y = f\"{a} and {b}\"\n";
+
+    auto sequential = LEXER(input, "").result();
+
+    size_t threshold = LEXER::parallel_threshold;
+    size_t chunk = LEXER::parallel_chunk;
+    LEXER::parallel_threshold = 0;
+    LEXER::parallel_chunk = 64;
+    auto parallel = LEXER(input, "").result();
+    LEXER::parallel_threshold = threshold;
+    LEXER::parallel_chunk = chunk;
+
+    REQUIRE(parallel.size() == sequential.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+        CHECK(parallel[i].tkType == sequential[i].tkType);
+        CHECK(parallel[i].keyword() == sequential[i].keyword());
+        CHECK(parallel[i].line == sequential[i].line);
+        CHECK(parallel[i].location == sequential[i].location);
+        CHECK(parallel[i].start == sequential[i].start);
+    }
+}
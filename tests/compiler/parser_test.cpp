@@ -1,35 +1,151 @@
 #include "doctest.h"
 
-#include <vector>
-#include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
-#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/wait.h>
+#include <ast/ast.hpp>
 #include <lexer/lexer.hpp>
 #include <lexer/tokens.hpp>
 #include <parser/parser.hpp>
-#include <ast/ast.hpp>
+#include <utils/threadPool.hpp>
+
+// the shared pool is made the first time it is used, which is after this.
+// With more than one worker large files are parsed in parallel on any
+// machine
+static const int threads = setenv("PEREGRINE_THREADS", "4", 1);
 
-std::vector<Token> lexFile(const char* filename) {
+static std::string readFile(const std::filesystem::path& filename) {
     std::ifstream file(filename);
     std::stringstream buf;
     buf << file.rdbuf();
+    return buf.str();
+}
+
+// `source` parsed in chunks of about `chunk` tokens, or in one piece when
+// `chunk` is 0
+static ast::AstNodePtr parse(const std::string& source, size_t chunk) {
+    auto threshold = Parser::Parser::parallel_threshold;
+    auto size = Parser::Parser::parallel_chunk;
+    if (chunk != 0) {
+        Parser::Parser::parallel_threshold = 0;
+        Parser::Parser::parallel_chunk = chunk;
+    }
+    auto lex = LEXER(source, "test.pe");
+    Parser::Parser parser(lex, "test.pe");
+    auto program = parser.parse();
+    Parser::Parser::parallel_threshold = threshold;
+    Parser::Parser::parallel_chunk = size;
+    return program;
+}
+
+// a file with definitions of every kind that chunks start at
+static std::string definitions(size_t count) {
+    std::string source = "\"doc comment of the file\"\n";
+    for (size_t i = 0; i < count; ++i) {
+        auto n = std::to_string(i);
+        source += "def f" + n + "(a:int)->int:\n"
+                  "    x = g(a,\n1,\n    2)\n"
+                  "    return x\n"
+                  "@f" + n + "\n"
+                  "def d" + n + "():\n"
+                  "    ...\n"
+                  "class c" + n + ":\n"
+                  "    y:int = " + n + "\n"
+                  "enum e" + n + ":\n"
+                  "    A,\n"
+                  "    B\n"
+                  "union u" + n + ":\n"
+                  "    i:int\n"
+                  "    f:float\n"
+                  "type t" + n + " = def(int)->int\n"
+                  "v" + n + " = [1, 2]\n";
+    }
+    return source;
+}
 
-    return lexer(buf.str(), filename);
+// the output and exit status of parsing `source` with the test case below,
+// in a process of its own since a parse error exits
+static std::pair<std::string, int> parseAlone(const std::string& source,
+                                              size_t chunk) {
+    auto filename =
+        (std::filesystem::temp_directory_path() / "parser_test.pe").string();
+    std::ofstream(filename) << source;
+    auto command = "PEREGRINE_TEST_PARSE=" + filename +
+                   " PEREGRINE_TEST_CHUNK=" + std::to_string(chunk) +
+                   " " + std::filesystem::read_symlink("/proc/self/exe").string() +
+                   " -tc='Parse the file of PEREGRINE_TEST_PARSE'";
+    std::string output;
+    auto process = popen(command.c_str(), "r");
+    char buf[4096];
+    while (size_t read = fread(buf, 1, sizeof(buf), process)) {
+        output.append(buf, read);
+    }
+    int status = pclose(process);
+    std::filesystem::remove(filename);
+    return {output, WIFEXITED(status) ? WEXITSTATUS(status) : -1};
 }
 
 TEST_SUITE_BEGIN("Parser");
 
 TEST_CASE("Parse binary expressions") {
-    Parser parser(lexFile("../bin_expr.pe"));
-    AstNodePtr program = parser.parse();
-
-    auto programNode = std::dynamic_pointer_cast<Program>(program);
+    auto source = readFile(
+        std::filesystem::path(__FILE__).parent_path().parent_path() /
+        "bin_expr.pe");
+    ast::AstNodePtr program = parse(source, 0);
+    CHECK(program->type() == ast::KAstProgram);
 
     //TODO: implement it
 }
 
-TEST_SUITE_END();
+TEST_CASE("Parse large files in parallel") {
+    REQUIRE(Utils::ThreadPool::shared().size() > 1);
 
+    auto source = definitions(50);
+    auto sequential = parse(source, 0)->stringify();
+    for (size_t chunk : {1, 16, 100, 1000}) {
+        CHECK(parse(source, chunk)->stringify() == sequential);
+    }
+}
 
+TEST_CASE("Report the error a sequential parse reports") {
+    auto before = definitions(20);
+    size_t line = std::count(before.begin(), before.end(), '\n') + 1;
+    // a parse error in a chunk in the middle, where the chunks after it and
+    // the lexer have errors too, and a lexer error alone. The lexer reports
+    // it on the line after the last one
+    std::vector<std::pair<std::string, size_t>> files = {
+        {before + "def broken(:\n" + definitions(20) + "x = (\n", line},
+        {before + "x = (\n", line + 1}};
+    for (auto& [source, errorLine] : files) {
+        auto [expected, expectedStatus] = parseAlone(source, 0);
+        REQUIRE(expectedStatus == 1);
+        CHECK(expected.find("test.pe:" + std::to_string(errorLine) + ":") !=
+              std::string::npos);
+        for (size_t chunk : {1, 16, 100}) {
+            auto [output, status] = parseAlone(source, chunk);
+            CHECK(status == 1);
+            CHECK(output == expected);
+        }
+    }
+}
 
+// run by the test case above, a file without errors exits with 0
+TEST_CASE("Parse the file of PEREGRINE_TEST_PARSE") {
+    auto filename = std::getenv("PEREGRINE_TEST_PARSE");
+    if (filename == nullptr) {
+        return;
+    }
+    REQUIRE(Utils::ThreadPool::shared().size() > 1);
+    parse(readFile(filename),
+          std::strtoul(std::getenv("PEREGRINE_TEST_CHUNK"), nullptr, 10));
+    exit(0);
+}
 
+TEST_SUITE_END();
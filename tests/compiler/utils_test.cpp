@@ -0,0 +1,104 @@
+#include "doctest.h"
+
+#include <memory>
+#include <string>
+#include <utils/symbolTable.hpp>
+
+using Table = Utils::SymbolTable<int>;
+
+TEST_SUITE_BEGIN("Utils");
+
+TEST_CASE("Look up names of the enclosing scopes") {
+    auto global = std::make_shared<Table>(nullptr);
+    CHECK(global->set("a", 1));
+    auto function = std::make_shared<Table>(global);
+    CHECK(function->set("b", 2));
+    auto block = std::make_shared<Table>(function);
+    CHECK(block->set("c", 3));
+
+    CHECK(block->get("a") == 1);
+    CHECK(block->get("b") == 2);
+    CHECK(block->get("c") == 3);
+    CHECK(block->get("d") == std::nullopt);
+}
+
+TEST_CASE("Do not shadow names of an enclosing scope") {
+    auto global = std::make_shared<Table>(nullptr);
+    global->set("a", 1);
+    global->add_enum("e", 1);
+    {
+        auto block = std::make_shared<Table>(global);
+        // variables can not be defined again, enums and unions hide the
+        // outer ones until the scope closes
+        CHECK_FALSE(block->set("a", 2));
+        CHECK(block->get("a") == 1);
+        block->add_enum("e", 2);
+        CHECK(block->get_enum("e") == 2);
+    }
+    CHECK(global->get("a") == 1);
+    CHECK(global->get_enum("e") == 1);
+}
+
+TEST_CASE("Do not define a name twice in one scope") {
+    auto global = std::make_shared<Table>(nullptr);
+    CHECK(global->set("a", 1));
+    CHECK_FALSE(global->set("a", 2));
+    CHECK(global->get("a") == 1);
+
+    global->add_union("u", 1);
+    {
+        auto block = std::make_shared<Table>(global);
+        block->add_union("u", 2);
+        block->add_union("u", 3);
+        CHECK(block->get_union("u") == 3);
+    }
+    CHECK(global->get_union("u") == 1);
+}
+
+TEST_CASE("Forget the names of a scope once it is dropped") {
+    auto global = std::make_shared<Table>(nullptr);
+    global->set("a", 1);
+    {
+        auto block = std::make_shared<Table>(global);
+        block->set("b", 2);
+        block->add_enum("e", 3);
+        // assigned in the block, the variable is the one of the outer scope
+        CHECK(block->reassign("a", 4));
+        // enough names to grow the tables and move entries around when they
+        // are taken out again
+        for (int i = 0; i < 100; ++i) {
+            CHECK(block->set("n" + std::to_string(i), i));
+        }
+    }
+    CHECK(global->get("a") == 4);
+    CHECK(global->get("b") == std::nullopt);
+    CHECK(global->get_enum("e") == std::nullopt);
+    for (int i = 0; i < 100; ++i) {
+        CHECK(global->get("n" + std::to_string(i)) == std::nullopt);
+    }
+
+    // the next scope starts out empty
+    auto block = std::make_shared<Table>(global);
+    CHECK(block->get("b") == std::nullopt);
+    CHECK(block->set("b", 5));
+    CHECK(block->get("a") == 4);
+}
+
+TEST_CASE("Open scopes of their own over a shared outer scope") {
+    auto global = std::make_shared<Table>(nullptr);
+    global->set("a", 1);
+    {
+        auto first = Table::fork(global);
+        auto second = Table::fork(global);
+        CHECK(first->set("b", 2));
+        CHECK(second->set("b", 3));
+        CHECK(first->get("a") == 1);
+        CHECK(first->get("b") == 2);
+        CHECK(second->get("b") == 3);
+        CHECK_FALSE(first->reassign("a", 4));
+    }
+    CHECK(global->get("a") == 1);
+    CHECK(global->get("b") == std::nullopt);
+}
+
+TEST_SUITE_END();